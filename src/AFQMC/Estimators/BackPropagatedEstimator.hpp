@@ -71,18 +71,27 @@ class BackPropagatedEstimator: public EstimatorBase
     if(cur != NULL) {
       ParameterSet m_param;
       std::string restore_paths;
+      std::string history_precision("double");
       m_param.add(nStabalize, "ortho", "int");
       m_param.add(max_nback_prop, "nsteps", "int");
       m_param.add(nave, "naverages", "int");
       m_param.add(restore_paths, "path_restoration", "std::string");
       m_param.add(block_size, "block_size", "int");
       m_param.add(nblocks_skip, "nskip", "int");
+      m_param.add(history_precision, "history_precision", "std::string");
       m_param.put(cur);
       if(restore_paths == "true") {
         path_restoration = true;
       } else {
         path_restoration = false;
       }
+      if(history_precision == "single") {
+        sp_fields = true;
+      } else if(history_precision == "double") {
+        sp_fields = false;
+      } else {
+        APP_ABORT(" Error: Unknown history_precision in BackPropagatedEstimator. Options: double, single. \n");
+      }
     }
 
     if(nave <= 0)
@@ -101,7 +110,7 @@ class BackPropagatedEstimator: public EstimatorBase
 
     int ncv(prop0.global_number_of_cholesky_vectors());
     int nref(wfn0.number_of_references_for_back_propagation());
-    wset.resize_bp(max_nback_prop,ncv,nref);
+    wset.resize_bp(max_nback_prop,ncv,nref,sp_fields);
     wset.setBPPos(0);
     // set SMN in case BP begins right away
     if(nblocks_skip==0)
@@ -290,6 +299,8 @@ class BackPropagatedEstimator: public EstimatorBase
   // Whether to restore cosine projection and real local energy apprximation for weights
   // along back propagation path.
   bool path_restoration, importanceSampling;
+  // Whether to store the history of auxiliary fields in single precision.
+  bool sp_fields = false;
 
   bool write_metadata = true;
 
@@ -209,7 +209,6 @@ std::cout<<"\n";
       int nu0 = rotMuv.global_offset()[0];
       int nv = rotMuv.size(1);
       int nel_ = rotcPua[0].size(1);
-      int nspin = (walker_type==COLLINEAR)?2:1;
       assert(G.size(1) == nel_*nmo_);
       if(addEJ and getKl)
         assert(Kl->size(0) == nwalk && Kl->size(1) == nu);
@@ -220,14 +219,13 @@ std::cout<<"\n";
       std::tie(u0,uN) = FairDivideBoundary(comm->rank(),nu,comm->size());
       int v0,vN;
       std::tie(v0,vN) = FairDivideBoundary(comm->rank(),nv,comm->size());
-      // right now the algorithm uses 2 copies of matrices of size nuxnv in COLLINEAR case,
-      // consider moving loop over spin to avoid storing the second copy which is not used
-      // simultaneously
-      size_t memory_needs = nspin*nu*nv + nv + nu  + nel_*(nv+nu);
+      // in the COLLINEAR case the alpha and beta sectors of Guv are calculated one after the 
+      // other in the same buffer, only one matrix of size nuxnv is stored 
+      size_t memory_needs = nu*nv + nv + nu  + nel_*(nv+nu);
       set_shm_buffer(memory_needs);
       size_t cnt=0;
-      // Guv[nspin][nu][nv]
-      boost::multi::array_ref<ComplexType,3> Guv(to_address(SM_TMats.origin()),{nspin,nu,nv});
+      // Guv[1][nu][nv]
+      boost::multi::array_ref<ComplexType,3> Guv(to_address(SM_TMats.origin()),{1,nu,nv});
       cnt+=Guv.num_elements();
       // Guu[u]: summed over spin
       boost::multi::array_ref<ComplexType,1> Guu(to_address(SM_TMats.origin())+cnt,iextensions<1u>{nv});
@@ -260,70 +258,34 @@ std::cout<<"\n";
               std::copy_n(to_address(Tuu.origin())+u0,uN-u0,to_address((*Kr)[wi].origin())+u0);
             E[wi][2] = 0.5*scl*scl*ma::dot(Guu.sliced(nu0+u0,nu0+uN),Tuu.sliced(u0,uN));
           }
-          if(addEXX) {
-//Timer.reset("T0");
-//Timer.start("T0");
-            ComplexType E_(0.0);
-            for(int bu=0; bu<nbu; ++bu) {
-              int i0 = u0+bu*bsz;
-              int iN = std::min(u0+(bu+1)*bsz,uN);
-              for(int bv=0; bv<nbv; ++bv) {
-                int j0 = bv*bsz;
-                int jN = std::min((bv+1)*bsz,nv);
-                for(int i=i0; i<iN; ++i) {
-                  for(int j=j0; j<jN; ++j)
-                    E_ += Guv[0][i][j] * M_[i][j] * Guv[0][j][i];
-                }
-              }
-            }
-            E[wi][1] = -0.5*scl*E_;
-          }
+          if(addEXX) 
+            E[wi][1] = -0.5*scl*exchange_contraction(Guv[0],M_,u0,uN,nbu,nbv,bsz);
         }
       } else {
         for(int wi=0; wi<nwalk; wi++) {
           boost::multi::array_cref<ComplexType,2> Gw(to_address(G[wi].origin()),{nel_,nmo_});
           boost::multi::array_cref<ComplexType,1> G1DA(to_address(G[wi].origin()),iextensions<1u>{NAOA*nmo_});
           boost::multi::array_cref<ComplexType,1> G1DB(to_address(G[wi].origin())+NAOA*nmo_,iextensions<1u>{NAOB*nmo_});
+          ComplexType E_(0.0);
+          // alpha: Guv holds the alpha sector, Guu the alpha diagonal and the off-node terms
           Guv_Guu(Gw,Guv,Guu,T1,k);
-          // move calculation of Guv/Guu here to avoid storing 2 copies of Guv for alpha/beta
+          if(addEXX) 
+            E_ += exchange_contraction(Guv[0],M_,u0,uN,nbu,nbv,bsz);
+          // beta: overwrites Guv and completes the spin sum in Guu 
+          Guv_Guu_beta(Guv,Guu,T1,k);
+          if(addEXX) 
+            E_ += exchange_contraction(Guv[0],M_,u0,uN,nbu,nbv,bsz);
           if(addEJ) {
             ma::product(rotMuv.get().sliced(u0,uN),Guu,
                       Tuu.sliced(u0,uN));
             if(getKl)
-              std::copy_n(to_address(Guu.origin())+nu0+u0,uN,to_address((*Kl)[wi].origin())+u0);
+              std::copy_n(to_address(Guu.origin())+nu0+u0,uN-u0,to_address((*Kl)[wi].origin())+u0);
             if(getKr)
-              std::copy_n(to_address(Tuu.origin())+u0,uN,to_address((*Kr)[wi].origin())+u0);
+              std::copy_n(to_address(Tuu.origin())+u0,uN-u0,to_address((*Kr)[wi].origin())+u0);
             E[wi][2] = 0.5*ma::dot(Guu.sliced(nu0+u0,nu0+uN),Tuu.sliced(u0,uN));
           }
-          if(addEXX) {
-            // alpha
-            ComplexType E_(0.0);
-            for(int bu=0; bu<nbu; ++bu) {
-              int i0 = u0+bu*bsz;
-              int iN = std::min(u0+(bu+1)*bsz,uN);
-              for(int bv=0; bv<nbv; ++bv) {
-                int j0 = bv*bsz;
-                int jN = std::min((bv+1)*bsz,nv);
-                for(int i=i0; i<iN; ++i) {
-                  for(int j=j0; j<jN; ++j)
-                    E_ += Guv[0][i][j] * M_[i][j] * Guv[0][j][i];
-                }
-              }
-            }
-            for(int bu=0; bu<nbu; ++bu) {
-              int i0 = u0+bu*bsz;
-              int iN = std::min(u0+(bu+1)*bsz,uN);
-              for(int bv=0; bv<nbv; ++bv) {
-                int j0 = bv*bsz;
-                int jN = std::min((bv+1)*bsz,nv);
-                for(int i=i0; i<iN; ++i) {
-                  for(int j=j0; j<jN; ++j)
-                    E_ += Guv[1][i][j] * M_[i][j] * Guv[1][j][i];
-                }
-              }
-            }
+          if(addEXX) 
             E[wi][1] = -0.5*E_;
-          }
         }
       }
       comm->barrier();
@@ -820,8 +782,10 @@ std::cout<<"\n";
     // As opposed to the other Guu routines,
     //  this routine expects G for the walker in matrix form
     // rotMuv is partitioned along 'u'
+    // In the COLLINEAR case, only the alpha sector is calculated, 
+    //  the beta sector is added with Guv_Guu_beta
     // G[nel][nmo]
-    // Guv[nspin][nu][nu]
+    // Guv[1][nu][nu]
     // Guu[u]: summed over spin
     // T1[nel_][nu]
     template<class MatA, class MatB, class MatC, class MatD>
@@ -868,8 +832,9 @@ std::cout<<"\n";
           } else
             Guu[v] = Guv[0][v-nu0][v];
       } else {
+        // only the alpha sector is calculated here, see Guv_Guu_beta
         int nel_ = NAOA+NAOB;
-        assert(Guv.size(0) == 2);
+        assert(Guv.size(0) == 1);
         assert(G.size(0) == nel_);
         assert(G.size(1) == nmo_);
         assert(T1.size(0) == nel_);
@@ -883,18 +848,72 @@ std::cout<<"\n";
         ma::product(rotcPua[k].get()({nu0,nu0+nu},{0,NAOA}),
                     T1({0,NAOA},{v0,vN}),
                     Guv[0]({0,nu},{v0,vN}));
-        ma::product(rotcPua[k].get()({nu0,nu0+nu},{NAOA,nel_}),
-                    T1({NAOA,nel_},{v0,vN}),
-                    Guv[1]({0,nu},{v0,vN}));
         for(int v=v0; v<vN; ++v)
           if( v < nu0 || v >= nu0+nu ) {
             Guu[v] = ma::dot(rotcPua[k].get()[v],T1(T1.extension(0),v));
           } else
-            Guu[v] = Guv[0][v-nu0][v]+Guv[1][v-nu0][v];
+            Guu[v] = Guv[0][v-nu0][v];
       }
       comm->barrier();
     }
 
+    // COLLINEAR case only. 
+    // Overwrites Guv with the beta sector, using T1 from a previous call to Guv_Guu,
+    // and adds the beta contribution to the local diagonal terms of Guu.
+    // Guv[1][nu][nv]
+    // Guu[u]: summed over spin
+    // T1[nel_][nu]
+    template<class MatB, class MatC, class MatD>
+    void Guv_Guu_beta(MatB&& Guv, MatC&& Guu, MatD&& T1, int k) {
+
+      static_assert(std::decay<MatB>::type::dimensionality == 3, "Wrong dimensionality");
+      static_assert(std::decay<MatC>::type::dimensionality == 1, "Wrong dimensionality");
+      static_assert(std::decay<MatD>::type::dimensionality == 2, "Wrong dimensionality");
+      assert(walker_type==COLLINEAR);
+      int nel_ = NAOA+NAOB;
+      int nu = int(rotMuv.size(0));  // potentially distributed over nodes
+      int nv = int(rotMuv.size(1));  // not distributed over nodes
+      int v0,vN;
+      std::tie(v0,vN) = FairDivideBoundary(comm->rank(),nv,comm->size());
+      int nu0 = rotMuv.global_offset()[0];
+
+      assert(Guv.size(0) == 1);
+      assert(Guv.size(1) == nu);
+      assert(Guv.size(2) == nv);
+      assert(T1.size(0) == nel_);
+      assert(T1.size(1) == nv);
+
+      // alpha sector in Guv might still be in use 
+      comm->barrier();
+      ma::product(rotcPua[k].get()({nu0,nu0+nu},{NAOA,nel_}),
+                  T1({NAOA,nel_},{v0,vN}),
+                  Guv[0]({0,nu},{v0,vN}));
+      for(int v=std::max(v0,nu0); v<std::min(vN,nu0+nu); ++v)
+        Guu[v] += Guv[0][v-nu0][v];
+      comm->barrier();
+    }
+
+    // Exchange contraction sum_{u,v} Guv[u][v] * Muv[u][v] * Guv[v][u] over the rows [u0,uN) 
+    // of this core, in blocks of size bsz to keep the transposed access in cache.
+    template<class MatA, class MatM>
+    ComplexType exchange_contraction(MatA const& Guv, MatM const& M_, int u0, int uN, int nbu, int nbv, int bsz) {
+      int nv = int(M_.size(1));
+      ComplexType E_(0.0);
+      for(int bu=0; bu<nbu; ++bu) {
+        int i0 = u0+bu*bsz;
+        int iN = std::min(u0+(bu+1)*bsz,uN);
+        for(int bv=0; bv<nbv; ++bv) {
+          int j0 = bv*bsz;
+          int jN = std::min((bv+1)*bsz,nv);
+          for(int i=i0; i<iN; ++i) {
+            for(int j=j0; j<jN; ++j)
+              E_ += Guv[i][j] * M_[i][j] * Guv[j][i];
+          }
+        }
+      }
+      return E_;
+    }
+
     // since this is for energy, only compact is accepted
     // Computes Guv and Guu for a single walker
     // As opposed to the other Guu routines,
@@ -18,6 +18,7 @@
 #include "OhmmsData/Libxml2Doc.h"
 #include "OhmmsApp/ProjectData.h"
 #include "io/hdf_archive.h"
+#include "Utilities/RandomGenerator.h"
 
 #undef APP_ABORT
 #define APP_ABORT(x) {std::cout << x <<std::endl; exit(0);}
@@ -34,6 +35,7 @@
 #include "AFQMC/Hamiltonians/HamiltonianFactory.h"
 #include "AFQMC/Hamiltonians/Hamiltonian.hpp"
 #include "AFQMC/Hamiltonians/THCHamiltonian.h"
+#include "AFQMC/HamiltonianOperations/THCOps.hpp"
 #include "AFQMC/Utilities/readWfn.h"
 #include "AFQMC/SlaterDeterminantOperations/SlaterDetOperations.hpp"
 #include "AFQMC/Utilities/test_utils.hpp"
@@ -202,6 +204,209 @@ void ham_ops_basic_serial(boost::mpi3::communicator & world)
   }
 }
 
+// THCOps with random factors on a single node.
+// The COLLINEAR energy, calculated with a single Guv buffer for both spins, is compared
+// against the alpha and beta sectors of Guv stored separately. vbias and vHS are compared
+// against the dense contractions. With more than one core per node, the partition over 'u'
+// is uneven and the Kl/Kr copies of every core are checked.
+void thc_ops_collinear(boost::mpi3::communicator & world)
+{
+  using CVector = boost::multi::array<ComplexType,1>;
+  using CMatrix = boost::multi::array<ComplexType,2>;
+  using VMatrix = boost::multi::array<ValueType,2>;
+  using shmCMatrix = mpi3_shared_ma_proxy<ComplexType>;
+  using shmVMatrix = mpi3_shared_ma_proxy<ValueType>;
+  using shmArray = boost::multi::array<ComplexType,2,shared_allocator<ComplexType>>;
+
+  afqmc::GlobalTaskGroup gTG(world);
+  auto& node = gTG.Node();
+
+  const int NMO = 6, NAEA = 3, NAEB = 2, NEL = NAEA+NAEB;
+  const int NU = 11, NL = 7, nwalk = 2;
+  const ValueType E0(1.5);
+
+  // same sequence on all cores
+  RandomGenerator_t rng;
+  auto randC = [&]() { return ComplexType(rng()-0.5,rng()-0.5); };
+#if defined(QMC_COMPLEX)
+  auto randV = [&]() { return ValueType(rng()-0.5,rng()-0.5); };
+#else
+  auto randV = [&]() { return ValueType(rng()-0.5); };
+#endif
+
+  CMatrix rotPiu({NMO,NU}), Piu({NMO,NU}), rotcPua({NU,NEL}), cPua({NU,NEL});
+  VMatrix Muv({NU,NU}), Luv({NU,NL});
+  CVector haj(iextensions<1u>{NEL*NMO});
+  CMatrix G({nwalk,NEL*NMO});
+  for(int i=0; i<NMO; i++)
+    for(int u=0; u<NU; u++) {
+      rotPiu[i][u] = randC();
+      Piu[i][u] = randC();
+    }
+  for(int u=0; u<NU; u++)
+    for(int a=0; a<NEL; a++) {
+      rotcPua[u][a] = randC();
+      cPua[u][a] = randC();
+    }
+  for(int u=0; u<NU; u++)
+    for(int v=0; v<NU; v++)
+      Muv[u][v] = randV();
+  for(int u=0; u<NU; u++)
+    for(int n=0; n<NL; n++)
+      Luv[u][n] = randV();
+  for(int i=0; i<haj.size(0); i++)
+    haj[i] = randC();
+  for(int w=0; w<nwalk; w++)
+    for(int i=0; i<G.size(1); i++)
+      G[w][i] = randC();
+
+  auto to_shm = [&](auto const& A, auto& B) {
+    if(node.root())
+      std::copy_n(A.origin(),A.num_elements(),B.origin());
+    node.barrier();
+  };
+  shmVMatrix rotMuv_(node,{NU,NU});
+  shmCMatrix rotPiu_(node,{NMO,NU});
+  std::vector<shmCMatrix> rotcPua_;
+  rotcPua_.emplace_back(shmCMatrix(node,{NU,NEL}));
+  shmVMatrix Luv_(node,{NU,NL});
+  shmCMatrix Piu_(node,{NMO,NU});
+  std::vector<shmCMatrix> cPua_;
+  cPua_.emplace_back(shmCMatrix(node,{NU,NEL}));
+  to_shm(Muv,rotMuv_);
+  to_shm(rotPiu,rotPiu_);
+  to_shm(rotcPua,rotcPua_[0]);
+  to_shm(Luv,Luv_);
+  to_shm(Piu,Piu_);
+  to_shm(cPua,cPua_[0]);
+  std::vector<CVector> haj_;
+  haj_.emplace_back(haj);
+
+  THCOps<ValueType> thc(node,NMO,NAEA,NAEB,COLLINEAR,CMatrix({NMO,NMO}),std::move(haj_),
+                        std::move(rotMuv_),std::move(rotPiu_),std::move(rotcPua_),
+                        std::move(Luv_),std::move(Piu_),std::move(cPua_),CMatrix({NMO,NMO}),E0);
+
+  auto check = [](ComplexType a, ComplexType b) {
+    REQUIRE( real(a) == Approx(real(b)) );
+    REQUIRE( imag(a) == Approx(imag(b)) );
+  };
+
+  // Kl[nwalk][nu] followed by Kr[nwalk][nu] in shared memory,
+  // the last row catches copies past the end of Kr
+  shmArray Kbuff({2*nwalk+1,NU},shared_allocator<ComplexType>{node});
+  if(node.root())
+    std::fill_n(to_address(Kbuff.origin()),Kbuff.num_elements(),ComplexType(0.0));
+  node.barrier();
+  boost::multi::array_ref<ComplexType,2> Kl(to_address(Kbuff.origin()),{nwalk,NU});
+  boost::multi::array_ref<ComplexType,2> Kr(to_address(Kbuff.origin())+nwalk*NU,{nwalk,NU});
+  CMatrix E({nwalk,3});
+  thc.energy(E,G,0,&Kl,&Kr,node.root());
+  node.all_reduce_in_place_n(E.origin(),E.num_elements(),std::plus<>());
+
+  for(int w=0; w<nwalk; w++) {
+    boost::multi::array_cref<ComplexType,2> Gw(G[w].origin(),{NEL,NMO});
+    ComplexType E1(E0);
+    for(int a=0; a<NEL; a++)
+      for(int i=0; i<NMO; i++)
+        E1 += Gw[a][i]*haj[a*NMO+i];
+    // Guv[nspin][nu][nu], one copy per spin
+    boost::multi::array<ComplexType,3> Guv({2,NU,NU});
+    std::fill_n(Guv.origin(),Guv.num_elements(),ComplexType(0.0));
+    for(int a=0; a<NEL; a++) {
+      int s = (a<NAEA)?0:1;
+      for(int v=0; v<NU; v++) {
+        ComplexType T1(0.0);
+        for(int i=0; i<NMO; i++)
+          T1 += Gw[a][i]*rotPiu[i][v];
+        for(int u=0; u<NU; u++)
+          Guv[s][u][v] += rotcPua[u][a]*T1;
+      }
+    }
+    CVector Guu(iextensions<1u>{NU}), Tuu(iextensions<1u>{NU});
+    for(int u=0; u<NU; u++)
+      Guu[u] = Guv[0][u][u] + Guv[1][u][u];
+    ComplexType EJ(0.0), EXX(0.0);
+    for(int u=0; u<NU; u++) {
+      Tuu[u] = ComplexType(0.0);
+      for(int v=0; v<NU; v++)
+        Tuu[u] += Muv[u][v]*Guu[v];
+      EJ += 0.5*Guu[u]*Tuu[u];
+    }
+    for(int s=0; s<2; s++)
+      for(int u=0; u<NU; u++)
+        for(int v=0; v<NU; v++)
+          EXX += -0.5*Guv[s][u][v]*Muv[u][v]*Guv[s][v][u];
+
+    check(E[w][0],E1);
+    check(E[w][1],EXX);
+    check(E[w][2],EJ);
+    for(int u=0; u<NU; u++) {
+      check(Kl[w][u],Guu[u]);
+      check(Kr[w][u],Tuu[u]);
+    }
+  }
+  ComplexType const* Kend = to_address(Kbuff.origin())+2*nwalk*NU;
+  for(int u=0; u<NU; u++)
+    REQUIRE( std::abs(Kend[u]) == 0.0 );
+
+  // Cholesky vector n from Luv, complex vectors are split into real and imaginary parts
+  auto L = [&](int u, int n) {
+#if defined(QMC_COMPLEX)
+    return (n%2==0)?real(Luv[u][n/2]):imag(Luv[u][n/2]);
+#else
+    return Luv[u][n];
+#endif
+  };
+  int nchol = thc.local_number_of_cholesky_vectors();
+  double sqrtdt = std::sqrt(0.01);
+  shmArray X({nchol,nwalk},shared_allocator<ComplexType>{node});
+  thc.vbias(G,X,sqrtdt);
+  node.barrier();
+  for(int w=0; w<nwalk; w++) {
+    boost::multi::array_cref<ComplexType,2> Gw(G[w].origin(),{NEL,NMO});
+    CVector Guu(iextensions<1u>{NU});
+    for(int u=0; u<NU; u++) {
+      Guu[u] = ComplexType(0.0);
+      for(int a=0; a<NEL; a++)
+        for(int i=0; i<NMO; i++)
+          Guu[u] += cPua[u][a]*Piu[i][u]*Gw[a][i];
+    }
+    for(int n=0; n<nchol; n++) {
+      ComplexType Xn(0.0);
+      for(int u=0; u<NU; u++)
+        Xn += sqrtdt*L(u,n)*Guu[u];
+      check(X[n][w],Xn);
+    }
+  }
+
+  shmArray vHS({nwalk,NMO*NMO},shared_allocator<ComplexType>{node});
+  thc.vHS(X,vHS,sqrtdt);
+  node.barrier();
+  for(int w=0; w<nwalk; w++) {
+    CVector Tu(iextensions<1u>{NU});
+    for(int u=0; u<NU; u++) {
+      Tu[u] = ComplexType(0.0);
+      for(int n=0; n<nchol; n++)
+        Tu[u] += L(u,n)*ComplexType(X[n][w]);
+    }
+    for(int i=0; i<NMO; i++)
+      for(int k=0; k<NMO; k++) {
+        ComplexType vik(0.0);
+        for(int u=0; u<NU; u++)
+          vik += sqrtdt*Tu[u]*std::conj(Piu[i][u])*Piu[k][u];
+        check(vHS[w][i*NMO+k],vik);
+      }
+  }
+}
+
+TEST_CASE("thc_ops_collinear", "[hamiltonian_operations][thc_ops]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+  auto world = boost::mpi3::environment::get_world_instance();
+
+  thc_ops_collinear(world);
+}
+
 TEST_CASE("ham_ops_basic_serial", "[hamiltonian_operations]")
 {
   OHMMS::Controller->initialize(0, NULL);
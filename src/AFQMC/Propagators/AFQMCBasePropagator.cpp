@@ -46,6 +46,7 @@ void AFQMCBasePropagator::parse(xmlNodePtr cur)
   std::string impsam("yes");
   std::string external_field("");
   std::string P1ev("no");
+  std::string mixedp("no");
   double extfield_scale(1.0);
   ParameterSet m_param;
   m_param.add(vbias_bound,"vbias_bound","double");
@@ -60,6 +61,7 @@ void AFQMCBasePropagator::parse(xmlNodePtr cur)
   if(TG.TG_local().size() == 1)
     m_param.add(nbatched_qr,"nbatch_qr","int");
   m_param.add(freep,"free_projection","std::string");
+  m_param.add(mixedp,"mixed_precision","std::string");
 
   //m_param.add(sz_pin_field_file,"sz_pinning_field_file","std::string");
   //m_param.add(sz_pin_field_mag,"sz_pinning_field","double");
@@ -76,6 +78,8 @@ void AFQMCBasePropagator::parse(xmlNodePtr cur)
   if(freep == "yes" || freep == "true") free_projection=true; 
   std::transform(P1ev.begin(),P1ev.end(),P1ev.begin(),(int (*)(int)) tolower);
   if(P1ev == "yes" || P1ev == "true") printP1eV=true; 
+  std::transform(mixedp.begin(),mixedp.end(),mixedp.begin(),(int (*)(int)) tolower);
+  if(mixedp == "yes" || mixedp == "true") mixed_precision=true; 
 
   app_log()<<"\n\n --------------- Parsing Propagator input ------------------ \n\n";
 
@@ -87,6 +91,8 @@ void AFQMCBasePropagator::parse(xmlNodePtr cur)
     app_log()<<" Using batched orthogonalization in back propagation with a batch size: " <<nbatched_qr <<"\n";
   else
     app_log()<<" Using sequential orthogonalization in back propagation. \n";
+  if(mixed_precision)
+    app_log()<<" Using single precision in the application of exp(vHS). \n";
   app_log()<<" vbias_bound: " <<vbias_bound <<std::endl;
 
   if(free_projection) {
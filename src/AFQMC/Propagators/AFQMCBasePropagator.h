@@ -90,7 +90,8 @@ class AFQMCBasePropagator: public AFQMCInfo
             order(6),
             nbatched_propagation(0),
             nbatched_qr(0),
-            spin_dependent_P1(false)
+            spin_dependent_P1(false),
+            mixed_precision(false)
     {
       P1.reserve(2);  
       P1.emplace_back(P1Type(tp_ul_ul{0,0},tp_ul_ul{0,0},0,aux_alloc_));
@@ -184,6 +185,8 @@ class AFQMCBasePropagator: public AFQMCInfo
     int nbatched_qr;
     bool spin_dependent_P1;
     bool printP1eV=false;
+    // apply the Taylor expansion of exp(vHS) in single precision 
+    bool mixed_precision;
 
     RealType vbias_bound;
 
@@ -229,6 +232,24 @@ class AFQMCBasePropagator: public AFQMCInfo
     template<class WSet>
     void apply_propagators_batched(char TA, WSet& wset, int ni, C3Tensor_ref& vHS3D);
 
+    template<class... Args>
+    void propagate(Args&&... args)
+    {
+      if(mixed_precision)
+        SDetOp->PropagateMixedPrecision(std::forward<Args>(args)...);
+      else
+        SDetOp->Propagate(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    void batched_propagate(Args&&... args)
+    {
+      if(mixed_precision)
+        SDetOp->BatchedPropagateMixedPrecision(std::forward<Args>(args)...);
+      else
+        SDetOp->BatchedPropagate(std::forward<Args>(args)...);
+    }
+
     ComplexType apply_bound_vbias(ComplexType v, RealType sqrtdt)
     {
       return (std::abs(v)>vbias_bound*sqrtdt)?
@@ -97,6 +97,14 @@ class SlaterDetOperations:
         );
     }
 
+    template<class... Args>
+    void BatchedPropagateMixedPrecision(Args&&... args) {
+        boost::apply_visitor(
+            [&](auto&& a){a.BatchedPropagateMixedPrecision(std::forward<Args>(args)...);},
+            *this
+        );
+    }
+
     template<class... Args>
     ComplexType MixedDensityMatrix_noHerm(Args&&... args) {
         return boost::apply_visitor(
@@ -153,6 +161,14 @@ class SlaterDetOperations:
         );
     }
 
+    template<class... Args>
+    void PropagateMixedPrecision(Args&&... args) {
+        boost::apply_visitor(
+            [&](auto&& a){a.PropagateMixedPrecision(std::forward<Args>(args)...);},
+            *this
+        );
+    }
+
     template<class... Args>
     ComplexType Orthogonalize(Args&&... args) {
         return boost::apply_visitor(
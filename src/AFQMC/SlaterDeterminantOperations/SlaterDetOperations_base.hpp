@@ -42,6 +42,9 @@ class SlaterDetOperations_base
     using IAlloc = typename Alloc::template rebind<int>::other;
     using RAlloc = typename Alloc::template rebind<R>::other;
     using Rpointer = typename RAlloc::pointer;
+    using SpT = typename to_single_precision<T>::value_type;
+    using SpAlloc = typename Alloc::template rebind<SpT>::other;
+    using Sppointer = typename SpAlloc::pointer;
 
     using IVector = boost::multi::array<int,1,IAlloc>;  
     using TVector = boost::multi::array<T,1,Alloc>;  
@@ -50,6 +53,9 @@ class SlaterDetOperations_base
     using TMatrix = boost::multi::array<T,2,Alloc>;  
     using TMatrix_ref = boost::multi::array_ref<T,2,pointer>;  
     using TTensor_ref = boost::multi::array_ref<T,3,pointer>;  
+    using SpTVector = boost::multi::array<SpT,1,SpAlloc>;  
+    using SpTMatrix_ref = boost::multi::array_ref<SpT,2,Sppointer>;  
+    using SpTTensor_ref = boost::multi::array_ref<SpT,3,Sppointer>;  
 
     SlaterDetOperations_base(Alloc alloc_={}):
       allocator_(alloc_),
@@ -57,7 +63,8 @@ class SlaterDetOperations_base
       WORK(iextensions<1u>{0},allocator_),
       IWORK(iextensions<1u>{0},iallocator_),
       TAU(iextensions<1u>{0},allocator_),
-      TBuff(iextensions<1u>{0},allocator_)
+      TBuff(iextensions<1u>{0},allocator_),
+      SpBuff(iextensions<1u>{0},SpAlloc(alloc_))
     {
     }
 
@@ -69,7 +76,8 @@ class SlaterDetOperations_base
       IWORK(iextensions<1u>{NMO+1},iallocator_),  
       RWORK(iextensions<1u>{NMO+1},rallocator_),  
       TAU(iextensions<1u>{NMO},allocator_),  
-      TBuff(iextensions<1u>{NMO*NMO},allocator_)
+      TBuff(iextensions<1u>{NMO*NMO},allocator_),
+      SpBuff(iextensions<1u>{0},SpAlloc(alloc_))
     {
 
       // only used to determine size of WORK  
@@ -240,6 +248,44 @@ class SlaterDetOperations_base
       }  
     }
 
+    /*
+     * Same as Propagate, but the Taylor expansion of exp(V) is applied in single precision.
+     * Only the correction (exp(V)-1)*P1*A is calculated in single precision, the 
+     * rest of the update and the application of P1 are done in the precision of A.
+     */
+    template<class Mat, class MatP1, class MatV>
+    void PropagateMixedPrecision(Mat&& A, const MatP1& P1, const MatV& V, int order=6, char TA='N') {
+      int NMO = A.size(0);
+      int NAEA = A.size(1);
+      assert(V.stride(1) == 1 && V.stride(0) == V.size(1));
+      set_buffer(2*NMO*NAEA);
+      set_sp_buffer(NMO*NMO + 3*NMO*NAEA);
+      TMatrix_ref TMN(TBuff.data(), {NMO,NAEA});
+      TMatrix_ref DMN(TMN.data()+TMN.num_elements(), {NMO,NAEA});
+      SpTMatrix_ref Vsp(SpBuff.data(), {V.size(0),V.size(1)});
+      SpTMatrix_ref Ssp(Vsp.data()+Vsp.num_elements(), {NMO,NAEA});
+      SpTMatrix_ref T1(Ssp.data()+Ssp.num_elements(), {NMO,NAEA});
+      SpTMatrix_ref T2(T1.data()+T1.num_elements(), {NMO,NAEA});
+      using ma::axpy;
+      copy_n_cast(V.origin(),V.num_elements(),Vsp.origin());
+      if(TA=='H' || TA=='h') 
+        ma::product(ma::H(P1),std::forward<Mat>(A),TMN);
+      else if(TA=='T' || TA=='t') 
+        ma::product(ma::T(P1),std::forward<Mat>(A),TMN);
+      else
+        ma::product(P1,std::forward<Mat>(A),TMN);
+      copy_n_cast(TMN.origin(),TMN.num_elements(),Ssp.origin());
+      SlaterDeterminantOperations::base::apply_expM_correction(Vsp,Ssp,T1,T2,order,TA);
+      copy_n_cast(Ssp.origin(),Ssp.num_elements(),DMN.origin());
+      axpy(TMN.num_elements(),T(1.0),DMN.origin(),1,TMN.origin(),1);
+      if(TA=='H' || TA=='h') 
+        ma::product(ma::H(P1),TMN,std::forward<Mat>(A));
+      else if(TA=='T' || TA=='t') 
+        ma::product(ma::T(P1),TMN,std::forward<Mat>(A));
+      else
+        ma::product(P1,TMN,std::forward<Mat>(A));
+    }
+
 // NOTE: Move to a single buffer for all TNXs, to be able to reuse buffers 
 //       more efficiently and to eventually share them with HamOps  
 
@@ -295,6 +341,9 @@ class SlaterDetOperations_base
 
     TVector TBuff;
 
+    // single precision buffer used in mixed precision propagation
+    SpTVector SpBuff;
+
     void set_buffer(size_t N) {
       if(TBuff.num_elements() < N) 
         TBuff = std::move(TVector(iextensions<1u>{N}));
@@ -302,6 +351,11 @@ class SlaterDetOperations_base
       fill_n(TBuff.origin(),N,T(0.0));
     }
 
+    void set_sp_buffer(size_t N) {
+      if(SpBuff.num_elements() < N) 
+        SpBuff = std::move(SpTVector(iextensions<1u>{N},SpAlloc(allocator_)));
+    }
+
 };
 
 }
@@ -51,6 +51,8 @@ class SlaterDetOperations_serial : public SlaterDetOperations_base<AllocType>
     using TMatrix = typename Base::TMatrix;
     using TMatrix_ref = typename Base::TMatrix_ref;
     using TTensor_ref = typename Base::TTensor_ref;
+    using SpT = typename Base::SpT;
+    using SpTTensor_ref = typename Base::SpTTensor_ref;
 
     using Base::MixedDensityMatrix;
     using Base::MixedDensityMatrixForWoodbury;
@@ -60,6 +62,7 @@ class SlaterDetOperations_serial : public SlaterDetOperations_base<AllocType>
     using Base::Overlap_noHerm;
     using Base::OverlapForWoodbury;
     using Base::Propagate;
+    using Base::PropagateMixedPrecision;
     using Base::Orthogonalize;
 
     SlaterDetOperations_serial(AllocType alloc_={}):
@@ -122,6 +125,14 @@ class SlaterDetOperations_serial : public SlaterDetOperations_base<AllocType>
       Base::Propagate(std::forward<Mat>(A),P1,V,order,TA);
     }
 
+    template<class Mat, class MatP1, class MatV>
+    void PropagateMixedPrecision(Mat&& A, const MatP1& P1, const MatV& V, communicator& comm, int order=6, char TA='N') {
+#ifdef ENABLE_CUDA
+      APP_ABORT(" Error: SlaterDetOperations_serial should not be here. \n");
+#endif
+      Base::PropagateMixedPrecision(std::forward<Mat>(A),P1,V,order,TA);
+    }
+
     template<class MatA, class MatP1, class MatV>
     void BatchedPropagate(std::vector<MatA> &Ai, const MatP1& P1, const MatV& V, int order=6, char TA='N') {
       static_assert( std::decay<MatA>::type::dimensionality == 2, " dimenionality == 2" );
@@ -161,6 +172,48 @@ class SlaterDetOperations_serial : public SlaterDetOperations_base<AllocType>
       }
     }
 
+    template<class MatA, class MatP1, class MatV>
+    void BatchedPropagateMixedPrecision(std::vector<MatA> &Ai, const MatP1& P1, const MatV& V, int order=6, char TA='N') {
+      static_assert( std::decay<MatA>::type::dimensionality == 2, " dimenionality == 2" );
+      static_assert( std::decay<MatV>::type::dimensionality == 3, " dimenionality == 3" );
+      if(Ai.size() == 0) return;
+      assert(Ai.size() == V.size(0));
+      int nbatch = Ai.size();
+      int NMO = Ai[0].size(0);
+      int NAEA = Ai[0].size(1);
+      set_buffer(nbatch*2*NMO*NAEA);
+      set_sp_buffer(V.num_elements() + nbatch*3*NMO*NAEA);
+      TTensor_ref TMN(TBuff.data(), {nbatch,NMO,NAEA});
+      TTensor_ref DMN(TMN.data()+TMN.num_elements(), {nbatch,NMO,NAEA});
+      SpTTensor_ref Vsp(SpBuff.data(), {V.size(0),V.size(1),V.size(2)});
+      SpTTensor_ref Ssp(Vsp.data()+Vsp.num_elements(), {nbatch,NMO,NAEA});
+      SpTTensor_ref T1(Ssp.data()+Ssp.num_elements(), {nbatch,NMO,NAEA});
+      SpTTensor_ref T2(T1.data()+T1.num_elements(), {nbatch,NMO,NAEA});
+      using ma::axpy;
+      copy_n_cast(V.origin(),V.num_elements(),Vsp.origin());
+      // could be batched when csrmm is batched  
+      for(int ib=0; ib<nbatch; ib++) {
+        if(TA=='H' || TA=='h') 
+          ma::product(ma::H(P1),Ai[ib],TMN[ib]);
+        else if(TA=='T' || TA=='t') 
+          ma::product(ma::T(P1),Ai[ib],TMN[ib]);
+        else
+          ma::product(P1,Ai[ib],TMN[ib]);
+      }
+      copy_n_cast(TMN.origin(),TMN.num_elements(),Ssp.origin());
+      SlaterDeterminantOperations::batched::apply_expM_correction(Vsp,Ssp,T1,T2,order,TA);
+      copy_n_cast(Ssp.origin(),Ssp.num_elements(),DMN.origin());
+      axpy(TMN.num_elements(),T(1.0),DMN.origin(),1,TMN.origin(),1);
+      for(int ib=0; ib<nbatch; ib++) {
+        if(TA=='H' || TA=='h') 
+          ma::product(ma::H(P1),TMN[ib],Ai[ib]);
+        else if(TA=='T' || TA=='t') 
+          ma::product(ma::T(P1),TMN[ib],Ai[ib]);
+        else
+          ma::product(P1,TMN[ib],Ai[ib]);
+      }
+    }
+
     // C[nwalk, M, N]
     template<class MatA, class MatB, class MatC, class TVec>
     void BatchedMixedDensityMatrix(const MatA& hermA, std::vector<MatB> &Bi, MatC&& C, T LogOverlapFactor, TVec&& ovlp, bool compact=false, bool herm=true) {
@@ -312,6 +365,8 @@ class SlaterDetOperations_serial : public SlaterDetOperations_base<AllocType>
     using Base::WORK;
     using Base::TBuff;
     using Base::set_buffer;
+    using Base::SpBuff;
+    using Base::set_sp_buffer;
 
 };
 
@@ -56,6 +56,7 @@ class SlaterDetOperations_shared : public SlaterDetOperations_base<std::allocato
     using Base::Overlap_noHerm;
     using Base::OverlapForWoodbury;
     using Base::Propagate;
+    using Base::PropagateMixedPrecision;
     using Base::Orthogonalize;
     using Base::IWORK;
     using Base::WORK;
@@ -169,6 +170,13 @@ class SlaterDetOperations_shared : public SlaterDetOperations_base<std::allocato
       comm.barrier();
     }
 
+    // the shared memory version is only used for the few walkers left after the serial distribution, 
+    // it is always done in full precision 
+    template<class Mat, class MatP1, class MatV>
+    void PropagateMixedPrecision(Mat&& A, const MatP1& P1, const MatV& V, communicator& comm, int order=6, char TA='N') {
+      Propagate(std::forward<Mat>(A),P1,V,comm,order,TA);
+    }
+
     // C[nwalk, M, N]
     template<class MatA, class MatB, class MatC, class TVec>
     void BatchedMixedDensityMatrix(const MatA& hermA, std::vector<MatB> &Bi, MatC&& C, T LogOverlapFactor, TVec&& ovlp, bool compact=false, bool herm=true) {
@@ -190,6 +198,11 @@ class SlaterDetOperations_shared : public SlaterDetOperations_base<std::allocato
       APP_ABORT(" Error: Batched routines not compatible with SlaterDetOperations_shared::BatchedPropagate \n");
     }
 
+    template<class MatA, class MatP1, class MatV>
+    void BatchedPropagateMixedPrecision(std::vector<MatA> &Ai, const MatP1& P1, const MatV& V, int order=6, char TA='N') {
+      APP_ABORT(" Error: Batched routines not compatible with SlaterDetOperations_shared::BatchedPropagateMixedPrecision \n");
+    }
+
     template<class MatA>
     void BatchedOrthogonalize(std::vector<MatA> &Ai, T LogOverlapFactor) {
       APP_ABORT(" Error: Batched routines not compatible with SlaterDetOperations_shared::BatchedOrthogonalize \n");
@@ -78,6 +78,55 @@ inline void apply_expM( const MatA& V, MatB& S, MatC& T1, MatC& T2, int order=6,
 
 }
 
+/*
+ * Calculate S = (exp(im*V)-1)*S using a Taylor expansion of exp(V)
+ * Used in mixed precision propagation, where only the correction to S is calculated 
+ * in reduced precision and then added to the full precision matrix by the caller.
+ */ 
+template< class MatA,
+          class MatB,
+          class MatC
+        >
+inline void apply_expM_correction( const MatA& V, MatB& S, MatC& T1, MatC& T2, int order=6, char TA='N')
+{ 
+  assert( V.size(0) == V.size(1) );
+  assert( V.size(1) == S.size(0) );
+  assert( S.size(0) == T1.size(0) );
+  assert( S.size(1) == T1.size(1) );
+  assert( S.size(0) == T2.size(0) );
+  assert( S.size(1) == T2.size(1) );
+
+  using ma::H;
+  using ma::T;
+  using ComplexType = typename std::decay<MatB>::type::element; 
+  ComplexType zero(0.);
+  auto pT1(std::addressof(T1));
+  auto pT2(std::addressof(T2));
+
+  ComplexType im(0.0,1.0);
+  if(TA=='H' || TA=='h')
+    im=ComplexType (0.0,-1.0);
+
+  // getting around issue in multi, fix later  
+  T1.sliced(0,T1.size(0)) = S;
+  for(int n=1; n<=order; n++) {
+    ComplexType fact = im*static_cast<ComplexType>(1.0/static_cast<double>(n));
+    if(TA=='H' || TA=='h')
+      ma::product(fact,ma::H(V),*pT1,zero,*pT2);
+    else if(TA=='T' || TA=='t')
+      ma::product(fact,ma::T(V),*pT1,zero,*pT2);
+    else
+      ma::product(fact,V,*pT1,zero,*pT2);
+    // the first term replaces S, since the identity is not included 
+    if(n==1)
+      S.sliced(0,S.size(0)) = *pT2;
+    else
+      ma::add(ComplexType(1.0),*pT2,ComplexType(1.0),S,S);
+    std::swap(pT1,pT2);
+  }
+
+}
+
 }
 
 namespace shm 
@@ -202,6 +251,69 @@ inline void apply_expM( const MatA& V, MatB& S, MatC& T1, MatC& T2, int order=6,
 
 }
 
+/*
+ * Calculate S = (exp(im*V)-1)*S using a Taylor expansion of exp(V)
+ * Batched version of base::apply_expM_correction.
+ */
+template< class MatA,
+          class MatB,
+          class MatC
+        >
+inline void apply_expM_correction( const MatA& V, MatB& S, MatC& T1, MatC& T2, int order=6, char TA='N')
+{
+  static_assert( std::decay<MatA>::type::dimensionality == 3, " batched::apply_expM_correction::dimenionality == 3" );
+  static_assert( std::decay<MatB>::type::dimensionality == 3, " batched::apply_expM_correction::dimenionality == 3" );
+  static_assert( std::decay<MatC>::type::dimensionality == 3, " batched::apply_expM_correction::dimenionality == 3" );
+  assert( V.size(0) == S.size(0) );
+  assert( V.size(0) == T1.size(0) );
+  assert( V.size(0) == T2.size(0) );
+  assert( V.size(1) == V.size(2) );
+  assert( V.size(2) == S.size(1) );
+  assert( S.size(1) == T1.size(1) );
+  assert( S.size(2) == T1.size(2) );
+  assert( S.size(1) == T2.size(1) );
+  assert( S.size(2) == T2.size(2) );
+  // for now limit to continuous
+  assert( S.stride(0) == S.size(1)*S.size(2));
+  assert( T1.stride(0) == T1.size(1)*T1.size(2));
+  assert( T2.stride(0) == T2.size(1)*T2.size(2));
+  assert( S.stride(1) == S.size(2));
+  assert( T1.stride(1) == T1.size(2));
+  assert( T2.stride(1) == T2.size(2));
+  assert( S.stride(2) == 1 );
+  assert( T1.stride(2) == 1 );
+  assert( T2.stride(2) == 1 );
+
+  using ComplexType = typename std::decay<MatB>::type::element;
+  ComplexType zero(0.);
+  ComplexType im(0.0,1.0);
+  if(TA=='H' || TA=='h')
+    im=ComplexType (0.0,-1.0);
+  auto pT1(std::addressof(T1));
+  auto pT2(std::addressof(T2));
+
+  using std::copy_n;
+  copy_n(S.origin(),S.num_elements(),T1.origin());
+  for(int n=1; n<=order; n++) {
+    ComplexType fact = im*static_cast<ComplexType>(1.0/static_cast<double>(n));
+    if(TA=='H' || TA=='h')
+      ma::productStridedBatched(fact,ma::H(V),*pT1,zero,*pT2);
+    else if(TA=='T' || TA=='t')
+      ma::productStridedBatched(fact,ma::T(V),*pT1,zero,*pT2);
+    else
+      ma::productStridedBatched(fact,V,*pT1,zero,*pT2);
+    // the first term replaces S, since the identity is not included 
+    if(n==1) { 
+      copy_n((*pT2).origin(),S.num_elements(),S.origin());
+    } else {
+      using ma::axpy;
+      axpy(S.num_elements(), ComplexType(1.0), (*pT2).origin(), 1, S.origin(), 1);
+    }
+    std::swap(pT1,pT2);
+  }
+
+}
+
 } // namespace batched
 
 } // 
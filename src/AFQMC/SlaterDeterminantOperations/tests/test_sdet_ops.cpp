@@ -916,6 +916,51 @@ TEST_CASE("SDetOps_complex_serial", "[sdet_ops]")
 
 }
 
+TEST_CASE("SDetOps_mixed_precision_propagate", "[sdet_ops]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+  auto world = boost::mpi3::environment::get_world_instance();
+  auto node = world.split_shared(world.rank());
+
+  const int NMO = 4;
+  const int NEL = 3;
+
+  using Type = std::complex<double>;
+  using array = boost::multi::array<Type,2>;
+  using csr_matrix = ma::sparse::csr_matrix<Type,int,int,
+                                shared_allocator<Type>,
+                                ma::sparse::is_root>;
+
+  array A({NMO,NEL});
+  array P1({NMO,NMO});
+  array V({NMO,NMO});
+  for(int i=0; i<NMO; i++) {
+    for(int j=0; j<NEL; j++)
+      A[i][j] = Type(0.3*(i+1)-0.2*j, 0.1*(i*j)-0.05);
+    for(int j=0; j<NMO; j++) {
+      P1[i][j] = (i==j)?Type(0.95):Type(0.02*(i+j),0.01*(i-j));
+      V[i][j] = Type(0.05*(i+j)-0.1, 0.03*(i-j));
+    }
+  }
+  csr_matrix P1csr(csr::shm::construct_csr_matrix_single_input<csr_matrix>(P1,0.0,'N',node));
+
+  SlaterDetOperations_shared<ComplexType> SDet(NMO,NEL);
+
+  for(char TA : {'N','H'}) {
+    array Aref(A);
+    array Amp(A);
+    SDet.Propagate(Aref,P1csr,V,6,TA);
+    SDet.PropagateMixedPrecision(Amp,P1csr,V,6,TA);
+    // only the correction (exp(V)-1)*P1*A is calculated in single precision 
+    for(int i=0; i<NMO; i++)
+      for(int j=0; j<NEL; j++) {
+        REQUIRE(std::abs(Amp[i][j]-A[i][j]) > 1e-3);
+        REQUIRE(Amp[i][j].real() == Approx(Aref[i][j].real()).epsilon(1e-6));
+        REQUIRE(Amp[i][j].imag() == Approx(Aref[i][j].imag()).epsilon(1e-6));
+      }
+  }
+}
+
 /*
 TEST_CASE("SDetOps_complex_mpi3", "[sdet_ops]")
 {
@@ -13,7 +13,7 @@ namespace afqmc {
 }
 }
 
-enum LOAD_BALANCE_ALGORITHM { UNDEFINED_LOAD_BALANCE, SIMPLE, ASYNC };
+enum LOAD_BALANCE_ALGORITHM { UNDEFINED_LOAD_BALANCE, SIMPLE, ASYNC, OVERLAP };
 enum BRANCHING_ALGORITHM { UNDEFINED_BRANCHING, PAIR, COMB, MIN_BRANCH, SERIAL_COMB };
 
 #endif
@@ -14,6 +14,7 @@
 
 
 #include<tuple>
+#include<array>
 #include<cassert>
 #include <memory>
 #include <stack>
@@ -204,6 +205,125 @@ inline int swapWalkersAsync(WlkBucket& wset, Mat&& Wexcess, IVec& CurrNumPerNode
   return nswap;
 }
 
+/** exchange plan of the load balancing step
+ *
+ * Pairs nodes with walkers beyond their new population (sources) with nodes below it (targets)
+ * in rank order, the same pairing used by swapWalkersSimple and swapWalkersAsync.
+ * Returns the list of {source, target, number of walkers} transfers, at most one per pair of nodes.
+ * The cost is O(number of nodes), independent of the number of walkers exchanged.
+ */
+template<class IVec = std::vector<int>
+         >
+inline std::vector<std::array<int,3>> getWalkerExchangePlan(IVec& CurrNumPerNode, IVec& NewNumPerNode, int NumContexts)
+{
+  std::vector<std::array<int,3>> plan;
+  int src=0, tgt=0;
+  int excess=0, deficit=0;
+  while(true)
+  {
+    while(excess==0 && src<NumContexts)
+    {
+      excess = CurrNumPerNode[src]-NewNumPerNode[src];
+      if(excess<=0)
+      {
+        excess=0;
+        ++src;
+      }
+    }
+    while(deficit==0 && tgt<NumContexts)
+    {
+      deficit = NewNumPerNode[tgt]-CurrNumPerNode[tgt];
+      if(deficit<=0)
+      {
+        deficit=0;
+        ++tgt;
+      }
+    }
+    if(src==NumContexts || tgt==NumContexts)
+      break;
+    int n = std::min(excess,deficit);
+    plan.push_back({src,tgt,n});
+    excess -= n;
+    deficit -= n;
+    if(excess==0)
+      ++src;
+    if(deficit==0)
+      ++tgt;
+  }
+  return plan;
+}
+
+/** swap Walkers with a precomputed exchange plan and packed buffers
+ *
+ * Outgoing walkers are sent directly from the contiguous rows of Wexcess, with one Isend per target node.
+ * Incoming walkers are received into a single contiguous buffer and added to the set with one push_walkers call.
+ * All sends and receives of the plan are posted before waiting on any of them, so the transfers between
+ * different pairs of nodes overlap. All requests are completed before returning.
+ */
+template<class WlkBucket,
+         class Mat,
+         class IVec = std::vector<int>
+         >
+inline int swapWalkersOverlap(WlkBucket& wset, Mat&& Wexcess, IVec& CurrNumPerNode, IVec& NewNumPerNode, communicator& comm,
+                              std::vector<ComplexType>& recv_buffer)
+{
+  int wlk_size = wset.single_walker_size()+wset.single_walker_bp_size();
+  int NumContexts, MyContext;
+  NumContexts = comm.size();
+  MyContext = comm.rank();
+  static_assert(std::decay<Mat>::type::dimensionality==2, "Wrong dimensionality");
+  if(wlk_size != Wexcess.size(1))
+    throw std::runtime_error("Array dimension error in swapWalkersOverlap().");
+  if(1 != Wexcess.stride(1) ||
+     (Wexcess.size(0) > 0 && Wexcess.size(1) != Wexcess.stride(0)))
+    throw std::runtime_error("Array shape error in swapWalkersOverlap().");
+  if(CurrNumPerNode.size() < NumContexts || NewNumPerNode.size() < NumContexts)
+    throw std::runtime_error("Array dimension error in swapWalkersOverlap().");
+  if(wset.capacity() < NewNumPerNode[MyContext])
+    throw std::runtime_error("Insufficient capacity in swapWalkersOverlap().");
+  int deltaN = CurrNumPerNode[MyContext]-NewNumPerNode[MyContext];
+  if(deltaN <=0 && wset.size() != CurrNumPerNode[MyContext])
+    throw std::runtime_error("error(1) in swapWalkersOverlap().");
+  if(deltaN > 0 &&
+    (wset.size() != NewNumPerNode[MyContext] || int(Wexcess.size(0)) != deltaN))
+    throw std::runtime_error("error(2) in swapWalkersOverlap().");
+
+  std::vector<std::array<int,3>> plan(getWalkerExchangePlan(CurrNumPerNode,NewNumPerNode,NumContexts));
+  int nrecv=0;
+  for(auto& t: plan)
+    if(t[1]==MyContext)
+      nrecv += t[2];
+  recv_buffer.resize(nrecv*wlk_size);
+
+  std::vector<boost::mpi3::request> send_requests;
+  std::vector<boost::mpi3::request> recv_requests;
+  int nswap=0;
+  int nsend=0;
+  int irecv=0;
+  for(auto& t: plan)
+  {
+    nswap += t[2];
+    if(t[0]==MyContext)
+    {
+      send_requests.emplace_back( comm.isend(Wexcess[nsend].origin(),Wexcess[nsend].origin()+t[2]*wlk_size,t[1],t[0]+2999) );
+      nsend += t[2];
+    }
+    if(t[1]==MyContext)
+    {
+      recv_requests.emplace_back( comm.ireceive_n(recv_buffer.data()+irecv*wlk_size,t[2]*wlk_size,t[0],t[0]+2999) );
+      irecv += t[2];
+    }
+  }
+  if(nrecv > 0)
+  {
+    for(auto& r: recv_requests)
+      r.wait();
+    wset.push_walkers(boost::multi::array_ref<ComplexType,2>(recv_buffer.data(),{nrecv,wlk_size}));
+  }
+  for(auto& r: send_requests)
+    r.wait();
+  return nswap;
+}
 
 /**
  * Implements Cafarrel's minimum branching algorithm.
@@ -23,6 +23,7 @@
 #include "AFQMC/config.h"
 #include "Utilities/NewTimer.h"
 #include "AFQMC/Utilities/taskgroup.h"
+#include "AFQMC/Utilities/type_conversion.hpp"
 #include "AFQMC/Numerics/ma_blas.hpp"
 
 #include "AFQMC/Walkers/Walkers.hpp"
@@ -57,6 +58,7 @@ class WalkerSetBase: public AFQMCInfo
   using bp_pointer = ComplexType*; //BPPtr;
   using const_bp_element = const bp_element;
   using const_bp_pointer = const bp_pointer; 
+  using bp_sp_element = typename to_single_precision<bp_element>::value_type;
   using BPAllocator = shared_allocator<bp_element>;//BPAlloc;
 
   using CMatrix = boost::multi::array<element,2,Allocator>;
@@ -274,7 +276,11 @@ class WalkerSetBase: public AFQMCInfo
     }
   }
 
-  void resize_bp(int nbp, int nCV, int nref) {
+  /*
+   * Allocates space for back propagation. 
+   * If sp_fields==true, the history of auxiliary fields is stored in single precision.
+   */
+  void resize_bp(int nbp, int nCV, int nref, bool sp_fields=false) {
     assert(walker_buffer.size(1) == walker_size);
     assert(bp_buffer.size(0) == bp_walker_size);
     assert(walker_buffer.size(0) == bp_buffer.size(1));
@@ -295,8 +301,11 @@ class WalkerSetBase: public AFQMCInfo
         APP_ABORT("");
       }
     }
+    // in single precision, 2 consecutive fields of a walker share one element of bp_buffer
+    single_precision_fields = sp_fields;
+    fields_rows_per_step = (single_precision_fields?(nCV+1)/2:nCV);
     int cnt=0;
-    data_displ[FIELDS] = cnt;          cnt+=nbp*nCV;
+    data_displ[FIELDS] = cnt;          cnt+=nbp*fields_rows_per_step;
     data_displ[WEIGHT_FAC] = cnt;      cnt+=nbp;
     data_displ[WEIGHT_HISTORY] = cnt;  cnt+=nbp;
     bp_walker_size = cnt;  
@@ -610,33 +619,61 @@ class WalkerSetBase: public AFQMCInfo
     TG.TG_local().barrier();
   }
 
-  // Careful!!! This matrix returns an array_ref, NOT a copy!!!
-  stdCMatrix_ref getFields(int ip)
-  {
-    if(ip < 0 || ip > wlk_desc[3])
-      APP_ABORT(" Error: index out of bounds in getFields. \n");
-    int skip = (data_displ[FIELDS] + ip*wlk_desc[4])*bp_buffer.size(1); 
-    return stdCMatrix_ref(to_address(bp_buffer.origin())+skip,{wlk_desc[4],bp_buffer.size(1)});
-  } 
-
-  stdCTensor_ref getFields()
+  /*
+   * Stores the fields of step ip: F[cv][iw] = scl * V[cv-cv0][iw], for cv in [cv0,cvN).  
+   * V can be in device memory.
+   */
+  template<class Mat>  
+  void storeFields(int ip, int cv0, int cvN, Mat&& V, ComplexType scl=ComplexType(1.0))
   {
-    return stdCTensor_ref(to_address(bp_buffer.origin())+data_displ[FIELDS]*bp_buffer.size(1),
-                            {wlk_desc[3],wlk_desc[4],bp_buffer.size(1)});
+    static_assert(std::decay<Mat>::type::dimensionality == 2, "Wrong dimensionality");
+    if(ip < 0 || ip >= wlk_desc[3])
+      APP_ABORT(" Error: index out of bounds in storeFields. \n");
+    assert(V.size(0) == cvN-cv0);
+    assert(V.size(1) <= bp_buffer.size(1));
+    using std::copy_n;
+    int nw = V.size(1);
+    int ldf = bp_buffer.size(1);
+    std::vector<bp_element> row(nw);
+    for(int cv=cv0; cv<cvN; ++cv) {
+      copy_n(V[cv-cv0].origin(),nw,row.data());
+      if(single_precision_fields) {
+        bp_sp_element* F = fields_row_sp(ip,cv);
+        for(int iw=0; iw<nw; ++iw) 
+          F[2*iw] = static_cast<bp_sp_element>(scl*row[iw]);
+      } else {
+        bp_pointer F = to_address(bp_buffer.origin()) + (data_displ[FIELDS]+ip*fields_rows_per_step+cv)*ldf;
+        for(int iw=0; iw<nw; ++iw) 
+          F[iw] = scl*row[iw];
+      }
+    }
   }
 
-  template<class Mat>  
-  void storeFields(int ip, Mat&& V)
+  /*
+   * Copies the elements [i0,iN) of the fields of step ip, in the flattened [nCV][capacity()] layout,
+   * into the n=iN-i0 consecutive positions starting at X. X can be in device memory.
+   */
+  template<class XPtr>  
+  void loadFields(int ip, size_t i0, size_t iN, XPtr X)
   {
-    static_assert(std::decay<Mat>::type::dimensionality == 2, "Wrong dimensionality");
-    auto&& F(getFields(ip));
-    if(V.stride(0) == V.size(1)) {
-      using std::copy_n;
-      copy_n(V.origin(),F.num_elements(),F.origin());
-    } else 
-      F = V;
+    if(ip < 0 || ip >= wlk_desc[3])
+      APP_ABORT(" Error: index out of bounds in loadFields. \n");
+    using std::copy_n;
+    size_t ldf = bp_buffer.size(1);
+    assert(iN <= wlk_desc[4]*ldf); 
+    if(not single_precision_fields) {
+      copy_n(to_address(bp_buffer.origin())+(data_displ[FIELDS]+ip*fields_rows_per_step)*ldf+i0,
+             iN-i0,X);
+      return;
+    }
+    std::vector<bp_element> buff(iN-i0);
+    for(size_t i=i0; i<iN; ++i) 
+      buff[i-i0] = static_cast<bp_element>(fields_row_sp(ip,int(i/ldf))[2*(i%ldf)]);
+    copy_n(buff.data(),buff.size(),X);
   }
 
+  bool single_precision_fields_history() const { return single_precision_fields; }
+
   stdCMatrix_ref getWeightFactors()
   {
     return stdCMatrix_ref(to_address(bp_buffer.origin())+data_displ[WEIGHT_FAC]*bp_buffer.size(1),
@@ -673,6 +710,17 @@ class WalkerSetBase: public AFQMCInfo
   int walker_size, walker_memory_usage;
   int bp_walker_size, bp_walker_memory_usage;
   int bp_pos;
+  // number of rows of bp_buffer used by the fields of a single step
+  int fields_rows_per_step = 0;
+  bool single_precision_fields = false;
+
+  // first single precision element of fields(ip,cv,:), consecutive walkers are 2 elements apart  
+  bp_sp_element* fields_row_sp(int ip, int cv)
+  {
+    bp_pointer F = to_address(bp_buffer.origin()) + 
+                   (data_displ[FIELDS]+ip*fields_rows_per_step+cv/2)*bp_buffer.size(1);
+    return reinterpret_cast<bp_sp_element*>(F) + cv%2; 
+  }
 
   // wlk_descriptor: {nmo, naea, naeb, nback_prop, nCV, nRefs} 
   wlk_descriptor wlk_desc; 
@@ -729,6 +777,12 @@ class WalkerSetBase: public AFQMCInfo
         afqmc::swapWalkersAsync(*this,std::forward<Mat>(M),
             nwalk_counts_old,nwalk_counts_new,TG.TG_heads());
 
+    } else if(load_balance == OVERLAP) {
+
+      if(TG.TG_local().root())
+        afqmc::swapWalkersOverlap(*this,std::forward<Mat>(M),
+            nwalk_counts_old,nwalk_counts_new,TG.TG_heads(),recv_buffer);
+
     }
     TG.local_barrier();
     // since tot_num_walkers is local, you need to sync it
@@ -741,6 +795,9 @@ class WalkerSetBase: public AFQMCInfo
 
   std::vector<int> nwalk_counts_new, nwalk_counts_old;
 
+  // contiguous receive buffer for load balancing
+  std::vector<ComplexType> recv_buffer;
+
 };
 
 }
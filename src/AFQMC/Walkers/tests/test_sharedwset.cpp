@@ -469,6 +469,162 @@ const char *xml_block =
 
 }
 
+// Exchanges walkers with swapWalkersOverlap after an unbalanced branching step:
+// TG 0 holds the excess walkers of all other TGs, which are below the target by nmiss walkers each.
+// Run with more than one TG to exchange walkers between them.
+void test_walker_exchange_overlap()
+{
+  OHMMS::Controller->initialize(0, NULL);
+  auto world = boost::mpi3::environment::get_world_instance();
+
+  using Type = std::complex<double>;
+
+  int NMO=8,NAEA=2,NAEB=2, nwalkers=4, nmiss=2;
+
+  GlobalTaskGroup gTG(world);
+  TaskGroup_ TG(gTG,std::string("TaskGroup"),1,1);
+  AFQMCInfo info;
+  info.NMO = NMO;
+  info.NAEA = NAEA;
+  info.NAEB = NAEB;
+  info.name = "walker";
+  boost::multi::array<Type,2> initA({NMO,NAEA});
+  boost::multi::array<Type,2> initB({NMO,NAEB});
+  for(int i=0; i<NAEA; i++) initA[i][i] = Type(0.22);
+  for(int i=0; i<NAEB; i++) initB[i][i] = Type(0.22);
+  RandomGenerator_t rng;
+
+const char *xml_block =
+"<WalkerSet name=\"wset0\">  \
+  <parameter name=\"walker_type\">closed</parameter>  \
+  <parameter name=\"load_balance\">overlap</parameter>  \
+</WalkerSet> \
+";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(xml_block);
+  REQUIRE(okay);
+
+  auto& heads = TG.TG_heads();
+  int ntg = heads.size();
+  int rank = heads.rank();
+  int nexcess = nmiss*(ntg-1);
+
+  WalkerSet wset(TG,doc.getRoot(),info,&rng);
+  wset.resize(nwalkers+nexcess,initA,initB);
+  int wlk_size = wset.single_walker_size()+wset.single_walker_bp_size();
+  // the weight identifies the TG and position of the walker
+  for(int i=0; i<wset.size(); i++)
+    *wset[i].weight() = 100.0*rank+i;
+
+  // walkers beyond the target go in Wexcess, the last walker of the set first
+  boost::multi::array<Type,2> Wexcess({0,wlk_size});
+  if(rank==0) {
+    Wexcess.reextent({nexcess,wlk_size});
+    wset.pop_walkers(Wexcess);
+  } else {
+    boost::multi::array<Type,2> Wlost({nexcess+nmiss,wlk_size});
+    wset.pop_walkers(Wlost);
+  }
+  std::vector<int> curr(ntg,nwalkers-nmiss), next(ntg,nwalkers);
+  curr[0] = nwalkers+nexcess;
+  REQUIRE( wset.size() == curr[rank] );
+
+  std::vector<Type> recv_buffer;
+  int nswap = swapWalkersOverlap(wset,Wexcess,curr,next,heads,recv_buffer);
+  REQUIRE( nswap == nexcess );
+  REQUIRE( wset.size() == nwalkers );
+  // the sends are complete, Wexcess can be released
+  Wexcess.reextent({0,wlk_size});
+  heads.barrier();
+
+  if(rank==0) {
+    REQUIRE( recv_buffer.size() == 0 );
+    for(int i=0; i<nwalkers; i++)
+      REQUIRE( *wset[i].weight() == Type(i) );
+  } else {
+    REQUIRE( recv_buffer.size() == nmiss*wlk_size );
+    for(int i=0; i<nwalkers-nmiss; i++)
+      REQUIRE( *wset[i].weight() == Type(100.0*rank+i) );
+    // rows nmiss*(rank-1),... of Wexcess in TG 0
+    for(int i=0; i<nmiss; i++)
+      REQUIRE( *wset[nwalkers-nmiss+i].weight() == Type(nwalkers+nexcess-1-nmiss*(rank-1)-i) );
+  }
+}
+
+void test_walker_fields()
+{
+  OHMMS::Controller->initialize(0, NULL);
+  auto world = boost::mpi3::environment::get_world_instance();
+
+  using Type = std::complex<double>;
+
+  int NMO=8,NAEA=2,NAEB=2, nwalkers=10, nCV=5, nbp=3;
+
+  GlobalTaskGroup gTG(world);
+  TaskGroup_ TG(gTG,std::string("TaskGroup"),1,1);
+  AFQMCInfo info;
+  info.NMO = NMO;
+  info.NAEA = NAEA;
+  info.NAEB = NAEB;
+  info.name = "walker";
+  boost::multi::array<Type,2> initA({NMO,NAEA});
+  boost::multi::array<Type,2> initB({NMO,NAEB});
+  for(int i=0; i<NAEA; i++) initA[i][i] = Type(0.22);
+  for(int i=0; i<NAEB; i++) initB[i][i] = Type(0.22);
+  RandomGenerator_t rng;
+
+const char *xml_block =
+"<WalkerSet name=\"wset0\">  \
+  <parameter name=\"walker_type\">closed</parameter>  \
+</WalkerSet> \
+";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(xml_block);
+  REQUIRE(okay);
+
+  boost::multi::array<Type,2> V({nCV,nwalkers});
+  for(int i=0; i<nCV; i++)
+    for(int j=0; j<nwalkers; j++)
+      V[i][j] = Type(0.1*i-0.3+0.01*j, 0.2*j-1.0/(i+1.0));
+
+  for(bool sp : {false, true}) {
+    WalkerSet wset(TG,doc.getRoot(),info,&rng);
+    wset.resize(nwalkers,initA,initB);
+    wset.resize_bp(nbp,nCV,1,sp);
+    REQUIRE(wset.NumBackProp() == nbp);
+    REQUIRE(wset.single_precision_fields_history() == sp);
+
+    int ldf = wset.capacity();
+    for(int ip=0; ip<nbp; ip++)
+      wset.storeFields(ip,0,nCV,V,Type(ip+1.0));
+    // partial update of the second step
+    wset.storeFields(1,1,3,V.sliced(1,3),Type(-1.0));
+
+    std::vector<Type> F(nCV*ldf);
+    for(int ip=0; ip<nbp; ip++) {
+      wset.loadFields(ip,0,F.size(),F.data());
+      for(int i=0; i<nCV; i++)
+        for(int j=0; j<nwalkers; j++) {
+          Type scl = (ip==1 && i>=1 && i<3)?Type(-1.0):Type(ip+1.0);
+          Type ref = scl*V[i][j];
+          REQUIRE(F[i*ldf+j].real() == Approx(ref.real()).epsilon(1e-6));
+          REQUIRE(F[i*ldf+j].imag() == Approx(ref.imag()).epsilon(1e-6));
+        }
+    }
+    // sub-ranges of the flattened fields
+    std::vector<Type> Fr(ldf+3);
+    wset.loadFields(2,2*ldf-1,3*ldf+2,Fr.data());
+    for(int k=0; k<Fr.size(); k++) {
+      int i = (2*ldf-1+k)/ldf;
+      int j = (2*ldf-1+k)%ldf;
+      if(j >= nwalkers) continue; 
+      Type ref = Type(3.0)*V[i][j];
+      REQUIRE(Fr[k].real() == Approx(ref.real()).epsilon(1e-6));
+      REQUIRE(Fr[k].imag() == Approx(ref.imag()).epsilon(1e-6));
+    }
+  }
+}
+
 TEST_CASE("swset_test_serial", "[shared_wset]")
 {
   test_basic_walker_features(true);
@@ -486,4 +642,37 @@ TEST_CASE("walker_io", "[shared_wset]")
   test_walker_io();
 }
 
+TEST_CASE("walker_fields", "[shared_wset]")
+{
+  test_walker_fields();
+}
+
+TEST_CASE("walker_exchange_plan", "[shared_wset]")
+{
+  std::vector<int> curr{5,3,4,0};
+  std::vector<int> next{3,3,3,3};
+  auto plan = getWalkerExchangePlan(curr,next,4);
+  REQUIRE(plan.size() == 2);
+  REQUIRE(plan[0] == (std::array<int,3>{0,3,2}));
+  REQUIRE(plan[1] == (std::array<int,3>{2,3,1}));
+
+  std::vector<int> curr2{0,7,1,0,4};
+  std::vector<int> next2{3,2,2,3,2};
+  plan = getWalkerExchangePlan(curr2,next2,5);
+  REQUIRE(plan.size() == 4);
+  REQUIRE(plan[0] == (std::array<int,3>{1,0,3}));
+  REQUIRE(plan[1] == (std::array<int,3>{1,2,1}));
+  REQUIRE(plan[2] == (std::array<int,3>{1,3,1}));
+  REQUIRE(plan[3] == (std::array<int,3>{4,3,2}));
+
+  // balanced populations require no exchange
+  plan = getWalkerExchangePlan(next,next,4);
+  REQUIRE(plan.size() == 0);
+}
+
+TEST_CASE("walker_exchange_overlap", "[shared_wset][walker_exchange]")
+{
+  test_walker_exchange_overlap();
+}
+
 }
@@ -0,0 +1,136 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Benchmarks/SyntheticSystem.h"
+#include "ParticleIO/ParticleIOUtility.h"
+#include "Numerics/OneDimGridBase.h"
+#include "Numerics/OneDimCubicSpline.h"
+#include "Numerics/Quadrature.h"
+
+namespace qmcplusplus
+{
+using RealType = QMCTraits::RealType;
+
+void createGraphite(ParticleSet& ions, const Tensor<int, 3>& tmat)
+{
+  Tensor<RealType, 3> graphite = {4.65099, 0.0, 0.0, -2.3255, 4.02788, 0.0, 0.0, 0.0, 12.67609393};
+  ions.setName("ion");
+  ions.Lattice.BoxBConds = 1;
+  ions.Lattice.set(graphite);
+  ions.create(4);
+  ions.R.InUnit = PosUnit::Cartesian;
+  ions.R[0]     = {0.0, 0.0, 0.0};
+  ions.R[1]     = {0.0, 2.68525, 0.0};
+  ions.R[2]     = {0.0, 0.0, 6.33805};
+  ions.R[3]     = {2.3255, 1.34263, 6.33805};
+
+  SpeciesSet& species(ions.getSpeciesSet());
+  const int icharge    = species.addAttribute("charge");
+  const int iC         = species.addSpecies("C");
+  species(icharge, iC) = 4;
+
+  Tensor<int, 3> tiling(tmat);
+  expandSuperCell(ions, tiling);
+  ions.resetGroups();
+}
+
+void createElectrons(ParticleSet& els, const ParticleSet& ions, RandomGenerator_t& rng)
+{
+  const int nels = 4 * ions.getTotalNum();
+  els.setName("e");
+  els.Lattice = ions.Lattice;
+  std::vector<int> ud{nels / 2, nels - nels / 2};
+  els.create(ud);
+
+  SpeciesSet& species(els.getSpeciesSet());
+  const int iu         = species.addSpecies("u");
+  const int id         = species.addSpecies("d");
+  const int icharge    = species.addAttribute("charge");
+  species(icharge, iu) = -1;
+  species(icharge, id) = -1;
+  els.resetGroups();
+
+  els.R.InUnit = PosUnit::Lattice;
+  for (int iat = 0; iat < nels; iat++)
+    for (int idim = 0; idim < 3; idim++)
+      els.R[iat][idim] = rng();
+  els.convert2Cart(els.R);
+  els.createSK();
+}
+
+J2Type* createJ2(ParticleSet& els, RealType rcut)
+{
+  using Func = BsplineFunctor<RealType>;
+  J2Type* J2 = new J2Type(els, 0);
+
+  const int npts = 10;
+  std::string optimize("no");
+  const RealType dr = rcut / static_cast<RealType>(npts);
+  std::vector<RealType> X(npts + 1);
+  for (int i = 0; i <= npts; ++i)
+    X[i] = static_cast<RealType>(i) * dr;
+
+  { // uu and dd
+    std::vector<RealType> Y = {0.4711, 0.3478, 0.2445, 0.1677, 0.1118, 0.0733, 0.0462, 0.0273, 0.0145, 0.0063, 0.0};
+    std::string suu("uu");
+    Func* f = new Func;
+    f->initialize(npts, X, Y, -0.25, rcut, suu, optimize);
+    J2->addFunc(0, 0, f);
+  }
+  { // ud and du
+    std::vector<RealType> Y = {0.6715, 0.4433, 0.2901, 0.1889, 0.1227, 0.0793, 0.0496, 0.0292, 0.0152, 0.0061, 0.0};
+    std::string sud("ud");
+    Func* f = new Func;
+    f->initialize(npts, X, Y, -0.5, rcut, sud, optimize);
+    J2->addFunc(0, 1, f);
+  }
+  return J2;
+}
+
+NonLocalECPComponent* createNonLocalPP(int lmax, int rule)
+{
+  // amplitude and exponent of the s channel of C BFD, the higher channels are weaker
+  const RealType amp0 = 22.55164191;
+  const RealType zeta = 5.02991637;
+  const RealType eps  = 1e-4;
+  const RealType rmax = std::sqrt(std::log(amp0 / eps) / zeta);
+  const int ng        = static_cast<int>(rmax / 0.001) + 1;
+
+  LinearGrid<RealType>* agrid = new LinearGrid<RealType>;
+  agrid->set(0.0, rmax, ng);
+
+  NonLocalECPComponent* nlpp = new NonLocalECPComponent;
+  std::vector<RealType> v(ng);
+  for (int l = 0; l <= lmax; l++)
+  {
+    const RealType amp = amp0 / static_cast<RealType>(l + 1);
+    for (int ig = 0; ig < ng; ig++)
+    {
+      const RealType r = (*agrid)[ig];
+      v[ig]            = amp * std::exp(-zeta * r * r);
+    }
+    v[ng - 1] = 0.0;
+    OneDimCubicSpline<RealType>* vl = new OneDimCubicSpline<RealType>(agrid, v);
+    vl->spline();
+    nlpp->add(l, vl);
+  }
+  nlpp->setLmax(lmax);
+  nlpp->setRmax(rmax);
+
+  Quadrature3D<RealType> myRule(rule);
+  for (int ik = 0; ik < myRule.nk; ik++)
+    nlpp->addknot(myRule.xyz_m[ik], myRule.weight_m[ik]);
+  nlpp->resize_warrays(myRule.nk, lmax + 1, lmax);
+  return nlpp;
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/** @file SyntheticSystem.h
+ * @brief synthetic systems of arbitrary size for the benchmarks
+ *
+ * The ions are the 4-atom graphite cell of the miniapps expanded by a tiling
+ * matrix, with four valence electrons per carbon. The Jastrow is the Bspline J2
+ * of the miniapps and the pseudopotential has gaussian semilocal channels.
+ * The orbitals come from SyntheticSplineSetBuilder. Nothing is read from a file.
+ */
+#ifndef QMCPLUSPLUS_BENCHMARKS_SYNTHETIC_SYSTEM_H
+#define QMCPLUSPLUS_BENCHMARKS_SYNTHETIC_SYSTEM_H
+
+#include "Configuration.h"
+#include "Particle/ParticleSet.h"
+#include "Utilities/RandomGenerator.h"
+#include "QMCWaveFunctions/SPOSet.h"
+#include "QMCWaveFunctions/BsplineFactory/SyntheticSplineSetBuilder.h"
+#include "QMCWaveFunctions/Jastrow/J2OrbitalSoA.h"
+#include "QMCWaveFunctions/Jastrow/BsplineFunctor.h"
+#include "QMCHamiltonians/NonLocalECPComponent.h"
+
+namespace qmcplusplus
+{
+using J2Type = J2OrbitalSoA<BsplineFunctor<QMCTraits::RealType>>;
+
+/** create the tiled graphite ions
+ * @param ions particle set of the ions, the lattice is set to the supercell
+ * @param tmat tiling matrix
+ */
+void createGraphite(ParticleSet& ions, const Tensor<int, 3>& tmat);
+
+/** create the up and down electrons at random positions in the cell of the ions
+ *
+ * The species charges and the structure factor are set for the Coulomb interaction.
+ */
+void createElectrons(ParticleSet& els, const ParticleSet& ions, RandomGenerator_t& rng);
+
+/** create the uu and ud Bspline J2 of the miniapps
+ * @param els electrons with the e-e table
+ * @param rcut cutoff of the correlation functions
+ */
+J2Type* createJ2(ParticleSet& els, QMCTraits::RealType rcut);
+
+/** create a nonlocal pseudopotential of gaussian channels
+ * @param lmax the channels are l=0..lmax
+ * @param rule quadrature rule of the knots, see Quadrature3D
+ *
+ * The s channel is the one of the carbon BFD pseudopotential.
+ */
+NonLocalECPComponent* createNonLocalPP(int lmax, int rule);
+
+} // namespace qmcplusplus
+#endif
@@ -0,0 +1,506 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/** @file qmc_benchmarks.cpp
+ * @brief throughput of the hot kernels of the production classes on synthetic systems
+ *
+ * Every thread sweeps its own walker of a synthetic system, see SyntheticSystem.h,
+ * with the single particle moves of VMC and times each kernel separately:
+ * - SoaDistanceTableAA: makeMove and acceptMove of the e-e table alone
+ * - J2OrbitalSoA: ratioGrad and acceptMove
+ * - SplineC2RSoA (SplineC2CSoA for complex builds): values, gradients and laplacians
+ * - DiracDeterminant: ratioGrad including the orbitals, acceptMove and completeUpdates with the delayed update
+ * - MultiDiracDeterminant: the determinants and gradients of an expansion for a move and acceptMove
+ * - NonLocalECPComponent: evaluateOne of the ion-electron pairs within the cutoff
+ * - CoulombPBCAA: the e-e energy of a walker
+ * The results are written in JSON, the throughput of a kernel is the sum over the threads.
+ */
+#include "Configuration.h"
+#include "qmcpack_version.h"
+#include "Message/Communicate.h"
+#include "Message/OpenMP.h"
+#include "Utilities/Clock.h"
+#include "Utilities/Timer.h"
+#include "Utilities/OutputManager.h"
+#include "ParticleBase/RandomSeqGenerator.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "QMCWaveFunctions/Fermion/SlaterDet.h"
+#include "QMCWaveFunctions/Fermion/DiracDeterminant.h"
+#include "QMCWaveFunctions/Fermion/MultiDiracDeterminant.h"
+#include "QMCHamiltonians/CoulombPBCAA.h"
+#include "Benchmarks/SyntheticSystem.h"
+#include <getopt.h>
+#include <fstream>
+#include <memory>
+
+using namespace qmcplusplus;
+
+namespace qmcplusplus
+{
+enum
+{
+  KERNEL_DT_AA = 0,
+  KERNEL_J2,
+  KERNEL_SPLINE,
+  KERNEL_DET,
+  KERNEL_MSD,
+  KERNEL_NLPP,
+  KERNEL_COULOMB_AA,
+  NUM_KERNELS
+};
+
+struct KernelInfo
+{
+  const char* name;
+  const char* operation;
+  const char* unit;
+};
+
+const KernelInfo kernel_info[NUM_KERNELS] = {
+    {"SoaDistanceTableAA", "makeMove+acceptMove", "moves/s"},
+    {"J2OrbitalSoA", "ratioGrad+acceptMove", "moves/s"},
+#if defined(QMC_COMPLEX)
+    {"SplineC2CSoA", "evaluate_vgl", "evaluations/s"},
+#else
+    {"SplineC2RSoA", "evaluate_vgl", "evaluations/s"},
+#endif
+    {"DiracDeterminant", "ratioGrad+acceptMove+completeUpdates", "moves/s"},
+    {"MultiDiracDeterminant", "evaluateDetsAndGradsForPtclMove+acceptMove", "moves/s"},
+    {"NonLocalECPComponent", "evaluateOne", "pairs/s"},
+    {"CoulombPBCAA", "evaluate", "evaluations/s"}};
+
+/// time and number of calls of a kernel on a thread
+struct KernelTimer
+{
+  double seconds = 0.0;
+  size_t calls   = 0;
+
+  inline void add(double t, size_t n)
+  {
+    seconds += t;
+    calls += n;
+  }
+};
+
+struct BenchmarkInput
+{
+  Tensor<int, 3> tmat         = Tensor<int, 3>(1, 0, 0, 0, 1, 0, 0, 0, 1);
+  int sweeps                  = 5;
+  QMCTraits::RealType spacing = 0.3;
+  int delay_rank              = 1;
+  int num_dets                = 16;
+  int num_virtual             = 8;
+  int nlpp_lmax               = 1;
+  int nlpp_rule               = 4;
+  bool single_spline          = true;
+  int seed                    = 11;
+  std::string output;
+};
+
+/** a walker of the synthetic system with the components of the benchmarks
+ *
+ * The determinants and the J2 are owned by the trial wave function used by the
+ * pseudopotential, the spline tables are shared among the walkers.
+ */
+struct BenchmarkWalker
+{
+  using RealType  = QMCTraits::RealType;
+  using ValueType = QMCTraits::ValueType;
+  using GradType  = QMCTraits::GradType;
+  using PosType   = QMCTraits::PosType;
+
+  ParticleSet ions, els, els_aa;
+  int ei_table;
+  RandomGenerator_t rng;
+  TrialWaveFunction psi;
+  J2Type* J2;
+  DiracDeterminant<>* dets[2];
+  std::unique_ptr<SPOSet> spos[2], msd_spos[2];
+  std::unique_ptr<MultiDiracDeterminant> msds[2];
+  std::unique_ptr<NonLocalECPComponent> nlpp;
+  std::unique_ptr<CoulombPBCAA> caa;
+  ParticleSet::ParticlePos_t deltaR;
+  SPOSet::ValueVector_t psiV;
+  SPOSet::GradVector_t dpsiV;
+  SPOSet::ValueVector_t d2psiV;
+  std::vector<NonLocalData> Txy;
+  KernelTimer timers[NUM_KERNELS];
+
+  BenchmarkWalker(const BenchmarkInput& input,
+                  int walker_id,
+                  SPOSet& spo_main,
+                  SPOSet& msd_spo_main,
+                  const std::vector<ci_configuration2>& ci_list)
+      : psi(OHMMS::Controller)
+  {
+    rng.init(0, 1, input.seed + walker_id);
+    createGraphite(ions, input.tmat);
+    createElectrons(els, ions, rng);
+    // e-e table alone
+    createElectrons(els_aa, ions, rng);
+    els_aa.addTable(els_aa, DT_SOA);
+    els_aa.update();
+
+    els.addTable(els, DT_SOA);
+    ei_table = els.addTable(ions, DT_SOA);
+    els.update();
+
+    J2 = createJ2(els, els.Lattice.WignerSeitzRadius);
+    SlaterDet* slater = new SlaterDet(els);
+    for (int spin = 0; spin < 2; spin++)
+    {
+      spos[spin].reset(spo_main.makeClone());
+      dets[spin] = new DiracDeterminant<>(spos[spin].get(), els.first(spin));
+      dets[spin]->set(els.first(spin), els.last(spin) - els.first(spin), input.delay_rank);
+      slater->add(dets[spin], spin);
+
+      msd_spos[spin].reset(msd_spo_main.makeClone());
+      msds[spin].reset(new MultiDiracDeterminant(msd_spos[spin].get(), els.first(spin)));
+      msds[spin]->ReferenceDeterminant = 0;
+      msds[spin]->NumDets              = ci_list.size();
+      *msds[spin]->ciConfigList        = ci_list;
+      msds[spin]->set(els.first(spin), els.last(spin) - els.first(spin), msd_spo_main.getOrbitalSetSize());
+    }
+    psi.addComponent(slater, "SlaterDet");
+    psi.addComponent(J2, "J2");
+
+    nlpp.reset(createNonLocalPP(input.nlpp_lmax, input.nlpp_rule));
+    nlpp->initVirtualParticle(els);
+    caa.reset(new CoulombPBCAA(els, true));
+
+    deltaR.resize(els.getTotalNum());
+    psiV.resize(spo_main.getOrbitalSetSize());
+    dpsiV.resize(spo_main.getOrbitalSetSize());
+    d2psiV.resize(spo_main.getOrbitalSetSize());
+
+    psi.evaluateLog(els);
+    for (int spin = 0; spin < 2; spin++)
+      msds[spin]->evaluateForWalkerMove(els);
+  }
+
+  /** a sweep of single particle moves followed by the evaluation of the potentials
+   * @param tau time step of the moves
+   * @param timed false for the warmup
+   */
+  void sweep(RealType tau, bool timed)
+  {
+    const RealType sqrttau = std::sqrt(tau);
+    double t0, t1;
+    makeGaussRandomWithEngine(deltaR, rng);
+    for (int iat = 0; iat < els.getTotalNum(); iat++)
+    {
+      const PosType dr = sqrttau * deltaR[iat];
+      const int spin   = els.GroupID[iat];
+
+      t0 = cpu_clock();
+      els_aa.makeMove(iat, dr);
+      els_aa.acceptMove(iat);
+      t1 = cpu_clock();
+      timers[KERNEL_DT_AA].add(t1 - t0, 1);
+
+      // at the current position, the determinant evaluates the orbitals at the proposed one
+      t0 = cpu_clock();
+      spos[spin]->evaluate(els, iat, psiV, dpsiV, d2psiV);
+      t1 = cpu_clock();
+      timers[KERNEL_SPLINE].add(t1 - t0, 1);
+
+      els.makeMove(iat, dr);
+      GradType grad_j2, grad_det;
+
+      t0                       = cpu_clock();
+      const ValueType ratio_j2 = J2->ratioGrad(els, iat, grad_j2);
+      t1                       = cpu_clock();
+      timers[KERNEL_J2].add(t1 - t0, 0);
+
+      t0                        = cpu_clock();
+      const ValueType ratio_det = dets[spin]->ratioGrad(els, iat, grad_det);
+      t1                        = cpu_clock();
+      timers[KERNEL_DET].add(t1 - t0, 0);
+
+      t0 = cpu_clock();
+      msds[spin]->evaluateDetsAndGradsForPtclMove(els, iat);
+      t1 = cpu_clock();
+      timers[KERNEL_MSD].add(t1 - t0, 0);
+
+      if (rng() < std::norm(ratio_j2 * ratio_det))
+      {
+        t0 = cpu_clock();
+        J2->acceptMove(els, iat);
+        t1 = cpu_clock();
+        timers[KERNEL_J2].add(t1 - t0, 1);
+
+        t0 = cpu_clock();
+        dets[spin]->acceptMove(els, iat);
+        t1 = cpu_clock();
+        timers[KERNEL_DET].add(t1 - t0, 1);
+
+        t0 = cpu_clock();
+        msds[spin]->acceptMove(els, iat);
+        t1 = cpu_clock();
+        timers[KERNEL_MSD].add(t1 - t0, 1);
+
+        els.acceptMove(iat);
+      }
+      else
+      {
+        J2->restore(iat);
+        dets[spin]->restore(iat);
+        msds[spin]->restore(iat);
+        els.rejectMove(iat);
+        timers[KERNEL_J2].add(0.0, 1);
+        timers[KERNEL_DET].add(0.0, 1);
+        timers[KERNEL_MSD].add(0.0, 1);
+      }
+    }
+    t0 = cpu_clock();
+    for (int spin = 0; spin < 2; spin++)
+      dets[spin]->completeUpdates();
+    t1 = cpu_clock();
+    timers[KERNEL_DET].add(t1 - t0, 0);
+    els.donePbyP();
+
+    nlpp->randomize_grid(rng);
+    const auto& d_ei = els.getDistTable(ei_table);
+    size_t npairs    = 0;
+    t0               = cpu_clock();
+    for (int jel = 0; jel < els.getTotalNum(); jel++)
+    {
+      const auto& dist  = d_ei.Distances[jel];
+      const auto& displ = d_ei.Displacements[jel];
+      for (int iat = 0; iat < ions.getTotalNum(); iat++)
+        if (dist[iat] < nlpp->getRmax())
+        {
+          nlpp->evaluateOne(els, iat, psi, jel, dist[iat], RealType(-1) * displ[iat], false, Txy);
+          npairs++;
+        }
+    }
+    t1 = cpu_clock();
+    timers[KERNEL_NLPP].add(t1 - t0, npairs);
+
+    t0 = cpu_clock();
+    caa->evaluate(els);
+    t1 = cpu_clock();
+    timers[KERNEL_COULOMB_AA].add(t1 - t0, 1);
+
+    if (!timed)
+      for (int i = 0; i < NUM_KERNELS; i++)
+        timers[i] = KernelTimer();
+  }
+};
+
+/** the reference and its single and double excitations in the order of increasing orbital index
+ * @param nel number of electrons of a spin
+ * @param norb number of orbitals including the virtual ones
+ * @param ndets largest number of configurations
+ */
+std::vector<ci_configuration2> createExcitations(int nel, int norb, int ndets)
+{
+  std::vector<ci_configuration2> ci_list(1);
+  ci_list[0].occup.resize(nel);
+  for (int i = 0; i < nel; i++)
+    ci_list[0].occup[i] = i;
+  // singles
+  for (int i = nel - 1; i >= 0 && ci_list.size() < ndets; i--)
+    for (int a = nel; a < norb && ci_list.size() < ndets; a++)
+    {
+      ci_configuration2 c(ci_list[0]);
+      c.occup.erase(c.occup.begin() + i);
+      c.occup.push_back(a);
+      ci_list.push_back(c);
+    }
+  // doubles
+  for (int i = nel - 1; i >= 0 && ci_list.size() < ndets; i--)
+    for (int j = i - 1; j >= 0 && ci_list.size() < ndets; j--)
+      for (int a = nel; a < norb && ci_list.size() < ndets; a++)
+        for (int b = a + 1; b < norb && ci_list.size() < ndets; b++)
+        {
+          ci_configuration2 c(ci_list[0]);
+          c.occup.erase(c.occup.begin() + i);
+          c.occup.erase(c.occup.begin() + j);
+          c.occup.push_back(a);
+          c.occup.push_back(b);
+          ci_list.push_back(c);
+        }
+  return ci_list;
+}
+
+void printUsage()
+{
+  std::cerr << "Usage: qmc_benchmarks [options]\n"
+            << "  -g \"n0 n1 n2\"  tiling of the 4-atom graphite cell, default 1 1 1\n"
+            << "  -i sweeps      number of timed sweeps, default 5\n"
+            << "  -m spacing     grid spacing of the spline orbitals in bohr, default 0.3\n"
+            << "  -p precision   single or double precision spline coefficients, default single\n"
+            << "  -d rank        delay rank of the determinant updates, default 1\n"
+            << "  -e ndets       number of determinants per spin of the multi determinant, default 16\n"
+            << "  -v norb        number of virtual orbitals of the multi determinant, default 8\n"
+            << "  -l lmax        highest angular momentum of the pseudopotential channels, default 1\n"
+            << "  -q rule        quadrature rule of the pseudopotential, default 4\n"
+            << "  -r seed        random seed, default 11\n"
+            << "  -o file        JSON output, default the standard output\n";
+}
+
+} // namespace qmcplusplus
+
+int main(int argc, char** argv)
+{
+  OHMMS::Controller->initialize(argc, argv);
+  const bool ionode = (OHMMS::Controller->rank() == 0);
+
+  BenchmarkInput input;
+  int opt;
+  while ((opt = getopt(argc, argv, "hg:i:m:p:d:e:v:l:q:r:o:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'g':
+    {
+      int na = 1, nb = 1, nc = 1;
+      sscanf(optarg, "%d %d %d", &na, &nb, &nc);
+      input.tmat = Tensor<int, 3>(na, 0, 0, 0, nb, 0, 0, 0, nc);
+      break;
+    }
+    case 'i':
+      input.sweeps = atoi(optarg);
+      break;
+    case 'm':
+      input.spacing = atof(optarg);
+      break;
+    case 'p':
+      input.single_spline = (std::string(optarg) != "double");
+      break;
+    case 'd':
+      input.delay_rank = atoi(optarg);
+      break;
+    case 'e':
+      input.num_dets = atoi(optarg);
+      break;
+    case 'v':
+      input.num_virtual = atoi(optarg);
+      break;
+    case 'l':
+      input.nlpp_lmax = atoi(optarg);
+      break;
+    case 'q':
+      input.nlpp_rule = atoi(optarg);
+      break;
+    case 'r':
+      input.seed = atoi(optarg);
+      break;
+    case 'o':
+      input.output = optarg;
+      break;
+    default:
+      if (ionode)
+        printUsage();
+      OHMMS::Controller->finalize();
+      return opt == 'h' ? 0 : 1;
+    }
+  }
+
+  // the builders report to app_log, the standard output is kept for the results
+  infoSummary.shutOff();
+  infoLog.shutOff();
+
+  const int num_threads = omp_get_max_threads();
+  ParticleSet ions, els;
+  RandomGenerator_t rng;
+  rng.init(0, 1, input.seed);
+  createGraphite(ions, input.tmat);
+  createElectrons(els, ions, rng);
+  const int nel_up = els.last(0) - els.first(0);
+  const int smoothing = 4;
+  std::unique_ptr<SPOSet> spo_main(SyntheticSplineSetBuilder::createRandomSplines(els, nel_up, input.spacing, smoothing,
+                                                                                  input.single_spline, rng));
+  std::unique_ptr<SPOSet> msd_spo_main(SyntheticSplineSetBuilder::createRandomSplines(els, nel_up + input.num_virtual,
+                                                                                      input.spacing, smoothing,
+                                                                                      input.single_spline, rng));
+  const std::vector<ci_configuration2> ci_list =
+      createExcitations(nel_up, nel_up + input.num_virtual, std::max(1, input.num_dets));
+
+  std::vector<std::unique_ptr<BenchmarkWalker>> walkers(num_threads);
+  for (int ip = 0; ip < num_threads; ip++)
+    walkers[ip].reset(new BenchmarkWalker(input, num_threads * OHMMS::Controller->rank() + ip, *spo_main,
+                                          *msd_spo_main, ci_list));
+
+  const QMCTraits::RealType tau = 0.5;
+  Timer wall_clock;
+#pragma omp parallel
+  {
+    BenchmarkWalker& walker = *walkers[omp_get_thread_num()];
+    walker.sweep(tau, false);
+    for (int step = 0; step < input.sweeps; step++)
+      walker.sweep(tau, true);
+  }
+  const double wall_time = wall_clock.elapsed();
+
+  if (ionode)
+  {
+    std::ofstream fout;
+    if (!input.output.empty())
+      fout.open(input.output);
+    std::ostream& os = input.output.empty() ? std::cout : fout;
+
+    os << "{\n";
+    os << "  \"version\": \"" << QMCPACK_VERSION_MAJOR << "." << QMCPACK_VERSION_MINOR << "."
+       << QMCPACK_VERSION_PATCH << "\",\n";
+#if defined(QMCPACK_GIT_HASH)
+    os << "  \"git_hash\": \"" << QMCPACK_GIT_HASH << "\",\n";
+#endif
+    os << "  \"real_precision\": " << sizeof(QMCTraits::RealType) * 8 << ",\n";
+#if defined(QMC_COMPLEX)
+    os << "  \"complex\": true,\n";
+#else
+    os << "  \"complex\": false,\n";
+#endif
+    os << "  \"mpi_ranks\": " << OHMMS::Controller->size() << ",\n";
+    os << "  \"threads\": " << num_threads << ",\n";
+    os << "  \"system\": {\n";
+    os << "    \"tiling\": [";
+    for (int i = 0; i < 9; i++)
+      os << input.tmat(i) << (i < 8 ? ", " : "],\n");
+    os << "    \"ions\": " << ions.getTotalNum() << ",\n";
+    os << "    \"electrons\": " << els.getTotalNum() << ",\n";
+    os << "    \"grid_spacing\": " << input.spacing << ",\n";
+    os << "    \"spline_precision\": \"" << (input.single_spline ? "single" : "double") << "\",\n";
+    os << "    \"delay_rank\": " << input.delay_rank << ",\n";
+    os << "    \"determinants\": " << ci_list.size() << ",\n";
+    os << "    \"virtual_orbitals\": " << input.num_virtual << ",\n";
+    os << "    \"nlpp_lmax\": " << input.nlpp_lmax << ",\n";
+    os << "    \"nlpp_knots\": " << walkers[0]->nlpp->getNknot() << "\n";
+    os << "  },\n";
+    os << "  \"sweeps\": " << input.sweeps << ",\n";
+    os << "  \"wall_time\": " << wall_time << ",\n";
+    os << "  \"kernels\": [\n";
+    for (int i = 0; i < NUM_KERNELS; i++)
+    {
+      size_t calls      = 0;
+      double seconds    = 0.0;
+      double throughput = 0.0;
+      for (int ip = 0; ip < num_threads; ip++)
+      {
+        const KernelTimer& t = walkers[ip]->timers[i];
+        calls += t.calls;
+        seconds += t.seconds;
+        if (t.seconds > 0.0)
+          throughput += t.calls / t.seconds;
+      }
+      os << "    {\"name\": \"" << kernel_info[i].name << "\", \"operation\": \"" << kernel_info[i].operation
+         << "\", \"calls\": " << calls << ", \"seconds\": " << seconds / num_threads << ", \"throughput\": "
+         << throughput << ", \"unit\": \"" << kernel_info[i].unit << "\"}" << (i < NUM_KERNELS - 1 ? ",\n" : "\n");
+    }
+    os << "  ]\n";
+    os << "}\n";
+  }
+
+  OHMMS::Controller->finalize();
+  return 0;
+}
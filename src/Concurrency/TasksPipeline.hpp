@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source
+// License.  See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_TASKSPIPELINE_HPP
+#define QMCPLUSPLUS_TASKSPIPELINE_HPP
+
+#include "Concurrency/Info.hpp"
+
+namespace qmcplusplus
+{
+/** Abstraction for task based execution of independent three stage pipelines
+ *
+ *  Construct with num_threads to run
+ *  then call operator()(num_groups, head, num_items, body, tail)
+ *  For each group_id in [0, num_groups)
+ *      head(group_id)
+ *      body(group_id, item_id) for each item_id in [0, num_items(group_id)), in any order
+ *      tail(group_id)
+ *  run in that order. The groups do not wait on each other, a thread
+ *  done with its own group picks up the body items of the others.
+ *
+ *  Like TasksOneToOne it is not intended for use below the top level of openmp threading.
+ */
+template<Threading TT = Threading::OPENMP>
+class TasksPipeline
+{
+public:
+  TasksPipeline(int num_threads) : num_threads_(num_threads) {}
+
+  template<typename HEAD, typename NUM_ITEMS, typename BODY, typename TAIL>
+  void operator()(int num_groups, HEAD&& head, NUM_ITEMS&& num_items, BODY&& body, TAIL&& tail);
+
+private:
+  const int num_threads_;
+};
+
+} // namespace qmcplusplus
+
+// Implementation includes must follow functor declaration
+#include "Concurrency/TasksPipelineOPENMP.hpp"
+#endif
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source
+// License.  See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+////////////////////////////////////////////////////////////////////////////////
+
+/** @file
+ *  @brief implementation of openmp specialization of TasksPipeline
+ */
+#ifndef QMCPLUSPLUS_TASKSPIPELINEOPENMP_HPP
+#define QMCPLUSPLUS_TASKSPIPELINEOPENMP_HPP
+
+#include <exception>
+#include <stdexcept>
+#include <omp.h>
+
+#include "Concurrency/TasksPipeline.hpp"
+
+namespace qmcplusplus
+{
+/** implements the pipelines with openmp tasks.
+ *
+ *  Each group is a task which spawns its body items as child tasks and waits on them.
+ *  Idle threads of the team take the pending tasks of any group.
+ *  The first exception thrown by a stage is rethrown after the team joins,
+ *  the tail of a group whose head threw is skipped.
+ */
+template<>
+template<typename HEAD, typename NUM_ITEMS, typename BODY, typename TAIL>
+void TasksPipeline<Threading::OPENMP>::operator()(int num_groups,
+                                                  HEAD&& head,
+                                                  NUM_ITEMS&& num_items,
+                                                  BODY&& body,
+                                                  TAIL&& tail)
+{
+  if (omp_get_level() > 0)
+    throw std::runtime_error("TasksPipeline should not be used for nested openmp threading\n");
+  std::exception_ptr error;
+  auto guarded = [&error](auto&& stage) {
+    try
+    {
+      stage();
+    }
+    catch (...)
+    {
+#pragma omp critical(TasksPipeline_error)
+      if (!error)
+        error = std::current_exception();
+    }
+  };
+#pragma omp parallel num_threads(num_threads_)
+#pragma omp single
+  for (int group_id = 0; group_id < num_groups; ++group_id)
+  {
+#pragma omp task firstprivate(group_id)
+    {
+      int items      = 0;
+      bool head_done = false;
+      guarded([&]() {
+        head(group_id);
+        items     = num_items(group_id);
+        head_done = true;
+      });
+      for (int item_id = 0; item_id < items; ++item_id)
+      {
+#pragma omp task firstprivate(group_id, item_id)
+        guarded([&]() { body(group_id, item_id); });
+      }
+#pragma omp taskwait
+      if (head_done)
+        guarded([&]() { tail(group_id); });
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+} // namespace qmcplusplus
+
+#endif
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <vector>
+#include <stdexcept>
+#include "Concurrency/TasksPipeline.hpp"
+
+namespace qmcplusplus
+{
+TEST_CASE("TasksPipeline<OPENMP> stage order", "[concurrency]")
+{
+  const int num_threads = omp_get_max_threads();
+  const int num_groups  = num_threads + 3;
+  TasksPipeline<Threading::OPENMP> pipeline(num_threads);
+  std::vector<int> heads(num_groups, 0);
+  std::vector<int> bodies(num_groups, 0);
+  std::vector<int> tails(num_groups, 0);
+  int out_of_order = 0;
+  pipeline(
+      num_groups, [&heads](int group_id) { heads[group_id] = 1; }, [](int group_id) { return group_id + 1; },
+      [&heads, &bodies, &out_of_order](int group_id, int item_id) {
+        if (heads[group_id] != 1)
+        {
+#pragma omp atomic update
+          out_of_order++;
+        }
+#pragma omp atomic update
+        bodies[group_id]++;
+      },
+      [&bodies, &tails, &out_of_order](int group_id) {
+        if (bodies[group_id] != group_id + 1)
+        {
+#pragma omp atomic update
+          out_of_order++;
+        }
+        tails[group_id] = 1;
+      });
+  REQUIRE(out_of_order == 0);
+  for (int group_id = 0; group_id < num_groups; ++group_id)
+  {
+    CHECK(bodies[group_id] == group_id + 1);
+    CHECK(tails[group_id] == 1);
+  }
+}
+
+TEST_CASE("TasksPipeline<OPENMP> exception", "[concurrency]")
+{
+  TasksPipeline<Threading::OPENMP> pipeline(2);
+  int tails = 0;
+  auto failingBody = [](int group_id, int item_id) {
+    if (group_id == 1 && item_id == 1)
+      throw std::runtime_error("body failed");
+  };
+  auto countTails = [&tails](int group_id) {
+#pragma omp atomic update
+    tails++;
+  };
+  REQUIRE_THROWS_WITH(pipeline(
+                          3, [](int group_id) {}, [](int group_id) { return 2; }, failingBody, countTails),
+                      Catch::Contains("body failed"));
+  // the other stages still ran
+  REQUIRE(tails == 3);
+}
+
+TEST_CASE("TasksPipeline<OPENMP> nested case", "[concurrency]")
+{
+  TasksPipeline<Threading::OPENMP> pipeline(1);
+  bool threw = false;
+#pragma omp parallel num_threads(1)
+  {
+    try
+    {
+      pipeline(
+          1, [](int group_id) {}, [](int group_id) { return 0; }, [](int group_id, int item_id) {},
+          [](int group_id) {});
+    }
+    catch (const std::runtime_error& re)
+    {
+      threw = true;
+    }
+  }
+  REQUIRE(threw);
+}
+
+} // namespace qmcplusplus
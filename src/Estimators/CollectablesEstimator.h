@@ -24,7 +24,7 @@ namespace qmcplusplus
 class CollectablesEstimator : public ScalarEstimatorBase
 {
   ///save the reference hamiltonian
-  const QMCHamiltonian& refH;
+  QMCHamiltonian& refH;
 
 public:
   /** constructor
@@ -50,6 +50,12 @@ public:
     for (int i = 0; i < data.size(); ++i)
       scalars[i](data[i], wgt);
   }
+
+  /** collect the data the operators accumulate outside of the collectables
+   * @param comm communicator of the ranks
+   * @param write true on the rank writing the h5 file
+   */
+  inline void collectBlock(Communicate* comm, bool write) { refH.collectBlock(comm, write); }
 };
 } // namespace qmcplusplus
 #endif
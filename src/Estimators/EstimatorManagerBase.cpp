@@ -27,6 +27,7 @@
 #include "Estimators/LocalEnergyOnlyEstimator.h"
 #include "Estimators/RMCLocalEnergyEstimator.h"
 #include "Estimators/CollectablesEstimator.h"
+#include "Estimators/EstimatorManagerCrowd.h"
 #include "QMCDrivers/SimpleFixedNodeBranch.h"
 #include "Utilities/IteratorUtility.h"
 #include "Numerics/HDFNumericAttrib.h"
@@ -327,12 +328,14 @@ void EstimatorManagerBase::collectScalarEstimators(const RefVector<ScalarEstimat
   std::vector<ScalarType> averages_sum(num_scalars, 0.0);
 
   auto accumulateVectorsInPlace = [](auto& vec_a, const auto& vec_b) {
-    for (int i = 0; i < vec_a.size(); ++i)
+    for (int i = 0; i < vec_b.size(); ++i)
       vec_a[i] += vec_b[i];
   };
 
   AverageCache = 0.0;
-  if (AverageCache.size() != num_scalars)
+  // the collectables are at the end of the caches, see collectCollectables
+  const int num_collectables = (Collectables) ? Collectables->size() : 0;
+  if (AverageCache.size() != num_scalars + num_collectables)
     throw std::runtime_error(
         "EstimatorManagerBase and Crowd ScalarManagers do not agree on number of scalars being estimated");
   for (int i = 0; i < num_est; ++i)
@@ -347,6 +350,41 @@ void EstimatorManagerBase::collectScalarEstimators(const RefVector<ScalarEstimat
 
 }
 
+void EstimatorManagerBase::accumulateCollectables(const RefVector<EstimatorManagerCrowd>& crowd_ems, RealType norm)
+{
+  const int num_crowds = crowd_ems.size();
+  if (Collectables == 0 || num_crowds == 0)
+    return;
+  RealType step_weight = 0.0;
+  for (int i = 0; i < num_crowds; ++i)
+    step_weight += crowd_ems[i].get().get_step_weight();
+  // the crowds bin into private buffers, no crowd writes to another one's histogram
+  for (int stride = 1; stride < num_crowds; stride *= 2)
+  {
+#pragma omp parallel for
+    for (int i = 0; i < num_crowds - stride; i += 2 * stride)
+    {
+      ParticleSet::Buffer_t& sum           = crowd_ems[i].get().get_step_collectables();
+      const ParticleSet::Buffer_t& partial = crowd_ems[i + stride].get().get_step_collectables();
+      for (int j = 0; j < sum.size(); ++j)
+        sum[j] += partial[j];
+    }
+  }
+  if (norm == 0.0)
+    norm = (step_weight > 0.0) ? 1.0 / step_weight : 0.0;
+  ParticleSet::Buffer_t& step_collectables = crowd_ems[0].get().get_step_collectables();
+  step_collectables *= norm;
+  Collectables->accumulate_all(step_collectables, 1.0);
+  for (int i = 0; i < num_crowds; ++i)
+    crowd_ems[i].get().resetStepCollectables();
+}
+
+void EstimatorManagerBase::collectCollectables()
+{
+  if (Collectables)
+    Collectables->takeBlockAverage(AverageCache.begin(), SquaredAverageCache.begin());
+}
+
 void EstimatorManagerBase::stopBlock(const std::vector<EstimatorManagerBase*>& est)
 {
   //normalized it by the thread
@@ -400,6 +438,8 @@ void EstimatorManagerBase::collectBlockAverages()
         PropertyCache[i] *= nth;
     }
   }
+  if (Collectables)
+    Collectables->collectBlock(myComm, Archive != 0);
   //add the block average to summarize
   energyAccumulator(AverageCache[0]);
   varAccumulator(SquaredAverageCache[0] - AverageCache[0] * AverageCache[0]);
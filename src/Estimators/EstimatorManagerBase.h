@@ -37,6 +37,7 @@ namespace qmcplusplus
 class MCWalkerConifugration;
 class QMCHamiltonian;
 class CollectablesEstimator;
+class EstimatorManagerCrowd;
 
 /** Class to manage a set of ScalarEstimators */
 class EstimatorManagerBase : public EstimatorManagerInterface
@@ -192,6 +193,21 @@ public:
    */
   void collectScalarEstimators(const RefVector<ScalarEstimatorBase>& scalar_estimators, const int total_walkers, const RealType block_weight);
 
+  /** accumulate the collectables of a step of all the crowds
+   * @param crowd_ems estimator managers of the crowds
+   * @param norm normalization of the step, the inverse of the total walker weight of the crowds if 0
+   *
+   *  The raw step sums of the crowds are added pairwise in a tree and normalized once, so that
+   *  every walker counts with its weight whatever crowd it is in. The crowd step buffers are reset.
+   */
+  void accumulateCollectables(const RefVector<EstimatorManagerCrowd>& crowd_ems, RealType norm = 0.0);
+
+  /** At end of block take the block average of the collectables
+   *
+   *  Must follow collectScalarEstimators which resets the caches.
+   */
+  void collectCollectables();
+
   /** accumulate the measurements
    * @param W walkers
    */
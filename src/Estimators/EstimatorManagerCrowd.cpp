@@ -25,6 +25,7 @@ EstimatorManagerCrowd::EstimatorManagerCrowd(EstimatorManagerBase& em)
       MainEstimator(0),
       Collectables(0),
       EstimatorMap(em.EstimatorMap),
+      step_weight_(0.0),
       max4ascii(em.max4ascii)
 {
   // For now I'm going to try to refactor away the clone pattern only at the manager level.
@@ -33,7 +34,10 @@ EstimatorManagerCrowd::EstimatorManagerCrowd(EstimatorManagerBase& em)
     scalar_estimators_.push_back(em.Estimators[i]->clone());
   MainEstimator = scalar_estimators_[EstimatorMap[MainEstimatorName]];
   if (em.Collectables)
+  {
     Collectables = em.Collectables->clone();
+    step_collectables_.resize(Collectables->size());
+  }
 }
 
 void EstimatorManagerCrowd::stopBlock()
@@ -76,7 +76,12 @@ public:
   /** start  a block
    * @param steps number of steps in a block
    */
-  void startBlock(int steps){ block_weight_ = 0.0;};
+  void startBlock(int steps)
+  {
+    block_weight_ = 0.0;
+    // drop what was binned by steps which are not accumulated, e.g. warmup
+    resetStepCollectables();
+  }
 
   void stopBlock();
 
@@ -95,9 +100,26 @@ public:
     // things that should be a POD argument
     for (int i = 0; i < num_scalar_estimators; ++i)
       scalar_estimators_[i]->accumulate(global_walkers, walkers, norm);  
+    if (Collectables)
+      for (MCPWalker& walker : walkers)
+        step_weight_ += walker.Weight;
   }
 
   RefVector<EstimatorType> get_scalar_estimators() { return convertPtrToRefVector(scalar_estimators_); }
+  /** buffer the collectables of the current step are evaluated into
+   *
+   *  Private to the crowd, the sums of the crowds are normalized by the population weight
+   *  and accumulated by EstimatorManagerBase::accumulateCollectables.
+   */
+  ParticleSet::Buffer_t& get_step_collectables() { return step_collectables_; }
+  /// total weight of the walkers of the crowd accumulated in the current step
+  RealType get_step_weight() const { return step_weight_; }
+  /// clear the step collectables and their weight
+  void resetStepCollectables()
+  {
+    step_weight_ = 0.0;
+    std::fill(step_collectables_.begin(), step_collectables_.end(), 0.0);
+  }
   RealType get_block_weight() const { return block_weight_; }
 
 protected:
@@ -153,6 +175,10 @@ protected:
   std::map<std::string, int> EstimatorMap;
   ///estimators of simple scalars
   std::vector<EstimatorType*> scalar_estimators_;
+  ///collectables of the walkers of the crowd in the current step
+  ParticleSet::Buffer_t step_collectables_;
+  ///weight of the walkers of the crowd in the current step
+  RealType step_weight_;
 
   Timer MyTimer;
 
@@ -99,6 +99,14 @@ struct accumulator_set
     properties[WEIGHT] = 1;
   }
 
+  /** add the samples of another accumulator */
+  inline accumulator_set& operator+=(const accumulator_set& rhs)
+  {
+    for (int i = 0; i < CAPACITY; ++i)
+      properties[i] += rhs.properties[i];
+    return *this;
+  }
+
   /** return true if Weight!= 0 */
   inline bool good() const { return properties[WEIGHT] > 0; }
   /** return true if Weight== 0 */
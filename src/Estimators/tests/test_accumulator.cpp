@@ -111,4 +111,27 @@ TEST_CASE("accumulator with weights float", "[estimators]") { test_real_accumula
 
 TEST_CASE("accumulator with weights double", "[estimators]") { test_real_accumulator_weights<double>(); }
 
+template<typename T>
+void test_real_accumulator_sum()
+{
+  // the samples of test_real_accumulator_weights split over two accumulators
+  accumulator_set<T> a, b;
+  a(2.0, 1.0);
+  a(3.1, 2.4);
+  b(-1.1, 2.1);
+  b(4.8, 3.3);
+  a += b;
+  REQUIRE(a.count() == Approx(8.8));
+
+  REQUIRE(a.result() == Approx(22.97));
+  REQUIRE(a.result2() == Approx(105.637));
+  REQUIRE(a.mean() == Approx(2.6102272727));
+  REQUIRE(a.variance() == Approx(5.1909181302));
+  REQUIRE(b.count() == Approx(5.4));
+}
+
+TEST_CASE("accumulator sum float", "[estimators]") { test_real_accumulator_sum<float>(); }
+
+TEST_CASE("accumulator sum double", "[estimators]") { test_real_accumulator_sum<double>(); }
+
 } // namespace qmcplusplus
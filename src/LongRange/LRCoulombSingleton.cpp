@@ -21,6 +21,7 @@
 #if OHMMS_DIM == 3
 #include "LongRange/EwaldHandler.h"
 #include "LongRange/EwaldHandler3D.h"
+#include "LongRange/PPPMHandler.h"
 #elif OHMMS_DIM == 2
 #include "LongRange/TwoDEwaldHandler.h"
 #endif
@@ -30,6 +31,9 @@ namespace qmcplusplus
 //initialization of the static data
 LRCoulombSingleton::LRHandlerType* LRCoulombSingleton::CoulombHandler      = 0;
 LRCoulombSingleton::LRHandlerType* LRCoulombSingleton::CoulombDerivHandler = 0;
+LRCoulombSingleton::lrbreakup_type LRCoulombSingleton::this_lr_type        = ESLER;
+int LRCoulombSingleton::pppm_order                                         = 4;
+LRCoulombSingleton::mRealType LRCoulombSingleton::pppm_mesh_factor         = 2.0;
 /** CoulombFunctor
  *
  * An example for a Func for LRHandlerTemp. Four member functions have to be provided
@@ -117,12 +121,20 @@ LRCoulombSingleton::LRHandlerType* LRCoulombSingleton::getHandler(ParticleSet& r
       app_log() << "\n   Creating CoulombHandler using quasi-2D Ewald method for the slab. " << std::endl;
       CoulombHandler = new EwaldHandler(ref);
     }
+    else if (this_lr_type == PPPM)
+    {
+      app_log() << "\n  Creating CoulombHandler with the particle-mesh Ewald breakup. " << std::endl;
+      CoulombHandler = new PPPMHandler(ref, pppm_order, pppm_mesh_factor);
+    }
+    else if (this_lr_type == EWALD)
+    {
+      app_log() << "\n  Creating CoulombHandler with the Ewald3D breakup. " << std::endl;
+      CoulombHandler = new EwaldHandler3D(ref);
+    }
     else //if(ref.LRBox.SuperCellEnum == SUPERCELL_BULK)
     {
       app_log() << "\n  Creating CoulombHandler with the optimal breakup. " << std::endl;
       CoulombHandler = new LRHandlerTemp<CoulombFunctor<mRealType>, LPQHIBasis>(ref);
-      //  app_log() << "\n  Creating CoulombHandler with the Ewald3D breakup. " << std::endl;
-      //  CoulombHandler= new EwaldHandler3D(ref);
       //  CoulombHandler = new LRHandlerSRCoulomb<CoulombFunctor<mRealType>, LPQHISRCoulombBasis>(ref);
     }
 //        else if(ref.LRBox.SuperCellEnum == SUPERCELL_SLAB)
@@ -37,6 +37,20 @@ struct LRCoulombSingleton
   typedef LinearGrid<pRealType> GridType;
   typedef OneDimCubicSpline<pRealType> RadFunctorType;
 
+  ///type of the long-range handler of the bulk systems
+  enum lrbreakup_type
+  {
+    ESLER = 0,
+    EWALD,
+    PPPM
+  };
+
+  ///long-range handler selected by LR_handler of the lattice
+  static lrbreakup_type this_lr_type;
+  ///order of the charge assignment of the PPPM handler
+  static int pppm_order;
+  ///ratio of the PPPM mesh cutoff to LR_kc
+  static mRealType pppm_mesh_factor;
   ///Stores the energ optimized LR handler.
   static LRHandlerType* CoulombHandler;
   ///Stores the force/stress optimized LR handler.
@@ -0,0 +1,343 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "LongRange/PPPMHandler.h"
+#include "Message/Communicate.h"
+#if defined(HAVE_LIBFFTW)
+#include <fftw3.h>
+#endif
+
+namespace qmcplusplus
+{
+/** influence function, real space kernel and FFT plans of a mesh
+ *
+ * Built once by initBreakup and shared by the clones. The plans are only executed
+ * through fftw_execute_dft which is thread safe.
+ */
+struct PPPMHandler::MeshKernel
+{
+  using mRealType    = PPPMHandler::mRealType;
+  using mComplexType = PPPMHandler::mComplexType;
+  ///\f$G({\bf m})=F_k\prod_d|b_d(m_d)|^2\f$
+  std::vector<mRealType> G;
+  ///\f$\theta({\bf x})=\sum_{\bf m}G({\bf m})e^{2\pi i{\bf m}\cdot{\bf x}/N}\f$
+  std::vector<mRealType> Theta;
+#if defined(HAVE_LIBFFTW)
+  fftw_plan forward;
+  fftw_plan backward;
+
+  MeshKernel(const MeshIndexType& dims)
+  {
+    std::vector<mComplexType> work(dims[0] * dims[1] * dims[2]);
+    fftw_complex* p = reinterpret_cast<fftw_complex*>(work.data());
+    forward  = fftw_plan_dft_3d(dims[0], dims[1], dims[2], p, p, FFTW_FORWARD, FFTW_ESTIMATE | FFTW_UNALIGNED);
+    backward = fftw_plan_dft_3d(dims[0], dims[1], dims[2], p, p, FFTW_BACKWARD, FFTW_ESTIMATE | FFTW_UNALIGNED);
+  }
+
+  ~MeshKernel()
+  {
+    fftw_destroy_plan(forward);
+    fftw_destroy_plan(backward);
+  }
+
+  inline void execute(fftw_plan plan, std::vector<mComplexType>& work) const
+  {
+    fftw_complex* p = reinterpret_cast<fftw_complex*>(work.data());
+    fftw_execute_dft(plan, p, p);
+  }
+#endif
+};
+
+PPPMHandler::PPPMHandler(ParticleSet& ref, int order, mRealType mesh_factor, mRealType kc_in)
+    : EwaldHandler3D(ref, kc_in), Order(order), MeshFactor(mesh_factor), MeshDims(0), PotentialValid(false)
+{
+  LRHandlerBase::ClassName = "PPPMHandler";
+  if (Order < 2 || Order > MaxOrder)
+    APP_ABORT("PPPMHandler::PPPMHandler LR_mesh_order should be between 2 and 8.");
+  if (MeshFactor < 1.0)
+  {
+    app_warning() << "  PPPMHandler LR_mesh_factor " << MeshFactor << " is too small. Reset to 1." << std::endl;
+    MeshFactor = 1.0;
+  }
+}
+
+PPPMHandler::PPPMHandler(const PPPMHandler& aLR, ParticleSet& ref)
+    : EwaldHandler3D(aLR, ref),
+      Order(aLR.Order),
+      MeshFactor(aLR.MeshFactor),
+      MeshDims(aLR.MeshDims),
+      Kernel(aLR.Kernel),
+      MeshBox(aLR.MeshBox),
+      PotentialValid(false)
+{
+  const int n = getMeshSize();
+  Charge.resize(n, 0.0);
+  Potential.resize(n, 0.0);
+  MeshWork.resize(n);
+}
+
+void PPPMHandler::initBreakup(ParticleSet& ref)
+{
+#if defined(HAVE_LIBFFTW)
+  EwaldHandler3D::initBreakup(ref);
+  MeshBox = ref.LRBox;
+  // the mesh holds every k-vector within LR_kc without touching the Nyquist frequency
+  for (int d = 0; d < OHMMS_DIM; ++d)
+  {
+    const int mmax =
+        static_cast<int>(std::floor(MeshFactor * LR_kc * std::sqrt(dot(MeshBox.a(d), MeshBox.a(d))) / (2 * M_PI))) + 1;
+    MeshDims[d] = std::max(2 * mmax, 2 * Order);
+  }
+  const int n = getMeshSize();
+  Charge.assign(n, 0.0);
+  Potential.assign(n, 0.0);
+  MeshWork.resize(n);
+  PotentialValid = false;
+
+  // M_p at the integers for the B-spline structure factors
+  std::vector<mRealType> mp(Order + 1, 0.0);
+  {
+    MeshWeights mw;
+    computeWeights(PosType(0.0), mw);
+    for (int j = 0; j < Order; ++j)
+      mp[j] = mw.w[0][j];
+  }
+  std::vector<mRealType> bsq[OHMMS_DIM];
+  for (int d = 0; d < OHMMS_DIM; ++d)
+  {
+    bsq[d].resize(MeshDims[d]);
+    for (int m = 0; m < MeshDims[d]; ++m)
+    {
+      mComplexType den(0.0);
+      for (int k = 0; k < Order - 1; ++k)
+      {
+        const mRealType phase = 2 * M_PI * m * k / MeshDims[d];
+        den += mp[k + 1] * mComplexType(std::cos(phase), std::sin(phase));
+      }
+      const mRealType densq = std::norm(den);
+      bsq[d][m]             = (densq < 1e-7) ? 0.0 : 1.0 / densq;
+    }
+  }
+
+  auto kernel = std::make_shared<MeshKernel>(MeshDims);
+  kernel->G.resize(n);
+  kernel->Theta.resize(n);
+  const mRealType kgauss = 1.0 / (4 * Sigma * Sigma);
+  const mRealType knorm  = 4 * M_PI / Volume;
+  const mRealType kcsq   = LR_kc * LR_kc;
+  int nk                 = 0;
+  for (int i = 0; i < MeshDims[0]; ++i)
+    for (int j = 0; j < MeshDims[1]; ++j)
+      for (int k = 0; k < MeshDims[2]; ++k)
+      {
+        const int idx = meshIndex(i, j, k);
+        PosType m(i > MeshDims[0] / 2 ? i - MeshDims[0] : i, j > MeshDims[1] / 2 ? j - MeshDims[1] : j,
+                  k > MeshDims[2] / 2 ? k - MeshDims[2] : k);
+        const PosType kvec  = MeshBox.k_cart(m);
+        const mRealType ksq = dot(kvec, kvec);
+        kernel->G[idx]      = 0.0;
+        if (ksq > 0.0 && ksq <= kcsq)
+        {
+          kernel->G[idx] = knorm * std::exp(-ksq * kgauss) / ksq * bsq[0][i] * bsq[1][j] * bsq[2][k];
+          nk++;
+        }
+        MeshWork[idx] = kernel->G[idx];
+      }
+  kernel->execute(kernel->backward, MeshWork);
+  for (int idx = 0; idx < n; ++idx)
+    kernel->Theta[idx] = MeshWork[idx].real();
+  Kernel = kernel;
+
+  app_log() << "  PPPMHandler mesh " << MeshDims << " order " << Order << " with " << nk << " k-vectors" << std::endl;
+#else
+  APP_ABORT("PPPMHandler::initBreakup requires FFTW.");
+#endif
+}
+
+void PPPMHandler::computeWeights(const PosType& r, MeshWeights& mw) const
+{
+  PosType u = MeshBox.toUnit(r);
+  for (int d = 0; d < OHMMS_DIM; ++d)
+  {
+    const mRealType x  = (u[d] - std::floor(u[d])) * MeshDims[d];
+    const mRealType fl = std::floor(x);
+    const mRealType f  = x - fl;
+    mw.base[d]         = static_cast<int>(fl);
+    // w[j] = M_p(f+j) on the mesh point base-j
+    mRealType* restrict c = mw.w[d];
+    c[0]                  = f;
+    c[1]                  = 1.0 - f;
+    for (int n = 3; n <= Order; ++n)
+    {
+      const mRealType div = 1.0 / (n - 1);
+      c[n - 1]            = (1.0 - f) * c[n - 2] * div;
+      for (int j = n - 2; j > 0; --j)
+        c[j] = ((f + j) * c[j] + (n - f - j) * c[j - 1]) * div;
+      c[0] = f * c[0] * div;
+    }
+  }
+}
+
+void PPPMHandler::addCharge(pRealType q, const PosType& r)
+{
+  MeshWeights mw;
+  computeWeights(r, mw);
+  for (int a = 0; a < Order; ++a)
+  {
+    const int i        = wrap(mw.base[0] - a, MeshDims[0]);
+    const mRealType wa = q * mw.w[0][a];
+    for (int b = 0; b < Order; ++b)
+    {
+      const int j        = wrap(mw.base[1] - b, MeshDims[1]);
+      const mRealType wb = wa * mw.w[1][b];
+      for (int c = 0; c < Order; ++c)
+        Charge[meshIndex(i, j, wrap(mw.base[2] - c, MeshDims[2]))] += wb * mw.w[2][c];
+    }
+  }
+}
+
+void PPPMHandler::assignCharges(const ParticleSet& P, const std::vector<pRealType>& Z)
+{
+  std::fill(Charge.begin(), Charge.end(), 0.0);
+  for (int iat = 0; iat < P.getTotalNum(); ++iat)
+    addCharge(Z[iat], P.R[iat]);
+  PotentialValid = false;
+}
+
+void PPPMHandler::solvePotential()
+{
+#if defined(HAVE_LIBFFTW)
+  const int n = getMeshSize();
+  for (int idx = 0; idx < n; ++idx)
+    MeshWork[idx] = Charge[idx];
+  Kernel->execute(Kernel->forward, MeshWork);
+  const mRealType* restrict g = Kernel->G.data();
+  for (int idx = 0; idx < n; ++idx)
+    MeshWork[idx] *= g[idx];
+  Kernel->execute(Kernel->backward, MeshWork);
+  for (int idx = 0; idx < n; ++idx)
+    Potential[idx] = MeshWork[idx].real();
+  PotentialValid = true;
+#else
+  APP_ABORT("PPPMHandler::solvePotential requires FFTW.");
+#endif
+}
+
+PPPMHandler::mRealType PPPMHandler::evaluatePotential(pRealType q, const PosType& r)
+{
+  if (!PotentialValid)
+    solvePotential();
+  MeshWeights mw;
+  computeWeights(r, mw);
+  mRealType res = 0.0;
+  for (int a = 0; a < Order; ++a)
+  {
+    const int i = wrap(mw.base[0] - a, MeshDims[0]);
+    for (int b = 0; b < Order; ++b)
+    {
+      const int j  = wrap(mw.base[1] - b, MeshDims[1]);
+      mRealType vc = 0.0;
+      for (int c = 0; c < Order; ++c)
+        vc += mw.w[2][c] * Potential[meshIndex(i, j, wrap(mw.base[2] - c, MeshDims[2]))];
+      res += mw.w[0][a] * mw.w[1][b] * vc;
+    }
+  }
+  return q * res;
+}
+
+PPPMHandler::mRealType PPPMHandler::evaluateMesh(const ParticleSet& P, const std::vector<pRealType>& Z)
+{
+  assignCharges(P, Z);
+  solvePotential();
+  mRealType res = 0.0;
+  for (int idx = 0; idx < Charge.size(); ++idx)
+    res += Charge[idx] * Potential[idx];
+  return 0.5 * res;
+}
+
+PPPMHandler::mRealType PPPMHandler::evaluateMesh(const ParticleSet& A,
+                                                 const std::vector<pRealType>& ZA,
+                                                 const ParticleSet& B,
+                                                 const std::vector<pRealType>& ZB)
+{
+  assignCharges(A, ZA);
+  solvePotential();
+  mRealType res = 0.0;
+  for (int jat = 0; jat < B.getTotalNum(); ++jat)
+    res += evaluatePotential(ZB[jat], B.R[jat]);
+  return res;
+}
+
+void PPPMHandler::chargeChange(pRealType q,
+                               const PosType& rold,
+                               const PosType& rnew,
+                               std::vector<MeshIndexType>& pts,
+                               std::vector<mRealType>& dq) const
+{
+  const int np = Order * Order * Order;
+  MeshWeights mw[2];
+  computeWeights(rold, mw[0]);
+  computeWeights(rnew, mw[1]);
+  pts.resize(2 * np);
+  dq.resize(2 * np);
+  for (int s = 0, p = 0; s < 2; ++s)
+  {
+    const mRealType qs = (s == 0) ? -q : q;
+    for (int a = 0; a < Order; ++a)
+      for (int b = 0; b < Order; ++b)
+        for (int c = 0; c < Order; ++c, ++p)
+        {
+          pts[p] = MeshIndexType(wrap(mw[s].base[0] - a, MeshDims[0]), wrap(mw[s].base[1] - b, MeshDims[1]),
+                                 wrap(mw[s].base[2] - c, MeshDims[2]));
+          dq[p]  = qs * mw[s].w[0][a] * mw[s].w[1][b] * mw[s].w[2][c];
+        }
+  }
+}
+
+PPPMHandler::mRealType PPPMHandler::evaluateMove(pRealType q, const PosType& rold, const PosType& rnew)
+{
+  if (!PotentialValid)
+    solvePotential();
+  std::vector<MeshIndexType> pts;
+  std::vector<mRealType> dq;
+  chargeChange(q, rold, rnew, pts, dq);
+
+  const mRealType* restrict theta = Kernel->Theta.data();
+  mRealType dphi = 0.0, dself = 0.0;
+  for (int p = 0; p < pts.size(); ++p)
+  {
+    const MeshIndexType& x = pts[p];
+    dphi += dq[p] * Potential[meshIndex(x[0], x[1], x[2])];
+    mRealType v = 0.0;
+    for (int p2 = 0; p2 < pts.size(); ++p2)
+    {
+      const MeshIndexType& y = pts[p2];
+      v += dq[p2] *
+          theta[meshIndex(wrap(x[0] - y[0], MeshDims[0]), wrap(x[1] - y[1], MeshDims[1]),
+                          wrap(x[2] - y[2], MeshDims[2]))];
+    }
+    dself += dq[p] * v;
+  }
+  return dphi + 0.5 * dself;
+}
+
+void PPPMHandler::acceptMove(pRealType q, const PosType& rold, const PosType& rnew)
+{
+  std::vector<MeshIndexType> pts;
+  std::vector<mRealType> dq;
+  chargeChange(q, rold, rnew, pts, dq);
+  for (int p = 0; p < pts.size(); ++p)
+    Charge[meshIndex(pts[p][0], pts[p][1], pts[p][2])] += dq[p];
+  PotentialValid = false;
+}
+
+} // namespace qmcplusplus
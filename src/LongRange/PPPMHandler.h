@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file PPPMHandler.h
+ * @brief Define a LRHandler evaluating the long-range part on a mesh
+ */
+#ifndef QMCPLUSPLUS_PPPM_HANDLER_H
+#define QMCPLUSPLUS_PPPM_HANDLER_H
+
+#include <memory>
+#include "LongRange/EwaldHandler3D.h"
+
+namespace qmcplusplus
+{
+/* Particle-particle particle-mesh handler for the Ewald breakup in 3D
+ *
+ * The short-range part and the k-space components are the ones of EwaldHandler3D.
+ * The long-range energy is evaluated with the smooth particle-mesh Ewald method:
+ * the charges are assigned on a mesh with the cardinal B-splines of order Order,
+ * the mesh potential is solved by FFT with the Ewald kernel divided by the B-spline
+ * structure factors and the energy is summed on the mesh.
+ * The cost scales with the mesh size instead of the number of k-vectors times the number of particles
+ * and a particle move only changes 2*Order^3 mesh charges.
+ *
+ * The accuracy is set by LR_dim_cutoff as for EwaldHandler3D, by Order and by MeshFactor.
+ *
+ * evaluateMesh keeps the mesh charges and potential in the handler: each operator evaluates
+ * on its own clone and the handler of LRCoulombSingleton is only read.
+ * The single particle move API, evaluateMove and acceptMove, is not called by any driver.
+ */
+class PPPMHandler : public EwaldHandler3D
+{
+public:
+  using MeshIndexType = TinyVector<int, OHMMS_DIM>;
+  /// maximum order of the B-spline charge assignment
+  static constexpr int MaxOrder = 8;
+
+  /// order of the B-spline charge assignment, 4 is cubic
+  int Order;
+  /// the mesh resolves the k-vectors up to MeshFactor*LR_kc
+  mRealType MeshFactor;
+  /// number of mesh points along each lattice vector
+  MeshIndexType MeshDims;
+
+  /// Constructor
+  PPPMHandler(ParticleSet& ref, int order = 4, mRealType mesh_factor = 2.0, mRealType kc_in = -1.0);
+
+  /** "copy" constructor
+   * @param aLR PPPMHandler
+   * @param ref Particleset
+   *
+   * The influence function and the FFT plans are shared, the mesh charges and potential are not copied.
+   */
+  PPPMHandler(const PPPMHandler& aLR, ParticleSet& ref);
+
+  PPPMHandler* makeClone(ParticleSet& ref) { return new PPPMHandler(*this, ref); }
+
+  void initBreakup(ParticleSet& ref);
+
+  void Breakup(ParticleSet& ref, mRealType rs_in) { initBreakup(ref); }
+
+  /** evaluate the long-range energy of a particle set on the mesh
+   * @param P particle set
+   * @param Z charge of each particle
+   * @return \f$\frac{1}{2}\sum_{\bf k} F_{k}|\rho_{\bf k}|^2\f$
+   *
+   * The charges of P and their mesh potential are kept for evaluateMove and acceptMove.
+   */
+  mRealType evaluateMesh(const ParticleSet& P, const std::vector<pRealType>& Z);
+
+  /** evaluate the long-range interaction of two particle sets on the mesh
+   * @param A source particle set
+   * @param ZA charge of each particle of A
+   * @param B target particle set
+   * @param ZB charge of each particle of B
+   * @return \f$\sum_{\bf k} F_{k}\rho^A_{\bf k}\rho^B_{-\bf k}\f$
+   *
+   * The charges of A and their mesh potential are kept.
+   */
+  mRealType evaluateMesh(const ParticleSet& A,
+                         const std::vector<pRealType>& ZA,
+                         const ParticleSet& B,
+                         const std::vector<pRealType>& ZB);
+
+  /** change of the energy of the mesh charges for a single particle move
+   * @param q charge of the particle
+   * @param rold current position
+   * @param rnew proposed position
+   *
+   * Exact with respect to evaluateMesh at O(Order^6) cost,
+   * the mesh potential is solved first if it is not up to date.
+   */
+  mRealType evaluateMove(pRealType q, const PosType& rold, const PosType& rnew);
+
+  /** update the mesh charges for an accepted single particle move
+   *
+   * Only the 2*Order^3 changed charges are updated. The mesh potential is solved again by FFT
+   * when the next move is evaluated.
+   */
+  void acceptMove(pRealType q, const PosType& rold, const PosType& rnew);
+
+  /// interaction of a charge at r with the mesh potential
+  mRealType evaluatePotential(pRealType q, const PosType& r);
+
+  /// number of mesh points
+  int getMeshSize() const { return MeshDims[0] * MeshDims[1] * MeshDims[2]; }
+
+private:
+  /// influence function, real space kernel and FFT plans shared by the clones
+  struct MeshKernel;
+  std::shared_ptr<const MeshKernel> Kernel;
+  ///lattice of the mesh
+  ParticleSet::ParticleLayout_t MeshBox;
+  ///charges assigned on the mesh
+  std::vector<mRealType> Charge;
+  ///potential of the mesh charges
+  std::vector<mRealType> Potential;
+  ///FFT work space
+  std::vector<mComplexType> MeshWork;
+  ///true if Potential is the one of Charge
+  bool PotentialValid;
+
+  /// B-spline weights and mesh points of a particle at r
+  struct MeshWeights
+  {
+    MeshIndexType base;
+    mRealType w[OHMMS_DIM][MaxOrder];
+  };
+
+  void computeWeights(const PosType& r, MeshWeights& mw) const;
+  /// mesh points and charges changed by moving a charge q from rold to rnew
+  void chargeChange(pRealType q,
+                    const PosType& rold,
+                    const PosType& rnew,
+                    std::vector<MeshIndexType>& pts,
+                    std::vector<mRealType>& dq) const;
+  /// add q times the B-spline weights of a particle at r to the mesh charges
+  void addCharge(pRealType q, const PosType& r);
+  /// assign the charges of P on the mesh from scratch
+  void assignCharges(const ParticleSet& P, const std::vector<pRealType>& Z);
+  /// solve the potential of the mesh charges by FFT
+  void solvePotential();
+  inline int meshIndex(int i, int j, int k) const { return (i * MeshDims[1] + j) * MeshDims[2] + k; }
+  inline int wrap(int i, int n) const { return ((i % n) + n) % n; }
+};
+} // namespace qmcplusplus
+#endif
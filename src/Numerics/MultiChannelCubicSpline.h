@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file MultiChannelCubicSpline.h
+ * @brief cubic splines of several functions on a common linear grid
+ */
+#ifndef QMCPLUSPLUS_MULTICHANNEL_CUBIC_SPLINE_H
+#define QMCPLUSPLUS_MULTICHANNEL_CUBIC_SPLINE_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "Numerics/OneDimGridBase.h"
+#include "simd/allocator.hpp"
+
+namespace qmcplusplus
+{
+/** cubic splines of several channels sharing a linear grid
+ *
+ * The cubic spline of each channel is stored as the polynomial
+ * \f$a_0+a_1 s+a_2 s^2+a_3 s^3\f$ of \f$s=(r-r_i)/\Delta\f$ on every interval \f$[r_i,r_{i+1})\f$.
+ * The coefficients are interleaved as Coefs[(4*i+k)*NumChannels+c] so that
+ * all the channels at r are evaluated from a single contiguous block.
+ * A channel can accumulate several scaled splines, the unset channels are zero.
+ * The value of a channel at \f$r\ge r_{max}\f$ is the constant of its splines.
+ */
+template<typename T>
+class MultiChannelCubicSpline
+{
+public:
+  MultiChannelCubicSpline() : NumChannels(0), NumIntervals(0), Lower(0), Upper(0), Delta(0), DeltaInv(0) {}
+
+  /** allocate zero channels on a grid
+   * @param nch number of channels
+   * @param grid radial grid
+   * @return false if grid is not a linear grid
+   */
+  template<typename GT>
+  bool resize(int nch, const GT& grid)
+  {
+    NumChannels  = 0;
+    NumIntervals = 0;
+    Coefs.clear();
+    Tail.clear();
+    if (grid.getGridTag() != LINEAR_1DGRID || grid.size() < 2)
+      return false;
+    NumChannels  = nch;
+    NumIntervals = grid.size() - 1;
+    Lower        = grid.r(0);
+    Upper        = grid.r(NumIntervals);
+    Delta        = grid.dr(0);
+    DeltaInv     = 1.0 / Delta;
+    Coefs.resize(4 * NumIntervals * NumChannels, T(0));
+    Tail.resize(NumChannels, T(0));
+    return true;
+  }
+
+  /** add scale times a cubic spline to a channel
+   * @param ich channel index
+   * @param f OneDimCubicSpline on the grid of resize
+   * @param scale factor
+   * @return false if f is not defined on the same grid, the table is unchanged
+   */
+  template<typename SPL>
+  bool add(int ich, const SPL& f, T scale)
+  {
+    const auto& grid = f.grid();
+    if (grid.getGridTag() != LINEAR_1DGRID || grid.size() != NumIntervals + 1 || f.r_min != grid.r(0) ||
+        f.r_max != grid.r(NumIntervals) || std::abs(grid.r(0) - Lower) > 1e-10 * Delta ||
+        std::abs(grid.dr(0) - Delta) > 1e-10 * Delta)
+      return false;
+    const T h2 = Delta * Delta;
+    for (int i = 0; i < NumIntervals; ++i)
+    {
+      const T y1    = f.m_Y[i];
+      const T y2    = f.m_Y[i + 1];
+      const T d21   = f.m_Y2[i];
+      const T d22   = f.m_Y2[i + 1];
+      T* restrict a = Coefs.data() + 4 * i * NumChannels + ich;
+      a[0] += scale * y1;
+      a[NumChannels] += scale * (y2 - y1 - h2 * (2 * d21 + d22) / 6);
+      a[2 * NumChannels] += scale * h2 * d21 / 2;
+      a[3 * NumChannels] += scale * h2 * (d22 - d21) / 6;
+    }
+    Tail[ich] += scale * f.ConstValue;
+    return true;
+  }
+
+  inline int size() const { return NumChannels; }
+  inline bool empty() const { return NumChannels == 0; }
+
+  /// evaluate all the channels at \f$r\ge r_0\f$
+  inline void evaluate(T r, T* restrict v) const
+  {
+    if (r >= Upper)
+    {
+      std::copy(Tail.begin(), Tail.end(), v);
+      return;
+    }
+    int i;
+    const T s           = locate(r, i);
+    const T* restrict a = Coefs.data() + 4 * i * NumChannels;
+    const int nc        = NumChannels;
+    for (int c = 0; c < nc; ++c)
+      v[c] = a[c] + s * (a[nc + c] + s * (a[2 * nc + c] + s * a[3 * nc + c]));
+  }
+
+  /// evaluate all the channels and their first derivatives at \f$r\ge r_0\f$
+  inline void evaluate(T r, T* restrict v, T* restrict dv) const
+  {
+    if (r >= Upper)
+    {
+      std::copy(Tail.begin(), Tail.end(), v);
+      std::fill(dv, dv + NumChannels, T(0));
+      return;
+    }
+    int i;
+    const T s           = locate(r, i);
+    const T* restrict a = Coefs.data() + 4 * i * NumChannels;
+    const int nc        = NumChannels;
+    for (int c = 0; c < nc; ++c)
+    {
+      v[c]  = a[c] + s * (a[nc + c] + s * (a[2 * nc + c] + s * a[3 * nc + c]));
+      dv[c] = DeltaInv * (a[nc + c] + s * (2 * a[2 * nc + c] + 3 * s * a[3 * nc + c]));
+    }
+  }
+
+private:
+  int NumChannels;
+  int NumIntervals;
+  T Lower;
+  T Upper;
+  T Delta;
+  T DeltaInv;
+  ///interleaved polynomial coefficients
+  aligned_vector<T> Coefs;
+  ///values beyond the grid
+  std::vector<T> Tail;
+
+  /// return the fractional position in the interval i containing r
+  inline T locate(T r, int& i) const
+  {
+    const T x = (r - Lower) * DeltaInv;
+    i         = std::min(std::max(static_cast<int>(x), 0), NumIntervals - 1);
+    return x - i;
+  }
+};
+} // namespace qmcplusplus
+#endif
@@ -12,6 +12,7 @@
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 #include "Numerics/OneDimCubicSpline.h"
+#include "Numerics/MultiChannelCubicSpline.h"
 
 #include <stdio.h>
 #include <string>
@@ -175,4 +176,63 @@ TEST_CASE("one_dim_cubic_spline_1", "[numerics]")
   REQUIRE(check_yvals_d2u[5].d2u == Approx(10.25));
 }
 
+TEST_CASE("multi_channel_cubic_spline", "[numerics]")
+{
+  const int n = 11;
+  LinearGrid<double> grid;
+  grid.set(0.0, 2.0, n);
+
+  std::vector<double> y0(n), y1(n);
+  for (int i = 0; i < n; i++)
+  {
+    double r = grid.r(i);
+    y0[i]    = std::exp(-r * r);
+    y1[i]    = r * std::exp(-r);
+  }
+  OneDimCubicSpline<double> f0(&grid, y0);
+  OneDimCubicSpline<double> f1(&grid, y1);
+  f0.spline(0, 0.0, n - 1, 0.0);
+  f1.spline(0, 1.0, n - 1, 0.0);
+
+  // channel 1 is left zero, channel 2 is f1 added twice
+  MultiChannelCubicSpline<double> table;
+  REQUIRE(table.resize(3, grid));
+  REQUIRE(table.add(0, f0, 3.0));
+  REQUIRE(table.add(2, f1, 1.0));
+  REQUIRE(table.add(2, f1, 4.0));
+  REQUIRE(table.size() == 3);
+
+  // splines on another grid are rejected
+  LinearGrid<double> grid2;
+  grid2.set(0.0, 2.0, n + 1);
+  std::vector<double> y2(n + 1, 1.0);
+  OneDimCubicSpline<double> f2(&grid2, y2);
+  f2.spline();
+  REQUIRE_FALSE(table.add(1, f2, 1.0));
+
+  std::vector<double> check_xvals = {0.0, 0.13, 0.5, 0.77, 1.2, 1.99, 2.0, 2.5};
+  for (int i = 0; i < check_xvals.size(); i++)
+  {
+    double r = check_xvals[i];
+    double v[3], dv[3];
+    table.evaluate(r, v);
+    REQUIRE(v[0] == Approx(3.0 * f0.splint(r)));
+    REQUIRE(v[1] == Approx(0.0));
+    REQUIRE(v[2] == Approx(5.0 * f1.splint(r)));
+
+    double du0 = 0.0, du1 = 0.0, d2u;
+    if (r < 2.0)
+    {
+      f0.splint(r, du0, d2u);
+      f1.splint(r, du1, d2u);
+    }
+    table.evaluate(r, v, dv);
+    REQUIRE(v[0] == Approx(3.0 * f0.splint(r)));
+    REQUIRE(v[2] == Approx(5.0 * f1.splint(r)));
+    REQUIRE(dv[0] == Approx(3.0 * du0).margin(1e-12));
+    REQUIRE(dv[1] == Approx(0.0));
+    REQUIRE(dv[2] == Approx(5.0 * du1).margin(1e-12));
+  }
+}
+
 } // namespace qmcplusplus
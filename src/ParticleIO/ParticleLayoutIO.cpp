@@ -23,6 +23,7 @@
 #include "ParticleIO/ParticleLayoutIO.h"
 #include "OhmmsData/AttributeSet.h"
 #include "QMCWaveFunctions/ElectronGas/HEGGrid.h"
+#include "LongRange/LRCoulombSingleton.h"
 
 namespace qmcplusplus
 {
@@ -104,6 +105,29 @@ bool LatticeParser::put(xmlNodePtr cur)
       {
         putContent(ref_.LR_dim_cutoff, cur);
       }
+      else if (aname == "LR_handler")
+      {
+        std::string handler_type("opt_breakup");
+        putContent(handler_type, cur);
+        tolower(handler_type);
+        if (handler_type == "opt_breakup")
+          LRCoulombSingleton::this_lr_type = LRCoulombSingleton::ESLER;
+        else if (handler_type == "ewald")
+          LRCoulombSingleton::this_lr_type = LRCoulombSingleton::EWALD;
+        else if (handler_type == "pppm")
+          LRCoulombSingleton::this_lr_type = LRCoulombSingleton::PPPM;
+        else
+          APP_ABORT("LatticeParser::put. Long range breakup handler not recognized: " + handler_type +
+                    ". Allowed values are opt_breakup, ewald and pppm.");
+      }
+      else if (aname == "LR_mesh_order")
+      {
+        putContent(LRCoulombSingleton::pppm_order, cur);
+      }
+      else if (aname == "LR_mesh_factor")
+      {
+        putContent(LRCoulombSingleton::pppm_mesh_factor, cur);
+      }
       else if (aname == "rs")
       {
         lattice_defined = true;
@@ -34,6 +34,8 @@
 #include "QMCDrivers/DMC/DMCFactory.h"
 #include "QMCDrivers/DMC/DMCFactoryNew.h"
 #include "QMCDrivers/RMC/RMCFactory.h"
+#include "QMCDrivers/RMC/RMCFactoryNew.h"
+#include "QMCDrivers/CorrelatedSampling/CSVMCFactoryNew.h"
 #include "QMCDrivers/QMCOptimize.h"
 #include "QMCDrivers/QMCFixedSampleLinearOptimize.h"
 #include "QMCDrivers/QMCCorrelatedSamplingLinearOptimize.h"
@@ -114,10 +116,19 @@ QMCDriverFactory::DriverAssemblyState QMCDriverFactory::readSection(int curSerie
     //         das.new_run_type=RMC_PBYP_RUN;
     //       }
     //       else
-    if (qmc_mode.find("rmc") < nchars)
+    if (qmc_mode.find("rmc_batch") < nchars) // order matters here
+    {
+      das.new_run_type = QMCRunType::RMC_BATCH;
+    }
+    else if (qmc_mode.find("rmc") < nchars)
     {
       das.new_run_type = QMCRunType::RMC;
     }
+    else if (qmc_mode.find("csvmc_batch") < nchars) // order matters here
+    {
+      das.new_run_type              = QMCRunType::CSVMC_BATCH;
+      das.what_to_do[MULTIPLE_MODE] = 1;
+    }
     else if (qmc_mode.find("vmc_batch") < nchars) // order matters here
     {
       das.new_run_type = QMCRunType::VMC_BATCH;
@@ -290,6 +301,16 @@ std::unique_ptr<QMCDriverInterface> QMCDriverFactory::createQMCDriver(xmlNodePtr
     new_driver.reset(
         fac.create(qmc_system, *primaryPsi, *primaryH, particle_pool, hamiltonian_pool, wavefunction_pool, comm));
   }
+  else if (das.new_run_type == QMCRunType::RMC_BATCH)
+  {
+    RMCFactoryNew fac(cur, das.what_to_do[UPDATE_MODE], qmc_common.qmc_counter);
+    new_driver.reset(fac.create(population, *primaryPsi, *primaryH, wavefunction_pool, comm));
+  }
+  else if (das.new_run_type == QMCRunType::CSVMC_BATCH)
+  {
+    CSVMCFactoryNew fac(cur, das.what_to_do[UPDATE_MODE], qmc_common.qmc_counter);
+    new_driver.reset(fac.create(population, *primaryPsi, *primaryH, wavefunction_pool, comm));
+  }
   else if (das.new_run_type == QMCRunType::OPTIMIZE)
   {
     QMCOptimize* opt = new QMCOptimize(qmc_system, *primaryPsi, *primaryH, hamiltonian_pool, wavefunction_pool, comm);
@@ -27,6 +27,7 @@
 #include "Platforms/devices.h"
 #include "OhmmsApp/ProjectData.h"
 #include "QMCApp/QMCMain.h"
+#include "QMCWaveFunctions/BsplineFactory/DistributedSplineWindows.h"
 #include "qmc_common.h"
 
 void output_hardware_info(Communicate* comm, Libxml2Document& doc, xmlNodePtr root);
@@ -237,6 +238,8 @@ int main(int argc, char** argv)
   }
   TimerManager.print(qmcComm);
 
+  // collective, before the distributed spline tables are destroyed with qmc
+  qmcplusplus::DistributedSplineWindows::release_all();
   if (qmc)
     delete qmc;
   if (useGPU)
@@ -10,6 +10,7 @@
 //////////////////////////////////////////////////////////////////////////////////////
 
 #include <type_traits>
+#include <limits>
 #include "QMCDrivers/ContextForSteps.h"
 #include "QMCDrivers/MCPopulation.h"
 
@@ -19,7 +20,7 @@ ContextForSteps::ContextForSteps(int num_walkers,
                          int num_particles,
                          std::vector<std::pair<int, int>> particle_group_indexes,
                          RandomGenerator_t& random_gen)
-    : particle_group_indexes_(particle_group_indexes), random_gen_(random_gen)
+    : num_particles_(num_particles), particle_group_indexes_(particle_group_indexes), random_gen_(random_gen)
 {
   /** glambda to create type T with constructor T(int) and put in it unique_ptr
    *
@@ -33,4 +34,15 @@ ContextForSteps::ContextForSteps(int num_walkers,
   walker_deltas_.resize(num_walkers * num_particles);
 }
 
+void ContextForSteps::seedWalkerRandomGens(int num_walkers)
+{
+  walker_random_gens_.resize(num_walkers, random_gen_);
+#ifndef USE_FAKE_RNG
+  // positive seeds, init falls back to a time based seed otherwise
+  for (int iw = 0; iw < num_walkers; ++iw)
+    walker_random_gens_[iw].init(iw, num_walkers,
+                                 1 + static_cast<int>(random_gen_() * (std::numeric_limits<int>::max() - 1)));
+#endif
+}
+
 } // namespace qmcplusplus
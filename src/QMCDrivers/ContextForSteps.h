@@ -50,10 +50,22 @@ public:
   int get_num_groups() const { return particle_group_indexes_.size(); }
   RandomGenerator_t& get_random_gen() { return random_gen_; }
 
-  void nextDeltaRs() {
+  /** generate the deltas of one step
+   * @param num_walkers walkers in the crowd, it can change between steps
+   */
+  void nextDeltaRs(int num_walkers) {
+    walker_deltas_.resize(num_walkers * num_particles_);
     makeGaussRandomWithEngine(walker_deltas_, random_gen_);
   }
   
+  /** reseed the walker private generators from the crowd generator
+   *
+   *  The walker tasks of TasksPipeline can run on any thread at the same time,
+   *  they draw from these instead of the crowd generator.
+   */
+  void seedWalkerRandomGens(int num_walkers);
+  RandomGenerator_t& get_walker_random_gen(int iw) { return walker_random_gens_[iw]; }
+
   std::vector<PosType>& get_walker_deltas() { return walker_deltas_; }
   auto deltaRsBegin() { return walker_deltas_.begin(); };
   
@@ -61,6 +73,7 @@ public:
   int getPtclGroupEnd(int group) const { return particle_group_indexes_[group].second; }
 
 protected:
+  int num_particles_;
   std::vector<PosType> walker_deltas_;
    
   /** indexes of start and stop of each particle group;
@@ -70,6 +83,7 @@ protected:
   std::vector<std::pair<int,int>> particle_group_indexes_;
   
   RandomGenerator_t& random_gen_;
+  std::vector<RandomGenerator_t> walker_random_gens_;
 
 
 
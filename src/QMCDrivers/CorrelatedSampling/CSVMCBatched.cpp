@@ -0,0 +1,532 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File refactored from: CSVMC.cpp, CSUpdateBase.cpp and CSVMCUpdatePbyP.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "QMCDrivers/CorrelatedSampling/CSVMCBatched.h"
+#include "Concurrency/TasksOneToOne.hpp"
+#include "Concurrency/Info.hpp"
+#include "Utilities/Timer.h"
+#include "ParticleBase/RandomSeqGenerator.h"
+#include "Estimators/CollectablesEstimator.h"
+#include <numeric>
+
+namespace qmcplusplus
+{
+void CSVMCBatched::CorrelatedSystems::resize(int num_psi, int num_walkers)
+{
+  psis.resize(num_psi);
+  hamiltonians.resize(num_psi);
+  ratios.resize(num_psi);
+  for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+  {
+    psis[ipsi].reserve(num_walkers);
+    hamiltonians[ipsi].reserve(num_walkers);
+    ratios[ipsi].resize(num_walkers);
+  }
+  ratio_ij.resize(num_walkers, Matrix<RealType>(num_psi, num_psi));
+  sum_ratios.resize(num_walkers, std::vector<RealType>(num_psi, 1.0));
+  cum_norm.resize(num_psi, 0.0);
+  ratios_sq.resize(num_psi);
+  logpsi.resize(num_psi);
+  accepted.resize(num_walkers);
+}
+
+void CSVMCBatched::CorrelatedSystems::addWalker(const std::vector<TrialWaveFunction*>& walker_psis,
+                                                const std::vector<QMCHamiltonian*>& walker_hamiltonians)
+{
+  for (int ipsi = 0; ipsi < walker_psis.size(); ++ipsi)
+  {
+    psis[ipsi].push_back(*walker_psis[ipsi]);
+    hamiltonians[ipsi].push_back(*walker_hamiltonians[ipsi]);
+  }
+}
+
+/** Constructor maintains proper ownership of input parameters
+   */
+CSVMCBatched::CSVMCBatched(QMCDriverInput&& qmcdriver_input,
+                           VMCDriverInput&& input,
+                           MCPopulation& pop,
+                           TrialWaveFunction& psi,
+                           QMCHamiltonian& h,
+                           WaveFunctionPool& wf_pool,
+                           Communicate* comm)
+    : QMCDriverNew(std::move(qmcdriver_input), pop, psi, h, wf_pool, "CSVMCBatched::", comm), vmcdriver_input_(input)
+{
+  QMCType = "CSVMCBatched";
+  qmc_driver_mode_.set(QMC_MULTIPLE, 1);
+}
+
+QMCTraits::IndexType CSVMCBatched::calc_default_local_walkers(IndexType walkers_per_rank)
+{
+  checkNumCrowdsLTNumThreads();
+  int num_threads(Concurrency::maxThreads<>());
+  if (num_crowds_ == 0)
+    num_crowds_ = std::min(num_threads, walkers_per_rank);
+  if (walkers_per_rank < num_crowds_)
+    walkers_per_rank = num_crowds_;
+  walkers_per_crowd_ = (walkers_per_rank % num_crowds_) ? walkers_per_rank / num_crowds_ + 1
+                                                         : walkers_per_rank / num_crowds_;
+
+  IndexType local_walkers = walkers_per_crowd_ * num_crowds_;
+  population_.set_num_local_walkers(local_walkers);
+  population_.set_num_global_walkers(local_walkers * population_.get_num_ranks());
+  if (local_walkers != qmcdriver_input_.get_walkers_per_rank())
+    app_warning() << "CSVMCBatched driver has adjusted walkers per rank to: " << local_walkers << '\n';
+
+  app_log() << "CSVMCBatched walkers per crowd " << walkers_per_crowd_ << std::endl;
+  return local_walkers;
+}
+
+void CSVMCBatched::computeSumRatio(const std::vector<RealType>& logpsi,
+                                   const std::vector<RealType>& avg_norm,
+                                   Matrix<RealType>& ratio_ij,
+                                   std::vector<RealType>& sumratio)
+{
+  const int num_psi = logpsi.size();
+  for (int ipsi = 0; ipsi < num_psi; ipsi++)
+  {
+    sumratio[ipsi]       = 1.0;
+    ratio_ij(ipsi, ipsi) = 1.0;
+  }
+  for (int ipsi = 0; ipsi < num_psi - 1; ipsi++)
+    for (int jpsi = ipsi + 1; jpsi < num_psi; jpsi++)
+    {
+      ratio_ij(ipsi, jpsi) = avg_norm[ipsi] / avg_norm[jpsi] * std::exp(2.0 * (logpsi[jpsi] - logpsi[ipsi]));
+      ratio_ij(jpsi, ipsi) = 1.0 / ratio_ij(ipsi, jpsi);
+      sumratio[ipsi] += ratio_ij(ipsi, jpsi);
+      sumratio[jpsi] += ratio_ij(jpsi, ipsi);
+    }
+}
+
+void CSVMCBatched::computeSumRatio(const Matrix<RealType>& ratio_ij, std::vector<RealType>& sumratio)
+{
+  const int num_psi = sumratio.size();
+  for (int ipsi = 0; ipsi < num_psi; ipsi++)
+    sumratio[ipsi] = 1.0;
+  for (int ipsi = 0; ipsi < num_psi - 1; ipsi++)
+    for (int jpsi = ipsi + 1; jpsi < num_psi; jpsi++)
+    {
+      sumratio[ipsi] += ratio_ij(ipsi, jpsi);
+      sumratio[jpsi] += ratio_ij(jpsi, ipsi);
+    }
+}
+
+void CSVMCBatched::updateRatioMatrix(const std::vector<RealType>& ratio_i, Matrix<RealType>& ratio_ij)
+{
+  const int num_psi = ratio_i.size();
+  for (int ipsi = 0; ipsi < num_psi - 1; ipsi++)
+    for (int jpsi = ipsi + 1; jpsi < num_psi; jpsi++)
+    {
+      ratio_ij(ipsi, jpsi) *= ratio_i[jpsi] / ratio_i[ipsi];
+      ratio_ij(jpsi, ipsi) = 1.0 / ratio_ij(ipsi, jpsi);
+    }
+}
+
+void CSVMCBatched::advanceWalkers(const StateForThread& sft,
+                                  Crowd& crowd,
+                                  DriverTimers& timers,
+                                  ContextForSteps& step_context,
+                                  CorrelatedSystems& systems,
+                                  bool recompute)
+{
+  sweepWalkers(sft, crowd, timers, step_context, systems, recompute);
+  evaluateCorrelatedEnergies(sft, crowd, timers, step_context, systems);
+}
+
+void CSVMCBatched::sweepWalkers(const StateForThread& sft,
+                                Crowd& crowd,
+                                DriverTimers& timers,
+                                ContextForSteps& step_context,
+                                CorrelatedSystems& systems,
+                                bool recompute)
+{
+  const int num_psi = systems.get_num_psi();
+  timers.buffer_timer.start();
+  crowd.loadWalkers();
+  auto& walkers      = crowd.get_walkers();
+  auto& walker_elecs = crowd.get_walker_elecs();
+  auto& mcp_buffers  = crowd.get_mcp_wfbuffers();
+  for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+    for (int iw = 0; iw < crowd.size(); ++iw)
+      systems.psis[ipsi][iw].get().copyFromBuffer(walker_elecs[iw], mcp_buffers[iw]);
+  // the norms can have changed since the last step
+  for (int iw = 0; iw < crowd.size(); ++iw)
+  {
+    for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+      systems.logpsi[ipsi] = walkers[iw].get().Properties(ipsi, LOGPSI);
+    computeSumRatio(systems.logpsi, sft.avg_norm, systems.ratio_ij[iw], systems.sum_ratios[iw]);
+  }
+  timers.buffer_timer.stop();
+
+  timers.movepbyp_timer.start();
+  int num_walkers = crowd.size();
+  step_context.nextDeltaRs(num_walkers);
+  auto it_delta_r = step_context.deltaRsBegin();
+  auto& drifts    = crowd.get_drifts();
+
+  for (int ig = 0; ig < step_context.get_num_groups(); ++ig)
+  {
+    RealType tauovermass = sft.qmcdrv_input.get_tau() * sft.population.get_ptclgrp_inv_mass()[ig];
+    RealType sqrttau     = std::sqrt(tauovermass);
+    int start_index      = step_context.getPtclGroupStart(ig);
+    int end_index        = step_context.getPtclGroupEnd(ig);
+    for (int iat = start_index; iat < end_index; ++iat)
+    {
+      ParticleSet::flex_setActive(walker_elecs, iat);
+      auto delta_r_start = it_delta_r + iat * num_walkers;
+      for (int iw = 0; iw < num_walkers; ++iw)
+        drifts[iw] = sqrttau * delta_r_start[iw];
+
+      // one move of the shared ParticleSet for all the wavefunctions
+      ParticleSet::flex_makeMove(walker_elecs, iat, drifts);
+      for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+        TrialWaveFunction::flex_calcRatio(systems.psis[ipsi], walker_elecs, iat, systems.ratios[ipsi]);
+
+      crowd.clearAcceptRejectLists();
+      auto& elec_accept_list = crowd.get_elec_accept_list();
+      auto& elec_reject_list = crowd.get_elec_reject_list();
+      for (int iw = 0; iw < num_walkers; ++iw)
+      {
+        // sampling sum_i |psi_i|^2/norm_i
+        RealType prob = 0.0;
+        for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+        {
+          systems.ratios_sq[ipsi] = std::norm(systems.ratios[ipsi][iw]);
+          prob += systems.ratios_sq[ipsi] / systems.sum_ratios[iw][ipsi];
+        }
+        systems.accepted[iw] = step_context.get_random_gen()() < prob;
+        if (systems.accepted[iw])
+        {
+          crowd.incAccept();
+          elec_accept_list.push_back(walker_elecs[iw]);
+          updateRatioMatrix(systems.ratios_sq, systems.ratio_ij[iw]);
+          computeSumRatio(systems.ratio_ij[iw], systems.sum_ratios[iw]);
+        }
+        else
+        {
+          crowd.incReject();
+          elec_reject_list.push_back(walker_elecs[iw]);
+        }
+      }
+
+      auto& twf_accept_list = crowd.get_twf_accept_list();
+      auto& twf_reject_list = crowd.get_twf_reject_list();
+      for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+      {
+        twf_accept_list.clear();
+        twf_reject_list.clear();
+        for (int iw = 0; iw < num_walkers; ++iw)
+          if (systems.accepted[iw])
+            twf_accept_list.push_back(systems.psis[ipsi][iw]);
+          else
+            twf_reject_list.push_back(systems.psis[ipsi][iw]);
+        TrialWaveFunction::flex_acceptMove(twf_accept_list, elec_accept_list, iat);
+        TrialWaveFunction::flex_rejectMove(twf_reject_list, iat);
+      }
+
+      ParticleSet::flex_acceptMove(elec_accept_list, iat);
+      ParticleSet::flex_rejectMove(elec_reject_list, iat);
+    }
+  }
+  for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+    for (TrialWaveFunction& twf : systems.psis[ipsi])
+      twf.completeUpdates();
+  ParticleSet::flex_donePbyP(walker_elecs);
+  timers.movepbyp_timer.stop();
+
+  timers.buffer_timer.start();
+  // the buffer update overwrites P.G and P.L, they are kept per wavefunction for its kinetic energy
+  for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+  {
+    TrialWaveFunction::flex_updateBuffer(systems.psis[ipsi], walker_elecs, mcp_buffers, recompute);
+    for (int iw = 0; iw < num_walkers; ++iw)
+    {
+      ParticleSet& pset      = walker_elecs[iw];
+      TrialWaveFunction& twf = systems.psis[ipsi][iw];
+      twf.G                  = pset.G;
+      twf.L                  = pset.L;
+      if (ipsi == 0)
+        pset.saveWalker(walkers[iw]);
+    }
+  }
+  timers.buffer_timer.stop();
+}
+
+void CSVMCBatched::evaluateCorrelatedEnergies(const StateForThread& sft,
+                                              Crowd& crowd,
+                                              DriverTimers& timers,
+                                              ContextForSteps& step_context,
+                                              CorrelatedSystems& systems)
+{
+  const int num_psi  = systems.get_num_psi();
+  auto& walkers      = crowd.get_walkers();
+  auto& walker_elecs = crowd.get_walker_elecs();
+
+  for (int iw = 0; iw < crowd.size(); ++iw)
+  {
+    MCPWalker& walker = walkers[iw];
+    for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+      systems.logpsi[ipsi] = systems.psis[ipsi][iw].get().getLogPsi();
+    computeSumRatio(systems.logpsi, sft.avg_norm, systems.ratio_ij[iw], systems.sum_ratios[iw]);
+    for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+    {
+      const RealType umbrella_weight          = 1.0 / systems.sum_ratios[iw][ipsi];
+      walker.Properties(ipsi, LOGPSI)         = systems.logpsi[ipsi];
+      walker.Properties(ipsi, SIGN)           = systems.psis[ipsi][iw].get().getPhase();
+      walker.Properties(ipsi, UMBRELLAWEIGHT) = umbrella_weight;
+      systems.cum_norm[ipsi] += umbrella_weight;
+    }
+    // Multiplicity is the container of sumratio[0] as in CSUpdateBase
+    walker.Multiplicity = systems.sum_ratios[iw][0];
+  }
+
+  for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+  {
+    auto& hamiltonians = systems.hamiltonians[ipsi];
+    timers.hamiltonian_timer.start();
+    for (int iw = 0; iw < crowd.size(); ++iw)
+    {
+      ParticleSet& pset            = walker_elecs[iw];
+      const TrialWaveFunction& twf = systems.psis[ipsi][iw];
+      pset.G                       = twf.G;
+      pset.L                       = twf.L;
+    }
+    const std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
+        QMCHamiltonian::flex_evaluate(hamiltonians, walker_elecs));
+    timers.hamiltonian_timer.stop();
+
+    timers.collectables_timer.start();
+    for (int iw = 0; iw < crowd.size(); ++iw)
+    {
+      MCPWalker& walker                    = walkers[iw];
+      QMCHamiltonian& ham                  = hamiltonians[iw];
+      walker.Properties(ipsi, LOCALENERGY) = local_energies[iw];
+      ham.setRandomGenerator(&step_context.get_random_gen());
+      ham.auxHevaluate(walker_elecs[iw], walker, true, false);
+      ham.saveProperty(walker.getPropertyBase(ipsi));
+    }
+    // the collectables are those of the primary hamiltonian
+    if (ipsi == 0)
+    {
+      std::copy(local_energies.begin(), local_energies.end(), crowd.get_local_energies().begin());
+      QMCHamiltonian::mw_auxHevaluateCollectables(hamiltonians, walker_elecs, walkers,
+                                                  crowd.get_estimator_manager_crowd().get_step_collectables());
+    }
+    timers.collectables_timer.stop();
+  }
+}
+
+void CSVMCBatched::initCorrelatedWalkers(int crowd_id,
+                                         const StateForThread& sft,
+                                         DriverTimers& timers,
+                                         std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
+                                         std::vector<std::unique_ptr<Crowd>>& crowds,
+                                         std::vector<CorrelatedSystems>& crowd_systems)
+{
+  Crowd& crowd               = *crowds[crowd_id];
+  CorrelatedSystems& systems = crowd_systems[crowd_id];
+  const int num_psi          = systems.get_num_psi();
+  auto& walkers              = crowd.get_walkers();
+  auto& walker_elecs         = crowd.get_walker_elecs();
+  auto& mcp_buffers          = crowd.get_mcp_wfbuffers();
+
+  crowd.loadWalkers();
+  // the wavefunctions are registered one after the other in the buffer of the walker
+  for (int iw = 0; iw < crowd.size(); ++iw)
+  {
+    MCPWalker& walker = walkers[iw];
+    ParticleSet& pset = walker_elecs[iw];
+    pset.update();
+    walker.resizeProperty(num_psi, walker.Properties.cols());
+    walker.DataSet.clear();
+    walker.DataSet.rewind();
+    walker.registerData();
+    for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+      systems.psis[ipsi][iw].get().registerData(pset, walker.DataSet);
+    walker.DataSet.allocate();
+    for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+      systems.psis[ipsi][iw].get().copyFromBuffer(pset, walker.DataSet);
+  }
+
+  for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+  {
+    TrialWaveFunction::flex_evaluateLog(systems.psis[ipsi], walker_elecs);
+    TrialWaveFunction::flex_updateBuffer(systems.psis[ipsi], walker_elecs, mcp_buffers);
+    for (int iw = 0; iw < crowd.size(); ++iw)
+    {
+      ParticleSet& pset      = walker_elecs[iw];
+      TrialWaveFunction& twf = systems.psis[ipsi][iw];
+      twf.G                  = pset.G;
+      twf.L                  = pset.L;
+      if (ipsi == 0)
+        pset.saveWalker(walkers[iw]);
+    }
+  }
+  evaluateCorrelatedEnergies(sft, crowd, timers, *context_for_steps[crowd_id], systems);
+}
+
+/** Thread body for CSVMC step
+ *
+ */
+void CSVMCBatched::runCSVMCStep(int crowd_id,
+                                const StateForThread& sft,
+                                DriverTimers& timers,
+                                std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
+                                std::vector<std::unique_ptr<Crowd>>& crowds,
+                                std::vector<CorrelatedSystems>& crowd_systems)
+{
+  Crowd& crowd = *(crowds[crowd_id]);
+  advanceWalkers(sft, crowd, timers, *context_for_steps[crowd_id], crowd_systems[crowd_id], false);
+  crowd.accumulate(sft.population.get_num_global_walkers());
+}
+
+void CSVMCBatched::createCorrelatedSystems()
+{
+  const int num_psi = Psi1.size();
+  if (num_psi == 0 || num_psi != H1.size())
+    throw std::runtime_error("CSVMCBatched needs a wavefunction and a hamiltonian for each of the correlated "
+                             "systems, given by the <qmcsystem/> elements of the qmc section");
+
+  // H1[0] is the primary, the collectables and traces are those of the first system
+  H1[0]->setPrimary(true);
+  for (int ipsi = 1; ipsi < num_psi; ipsi++)
+    H1[ipsi]->setPrimary(false);
+
+  psi_clones_.clear();
+  h_clones_.clear();
+  crowd_systems_.clear();
+  crowd_systems_.resize(crowds_.size());
+  std::vector<TrialWaveFunction*> walker_psis(num_psi);
+  std::vector<QMCHamiltonian*> walker_hamiltonians(num_psi);
+  outputManager.pause();
+  for (int crowd_id = 0; crowd_id < crowds_.size(); ++crowd_id)
+  {
+    Crowd& crowd = *crowds_[crowd_id];
+    crowd_systems_[crowd_id].resize(num_psi, crowd.size());
+    for (ParticleSet& pset : crowd.get_walker_elecs())
+    {
+      for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+      {
+        psi_clones_.emplace_back(Psi1[ipsi]->makeClone(pset));
+        h_clones_.emplace_back(H1[ipsi]->makeClone(pset, *psi_clones_.back()));
+        h_clones_.back()->setPrimary(ipsi == 0);
+        walker_psis[ipsi]         = psi_clones_.back().get();
+        walker_hamiltonians[ipsi] = h_clones_.back().get();
+        walker_psis[ipsi]->G.resize(pset.getTotalNum());
+        walker_psis[ipsi]->L.resize(pset.getTotalNum());
+      }
+      crowd_systems_[crowd_id].addWalker(walker_psis, walker_hamiltonians);
+    }
+  }
+  outputManager.resume();
+
+  avg_norm_.resize(num_psi, 1.0);
+  log_norm_.resize(num_psi, 0.0);
+  for (int ipsi = 0; ipsi < num_psi; ipsi++)
+    avg_norm_[ipsi] = std::exp(log_norm_[ipsi]);
+  app_log() << "  CSVMCBatched correlated systems " << num_psi << " on " << population_.get_num_local_walkers()
+            << " walkers" << std::endl;
+}
+
+void CSVMCBatched::updateNorms()
+{
+  const int num_psi = avg_norm_.size();
+  std::vector<RealType> cum_norm(num_psi, 0.0);
+  for (CorrelatedSystems& systems : crowd_systems_)
+    for (int ipsi = 0; ipsi < num_psi; ipsi++)
+    {
+      cum_norm[ipsi] += systems.cum_norm[ipsi];
+      systems.cum_norm[ipsi] = 0.0;
+    }
+  // the norms are those of the whole population
+  myComm->allreduce(cum_norm);
+  RealType winv = 1.0 / std::accumulate(cum_norm.begin(), cum_norm.end(), 0.0);
+  for (int ipsi = 0; ipsi < num_psi; ipsi++)
+  {
+    avg_norm_[ipsi] = cum_norm[ipsi] * winv;
+    log_norm_[ipsi] = std::log(avg_norm_[ipsi]);
+  }
+}
+
+/** Runs the actual CSVMC section
+ *
+ *  Same state machine as VMCBatched, the crowds are not tuned since the correlated systems are built per crowd.
+ */
+bool CSVMCBatched::run()
+{
+  IndexType num_blocks = qmcdriver_input_.get_max_blocks();
+  estimator_manager_->start(num_blocks);
+
+  if (vmcdriver_input_.get_use_drift())
+    app_warning() << "CSVMCBatched ignores use_drift, the moves are made without drift as in CSVMCUpdatePbyP"
+                  << std::endl;
+
+  createCorrelatedSystems();
+  StateForThread csvmc_state(qmcdriver_input_, vmcdriver_input_, population_, avg_norm_);
+
+  TasksOneToOne<> crowd_task(num_crowds_);
+  { // walker initialization
+    ScopedTimer local_timer(&(timers_.init_walkers_timer));
+    crowd_task(initCorrelatedWalkers, csvmc_state, std::ref(timers_), std::ref(step_contexts_), std::ref(crowds_),
+               std::ref(crowd_systems_));
+  }
+
+  auto runWarmupStep = [](int crowd_id, StateForThread& sft, DriverTimers& timers,
+                          UPtrVector<ContextForSteps>& context_for_steps, UPtrVector<Crowd>& crowds,
+                          std::vector<CorrelatedSystems>& crowd_systems) {
+    advanceWalkers(sft, *crowds[crowd_id], timers, *context_for_steps[crowd_id], crowd_systems[crowd_id], true);
+  };
+  const int num_warmup_steps = qmcdriver_input_.get_warmup_steps();
+  for (int step = 0; step < num_warmup_steps; ++step)
+  {
+    ScopedTimer local_timer(&(timers_.run_steps_timer));
+    crowd_task(runWarmupStep, std::ref(csvmc_state), std::ref(timers_), std::ref(step_contexts_), std::ref(crowds_),
+               std::ref(crowd_systems_));
+  }
+  if (num_warmup_steps > 0)
+    updateNorms();
+
+  for (int block = 0; block < num_blocks; ++block)
+  {
+    estimator_manager_->startBlock(qmcdriver_input_.get_max_steps());
+    for (auto& crowd : crowds_)
+      crowd->startBlock(qmcdriver_input_.get_max_steps());
+
+    for (int step = 0; step < qmcdriver_input_.get_max_steps(); ++step)
+    {
+      ScopedTimer local_timer(&(timers_.run_steps_timer));
+      csvmc_state.step = step;
+      crowd_task(runCSVMCStep, csvmc_state, timers_, std::ref(step_contexts_), std::ref(crowds_),
+                 std::ref(crowd_systems_));
+      accumulateCollectables();
+    }
+
+    RefVector<ScalarEstimatorBase> all_scalar_estimators;
+    FullPrecRealType total_block_weight = 0.0;
+    FullPrecRealType total_accept_ratio = 0.0;
+    // Collect all the ScalarEstimatorsFrom EMCrowds
+    for (const UPtr<Crowd>& crowd : crowds_)
+    {
+      auto crowd_sc_est = crowd->get_estimator_manager_crowd().get_scalar_estimators();
+      all_scalar_estimators.insert(all_scalar_estimators.end(), std::make_move_iterator(crowd_sc_est.begin()),
+                                   std::make_move_iterator(crowd_sc_est.end()));
+      total_block_weight += crowd->get_estimator_manager_crowd().get_block_weight();
+      total_accept_ratio += crowd->get_accept_ratio();
+    }
+    total_accept_ratio /= crowds_.size();
+    estimator_manager_->collectScalarEstimators(all_scalar_estimators, population_.get_num_local_walkers(),
+                                                total_block_weight);
+    estimator_manager_->collectCollectables();
+    estimator_manager_->stopBlockNew(total_accept_ratio);
+  }
+  return false;
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,181 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File refactored from CSVMC.h, CSUpdateBase.h and CSVMCUpdatePbyP.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_CSVMCBATCHED_H
+#define QMCPLUSPLUS_CSVMCBATCHED_H
+
+#include "QMCDrivers/QMCDriverNew.h"
+#include "QMCDrivers/VMC/VMCDriverInput.h"
+#include "QMCDrivers/MCPopulation.h"
+#include "QMCDrivers/ContextForSteps.h"
+#include "OhmmsPETE/OhmmsMatrix.h"
+
+namespace qmcplusplus
+{
+/** @ingroup QMCDrivers  ParticleByParticle
+ * @brief Implements a correlated sampling VMC using particle-by-particle move. Threaded execution.
+ *
+ *  Every walker carries a clone of each correlated wavefunction and hamiltonian built on the ParticleSet
+ *  of the walker. A move is made once per walker and the distance tables are shared by all the wavefunctions,
+ *  the ratios of each wavefunction are evaluated over the whole crowd with flex_calcRatio.
+ */
+class CSVMCBatched : public QMCDriverNew
+{
+public:
+  using FullPrecRealType  = QMCTraits::FullPrecRealType;
+  using PosType           = QMCTraits::PosType;
+  using ParticlePositions = PtclOnLatticeTraits::ParticlePos_t;
+  using PsiValueType      = TrialWaveFunction::PsiValueType;
+
+  /** The correlated systems of the walkers of a crowd
+   *
+   *  The wavefunction and hamiltonian lists are indexed [ipsi][iw] so each wavefunction is a crowd wide flex_ call.
+   */
+  struct CorrelatedSystems
+  {
+    std::vector<RefVector<TrialWaveFunction>> psis;
+    std::vector<RefVector<QMCHamiltonian>> hamiltonians;
+    /// ratios of the proposed move [ipsi][iw]
+    std::vector<std::vector<PsiValueType>> ratios;
+    /// |psi_j/psi_i|^2 scaled by the norms of each walker
+    std::vector<Matrix<RealType>> ratio_ij;
+    /// sum_j |psi_j/psi_i|^2 of each walker [iw][ipsi]
+    std::vector<std::vector<RealType>> sum_ratios;
+    /// 1/sum_ratios accumulated since the last update of the norms
+    std::vector<RealType> cum_norm;
+    /// squared ratios and log values of one walker
+    std::vector<RealType> ratios_sq;
+    std::vector<RealType> logpsi;
+    /// the walkers accepting the current single particle move
+    std::vector<int> accepted;
+
+    int get_num_psi() const { return psis.size(); }
+    int size() const { return psis.empty() ? 0 : psis[0].size(); }
+    void resize(int num_psi, int num_walkers);
+    void addWalker(const std::vector<TrialWaveFunction*>& walker_psis,
+                   const std::vector<QMCHamiltonian*>& walker_hamiltonians);
+  };
+
+  /** To avoid 10's of arguments to runCSVMCStep
+   *
+   *  There should be a division between const input to runCSVMCStep
+   *  And step to step state
+   */
+  struct StateForThread
+  {
+    const QMCDriverInput& qmcdrv_input;
+    const VMCDriverInput& vmcdrv_input;
+    const MCPopulation& population;
+    /// average norms of the wavefunctions
+    const std::vector<RealType>& avg_norm;
+    IndexType step;
+    StateForThread(QMCDriverInput& qmci, VMCDriverInput& vmci, MCPopulation& pop, std::vector<RealType>& norms)
+        : qmcdrv_input(qmci), vmcdrv_input(vmci), population(pop), avg_norm(norms)
+    {}
+  };
+
+  /// Constructor.
+  CSVMCBatched(QMCDriverInput&& qmcdriver_input,
+               VMCDriverInput&& input,
+               MCPopulation& pop,
+               TrialWaveFunction& psi,
+               QMCHamiltonian& h,
+               WaveFunctionPool& ppool,
+               Communicate* comm);
+
+  /// Same as VMCBatched
+  IndexType calc_default_local_walkers(IndexType walkers_per_rank);
+
+  bool run();
+
+  static void advanceWalkers(const StateForThread& sft,
+                             Crowd& crowd,
+                             DriverTimers& timers,
+                             ContextForSteps& move_context,
+                             CorrelatedSystems& systems,
+                             bool recompute);
+
+  /** @name Stages of advanceWalkers
+   *  the move sweep accepted with the sum of the squared ratios of all the wavefunctions and the buffer update,
+   *  the local energies and umbrella weights of every wavefunction.
+   *  @{
+   */
+  static void sweepWalkers(const StateForThread& sft,
+                           Crowd& crowd,
+                           DriverTimers& timers,
+                           ContextForSteps& move_context,
+                           CorrelatedSystems& systems,
+                           bool recompute);
+  static void evaluateCorrelatedEnergies(const StateForThread& sft,
+                                         Crowd& crowd,
+                                         DriverTimers& timers,
+                                         ContextForSteps& move_context,
+                                         CorrelatedSystems& systems);
+  /** @} */
+
+  /// registers all the wavefunctions of the walkers of a crowd in their buffers and evaluates them from scratch
+  static void initCorrelatedWalkers(int crowd_id,
+                                    const StateForThread& sft,
+                                    DriverTimers& timers,
+                                    std::vector<std::unique_ptr<ContextForSteps>>& move_context,
+                                    std::vector<std::unique_ptr<Crowd>>& crowds,
+                                    std::vector<CorrelatedSystems>& crowd_systems);
+
+  // This is the task body executed at crowd scope
+  // it does not have access to object members by design
+  static void runCSVMCStep(int crowd_id,
+                           const StateForThread& sft,
+                           DriverTimers& timers,
+                           std::vector<std::unique_ptr<ContextForSteps>>& move_context,
+                           std::vector<std::unique_ptr<Crowd>>& crowds,
+                           std::vector<CorrelatedSystems>& crowd_systems);
+
+  /** @name Sum ratios of CSUpdateBase
+   *  @{
+   */
+  /// ratio_ij and sum_j ratio_ij from the log values and the average norms
+  static void computeSumRatio(const std::vector<RealType>& logpsi,
+                              const std::vector<RealType>& avg_norm,
+                              Matrix<RealType>& ratio_ij,
+                              std::vector<RealType>& sumratio);
+  /// sum_j ratio_ij of the current ratio_ij
+  static void computeSumRatio(const Matrix<RealType>& ratio_ij, std::vector<RealType>& sumratio);
+  /// ratio_ij after an accepted move with the squared single particle ratios ratio_i
+  static void updateRatioMatrix(const std::vector<RealType>& ratio_i, Matrix<RealType>& ratio_ij);
+  /** @} */
+
+  QMCRunType getRunType() { return QMCRunType::CSVMC_BATCH; }
+
+private:
+  VMCDriverInput vmcdriver_input_;
+  /// the wavefunction and hamiltonian clones of the walkers of all the crowds
+  UPtrVector<TrialWaveFunction> psi_clones_;
+  UPtrVector<QMCHamiltonian> h_clones_;
+  /// the correlated systems of the walkers of each crowd in crowd order
+  std::vector<CorrelatedSystems> crowd_systems_;
+  std::vector<RealType> avg_norm_;
+  std::vector<RealType> log_norm_;
+
+  /// clones Psi1 and H1 on the ParticleSet of every walker
+  void createCorrelatedSystems();
+  /// average norms from the umbrella weights accumulated by the crowds
+  void updateNorms();
+
+  /// Copy Constructor (disabled)
+  CSVMCBatched(const CSVMCBatched&) = delete;
+  /// Copy operator (disabled).
+  CSVMCBatched& operator=(const CSVMCBatched&) = delete;
+};
+
+} // namespace qmcplusplus
+
+#endif
@@ -0,0 +1,34 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// Refactored from: VMCFactory.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "QMCDrivers/CorrelatedSampling/CSVMCFactoryNew.h"
+#include "QMCDrivers/CorrelatedSampling/CSVMCBatched.h"
+
+namespace qmcplusplus
+{
+QMCDriverInterface* CSVMCFactoryNew::create(MCPopulation& pop,
+                                            TrialWaveFunction& psi,
+                                            QMCHamiltonian& h,
+                                            WaveFunctionPool& wf_pool,
+                                            Communicate* comm)
+{
+  QMCDriverInput qmcdriver_input(qmc_counter_);
+  qmcdriver_input.readXML(input_node_);
+  VMCDriverInput vmcdriver_input;
+  vmcdriver_input.readXML(input_node_);
+  QMCDriverInterface* qmc =
+      new CSVMCBatched(std::move(qmcdriver_input), std::move(vmcdriver_input), pop, psi, h, wf_pool, comm);
+  // CSVMCBatched only supports PbyP
+  qmc->setUpdateMode(csvmc_mode_ & 1);
+  return qmc;
+}
+} // namespace qmcplusplus
@@ -0,0 +1,43 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// Refactored from: VMCFactory.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_CSVMCFACTORYNEW_H
+#define QMCPLUSPLUS_CSVMCFACTORYNEW_H
+#include "QMCDrivers/QMCDriverInterface.h"
+#include "QMCApp/WaveFunctionPool.h"
+#include "Message/Communicate.h"
+
+namespace qmcplusplus
+{
+class MCPopulation;
+
+class CSVMCFactoryNew
+{
+private:
+  const int csvmc_mode_;
+  const int qmc_counter_;
+  xmlNodePtr input_node_;
+
+public:
+  CSVMCFactoryNew(xmlNodePtr cur, const int csvmc_mode, const int qmc_counter)
+      : csvmc_mode_(csvmc_mode), qmc_counter_(qmc_counter), input_node_(cur)
+  {}
+
+  QMCDriverInterface* create(MCPopulation& pop,
+                             TrialWaveFunction& psi,
+                             QMCHamiltonian& h,
+                             WaveFunctionPool& wf_pool,
+                             Communicate* comm);
+};
+} // namespace qmcplusplus
+
+#endif
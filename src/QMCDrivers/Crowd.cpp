@@ -52,6 +52,24 @@ void Crowd::resizeResults(int crowd_size) {
   resizeCS(log_gf_);
   resizeCS(log_gb_);
   resizeCS(prob_);
+  resizeCS(drifts_);
+  resizeCS(r2_proposed_);
+  resizeCS(node_rejects_);
+  resizeCS(accepted_moves_);
+  resizeCS(local_energies_);
+  auto reserveCS = [crowd_size](auto& avector) { avector.reserve(crowd_size); };
+  reserveCS(elec_accept_list_);
+  reserveCS(elec_reject_list_);
+  reserveCS(twf_accept_list_);
+  reserveCS(twf_reject_list_);
+}
+
+void Crowd::clearAcceptRejectLists()
+{
+  elec_accept_list_.clear();
+  elec_reject_list_.clear();
+  twf_accept_list_.clear();
+  twf_reject_list_.clear();
 }
 
 void Crowd::addWalker(MCPWalker& walker, ParticleSet& elecs, TrialWaveFunction& twf, QMCHamiltonian& hamiltonian)
@@ -85,6 +103,8 @@ void Crowd::startBlock(int num_steps)
   // VMCBatched does no nonlocal moves
   n_nonlocal_accept_ = 0;
   estimator_manager_crowd_.startBlock(num_steps);
+  for (QMCHamiltonian& ham : walker_hamiltonians_)
+    ham.startBlock();
 }
 
 } // namespace qmcplusplus
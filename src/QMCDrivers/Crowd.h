@@ -35,6 +35,7 @@ public:
   using MCPWalker        = MCPopulation::MCPWalker;
   using WFBuffer         = MCPopulation::WFBuffer;
   using GradType         = QMCTraits::GradType;
+  using PosType          = QMCTraits::PosType;
   using RealType         = QMCTraits::RealType;
   using FullPrecRealType = QMCTraits::FullPrecRealType;
   /** This is the data structure for walkers within a crowd
@@ -94,6 +95,17 @@ public:
   std::vector<RealType>& get_log_gf() { return log_gf_; }
   std::vector<RealType>& get_log_gb() { return log_gb_; }
   std::vector<RealType>& get_prob() { return prob_; }
+  std::vector<PosType>& get_drifts() { return drifts_; }
+  std::vector<RealType>& get_r2_proposed() { return r2_proposed_; }
+  std::vector<int>& get_node_rejects() { return node_rejects_; }
+  std::vector<int>& get_accepted_moves() { return accepted_moves_; }
+  std::vector<FullPrecRealType>& get_local_energies() { return local_energies_; }
+  RefVector<ParticleSet>& get_elec_accept_list() { return elec_accept_list_; }
+  RefVector<ParticleSet>& get_elec_reject_list() { return elec_reject_list_; }
+  RefVector<TrialWaveFunction>& get_twf_accept_list() { return twf_accept_list_; }
+  RefVector<TrialWaveFunction>& get_twf_reject_list() { return twf_reject_list_; }
+  /// empties the accept/reject lists, their capacity is kept between the moves
+  void clearAcceptRejectLists();
   RefVector<WFBuffer>& get_mcp_wfbuffers() { return mcp_wfbuffers_; }
   const EstimatorManagerCrowd& get_estimator_manager_crowd() const { return estimator_manager_crowd_; }
   int size() const { return mcp_walkers_.size(); }
@@ -136,6 +148,20 @@ private:
   std::vector<RealType> log_gf_;
   std::vector<RealType> log_gb_;
   std::vector<RealType> prob_;
+  std::vector<PosType> drifts_;
+  /// squared proposed displacements of DMC scaled by tau over mass
+  std::vector<RealType> r2_proposed_;
+  /// DMC moves rejected because they crossed a node
+  std::vector<int> node_rejects_;
+  /// accepted single particle moves of each walker in the current step
+  std::vector<int> accepted_moves_;
+  /// local energies of the current step, written walker by walker between the move sweep and the accumulation
+  std::vector<FullPrecRealType> local_energies_;
+  /// walkers accepting and rejecting the current single particle move
+  RefVector<ParticleSet> elec_accept_list_;
+  RefVector<ParticleSet> elec_reject_list_;
+  RefVector<TrialWaveFunction> twf_accept_list_;
+  RefVector<TrialWaveFunction> twf_reject_list_;
   /** }@ */
 
   /** @name Step State
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iomanip>
+#include "QMCDrivers/CrowdTuner.h"
+#include "Message/CommOperators.h"
+
+namespace qmcplusplus
+{
+CrowdTuner::CrowdTuner(int num_crowds, int max_crowds, int num_walkers, int blocks_per_trial, Communicate* comm)
+    : blocks_per_trial_(blocks_per_trial), current_(0), blocks_done_(0), done_(false)
+{
+  // the ranks hold different numbers of walkers, the throughputs are reduced candidate by candidate
+  if (comm != nullptr && comm->size() > 1)
+  {
+    std::vector<int> bounds{num_crowds, max_crowds, num_walkers};
+    std::vector<int> all_bounds(3 * comm->size());
+    comm->allgather(bounds, all_bounds, 3);
+    for (int i = 0; i < comm->size(); ++i)
+    {
+      num_crowds  = std::min(num_crowds, all_bounds[3 * i]);
+      max_crowds  = std::min(max_crowds, all_bounds[3 * i + 1]);
+      num_walkers = std::min(num_walkers, all_bounds[3 * i + 2]);
+    }
+  }
+  best_crowds_ = realizable(num_crowds, num_walkers);
+  candidates_.push_back(best_crowds_);
+  for (int nc = max_crowds; nc > 0; nc /= 2)
+  {
+    const int filled = realizable(nc, num_walkers);
+    if (std::find(candidates_.begin(), candidates_.end(), filled) == candidates_.end())
+      candidates_.push_back(filled);
+  }
+  if (blocks_per_trial_ <= 0 || candidates_.size() < 2)
+    done_ = true;
+  realized_  = candidates_;
+  walker_steps_.resize(candidates_.size(), 0.0);
+  seconds_.resize(candidates_.size(), 0.0);
+}
+
+int CrowdTuner::realizable(int num_crowds, int num_walkers)
+{
+  if (num_crowds <= 0 || num_walkers <= 0)
+    return std::max(num_crowds, 1);
+  const int walkers_per_crowd = (num_walkers + num_crowds - 1) / num_crowds;
+  return (num_walkers + walkers_per_crowd - 1) / walkers_per_crowd;
+}
+
+bool CrowdTuner::recordBlock(double walker_steps, double seconds, int num_crowds, Communicate* comm)
+{
+  if (done_)
+    return false;
+  realized_[current_] = num_crowds;
+  walker_steps_[current_] += walker_steps;
+  seconds_[current_] += seconds;
+  if (++blocks_done_ < blocks_per_trial_)
+    return false;
+  blocks_done_ = 0;
+  if (++current_ < candidates_.size())
+    return true;
+
+  throughputs_.resize(candidates_.size());
+  for (int i = 0; i < candidates_.size(); ++i)
+    throughputs_[i] = seconds_[i] > 0.0 ? walker_steps_[i] / seconds_[i] : 0.0;
+  if (comm != nullptr)
+    comm->allreduce(throughputs_);
+  const int best = std::max_element(throughputs_.begin(), throughputs_.end()) - throughputs_.begin();
+  best_crowds_   = candidates_[best];
+  done_          = true;
+  return best_crowds_ != candidates_.back();
+}
+
+void CrowdTuner::report(std::ostream& os) const
+{
+  if (throughputs_.empty())
+    return;
+  os << "  Crowd tuning, walker steps per second summed over ranks" << std::endl;
+  os << "    crowds    on this rank    walker steps/s" << std::endl;
+  const std::ios_base::fmtflags flags = os.flags();
+  const std::streamsize precision     = os.precision();
+  os << std::right << std::fixed << std::setprecision(1);
+  for (int i = 0; i < candidates_.size(); ++i)
+    os << "    " << std::setw(6) << candidates_[i] << "    " << std::setw(12) << realized_[i] << "    " << std::setw(14)
+       << throughputs_[i] << std::endl;
+  os.flags(flags);
+  os.precision(precision);
+  os << "  Selected " << best_crowds_ << " crowds" << std::endl;
+}
+
+} // namespace qmcplusplus
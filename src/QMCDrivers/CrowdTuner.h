@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_CROWDTUNER_H
+#define QMCPLUSPLUS_CROWDTUNER_H
+
+#include <vector>
+#include <ostream>
+#include "Message/Communicate.h"
+
+namespace qmcplusplus
+{
+/** Picks the number of crowds with the highest walker throughput
+ *
+ *  The batched drivers run crowd_tuning_blocks blocks with each candidate
+ *  number of crowds and record the walker steps and the wall time of the blocks.
+ *  The candidates are the initial number of crowds and max_crowds halved down to 1,
+ *  both taken as the minimum over the ranks so that every rank measures the same list.
+ *  A candidate is replaced by the number of crowds its walkers per crowd actually fill,
+ *  see realizable, for the fewest walkers of any rank. A rank holding more walkers can
+ *  still fill a different number of crowds, the number it ran is recorded with each block.
+ *  Once every candidate is measured the throughputs are summed over the ranks so that
+ *  all of them select the same number of crowds, which is kept for the rest of the run.
+ *  Fewer crowds mean larger batches and idle threads, the optimum depends on
+ *  the system size and the machine.
+ */
+class CrowdTuner
+{
+public:
+  /** constructor
+   * @param num_crowds number of crowds the driver starts with
+   * @param max_crowds upper bound of the candidates, at most the number of threads and walkers
+   * @param num_walkers number of walkers of this rank
+   * @param blocks_per_trial blocks measured per candidate, 0 disables the tuning
+   * @param comm communicator of the ranks, may be nullptr
+   */
+  CrowdTuner(int num_crowds, int max_crowds, int num_walkers, int blocks_per_trial, Communicate* comm = nullptr);
+
+  /** number of crowds filled when num_walkers are split into num_crowds
+   *
+   *  The walkers per crowd are rounded up, e.g. 9 walkers asked for 4 crowds fill 3 crowds of 3.
+   */
+  static int realizable(int num_crowds, int num_walkers);
+
+  /// true until the number of crowds is selected
+  bool isTuning() const { return !done_; }
+
+  /// number of crowds for the next block
+  int get_num_crowds() const { return done_ ? best_crowds_ : candidates_[current_]; }
+
+  const std::vector<int>& get_candidates() const { return candidates_; }
+
+  /** record a finished block
+   * @param walker_steps walker moves performed in the block
+   * @param seconds wall time of the block
+   * @param num_crowds number of crowds this rank ran the block with
+   * @param comm communicator of the ranks, may be nullptr
+   * @return true if the number of crowds changes for the next block
+   */
+  bool recordBlock(double walker_steps, double seconds, int num_crowds, Communicate* comm);
+
+  /// print the measured throughputs and the selection
+  void report(std::ostream& os) const;
+
+private:
+  std::vector<int> candidates_;
+  /// number of crowds this rank ran each candidate with
+  std::vector<int> realized_;
+  std::vector<double> walker_steps_;
+  std::vector<double> seconds_;
+  /// walker steps per second of the candidates, summed over ranks
+  std::vector<double> throughputs_;
+  int blocks_per_trial_;
+  int current_;
+  int blocks_done_;
+  int best_crowds_;
+  bool done_;
+};
+
+} // namespace qmcplusplus
+#endif
@@ -11,9 +11,12 @@
 
 #include "QMCDrivers/DMC/DMCBatched.h"
 #include "Concurrency/TasksOneToOne.hpp"
+#include "Concurrency/TasksPipeline.hpp"
 #include "Concurrency/Info.hpp"
 #include "Utilities/RunTimeManager.h"
+#include "Utilities/Timer.h"
 #include "ParticleBase/RandomSeqGenerator.h"
+#include "Estimators/CollectablesEstimator.h"
 #include "Utilities/ProgressReportEngine.h"
 
 namespace qmcplusplus
@@ -81,6 +84,39 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
                                 //                                DMCTimers& dmc_timers,
                                 ContextForSteps& step_context,
                                 bool recompute)
+{
+  sweepWalkers(sft, crowd, timers, step_context, recompute);
+
+  auto& accepted_moves = crowd.get_accepted_moves();
+  RefVector<QMCHamiltonian> moved_hamiltonians;
+  RefVector<ParticleSet> moved_elecs;
+  moved_hamiltonians.reserve(crowd.size());
+  moved_elecs.reserve(crowd.size());
+  for (int iw = 0; iw < crowd.size(); ++iw)
+    if (accepted_moves[iw] > 0)
+    {
+      moved_hamiltonians.push_back(crowd.get_walker_hamiltonians()[iw]);
+      moved_elecs.push_back(crowd.get_walker_elecs()[iw]);
+    }
+  if (moved_hamiltonians.size() > 0)
+  {
+    timers.hamiltonian_timer.start();
+    const std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
+        QMCHamiltonian::flex_evaluateWithToperator(moved_hamiltonians, moved_elecs));
+    timers.hamiltonian_timer.stop();
+    for (int iw = 0, i_moved = 0; iw < crowd.size(); ++iw)
+      if (accepted_moves[iw] > 0)
+        crowd.get_local_energies()[iw] = local_energies[i_moved++];
+  }
+
+  finishStep(sft, crowd, timers, step_context);
+}
+
+void DMCBatched::sweepWalkers(const StateForThread& sft,
+                              Crowd& crowd,
+                              DriverTimers& timers,
+                              ContextForSteps& step_context,
+                              bool recompute)
 {
   timers.buffer_timer.start();
   crowd.loadWalkers();
@@ -104,26 +140,16 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   timers.movepbyp_timer.start();
   int num_walkers = crowd.size();
   //This generates an entire steps worth of deltas.
-  step_context.nextDeltaRs();
+  step_context.nextDeltaRs(num_walkers);
   auto it_delta_r = step_context.deltaRsBegin();
-  std::vector<PosType> drifts(num_walkers);
-
-  // local list to handle accept/reject
-  std::vector<std::reference_wrapper<ParticleSet>> elec_accept_list, elec_reject_list;
-  std::vector<std::reference_wrapper<TrialWaveFunction>> twf_accept_list, twf_reject_list;
-  elec_accept_list.reserve(num_walkers);
-  elec_reject_list.reserve(num_walkers);
-  twf_accept_list.reserve(num_walkers);
-  twf_reject_list.reserve(num_walkers);
-
-  //copy the old energy
-  std::vector<FullPrecRealType> old_walker_energies(num_walkers);
-  auto setOldEnergies = [](MCPWalker& walker, FullPrecRealType& old_walker_energy) {
-    old_walker_energy = walker.Properties(LOCALENERGY);
-  };
-  for (int iw = 0; iw < num_walkers; ++iw)
-    setOldEnergies(walkers[iw], old_walker_energies[iw]);
-  std::vector<FullPrecRealType> new_walker_energies(old_walker_energies);
+  // per move scratch persists in the crowd
+  auto& drifts  = crowd.get_drifts();
+  auto& ratios  = crowd.get_ratios();
+  auto& log_gf  = crowd.get_log_gf();
+  auto& log_gb  = crowd.get_log_gb();
+  auto& probs   = crowd.get_prob();
+  auto& rr      = crowd.get_r2_proposed();
+  auto& rejects = crowd.get_node_rejects();
 
   std::vector<RealType> gf_acc(num_walkers, 1.0);
   std::vector<RealType> rr_proposed(num_walkers, 0.0);
@@ -131,7 +157,8 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
 
   //  dmc_timers_.dmc_movePbyP.start();
 
-  std::vector<int> did_walker_move(num_walkers, 0);
+  auto& did_walker_move = crowd.get_accepted_moves();
+  std::fill(did_walker_move.begin(), did_walker_move.end(), 0);
 
   for (int ig = 0; ig < step_context.get_num_groups(); ++ig)
   {
@@ -142,24 +169,19 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
     int end_index        = step_context.getPtclGroupEnd(ig);
     for (int iat = start_index; iat < end_index; ++iat)
     {
-      // Correct for DMC as well as VMC?
-      crowd.clearResults();
-      ParticleSet::flex_setActive(crowd.get_walker_elecs(), iat);
+      ParticleSet::flex_setActive(walker_elecs, iat);
       auto delta_r_start = it_delta_r + iat * num_walkers;
-      auto delta_r_end   = delta_r_start + num_walkers;
 
       //get the displacement
-      TrialWaveFunction::flex_evalGrad(crowd.get_walker_twfs(), crowd.get_walker_elecs(), iat, crowd.get_grads_now());
+      TrialWaveFunction::flex_evalGrad(walker_twfs, walker_elecs, iat, crowd.get_grads_now());
       sft.drift_modifier.getDrifts(tauovermass, crowd.get_grads_now(), drifts);
 
-      std::transform(drifts.begin(), drifts.end(), delta_r_start, drifts.begin(),
-                     [sqrttau](PosType& drift, PosType& delta_r) { return drift + (sqrttau * delta_r); });
-
-      // only DMC does this
-      // TODO: rr needs a real name
-      std::vector<RealType> rr(num_walkers);
-      std::transform(delta_r_start, delta_r_end, rr.begin(),
-                     [tauovermass](auto& delta_r) { return tauovermass * dot(delta_r, delta_r); });
+      // only DMC computes rr
+      for (int iw = 0; iw < num_walkers; ++iw)
+      {
+        drifts[iw] += sqrttau * delta_r_start[iw];
+        rr[iw] = tauovermass * dot(delta_r_start[iw], delta_r_start[iw]);
+      }
 
       // in DMC this was done here, changed to match VMCBatched pending factoring to common source
       // if (rr > m_r2max)
@@ -167,11 +189,9 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
       //   ++nRejectTemp;
       //   continue;
       // }
-      auto elecs = crowd.get_walker_elecs();
-      ParticleSet::flex_makeMove(crowd.get_walker_elecs(), iat, drifts);
+      ParticleSet::flex_makeMove(walker_elecs, iat, drifts);
 
-      TrialWaveFunction::flex_ratioGrad(crowd.get_walker_twfs(), crowd.get_walker_elecs(), iat, crowd.get_ratios(),
-                                        crowd.get_grads_new());
+      TrialWaveFunction::flex_ratioGrad(walker_twfs, walker_elecs, iat, ratios, crowd.get_grads_new());
 
       // This lambda is not nested thread safe due to the nreject, nnode_crossing updates
       auto checkPhaseChanged = [&sft, &iat, &crowd, &nnode_crossing](TrialWaveFunction& twf, ParticleSet& elec,
@@ -189,55 +209,46 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
       };
 
       // Hopefully a phase change doesn't make any of these transformations fail.
+      sft.drift_modifier.getDrifts(tauovermass, crowd.get_grads_new(), drifts);
 
-      std::vector<int> rejects(num_walkers);
+      // node check, Green's functions and acceptance probabilities in one pass
       for (int iw = 0; iw < num_walkers; ++iw)
       {
         checkPhaseChanged(walker_twfs[iw], walker_elecs[iw], rejects[iw]);
         //This is just convenient to do here
         rr_proposed[iw] += rr[iw];
+        const ParticleSet& elecs = walker_elecs[iw];
+        const PosType dr_back    = elecs.R[iat] - elecs.activePos - drifts[iw];
+        log_gf[iw]               = mhalf * dot(delta_r_start[iw], delta_r_start[iw]);
+        log_gb[iw]               = -oneover2tau * dot(dr_back, dr_back);
+        probs[iw]                = std::real(ratios[iw]) * std::real(ratios[iw]);
       }
-      std::transform(delta_r_start, delta_r_end, crowd.get_log_gf().begin(),
-                     [mhalf](auto& delta_r) { return mhalf * dot(delta_r, delta_r); });
-
-      sft.drift_modifier.getDrifts(tauovermass, crowd.get_grads_new(), drifts);
-
-      std::transform(crowd.beginElectrons(), crowd.endElectrons(), drifts.begin(), drifts.begin(),
-                     [iat](auto& elecs, auto& drift) { return elecs.get().R[iat] - elecs.get().activePos - drift; });
-
-      std::transform(drifts.begin(), drifts.end(), crowd.get_log_gb().begin(),
-                     [oneover2tau](auto& drift) { return -oneover2tau * dot(drift, drift); });
-
-      std::transform(crowd.get_ratios().begin(), crowd.get_ratios().end(), crowd.get_prob().begin(),
-                     [](auto ratio) { return std::real(ratio) * std::real(ratio); });
-
-      twf_accept_list.clear();
-      twf_reject_list.clear();
-      elec_accept_list.clear();
-      elec_reject_list.clear();
 
+      crowd.clearAcceptRejectLists();
+      auto& twf_accept_list  = crowd.get_twf_accept_list();
+      auto& twf_reject_list  = crowd.get_twf_reject_list();
+      auto& elec_accept_list = crowd.get_elec_accept_list();
+      auto& elec_reject_list = crowd.get_elec_reject_list();
 
       for (int iw = 0; iw < num_walkers; ++iw)
       {
-        auto prob   = crowd.get_prob()[iw];
-        auto log_gf = crowd.get_log_gf()[iw];
-        auto log_gb = crowd.get_log_gb()[iw];
+        auto prob = probs[iw];
 
         if ((!rejects[iw]) && prob >= std::numeric_limits<RealType>::epsilon() &&
-            step_context.get_random_gen()() < prob * std::exp(log_gb - log_gf))
+            step_context.get_random_gen()() < prob * std::exp(log_gb[iw] - log_gf[iw]))
         {
           did_walker_move[iw] += 1;
           crowd.incAccept();
-          twf_accept_list.push_back(crowd.get_walker_twfs()[iw]);
-          elec_accept_list.push_back(crowd.get_walker_elecs()[iw]);
+          twf_accept_list.push_back(walker_twfs[iw]);
+          elec_accept_list.push_back(walker_elecs[iw]);
           rr_accepted[iw] += rr[iw];
           gf_acc[iw] *= prob;
         }
         else
         {
           crowd.incReject();
-          twf_reject_list.push_back(crowd.get_walker_twfs()[iw]);
-          elec_reject_list.push_back(crowd.get_walker_elecs()[iw]);
+          twf_reject_list.push_back(walker_twfs[iw]);
+          elec_reject_list.push_back(walker_elecs[iw]);
         }
       }
 
@@ -255,11 +266,69 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   //dmc_timers.dmc_movePbyP.stop();
   timers.movepbyp_timer.stop();
 
-  //To use the flex interfaces we have to build RefVectors for walker that moved and walkers that didn't
+  // the walkers that moved save their state before the local energy evaluation
+  auto& walker_mcp_wfbuffers = crowd.get_mcp_wfbuffers();
+  RefVector<MCPWalker> moved_walkers;
+  RefVector<TrialWaveFunction> moved_twfs;
+  RefVector<ParticleSet> moved_elecs;
+  RefVector<WFBuffer> moved_mcp_wfbuffers;
+  moved_walkers.reserve(num_walkers);
+  moved_twfs.reserve(num_walkers);
+  moved_elecs.reserve(num_walkers);
+  moved_mcp_wfbuffers.reserve(num_walkers);
+  for (int iw = 0; iw < num_walkers; ++iw)
+    if (did_walker_move[iw] > 0)
+    {
+      moved_walkers.push_back(walkers[iw]);
+      moved_twfs.push_back(walker_twfs[iw]);
+      moved_elecs.push_back(walker_elecs[iw]);
+      moved_mcp_wfbuffers.push_back(walker_mcp_wfbuffers[iw]);
+    }
+
+  if (moved_walkers.size() > 0)
+  {
+    timers.buffer_timer.start();
+    TrialWaveFunction::flex_updateBuffer(moved_twfs, moved_elecs, moved_mcp_wfbuffers);
 
+    ParticleSet::flex_saveWalker(moved_elecs, moved_walkers);
+    timers.buffer_timer.stop();
+  }
+}
+
+void DMCBatched::evaluateLocalEnergy(Crowd& crowd, int iw)
+{
+  if (crowd.get_accepted_moves()[iw] > 0)
+  {
+    QMCHamiltonian& walker_hamiltonian = crowd.get_walker_hamiltonians()[iw];
+    crowd.get_local_energies()[iw]     = walker_hamiltonian.evaluateWithToperator(crowd.get_walker_elecs()[iw]);
+  }
+}
+
+void DMCBatched::finishStep(const StateForThread& sft,
+                            Crowd& crowd,
+                            DriverTimers& timers,
+                            ContextForSteps& step_context)
+{
+  int num_walkers            = crowd.size();
+  auto& walkers              = crowd.get_walkers();
+  auto& walker_twfs          = crowd.get_walker_twfs();
+  auto& walker_elecs         = crowd.get_walker_elecs();
   auto& walker_hamiltonians  = crowd.get_walker_hamiltonians();
   auto& walker_mcp_wfbuffers = crowd.get_mcp_wfbuffers();
+  auto& did_walker_move      = crowd.get_accepted_moves();
+  auto& local_energies       = crowd.get_local_energies();
+
+  //copy the old energy
+  std::vector<FullPrecRealType> old_walker_energies(num_walkers);
+  auto setOldEnergies = [](MCPWalker& walker, FullPrecRealType& old_walker_energy) {
+    old_walker_energy = walker.Properties(LOCALENERGY);
+  };
+  for (int iw = 0; iw < num_walkers; ++iw)
+    setOldEnergies(walkers[iw], old_walker_energies[iw]);
+  std::vector<FullPrecRealType> new_walker_energies(old_walker_energies);
+  std::vector<RealType> gf_acc(num_walkers, 1.0);
 
+  //To use the flex interfaces we have to build RefVectors for walker that moved and walkers that didn't
   int num_moved = 0;
   for (int iw = 0; iw < num_walkers; ++iw)
   {
@@ -269,6 +338,8 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
 
   DMCPerWalkerRefs moved(num_moved);
   DMCPerWalkerRefs stalled(num_walkers - num_moved);
+  std::vector<FullPrecRealType> moved_local_energies;
+  moved_local_energies.reserve(num_moved);
 
   for (int iw = 0; iw < num_walkers; ++iw)
   {
@@ -281,6 +352,7 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
       moved.walker_mcp_wfbuffers.push_back(walker_mcp_wfbuffers[iw]);
       moved.old_energies.push_back(old_walker_energies[iw]);
       moved.new_energies.push_back(new_walker_energies[iw]);
+      moved_local_energies.push_back(local_energies[iw]);
     }
     else
     {
@@ -297,33 +369,27 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
 
   if (moved.walkers.size() > 0)
   {
-    timers.buffer_timer.start();
-    TrialWaveFunction::flex_updateBuffer(moved.walker_twfs, moved.walker_elecs, moved.walker_mcp_wfbuffers);
-
-    ParticleSet::flex_saveWalker(moved.walker_elecs, moved.walkers);
-    timers.buffer_timer.stop();
-    timers.hamiltonian_timer.start();
-    // std::vector<QMCHamiltonian::FullPrecRealType> local_energies(QMCHamiltonian::flex_evaluate(moved.walker_hamiltonians, moved.walker_elecs));
-    std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
-        QMCHamiltonian::flex_evaluateWithToperator(moved.walker_hamiltonians, moved.walker_elecs));
-    timers.hamiltonian_timer.stop();
-
     auto resetSigNLocalEnergy = [](MCPWalker& walker, TrialWaveFunction& twf, auto& local_energy) {
       walker.resetProperty(twf.getLogPsi(), twf.getPhase(), local_energy);
     };
     for (int iw = 0; iw < moved.walkers.size(); ++iw)
     {
-      resetSigNLocalEnergy(moved.walkers[iw], moved.walker_twfs[iw], local_energies[iw]);
+      resetSigNLocalEnergy(moved.walkers[iw], moved.walker_twfs[iw], moved_local_energies[iw]);
       moved.walkers[iw].get().Weight *=
           sft.branch_engine.branchWeightBare(moved.new_energies[iw], moved.old_energies[iw]);
     }
 
     timers.collectables_timer.start();
-    auto evaluateNonPhysicalHamiltonianElements = [](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker) {
-      ham.auxHevaluate(pset, walker);
+    // the sampling estimators, e.g. the one body density matrices, draw from the generator of the crowd
+    auto evaluateNonPhysicalHamiltonianElements = [&step_context](QMCHamiltonian& ham, ParticleSet& pset,
+                                                                   MCPWalker& walker) {
+      ham.setRandomGenerator(&step_context.get_random_gen());
+      ham.auxHevaluate(pset, walker, true, false);
     };
     for (int iw = 0; iw < moved.walkers.size(); ++iw)
       evaluateNonPhysicalHamiltonianElements(moved.walker_hamiltonians[iw], moved.walker_elecs[iw], moved.walkers[iw]);
+    QMCHamiltonian::mw_auxHevaluateCollectables(moved.walker_hamiltonians, moved.walker_elecs, moved.walkers,
+                                                crowd.get_estimator_manager_crowd().get_step_collectables());
 
     auto savePropertiesIntoWalker = [](QMCHamiltonian& ham, MCPWalker& walker) {
       ham.saveProperty(walker.getPropertyBase());
@@ -353,7 +419,9 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   }
 
 
-  //myTimers[DMC_tmoves]->start();
+  // walkers can change crowds between steps, the T-moves draw from the generator of this crowd
+  for (int iw = 0; iw < walkers.size(); ++iw)
+    walker_hamiltonians[iw].get().setRandomGenerator(&step_context.get_random_gen());
   std::vector<int> walker_non_local_moves_accepted(
       QMCHamiltonian::flex_makeNonLocalMoves(walker_hamiltonians, walker_elecs));
 
@@ -374,7 +442,7 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   {
     DMCPerWalkerRefs moved_nonlocal(num_moved_nonlocal);
 
-    for (int iw = 0; iw < moved.walkers.size(); ++iw)
+    for (int iw = 0; iw < walkers.size(); ++iw)
     {
       if (walker_non_local_moves_accepted[iw] > 0)
       {
@@ -420,15 +488,47 @@ void DMCBatched::runDMCStep(int crowd_id,
                             std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
                             std::vector<std::unique_ptr<Crowd>>& crowds)
 {
-  Crowd& crowd  = *(crowds[crowd_id]);
+  Crowd& crowd = *(crowds[crowd_id]);
+  advanceWalkers(sft, crowd, timers, *context_for_steps[crowd_id], isRecomputeStep(sft));
+}
+
+bool DMCBatched::isRecomputeStep(const StateForThread& sft)
+{
   int max_steps = sft.qmcdrv_input.get_max_steps();
   // This is migraine inducing here and in the original driver, I believe they are the same in
   // VMC(Batched)/DMC(Batched) needs another check and unit test
   bool is_recompute_block =
       sft.recomputing_blocks ? (1 + sft.block) % sft.qmcdrv_input.get_blocks_between_recompute() == 0 : false;
-  IndexType step           = sft.step;
-  bool recompute_this_step = (is_recompute_block && (step + 1) == max_steps);
-  advanceWalkers(sft, crowd, timers, *context_for_steps[crowd_id], recompute_this_step);
+  IndexType step = sft.step;
+  return (is_recompute_block && (step + 1) == max_steps);
+}
+
+/** Runs a DMC step of all the crowds as tasks
+ *
+ *  The move sweep and the branching weights with the T-moves are crowd tasks,
+ *  the local energies of the moved walkers are walker tasks.
+ *  A thread done with its own crowd evaluates the local energies of the slower crowds.
+ *  The walker tasks draw from walker private generators reseeded by the crowd every step.
+ */
+void DMCBatched::runDMCStepTasks(const StateForThread& sft,
+                                 DriverTimers& timers,
+                                 std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
+                                 std::vector<std::unique_ptr<Crowd>>& crowds)
+{
+  const bool recompute_this_step = isRecomputeStep(sft);
+  auto sweep = [&](int crowd_id) {
+    sweepWalkers(sft, *crowds[crowd_id], timers, *context_for_steps[crowd_id], recompute_this_step);
+    context_for_steps[crowd_id]->seedWalkerRandomGens(crowds[crowd_id]->size());
+  };
+  auto crowdSize   = [&crowds](int crowd_id) { return crowds[crowd_id]->size(); };
+  auto localEnergy = [&](int crowd_id, int iw) {
+    QMCHamiltonian& walker_hamiltonian = crowds[crowd_id]->get_walker_hamiltonians()[iw];
+    walker_hamiltonian.setRandomGenerator(&context_for_steps[crowd_id]->get_walker_random_gen(iw));
+    evaluateLocalEnergy(*crowds[crowd_id], iw);
+  };
+  auto finish      = [&](int crowd_id) { finishStep(sft, *crowds[crowd_id], timers, *context_for_steps[crowd_id]); };
+  TasksPipeline<> step_tasks(Concurrency::maxThreads());
+  step_tasks(crowds.size(), sweep, crowdSize, localEnergy, finish);
 }
 
 bool DMCBatched::run()
@@ -448,15 +548,14 @@ bool DMCBatched::run()
   { // walker initialization
     ScopedTimer local_timer(&(timers_.init_walkers_timer));
     TasksOneToOne<> section_start_task(num_crowds_);
-    section_start_task(initialLogEvaluation, std::ref(crowds_));
+    section_start_task(initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_));
   }
 
-
-  TasksOneToOne<> crowd_task(num_crowds_);
-
   for (int block = 0; block < num_blocks; ++block)
   {
     dmc_loop.start();
+    // the crowd tuning can change the number of crowds between blocks
+    TasksOneToOne<> crowd_task(num_crowds_);
     estimator_manager_->startBlock(qmcdriver_input_.get_max_steps());
 
     dmc_state.recalculate_properties_period = (qmc_driver_mode_[QMC_UPDATE_MODE])
@@ -467,17 +566,24 @@ bool DMCBatched::run()
     for (auto& crowd : crowds_)
       crowd->startBlock(qmcdriver_input_.get_max_steps());
 
+    Timer block_timer;
+    double block_walker_steps = 0.0;
     for (int step = 0; step < qmcdriver_input_.get_max_steps(); ++step)
     {
       ScopedTimer local_timer(&(timers_.run_steps_timer));
       dmc_state.step = step;
-      crowd_task(runDMCStep, dmc_state, timers_, std::ref(step_contexts_), std::ref(crowds_));
+      block_walker_steps += population_.get_active_walkers();
+      if (qmcdriver_input_.get_crowd_tasks())
+        runDMCStepTasks(dmc_state, timers_, step_contexts_, crowds_);
+      else
+        crowd_task(runDMCStep, dmc_state, timers_, std::ref(step_contexts_), std::ref(crowds_));
       
       branch_engine_->branch(step, crowds_, population_);
       for( auto& crowd_ptr : crowds_)
         crowd_ptr->clearWalkers();
       population_.distributeWalkers(crowds_.begin(), crowds_.end(), walkers_per_crowd_);
     }
+    const double block_seconds = block_timer.elapsed();
 
     RefVector<ScalarEstimatorBase> all_scalar_estimators;
     FullPrecRealType total_block_weight = 0.0;
@@ -495,9 +601,11 @@ bool DMCBatched::run()
     total_accept_ratio /= crowds_.size();
     estimator_manager_->collectScalarEstimators(all_scalar_estimators, population_.get_num_local_walkers(),
                                                 total_block_weight);
+    estimator_manager_->collectCollectables();
     // TODO: should be accept rate for block
     estimator_manager_->stopBlockNew(total_accept_ratio);
 
+    tuneCrowds(block_walker_steps, block_seconds);
   }
   return false;
 }
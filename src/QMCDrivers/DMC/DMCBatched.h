@@ -100,6 +100,21 @@ public:
                              ContextForSteps& move_context,
                              bool recompute);
 
+  /** @name Stages of advanceWalkers
+   *  the move sweep with the buffer update of the moved walkers, the local energy of one walker
+   *  and the branching weights with the collectables and the T-moves.
+   *  The accepted moves and the local energies go through the Crowd.
+   *  @{
+   */
+  static void sweepWalkers(const StateForThread& sft,
+                           Crowd& crowd,
+                           DriverTimers& timers,
+                           ContextForSteps& move_context,
+                           bool recompute);
+  static void evaluateLocalEnergy(Crowd& crowd, int iw);
+  static void finishStep(const StateForThread& sft, Crowd& crowd, DriverTimers& timers, ContextForSteps& move_context);
+  /** @} */
+
   // This is the task body executed at crowd scope
   // it does not have access to object members by design
   static void runDMCStep(int crowd_id,
@@ -109,6 +124,15 @@ public:
                          std::vector<std::unique_ptr<ContextForSteps>>& move_context,
                          std::vector<std::unique_ptr<Crowd>>& crowds);
 
+  /// runs the step of all crowds with TasksPipeline, enabled by crowd_tasks
+  static void runDMCStepTasks(const StateForThread& sft,
+                              DriverTimers& timers,
+                              std::vector<std::unique_ptr<ContextForSteps>>& move_context,
+                              std::vector<std::unique_ptr<Crowd>>& crowds);
+
+  /// is this the last step of a block recomputing the wavefunction
+  static bool isRecomputeStep(const StateForThread& sft);
+
 
   QMCRunType getRunType() { return QMCRunType::DMC_BATCH; }
 
@@ -17,7 +17,9 @@ enum class QMCRunType
   CS_LINEAR_OPTIMIZE,
   WF_TEST,
   VMC_BATCH,
-  DMC_BATCH
+  DMC_BATCH,
+  RMC_BATCH,
+  CSVMC_BATCH
 };
 
 /** enum to set the bit to determine the QMC mode 
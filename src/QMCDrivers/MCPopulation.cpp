@@ -158,25 +158,27 @@ void MCPopulation::createWalkers(IndexType num_walkers)
 
 /** creates a walker and returns a reference
  *
- *  none of the objects are "reused"
- *  if an objects allocation is expensive this should be dealt with
- *  by reusing memory.
+ *  A walker killed earlier is recycled together with its ParticleSet, TrialWaveFunction
+ *  and QMCHamiltonian, its DataSet is already registered and allocated so the caller
+ *  only has to copy the walker state in. Only when no dead walker is available are the
+ *  objects cloned.
  */
 MCPopulation::MCPWalker& MCPopulation::spawnWalker()
 {
   ++num_local_walkers_;
-  auto it_walkers = walkers_.begin();
-  int walker_index;
-  while (it_walkers != walkers_.end())
+  if (!dead_walkers_.empty())
   {
-    if (*it_walkers == nullptr)
-    {
-      createWalkerInplace(*it_walkers);
-      allocateWalkerStuffInplace(walker_index);
-      return **it_walkers;
-    }
-    ++it_walkers;
-    ++walker_index;
+    walkers_.push_back(std::move(dead_walkers_.back()));
+    dead_walkers_.pop_back();
+    walker_elec_particle_sets_.push_back(std::move(dead_walker_elec_particle_sets_.back()));
+    dead_walker_elec_particle_sets_.pop_back();
+    walker_trial_wavefunctions_.push_back(std::move(dead_walker_trial_wavefunctions_.back()));
+    dead_walker_trial_wavefunctions_.pop_back();
+    walker_hamiltonians_.push_back(std::move(dead_walker_hamiltonians_.back()));
+    dead_walker_hamiltonians_.pop_back();
+    walkers_.back()->Weight       = 1.0;
+    walkers_.back()->Multiplicity = 1.0;
+    return *(walkers_.back());
   }
 
   walkers_.push_back(std::make_unique<MCPWalker>(num_particles_));
@@ -200,19 +202,31 @@ MCPopulation::MCPWalker& MCPopulation::spawnWalker()
 }
 
 /** Kill a walker
+ *
+ *  The walker and its ParticleSet, TrialWaveFunction and QMCHamiltonian are moved
+ *  to the dead pool for spawnWalker to reuse, the live vectors stay dense.
  */
 void MCPopulation::killWalker(MCPWalker& walker)
 {
-  --num_local_walkers_;
-  // find the walker and null its pointer in the walker vector
+  // find the walker and retire it with its objects
   auto it_walkers = walkers_.begin();
   while (it_walkers != walkers_.end())
   {
     if (&walker == (*it_walkers).get())
     {
-      (*it_walkers).reset(nullptr);
+      const int walker_index = it_walkers - walkers_.begin();
+      dead_walkers_.push_back(std::move(*it_walkers));
+      walkers_.erase(it_walkers);
+      dead_walker_elec_particle_sets_.push_back(std::move(walker_elec_particle_sets_[walker_index]));
+      walker_elec_particle_sets_.erase(walker_elec_particle_sets_.begin() + walker_index);
+      dead_walker_trial_wavefunctions_.push_back(std::move(walker_trial_wavefunctions_[walker_index]));
+      walker_trial_wavefunctions_.erase(walker_trial_wavefunctions_.begin() + walker_index);
+      dead_walker_hamiltonians_.push_back(std::move(walker_hamiltonians_[walker_index]));
+      walker_hamiltonians_.erase(walker_hamiltonians_.begin() + walker_index);
+      --num_local_walkers_;
       return;
     }
+    ++it_walkers;
   }
   throw std::runtime_error("Attempt to kill nonexistent walker in MCPopulation!");
 }
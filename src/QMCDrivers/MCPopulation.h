@@ -77,6 +77,11 @@ private:
   UPtrVector<ParticleSet> walker_elec_particle_sets_;
   UPtrVector<TrialWaveFunction> walker_trial_wavefunctions_;
   UPtrVector<QMCHamiltonian> walker_hamiltonians_;
+  // Killed walkers and their objects, recycled by spawnWalker so branching does not clone.
+  UPtrVector<MCPWalker> dead_walkers_;
+  UPtrVector<ParticleSet> dead_walker_elec_particle_sets_;
+  UPtrVector<TrialWaveFunction> dead_walker_trial_wavefunctions_;
+  UPtrVector<QMCHamiltonian> dead_walker_hamiltonians_;
   // This should perhaps just be aquired from comm but currently MCPopulation
   // is innocent of comm, Every object needing a copy is suboptimal.
   int rank_;
@@ -172,6 +177,7 @@ public:
   IndexType get_num_global_walkers() const { return num_global_walkers_; }
   IndexType update_num_global_walkers(Communicate* comm);
   IndexType get_num_local_walkers() const { return num_local_walkers_; }
+  IndexType get_num_dead_walkers() const { return dead_walkers_.size(); }
   IndexType get_num_particles() const { return num_particles_; }
   IndexType get_max_samples() const { return max_samples_; }
   IndexType get_target_population() const { return target_population_; }
@@ -154,6 +154,50 @@ void DescentEngine::takeSample(const int replica_id,
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 void DescentEngine::takeSample(FullPrecValueType local_en, FullPrecValueType vgs_samp, FullPrecValueType weight_samp) {}
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief  Function that Take Sample Data from the Host Code without building the sample vectors
+///
+/// \param[in]  dlogpsi        derivatives of the log of the wavefunction
+/// \param[in]  dhpsioverpsi   <n|H|Psi_i>/<n|Psi> - local_en*dlogpsi
+/// \param[in]  local_en       local energy
+/// \param[in]  weight_samp    weight for this sample
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+void DescentEngine::takeSample(const int replica_id,
+                               const std::vector<ValueType>& dlogpsi,
+                               const std::vector<ValueType>& dhpsioverpsi,
+                               FullPrecRealType local_en,
+                               FullPrecValueType weight_samp)
+{
+  std::vector<FullPrecValueType>& le_der_samp  = replica_le_der_samp_[replica_id];
+  std::vector<FullPrecValueType>& der_rat_samp = replica_der_rat_samp_[replica_id];
+
+  //Same accumulation as the sample vectors with the real parts of the derivatives
+  for (int i = 0; i < num_params_; i++)
+  {
+    const FullPrecRealType der_rat = std::real(dlogpsi[i]);
+    le_der_samp[i] += std::real(dhpsioverpsi[i]) + local_en * der_rat;
+    der_rat_samp[i] += der_rat;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief  Function that Take the Sample Data of a walker batch from the Host Code
+///
+/// \param[in]  dlogpsi_list        derivatives of the log of the wavefunction of each walker
+/// \param[in]  dhpsioverpsi_list   <n|H|Psi_i>/<n|Psi> - local_en*dlogpsi of each walker
+/// \param[in]  local_energies      local energy of each walker
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+void DescentEngine::takeSamples(const int replica_id,
+                                const std::vector<std::vector<ValueType>>& dlogpsi_list,
+                                const std::vector<std::vector<ValueType>>& dhpsioverpsi_list,
+                                const std::vector<FullPrecRealType>& local_energies)
+{
+  for (int iw = 0; iw < local_energies.size(); iw++)
+    takeSample(replica_id, dlogpsi_list[iw], dhpsioverpsi_list[iw], local_energies[iw], 1.0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief  Function that reduces all vector information from all processors to the root
 ///         processor
@@ -191,6 +235,18 @@ void DescentEngine::sample_finish()
 }
 
 
+//Stores the current derivatives, the record of the previous step is the only one kept
+void DescentEngine::storeDerivRecord()
+{
+  if (deriv_records_.size() == 2)
+  {
+    std::swap(deriv_records_.front(), deriv_records_.back());
+    deriv_records_.back() = lderivs_;
+  }
+  else
+    deriv_records_.push_back(lderivs_);
+}
+
 //Function for updating parameters during descent optimization
 void DescentEngine::updateParameters()
 {
@@ -201,14 +257,9 @@ void DescentEngine::updateParameters()
             << " CI_eta=" << ci_eta_ << " Orb_eta=" << orb_eta_ << std::endl;
 
   // Get set of derivatives for current (kth) optimization step
-  std::vector<ValueType> cur_deriv_set = deriv_records_.at(deriv_records_.size() - 1);
-  std::vector<ValueType> prev_deriv_set;
-
-  if (!taus_.empty())
-  {
-    // Get set of derivatives for previous (k-1th) optimization step
-    prev_deriv_set = deriv_records_.at(deriv_records_.size() - 2);
-  }
+  const std::vector<ValueType>& cur_deriv_set = deriv_records_.back();
+  // Get set of derivatives for previous (k-1th) optimization step, only used once taus_ is set
+  const std::vector<ValueType>& prev_deriv_set = deriv_records_.front();
 
   ValueType denom;
   ValueType numer;
@@ -507,7 +558,7 @@ void DescentEngine::setupUpdate(const optimize::VariableSet& my_vars)
 
 // Helper method for storing vectors of parameter differences over the course of
 // a descent optimization for use in BLM steps of the hybrid method
-void DescentEngine::storeVectors(std::vector<ValueType>& current_params)
+void DescentEngine::storeVectors(const std::vector<ValueType>& current_params)
 {
   std::vector<ValueType> row_vec(current_params.size(), 0.0);
 
@@ -63,7 +63,7 @@ private:
   //Vector for storing parameter values for current optimization step
   std::vector<ValueType> current_params_;
 
-  //Vector for storing Lagrangian derivatives from previous optimization steps
+  //Vector for storing Lagrangian derivatives from the current and the previous optimization steps
   std::vector<std::vector<ValueType>> deriv_records_;
 
   //Vector for storing step size denominator values from previous optimization step
@@ -158,6 +158,34 @@ public:
   ////////////////////////////////////////////////////////////////////////////////////////////////////////
   void takeSample(FullPrecValueType local_en, FullPrecValueType vgs_samp, FullPrecValueType weight_samp);
 
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief  Function that Take Sample Data from the Host Code without building the sample vectors
+  ///
+  /// \param[in]  dlogpsi        derivatives of the log of the wavefunction
+  /// \param[in]  dhpsioverpsi   <n|H|Psi_i>/<n|Psi> - local_en*dlogpsi
+  /// \param[in]  local_en       local energy
+  /// \param[in]  weight_samp    weight for this sample
+  ///
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////
+  void takeSample(const int replica_id,
+                  const std::vector<ValueType>& dlogpsi,
+                  const std::vector<ValueType>& dhpsioverpsi,
+                  FullPrecRealType local_en,
+                  FullPrecValueType weight_samp);
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief  Function that Take the Sample Data of a walker batch from the Host Code
+  ///
+  /// \param[in]  dlogpsi_list        derivatives of the log of the wavefunction of each walker
+  /// \param[in]  dhpsioverpsi_list   <n|H|Psi_i>/<n|Psi> - local_en*dlogpsi of each walker
+  /// \param[in]  local_energies      local energy of each walker
+  ///
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////
+  void takeSamples(const int replica_id,
+                   const std::vector<std::vector<ValueType>>& dlogpsi_list,
+                   const std::vector<std::vector<ValueType>>& dhpsioverpsi_list,
+                   const std::vector<FullPrecRealType>& local_energies);
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////////
   /// \brief  Function that reduces all vector information from all processors to the root
   ///         processor
@@ -175,13 +203,14 @@ public:
   ValueType setStepSize(int i);
 
   //stores derivatives so they can be used in accelerated descent algorithm on later iterations
-  void storeDerivRecord() { deriv_records_.push_back(lderivs_); }
+  //only the current and the previous sets are kept
+  void storeDerivRecord();
 
   //helper method for transferring information on parameter names and types to the engine
   void setupUpdate(const optimize::VariableSet& my_vars);
 
   //Store a vector of parameter differences to be used by the BLM in a hybrid optimization
-  void storeVectors(std::vector<ValueType>& current_params);
+  void storeVectors(const std::vector<ValueType>& current_params);
 
   //Returns number of times a parameter difference vector will be stored in the optimization
   int retrieveStoreFrequency() const { return store_num_; }
@@ -403,6 +403,9 @@ void QMCCostFunction::engine_checkConfigurations(cqmc::engine::LMYEngine* Engine
     //       Return_t ef=0.0;
     Return_rt e2 = 0.0;
 
+    //derivative vectors reused by all the samples of this thread
+    std::vector<Return_t> Dsaved(needGrads ? NumOptimizables : 0);
+    std::vector<Return_t> HDsaved(needGrads ? NumOptimizables : 0);
 
     for (int iw = 0, iwg = wPerNode[ip]; iw < wRef.numSamples(); ++iw, ++iwg)
     {
@@ -414,53 +417,37 @@ void QMCCostFunction::engine_checkConfigurations(cqmc::engine::LMYEngine* Engine
       Return_rt etmp;
       if (needGrads)
       {
-        //allocate vector
-        std::vector<Return_t> Dsaved(NumOptimizables, 0.0);
-        std::vector<Return_t> HDsaved(NumOptimizables, 0.0);
-
-        std::vector<Return_rt> rDsaved(NumOptimizables, 0.0);
-        std::vector<Return_rt> rHDsaved(NumOptimizables, 0.0);
+        std::fill(Dsaved.begin(), Dsaved.end(), 0.0);
+        std::fill(HDsaved.begin(), HDsaved.end(), 0.0);
 
         psiClones[ip]->evaluateDerivatives(wRef, OptVariablesForPsi, Dsaved, HDsaved);
         etmp = hClones[ip]->evaluateValueAndDerivatives(wRef, OptVariablesForPsi, Dsaved, HDsaved, compute_nlpp);
 
-
-        //FIXME The ifdef should be removed after the optimizer is compatible with complex wave function parameters
-        for (int i = 0; i < NumOptimizables; i++)
+#ifdef HAVE_LMY_ENGINE
+        if (MinMethod == "adaptive")
         {
-          rDsaved[i]  = std::real(Dsaved[i]);
-          rHDsaved[i] = std::real(HDsaved[i]);
-        }
-
-        // add non-differentiated derivative vector
-        std::vector<Return_rt> der_rat_samp(NumOptimizables + 1, 0.0);
-        std::vector<Return_rt> le_der_samp(NumOptimizables + 1, 0.0);
+          // add non-differentiated derivative vector
+          std::vector<Return_rt> der_rat_samp(NumOptimizables + 1, 0.0);
+          std::vector<Return_rt> le_der_samp(NumOptimizables + 1, 0.0);
 
-        // dervative vectors
-        der_rat_samp.at(0) = 1.0;
-        for (int i = 0; i < rDsaved.size(); i++)
-          der_rat_samp.at(i + 1) = rDsaved.at(i);
+          //FIXME The real parts should be removed after the optimizer is compatible with complex wave function parameters
+          // dervative vectors
+          der_rat_samp.at(0) = 1.0;
+          for (int i = 0; i < NumOptimizables; i++)
+            der_rat_samp.at(i + 1) = std::real(Dsaved[i]);
 
-        // energy dervivatives
-        le_der_samp.at(0) = etmp;
-        for (int i = 0; i < rHDsaved.size(); i++)
-          le_der_samp.at(i + 1) = rHDsaved.at(i) + etmp * rDsaved.at(i);
+          // energy dervivatives
+          le_der_samp.at(0) = etmp;
+          for (int i = 0; i < NumOptimizables; i++)
+            le_der_samp.at(i + 1) = std::real(HDsaved[i]) + etmp * std::real(Dsaved[i]);
 
-#ifdef HAVE_LMY_ENGINE
-        if (MinMethod == "adaptive")
-        {
           // pass into engine
           EngineObj->take_sample(der_rat_samp, le_der_samp, le_der_samp, 1.0, saved[REWEIGHT]);
         }
         else if (MinMethod == "descent")
         {
-	    //Could remove this copying over if LM engine becomes compatible with complex numbers
-	    //so that der_rat_samp and le_der_samp are vectors of std::complex<double> when QMC_COMPLEX=1
-	    std::vector<FullPrecValueType> der_rat_samp_comp(der_rat_samp.begin(),der_rat_samp.end());
-	    std::vector<FullPrecValueType> le_der_samp_comp(le_der_samp.begin(),le_der_samp.end());
-	    
-
-          descentEngineObj.takeSample(ip, der_rat_samp_comp, le_der_samp_comp, le_der_samp_comp, 1.0, saved[REWEIGHT]);
+          // the engine reduces the derivatives as they come without the sample vectors
+          descentEngineObj.takeSample(ip, Dsaved, HDsaved, etmp, saved[REWEIGHT]);
         }
 #endif
       }
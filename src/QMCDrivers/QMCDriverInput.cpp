@@ -62,8 +62,11 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   parameter_set.add(tau_, "tau", "AU");
   parameter_set.add(max_cpu_secs_, "maxcpusecs", "real");
   parameter_set.add(blocks_between_recompute_, "blocks_between_recompute", "int");
+  parameter_set.add(crowd_tuning_blocks_, "crowd_tuning_blocks", "int");
   parameter_set.add(drift_modifier_, "drift_modifier", "string");
   parameter_set.add(drift_modifier_unr_a_, "drift_UNR_a", "double");
+  std::string crowd_tasks("no");
+  parameter_set.add(crowd_tasks, "crowd_tasks", "string");
 
   OhmmsAttributeSet aAttrib;
 
@@ -118,6 +121,7 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
 
   if (check_point_period_.period < 1)
     check_point_period_.period = max_blocks_;
+  crowd_tasks_ = (crowd_tasks == "yes");
 }
 
 } // namespace qmcplusplus
@@ -90,7 +90,10 @@ protected:
   RealType tau_                       = 0.1;
   IndexType max_cpu_secs_             = 360000;
   IndexType blocks_between_recompute_ = defaultBlocksBetweenRecompute<>();
+  IndexType crowd_tuning_blocks_      = 0;
   bool append_run_                    = false;
+  /// run the crowd steps as tasks, the local energies of all crowds are shared among the threads
+  bool crowd_tasks_                   = false;
 
   // from QMCDriverFactory
   std::string qmc_method_{"invalid"};
@@ -129,6 +132,8 @@ public:
   RealType get_tau() const { return tau_; }
   IndexType get_max_cpu_secs() const { return max_cpu_secs_; }
   IndexType get_blocks_between_recompute() const { return blocks_between_recompute_; }
+  IndexType get_crowd_tuning_blocks() const { return crowd_tuning_blocks_; }
+  bool get_crowd_tasks() const { return crowd_tasks_; }
   bool get_append_run() const { return append_run_; }
   input::PeriodStride get_walker_dump_period() const { return walker_dump_period_; }
   input::PeriodStride get_check_point_period() const { return check_point_period_; }
@@ -121,7 +121,8 @@ void QMCDriverNew::process(xmlNodePtr cur)
   RandomNumberControl::make_seeds();
   // }
 
-  
+  // T-moves options, the walker Hamiltonians cloned by setupWalkers inherit them
+  H.setNonLocalMoves(cur);
   setupWalkers();
 
   // If you really want to persist the MCPopulation it is not the business of QMCDriver to reset it.
@@ -170,6 +171,24 @@ void QMCDriverNew::process(xmlNodePtr cur)
   // Once they are created move contexts can be created.
   createRngsStepContexts();
 
+  crowd_tuner_.reset(new CrowdTuner(num_crowds_,
+                                    std::min<IndexType>(Concurrency::maxThreads(), population_.get_active_walkers()),
+                                    population_.get_active_walkers(), qmcdriver_input_.get_crowd_tuning_blocks(),
+                                    myComm));
+  // all the ranks start the tuning from the smallest number of crowds of any rank
+  if (crowd_tuner_->isTuning() && crowd_tuner_->get_num_crowds() != num_crowds_)
+    redistributeCrowds(crowd_tuner_->get_num_crowds());
+  if (crowd_tuner_->isTuning())
+  {
+    app_log() << "  Crowd tuning over " << qmcdriver_input_.get_crowd_tuning_blocks() << " blocks per candidate of";
+    for (int nc : crowd_tuner_->get_candidates())
+      app_log() << " " << nc;
+    app_log() << " crowds" << std::endl;
+  }
+  if (qmcdriver_input_.get_crowd_tasks())
+    app_log() << "  Crowd steps run as tasks, the local energies are balanced over "
+              << Concurrency::maxThreads() << " threads" << std::endl;
+
   // if (wOut == 0)
   //   wOut = new HDFWalkerOutput(W, root_name_, myComm);
   branch_engine_->start(root_name_);
@@ -367,9 +386,57 @@ void QMCDriverNew::createRngsStepContexts()
   }
 }
 
-void QMCDriverNew::initialLogEvaluation(int crowd_id, UPtrVector<Crowd>& crowds)
+void QMCDriverNew::redistributeCrowds(int num_crowds)
+{
+  const IndexType num_walkers = population_.get_active_walkers();
+  // the same rounding as the candidates of the tuner
+  num_crowds_        = CrowdTuner::realizable(num_crowds, num_walkers);
+  walkers_per_crowd_ = (num_walkers + num_crowds_ - 1) / num_crowds_;
+
+  for (auto& crowd : crowds_)
+    crowd->clearWalkers();
+  crowds_.resize(num_crowds_);
+  for (auto& crowd : crowds_)
+  {
+    if (!crowd)
+      crowd.reset(new Crowd(*estimator_manager_));
+    crowd->reserve(walkers_per_crowd_);
+  }
+  population_.distributeWalkers(crowds_.begin(), crowds_.end(), walkers_per_crowd_);
+
+  // keep the streams of the generators in use, a fresh child is only used once
+  for (int i = Rng.size(); i < num_crowds_; ++i)
+    Rng.emplace_back(new RandomGenerator_t(*(RandomNumberControl::Children[i])));
+  step_contexts_.resize(num_crowds_);
+  for (int i = 0; i < num_crowds_; ++i)
+    step_contexts_[i].reset(new ContextForSteps(crowds_[i]->size(), population_.get_num_particles(),
+                                                population_.get_particle_group_indexes(), *(Rng[i])));
+}
+
+void QMCDriverNew::accumulateCollectables()
+{
+  RefVector<EstimatorManagerCrowd> crowd_ems;
+  for (UPtr<Crowd>& crowd : crowds_)
+    crowd_ems.push_back(crowd->get_estimator_manager_crowd());
+  estimator_manager_->accumulateCollectables(crowd_ems);
+}
+
+void QMCDriverNew::tuneCrowds(double walker_steps, double seconds)
+{
+  if (!crowd_tuner_ || !crowd_tuner_->isTuning())
+    return;
+  if (crowd_tuner_->recordBlock(walker_steps, seconds, num_crowds_, myComm))
+    redistributeCrowds(crowd_tuner_->get_num_crowds());
+  if (!crowd_tuner_->isTuning())
+    crowd_tuner_->report(app_log());
+}
+
+void QMCDriverNew::initialLogEvaluation(int crowd_id,
+                                        UPtrVector<Crowd>& crowds,
+                                        UPtrVector<ContextForSteps>& context_for_steps)
 {
   Crowd& crowd = *(crowds[crowd_id]);
+  ContextForSteps& step_context = *(context_for_steps[crowd_id]);
   auto& walker_twfs  = crowd.get_walker_twfs();
   auto& mcp_buffers  = crowd.get_mcp_wfbuffers();
   auto& walker_elecs = crowd.get_walker_elecs();
@@ -407,7 +474,8 @@ void QMCDriverNew::initialLogEvaluation(int crowd_id, UPtrVector<Crowd>& crowds)
   for (int iw = 0; iw < crowd.size(); ++iw)
     resetSigNLocalEnergy(walkers[iw], walker_twfs[iw], local_energies[iw]);
 
-  auto evaluateNonPhysicalHamiltonianElements = [](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker){
+  auto evaluateNonPhysicalHamiltonianElements = [&step_context](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker){
+                                                   ham.setRandomGenerator(&step_context.get_random_gen());
                                                    ham.auxHevaluate(pset, walker);
                                                  };
   for (int iw = 0; iw < crowd.size(); ++iw)
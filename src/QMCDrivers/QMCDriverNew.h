@@ -37,6 +37,7 @@
 #include "QMCDrivers/BranchIO.h"
 #include "QMCDrivers/QMCDriverInput.h"
 #include "QMCDrivers/ContextForSteps.h"
+#include "QMCDrivers/CrowdTuner.h"
 
 class Communicate;
 
@@ -127,6 +128,28 @@ public:
 
   void createRngsStepContexts();
 
+  /** change the number of crowds and distribute the local walkers over them
+   * @param num_crowds requested number of crowds, reduced if there are not enough walkers
+   *
+   *  Only between blocks, the crowd estimators must have been collected.
+   *  The random generators of the crowds are kept, new crowds take unused children.
+   */
+  void redistributeCrowds(int num_crowds);
+
+  /** record the throughput of a block for the crowd tuning
+   * @param walker_steps walker moves of the block
+   * @param seconds wall time of the block steps
+   *
+   *  Changes the number of crowds when the tuner moves to the next candidate or selects.
+   */
+  void tuneCrowds(double walker_steps, double seconds);
+
+  /** accumulate the collectables the crowds binned in a step
+   *
+   *  Normalized by the walker weight of all the crowds, call after every crowd finished the step.
+   */
+  void accumulateCollectables();
+
   void setupWalkers();
 
   void putWalkers(std::vector<xmlNodePtr>& wset);
@@ -178,7 +201,7 @@ public:
    */
   void process(xmlNodePtr cur);
 
-  static void initialLogEvaluation(int crowd_id, UPtrVector<Crowd>& crowds);
+  static void initialLogEvaluation(int crowd_id, UPtrVector<Crowd>& crowds, UPtrVector<ContextForSteps>& context_for_steps);
 
   /** should be set in input don't see a reason to set individually
    * @param pbyp if true, use particle-by-particle update
@@ -287,6 +310,9 @@ protected:
    */
   std::vector<std::unique_ptr<ContextForSteps>> step_contexts_;
 
+  /// selects the number of crowds during the first blocks if crowd_tuning_blocks > 0
+  std::unique_ptr<CrowdTuner> crowd_tuner_;
+
   ///a list of TrialWaveFunctions for multiple method
   std::vector<TrialWaveFunction*> Psi1;
 
@@ -1347,7 +1347,7 @@ bool QMCFixedSampleLinearOptimize::descent_run()
 
   descentEngineObj->updateParameters();
 
-  std::vector<ValueType> results = descentEngineObj->retrieveNewParams();
+  const std::vector<ValueType>& results = descentEngineObj->retrieveNewParams();
 
 
   for (int i = 0; i < results.size(); i++)
@@ -1387,7 +1387,7 @@ bool QMCFixedSampleLinearOptimize::hybrid_run()
     //of vectors to the BLM engine.
     if (previous_optimizer_type_ == OptimizerType::DESCENT)
     {
-      std::vector<std::vector<ValueType>> hybridBLM_Input = descentEngineObj->retrieveHybridBLM_Input();
+      const std::vector<std::vector<ValueType>>& hybridBLM_Input = descentEngineObj->retrieveHybridBLM_Input();
 #if !defined(QMC_COMPLEX)
       //FIXME once complex is fixed in BLM engine
       EngineObj->setHybridBLM_Input(hybridBLM_Input);
@@ -166,6 +166,7 @@ void QMCUpdateBase::stopRun2()
 void QMCUpdateBase::startBlock(int steps)
 {
   Estimators->startBlock(steps);
+  H.startBlock();
 #if !defined(REMOVE_TRACEMANAGER)
   Traces->startBlock(steps);
 #endif
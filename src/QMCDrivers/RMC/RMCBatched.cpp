@@ -0,0 +1,409 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File refactored from: RMC.cpp and RMCUpdatePbyP.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "QMCDrivers/RMC/RMCBatched.h"
+#include "Concurrency/TasksOneToOne.hpp"
+#include "Concurrency/Info.hpp"
+#include "Utilities/Timer.h"
+#include "ParticleBase/RandomSeqGenerator.h"
+#include "Estimators/CollectablesEstimator.h"
+
+namespace qmcplusplus
+{
+/** Constructor maintains proper ownership of input parameters
+   */
+RMCBatched::RMCBatched(QMCDriverInput&& qmcdriver_input,
+                       RMCDriverInput&& input,
+                       MCPopulation& pop,
+                       TrialWaveFunction& psi,
+                       QMCHamiltonian& h,
+                       WaveFunctionPool& wf_pool,
+                       Communicate* comm)
+    : QMCDriverNew(std::move(qmcdriver_input), pop, psi, h, wf_pool, "RMCBatched::", comm), rmcdriver_input_(input)
+{
+  QMCType = "RMCBatched";
+}
+
+QMCTraits::IndexType RMCBatched::calc_default_local_walkers(IndexType walkers_per_rank)
+{
+  checkNumCrowdsLTNumThreads();
+  int num_threads(Concurrency::maxThreads<>());
+  IndexType rw = walkers_per_rank;
+  if (num_crowds_ == 0)
+    num_crowds_ = std::min(num_threads, rw);
+  walkers_per_crowd_ = (rw % num_crowds_) ? rw / num_crowds_ + 1 : rw / num_crowds_;
+
+  IndexType local_walkers = walkers_per_crowd_ * num_crowds_;
+  population_.set_num_local_walkers(local_walkers);
+  population_.set_num_global_walkers(local_walkers * population_.get_num_ranks());
+  if (rw != qmcdriver_input_.get_walkers_per_rank())
+    app_warning() << "RMCBatched driver has adjusted walkers per rank to: " << local_walkers << '\n';
+
+  app_log() << "RMCBatched reptiles per crowd " << walkers_per_crowd_ << std::endl;
+  return local_walkers;
+}
+
+void RMCBatched::sweepHeads(const StateForThread& sft,
+                            Crowd& crowd,
+                            DriverTimers& timers,
+                            ContextForSteps& step_context,
+                            std::vector<ReptileBeads>& reptiles)
+{
+  timers.buffer_timer.start();
+  crowd.loadWalkers();
+
+  auto& walker_twfs  = crowd.get_walker_twfs();
+  auto& walkers      = crowd.get_walkers();
+  auto& walker_elecs = crowd.get_walker_elecs();
+  for (int iw = 0; iw < crowd.size(); ++iw)
+    walker_twfs[iw].get().copyFromBuffer(walker_elecs[iw], walkers[iw].get().DataSet);
+  timers.buffer_timer.stop();
+
+  timers.movepbyp_timer.start();
+  int num_walkers = crowd.size();
+  constexpr RealType mhalf(-0.5);
+  for (ReptileBeads& reptile : reptiles)
+    reptile.resetMoveStats();
+  //This generates an entire steps worth of deltas.
+  step_context.nextDeltaRs(num_walkers);
+  auto it_delta_r = step_context.deltaRsBegin();
+  auto& drifts    = crowd.get_drifts();
+  auto& ratios    = crowd.get_ratios();
+  auto& log_gf    = crowd.get_log_gf();
+  auto& log_gb    = crowd.get_log_gb();
+  auto& probs     = crowd.get_prob();
+
+  for (int ig = 0; ig < step_context.get_num_groups(); ++ig) //loop over species
+  {
+    RealType tauovermass = sft.qmcdrv_input.get_tau() * sft.population.get_ptclgrp_inv_mass()[ig];
+    RealType oneover2tau = 0.5 / (tauovermass);
+    RealType sqrttau     = std::sqrt(tauovermass);
+    int start_index      = step_context.getPtclGroupStart(ig);
+    int end_index        = step_context.getPtclGroupEnd(ig);
+    for (int iat = start_index; iat < end_index; ++iat)
+    {
+      ParticleSet::flex_setActive(walker_elecs, iat);
+      auto delta_r_start = it_delta_r + iat * num_walkers;
+
+      TrialWaveFunction::flex_evalGrad(walker_twfs, walker_elecs, iat, crowd.get_grads_now());
+      sft.drift_modifier.getDrifts(tauovermass, crowd.get_grads_now(), drifts);
+      for (int iw = 0; iw < num_walkers; ++iw)
+        drifts[iw] += sqrttau * delta_r_start[iw];
+
+      ParticleSet::flex_makeMove(walker_elecs, iat, drifts);
+
+      TrialWaveFunction::flex_ratioGrad(walker_twfs, walker_elecs, iat, ratios, crowd.get_grads_new());
+      sft.drift_modifier.getDrifts(tauovermass, crowd.get_grads_new(), drifts);
+      for (int iw = 0; iw < num_walkers; ++iw)
+      {
+        const ParticleSet& elecs = walker_elecs[iw];
+        const PosType dr_back    = elecs.R[iat] - elecs.activePos - drifts[iw];
+        log_gf[iw]               = mhalf * dot(delta_r_start[iw], delta_r_start[iw]);
+        log_gb[iw]               = -oneover2tau * dot(dr_back, dr_back);
+        probs[iw]                = std::real(ratios[iw]) * std::real(ratios[iw]);
+      }
+
+      crowd.clearAcceptRejectLists();
+      auto& twf_accept_list  = crowd.get_twf_accept_list();
+      auto& twf_reject_list  = crowd.get_twf_reject_list();
+      auto& elec_accept_list = crowd.get_elec_accept_list();
+      auto& elec_reject_list = crowd.get_elec_reject_list();
+
+      for (int iw = 0; iw < num_walkers; ++iw)
+      {
+        ReptileBeads& reptile = reptiles[iw];
+        const RealType rr     = tauovermass * dot(delta_r_start[iw], delta_r_start[iw]);
+        reptile.rr_proposed += rr;
+        //node is crossed reject the move
+        if (!sft.branch_engine.phaseChanged(std::arg(ratios[iw])) &&
+            step_context.get_random_gen()() < probs[iw] * std::exp(log_gb[iw] - log_gf[iw]))
+        {
+          ++reptile.num_accepted;
+          reptile.rr_accepted += rr;
+          twf_accept_list.push_back(walker_twfs[iw]);
+          elec_accept_list.push_back(walker_elecs[iw]);
+        }
+        else
+        {
+          twf_reject_list.push_back(walker_twfs[iw]);
+          elec_reject_list.push_back(walker_elecs[iw]);
+        }
+      }
+
+      TrialWaveFunction::flex_acceptMove(twf_accept_list, elec_accept_list, iat);
+      TrialWaveFunction::flex_rejectMove(twf_reject_list, iat);
+
+      ParticleSet::flex_acceptMove(elec_accept_list, iat);
+      ParticleSet::flex_rejectMove(elec_reject_list, iat);
+    }
+  }
+  std::for_each(walker_twfs.begin(), walker_twfs.end(), [](auto& twf) { twf.get().completeUpdates(); });
+
+  ParticleSet::flex_donePbyP(walker_elecs);
+  timers.movepbyp_timer.stop();
+
+  timers.buffer_timer.start();
+  TrialWaveFunction::flex_updateBuffer(walker_twfs, walker_elecs, crowd.get_mcp_wfbuffers());
+  for (int iw = 0; iw < crowd.size(); ++iw)
+    walker_elecs[iw].get().saveWalker(walkers[iw]);
+  timers.buffer_timer.stop();
+}
+
+/** Accepts or rejects the proposed heads of the reptiles of a crowd
+ *
+ *  The proposed head is the walker of the reptile, on acceptance it overwrites the tail which becomes the head.
+ *  On rejection the reptile bounces and the walker continues from the new head.
+ */
+void RMCBatched::moveReptiles(const StateForThread& sft,
+                              Crowd& crowd,
+                              DriverTimers& timers,
+                              ContextForSteps& step_context,
+                              std::vector<ReptileBeads>& reptiles)
+{
+  auto& walkers             = crowd.get_walkers();
+  auto& walker_twfs         = crowd.get_walker_twfs();
+  auto& walker_elecs        = crowd.get_walker_elecs();
+  auto& walker_hamiltonians = crowd.get_walker_hamiltonians();
+  auto& local_energies      = crowd.get_local_energies();
+  const IndexType max_age   = sft.rmcdrv_input.get_max_age();
+
+  timers.collectables_timer.start();
+  for (int iw = 0; iw < crowd.size(); ++iw)
+  {
+    ReptileBeads& reptile   = reptiles[iw];
+    MCPWalker& prophead     = walkers[iw];
+    MCPWalker& curhead      = reptile.getHead();
+    QMCHamiltonian& ham     = walker_hamiltonians[iw];
+    // In the rare case that all proposed moves fail, we bounce.
+    bool accept = reptile.num_accepted > 0 && sft.unrolling;
+    if (reptile.num_accepted > 0 && !sft.unrolling)
+    {
+      MCPWalker& lastbead     = reptile.getTail();
+      MCPWalker& nextlastbead = reptile.getNext();
+      RealType dS = sft.branch_engine.DMCLinkAction(local_energies[iw], curhead.Properties(LOCALENERGY)) -
+          sft.branch_engine.DMCLinkAction(lastbead.Properties(LOCALENERGY), nextlastbead.Properties(LOCALENERGY));
+      RealType accept_prob = std::min(static_cast<RealType>(1.0), std::exp(-dS));
+      accept = (step_context.get_random_gen()() <= accept_prob) || curhead.Age >= max_age || lastbead.Age >= max_age;
+    }
+
+    if (accept)
+    {
+      TrialWaveFunction& twf = walker_twfs[iw];
+      prophead.resetProperty(twf.getLogPsi(), twf.getPhase(), local_energies[iw], reptile.rr_accepted,
+                             reptile.rr_proposed, 0.0);
+      prophead.Weight = 1.0;
+      ham.setRandomGenerator(&step_context.get_random_gen());
+      ham.auxHevaluate(walker_elecs[iw], prophead, true, false); //evaluate properties but not collectables.
+      ham.saveProperty(prophead.getPropertyBase());
+      prophead.Age         = 0;
+      reptile.getNewHead() = prophead;
+      crowd.incAccept();
+    }
+    else
+    {
+      ham.rejectedMove(walker_elecs[iw], prophead);
+      curhead.Properties(R2ACCEPTED) = 0.0;
+      curhead.Properties(R2PROPOSED) = reptile.rr_proposed;
+      curhead.Age += 1;
+      if (!sft.unrolling)
+        reptile.flip();
+      // the wavefunction of the new head is restored from its buffer by the next sweep
+      prophead = reptile.getHead();
+      crowd.incReject();
+    }
+  }
+
+  if (!sft.unrolling)
+  {
+    //Collectables should be evaluated on center bead.
+    RefVector<MCPWalker> centers;
+    centers.reserve(crowd.size());
+    for (int iw = 0; iw < crowd.size(); ++iw)
+    {
+      MCPWalker& centerbead = reptiles[iw].getCenter();
+      ParticleSet& elecs    = walker_elecs[iw];
+      elecs.loadWalker(centerbead, true);
+      elecs.update(); //Called to recompute S(k) and distance tables.
+      centers.push_back(centerbead);
+    }
+    QMCHamiltonian::mw_auxHevaluateCollectables(walker_hamiltonians, walker_elecs, centers,
+                                                crowd.get_estimator_manager_crowd().get_step_collectables());
+  }
+  timers.collectables_timer.stop();
+}
+
+void RMCBatched::advanceReptiles(const StateForThread& sft,
+                                 Crowd& crowd,
+                                 DriverTimers& timers,
+                                 ContextForSteps& step_context,
+                                 std::vector<ReptileBeads>& reptiles)
+{
+  sweepHeads(sft, crowd, timers, step_context, reptiles);
+
+  timers.hamiltonian_timer.start();
+  const std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
+      QMCHamiltonian::flex_evaluate(crowd.get_walker_hamiltonians(), crowd.get_walker_elecs()));
+  std::copy(local_energies.begin(), local_energies.end(), crowd.get_local_energies().begin());
+  timers.hamiltonian_timer.stop();
+
+  moveReptiles(sft, crowd, timers, step_context, reptiles);
+}
+
+/** Thread body for RMC step
+ *
+ *  The center beads are the samples of the estimators.
+ */
+void RMCBatched::runRMCStep(int crowd_id,
+                            const StateForThread& sft,
+                            DriverTimers& timers,
+                            std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
+                            std::vector<std::unique_ptr<Crowd>>& crowds,
+                            std::vector<std::vector<ReptileBeads>>& crowd_reptiles)
+{
+  Crowd& crowd                       = *(crowds[crowd_id]);
+  std::vector<ReptileBeads>& reptiles = crowd_reptiles[crowd_id];
+  advanceReptiles(sft, crowd, timers, *context_for_steps[crowd_id], reptiles);
+
+  RefVector<MCPWalker> centers;
+  centers.reserve(reptiles.size());
+  for (ReptileBeads& reptile : reptiles)
+    centers.push_back(reptile.getCenter());
+  crowd.get_estimator_manager_crowd().accumulate(sft.population.get_num_global_walkers(), centers,
+                                                 crowd.get_walker_elecs());
+}
+
+void RMCBatched::initReptiles(StateForThread& rmc_state)
+{
+  const IndexType num_beads = rmcdriver_input_.get_num_beads(qmcdriver_input_.get_tau());
+  app_log() << "  Projection time:  " << num_beads * qmcdriver_input_.get_tau() << " Ha^-1" << std::endl;
+  app_log() << "  Beads per reptile = " << num_beads << std::endl;
+
+  crowd_reptiles_.clear();
+  crowd_reptiles_.resize(crowds_.size());
+  for (int crowd_id = 0; crowd_id < crowds_.size(); ++crowd_id)
+  {
+    auto& walkers = crowds_[crowd_id]->get_walkers();
+    crowd_reptiles_[crowd_id].reserve(walkers.size());
+    for (MCPWalker& walker : walkers)
+      crowd_reptiles_[crowd_id].emplace_back(num_beads, walker);
+  }
+  branch_engine_->initReptile(population_);
+
+  //this will "unroll" the reptiles according to forced VMC steps (no bounce).
+  IndexType vmc_presteps =
+      (rmcdriver_input_.get_vmc_presteps() < 0) ? num_beads + 2 : rmcdriver_input_.get_vmc_presteps();
+  auto runUnrollStep = [](int crowd_id, StateForThread& sft, DriverTimers& timers,
+                          UPtrVector<ContextForSteps>& context_for_steps, UPtrVector<Crowd>& crowds,
+                          std::vector<std::vector<ReptileBeads>>& crowd_reptiles) {
+    advanceReptiles(sft, *crowds[crowd_id], timers, *context_for_steps[crowd_id], crowd_reptiles[crowd_id]);
+  };
+  rmc_state.unrolling = true;
+  TasksOneToOne<> unroll_task(num_crowds_);
+  for (int step = 0; step < vmc_presteps; ++step)
+    unroll_task(runUnrollStep, std::ref(rmc_state), std::ref(timers_), std::ref(step_contexts_), std::ref(crowds_),
+                std::ref(crowd_reptiles_));
+  rmc_state.unrolling = false;
+  app_log() << "Finished " << vmc_presteps << " VMC presteps\n";
+
+  RefVector<MCPWalker> walkers(convertUPtrToRefVector(population_.get_walkers()));
+  branch_engine_->checkParameters(population_.get_num_global_walkers(), walkers);
+}
+
+void RMCBatched::collectReptiles(int step)
+{
+  RefVector<MCPWalker> heads;
+  RefVector<MCPWalker> tails;
+  heads.reserve(population_.get_num_local_walkers());
+  tails.reserve(population_.get_num_local_walkers());
+  for (std::vector<ReptileBeads>& reptiles : crowd_reptiles_)
+    for (ReptileBeads& reptile : reptiles)
+    {
+      heads.push_back(reptile.getHead());
+      tails.push_back(reptile.getTail());
+    }
+  branch_engine_->collect(step, heads, tails, population_.get_num_particles());
+}
+
+/** Runs the actual RMC section
+ *
+ *  Dependent on base class state machine
+ *  Assumes state already updated from the following calls:
+ *  1. QMCDriverNew::setStatus
+ *  2. QMCDriverNew::putWalkers
+ *  3. QMCDriverNew::process
+ *
+ *  The reptiles are bound to the walker slots of the crowds so the crowds are not tuned between blocks.
+ */
+bool RMCBatched::run()
+{
+  IndexType num_blocks = qmcdriver_input_.get_max_blocks();
+  estimator_manager_->start(num_blocks);
+  StateForThread rmc_state(qmcdriver_input_, rmcdriver_input_, *drift_modifier_, *branch_engine_, population_);
+
+  { // walker initialization
+    ScopedTimer local_timer(&(timers_.init_walkers_timer));
+    TasksOneToOne<> section_start_task(num_crowds_);
+    section_start_task(initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_));
+    initReptiles(rmc_state);
+  }
+
+  TasksOneToOne<> crowd_task(num_crowds_);
+  auto runWarmupStep = [](int crowd_id, StateForThread& sft, DriverTimers& timers,
+                          UPtrVector<ContextForSteps>& context_for_steps, UPtrVector<Crowd>& crowds,
+                          std::vector<std::vector<ReptileBeads>>& crowd_reptiles) {
+    advanceReptiles(sft, *crowds[crowd_id], timers, *context_for_steps[crowd_id], crowd_reptiles[crowd_id]);
+  };
+  for (int step = 0; step < qmcdriver_input_.get_warmup_steps(); ++step)
+  {
+    ScopedTimer local_timer(&(timers_.run_steps_timer));
+    crowd_task(runWarmupStep, std::ref(rmc_state), std::ref(timers_), std::ref(step_contexts_), std::ref(crowds_),
+               std::ref(crowd_reptiles_));
+    collectReptiles(step);
+  }
+
+  for (int block = 0; block < num_blocks; ++block)
+  {
+    estimator_manager_->startBlock(qmcdriver_input_.get_max_steps());
+    for (auto& crowd : crowds_)
+      crowd->startBlock(qmcdriver_input_.get_max_steps());
+
+    for (int step = 0; step < qmcdriver_input_.get_max_steps(); ++step)
+    {
+      ScopedTimer local_timer(&(timers_.run_steps_timer));
+      rmc_state.step = step;
+      crowd_task(runRMCStep, rmc_state, timers_, std::ref(step_contexts_), std::ref(crowds_),
+                 std::ref(crowd_reptiles_));
+      accumulateCollectables();
+      collectReptiles(step);
+    }
+
+    RefVector<ScalarEstimatorBase> all_scalar_estimators;
+    FullPrecRealType total_block_weight = 0.0;
+    FullPrecRealType total_accept_ratio = 0.0;
+    // Collect all the ScalarEstimatorsFrom EMCrowds
+    for (const UPtr<Crowd>& crowd : crowds_)
+    {
+      auto crowd_sc_est = crowd->get_estimator_manager_crowd().get_scalar_estimators();
+      all_scalar_estimators.insert(all_scalar_estimators.end(), std::make_move_iterator(crowd_sc_est.begin()),
+                                   std::make_move_iterator(crowd_sc_est.end()));
+      total_block_weight += crowd->get_estimator_manager_crowd().get_block_weight();
+      total_accept_ratio += crowd->get_accept_ratio();
+    }
+    total_accept_ratio /= crowds_.size();
+    estimator_manager_->collectScalarEstimators(all_scalar_estimators, population_.get_num_local_walkers(),
+                                                total_block_weight);
+    estimator_manager_->collectCollectables();
+    estimator_manager_->stopBlockNew(total_accept_ratio);
+  }
+  return false;
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,180 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File refactored from RMC.h and RMCUpdatePbyP.h
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_RMCBATCHED_H
+#define QMCPLUSPLUS_RMCBATCHED_H
+
+#include "QMCDrivers/QMCDriverNew.h"
+#include "QMCDrivers/RMC/RMCDriverInput.h"
+#include "QMCDrivers/MCPopulation.h"
+#include "QMCDrivers/ContextForSteps.h"
+#include "QMCDrivers/GreenFunctionModifiers/DriftModifierBase.h"
+
+namespace qmcplusplus
+{
+/** @ingroup QMCDrivers  ParticleByParticle
+ * @brief Implements a RMC using particle-by-particle move of the heads of many reptiles. Threaded execution.
+ *
+ *  Each walker of the population is the head of a reptile, the crowd moves the heads of its reptiles
+ *  together through the flex_ APIs and evaluates the local energies of the proposed heads in one batch.
+ *  The beads behind the heads are kept by the driver.
+ */
+class RMCBatched : public QMCDriverNew
+{
+public:
+  using FullPrecRealType  = QMCTraits::FullPrecRealType;
+  using PosType           = QMCTraits::PosType;
+  using ParticlePositions = PtclOnLatticeTraits::ParticlePos_t;
+
+  /** The beads of a reptile as a circular queue
+   *
+   *  Same indexing as Reptile without the MCWalkerConfiguration, bead 0 is the head.
+   *  The beads are full walker copies so that a bounce can continue from the tail.
+   */
+  struct ReptileBeads
+  {
+    std::vector<MCPWalker> beads;
+    IndexType head_index = 0;
+    IndexType direction  = 1;
+    /// accepted single particle moves of the last sweep of the head
+    IndexType num_accepted = 0;
+    RealType rr_accepted   = 0.0;
+    RealType rr_proposed   = 0.0;
+
+    ReptileBeads(IndexType num_beads, const MCPWalker& walker) : beads(num_beads, walker) {}
+
+    IndexType size() const { return beads.size(); }
+    IndexType wrapIndex(IndexType repindex) const { return (repindex % size() + size()) % size(); }
+    IndexType getBeadIndex(IndexType i) const { return wrapIndex(head_index + direction * i); }
+    MCPWalker& getBead(IndexType i) { return beads[getBeadIndex(i)]; }
+    MCPWalker& getHead() { return getBead(0); }
+    MCPWalker& getTail() { return getBead(size() - 1); }
+    MCPWalker& getNext() { return getBead(size() - 2); }
+    MCPWalker& getCenter() { return getBead((size() - 1) / 2); }
+
+    /// the tail becomes the head and the reptile moves in the other direction
+    void flip()
+    {
+      head_index = wrapIndex(head_index - direction);
+      direction *= -1;
+    }
+
+    /// moves the reptile forward one bead, returns the new head to overwrite which was the tail
+    MCPWalker& getNewHead()
+    {
+      head_index = getBeadIndex(size() - 1);
+      return beads[head_index];
+    }
+
+    void resetMoveStats()
+    {
+      num_accepted = 0;
+      rr_accepted  = 0.0;
+      rr_proposed  = 0.0;
+    }
+  };
+
+  /** To avoid 10's of arguments to runRMCStep
+   *
+   *  There should be a division between const input to runRMCStep
+   *  And step to step state
+   */
+  struct StateForThread
+  {
+    const QMCDriverInput& qmcdrv_input;
+    const RMCDriverInput& rmcdrv_input;
+    const DriftModifierBase& drift_modifier;
+    const MCPopulation& population;
+    BranchEngineType& branch_engine;
+    IndexType step;
+    /// true for the VMC steps unrolling the reptiles, every head is accepted
+    bool unrolling = false;
+    StateForThread(QMCDriverInput& qmci,
+                   RMCDriverInput& rmci,
+                   DriftModifierBase& drift_mod,
+                   BranchEngineType& branch_eng,
+                   MCPopulation& pop)
+        : qmcdrv_input(qmci), rmcdrv_input(rmci), drift_modifier(drift_mod), population(pop), branch_engine(branch_eng)
+    {}
+  };
+
+  /// Constructor.
+  RMCBatched(QMCDriverInput&& qmcdriver_input,
+             RMCDriverInput&& input,
+             MCPopulation& pop,
+             TrialWaveFunction& psi,
+             QMCHamiltonian& h,
+             WaveFunctionPool& ppool,
+             Communicate* comm);
+
+  /** The initial number of local walkers, one per reptile
+   *
+   *  Same as DMCBatched
+   */
+  IndexType calc_default_local_walkers(IndexType walkers_per_rank);
+
+  bool run();
+
+  /// one RMC step of the reptiles of a crowd, or one VMC step while unrolling
+  static void advanceReptiles(const StateForThread& sft,
+                              Crowd& crowd,
+                              DriverTimers& timers,
+                              ContextForSteps& move_context,
+                              std::vector<ReptileBeads>& reptiles);
+
+  /** @name Stages of advanceReptiles
+   *  the drift-diffusion sweep of the heads with the buffer update, the batched local energies of the
+   *  proposed heads and the reptile moves accepted with the link action with the collectables on the center beads.
+   *  @{
+   */
+  static void sweepHeads(const StateForThread& sft,
+                         Crowd& crowd,
+                         DriverTimers& timers,
+                         ContextForSteps& move_context,
+                         std::vector<ReptileBeads>& reptiles);
+  static void moveReptiles(const StateForThread& sft,
+                           Crowd& crowd,
+                           DriverTimers& timers,
+                           ContextForSteps& move_context,
+                           std::vector<ReptileBeads>& reptiles);
+  /** @} */
+
+  // This is the task body executed at crowd scope
+  // it does not have access to object members by design
+  static void runRMCStep(int crowd_id,
+                         const StateForThread& sft,
+                         DriverTimers& timers,
+                         std::vector<std::unique_ptr<ContextForSteps>>& move_context,
+                         std::vector<std::unique_ptr<Crowd>>& crowds,
+                         std::vector<std::vector<ReptileBeads>>& crowd_reptiles);
+
+  QMCRunType getRunType() { return QMCRunType::RMC_BATCH; }
+
+private:
+  RMCDriverInput rmcdriver_input_;
+  /// the reptiles of the walkers of each crowd in crowd order
+  std::vector<std::vector<ReptileBeads>> crowd_reptiles_;
+
+  /// grows a reptile from every walker and unrolls them with VMC steps
+  void initReptiles(StateForThread& rmc_state);
+  /// feeds the head and tail energies of all the reptiles to the branch engine
+  void collectReptiles(int step);
+
+  /// Copy Constructor (disabled)
+  RMCBatched(const RMCBatched&) = delete;
+  /// Copy operator (disabled).
+  RMCBatched& operator=(const RMCBatched&) = delete;
+};
+
+} // namespace qmcplusplus
+
+#endif
@@ -0,0 +1,41 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "QMCDrivers/RMC/RMCDriverInput.h"
+
+namespace qmcplusplus
+{
+void RMCDriverInput::readXML(xmlNodePtr node)
+{
+  ParameterSet parameter_set_;
+  // from RMC.cpp RMC(...)
+  parameter_set_.add(beta_, "beta", "double");
+  parameter_set_.add(beads_, "beads", "int");
+  parameter_set_.add(vmc_presteps_, "vmcpresteps", "int");
+  parameter_set_.add(max_age_, "MaxAge", "int");
+  parameter_set_.put(node);
+
+  if (beads_ < 1 && beta_ <= 0)
+    throw std::runtime_error("RMC input section requires beads or beta");
+  if (max_age_ < 0)
+    throw std::runtime_error("Illegal input for MaxAge in RMC input section");
+}
+
+RMCDriverInput::IndexType RMCDriverInput::get_num_beads(RealType tau) const
+{
+  if (beads_ > 0)
+    return beads_;
+  return std::max(static_cast<IndexType>(beta_ / tau), IndexType(2));
+}
+
+std::ostream& operator<<(std::ostream& o_stream, const RMCDriverInput& rmci) { return o_stream; }
+
+} // namespace qmcplusplus
@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_RMCDRIVERINPUT_H
+#define QMCPLUSPLUS_RMCDRIVERINPUT_H
+
+#include "Configuration.h"
+#include "OhmmsData/ParameterSet.h"
+
+namespace qmcplusplus
+{
+/** Input representation for RMC driver class runtime parameters
+ */
+class RMCDriverInput
+{
+public:
+  using IndexType             = QMCTraits::IndexType;
+  using RealType              = QMCTraits::RealType;
+  using FullPrecisionRealType = QMCTraits::FullPrecRealType;
+  RMCDriverInput(){};
+  void readXML(xmlNodePtr xml_input);
+
+  /** number of beads of a reptile
+   *
+   *  beads takes precedence over beta, beta / tau if only beta was given.
+   */
+  IndexType get_num_beads(RealType tau) const;
+  IndexType get_vmc_presteps() const { return vmc_presteps_; }
+  IndexType get_max_age() const { return max_age_; }
+
+private:
+  /** @ingroup Parameters for RMC Driver
+   *  @{
+   *  
+   *  Do not write out blocks of gets for variables like this
+   *  there is are code_generation tools in QMCPACK_ROOT/utils/code_tools
+   */
+  ///number of beads on the reptile
+  IndexType beads_ = -1;
+  ///projection time of the reptile
+  RealType beta_ = -1;
+  ///number of VMC steps unrolling the reptiles, beads + 2 if negative
+  IndexType vmc_presteps_ = -1;
+  ///the head and the tail older than this are accepted
+  IndexType max_age_ = 10;
+  /** @} */
+
+public:
+  friend std::ostream& operator<<(std::ostream& o_stream, const RMCDriverInput& rmci);
+};
+
+extern std::ostream& operator<<(std::ostream& o_stream, const RMCDriverInput& rmci);
+
+} // namespace qmcplusplus
+#endif
@@ -0,0 +1,34 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// Refactored from: RMCFactory.cpp
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "QMCDrivers/RMC/RMCFactoryNew.h"
+#include "QMCDrivers/RMC/RMCBatched.h"
+
+namespace qmcplusplus
+{
+QMCDriverInterface* RMCFactoryNew::create(MCPopulation& pop,
+                                          TrialWaveFunction& psi,
+                                          QMCHamiltonian& h,
+                                          WaveFunctionPool& wf_pool,
+                                          Communicate* comm)
+{
+  QMCDriverInput qmcdriver_input(qmc_counter_);
+  qmcdriver_input.readXML(input_node_);
+  RMCDriverInput rmcdriver_input;
+  rmcdriver_input.readXML(input_node_);
+  QMCDriverInterface* qmc =
+      new RMCBatched(std::move(qmcdriver_input), std::move(rmcdriver_input), pop, psi, h, wf_pool, comm);
+  // RMCBatched only supports PbyP
+  qmc->setUpdateMode(rmc_mode_ & 1);
+  return qmc;
+}
+} // namespace qmcplusplus
@@ -292,7 +292,11 @@ int SimpleFixedNodeBranch::initWalkerController(MCPopulation& population, bool f
   return int(round(double(iParam[B_TARGETWALKERS]) / double(nwtot_now)));
 }
 
-void SimpleFixedNodeBranch::initReptile(MCWalkerConfiguration& W)
+void SimpleFixedNodeBranch::initReptile(MCWalkerConfiguration& W) { initReptile(W.R.size()); }
+
+void SimpleFixedNodeBranch::initReptile(MCPopulation& population) { initReptile(population.get_num_particles()); }
+
+void SimpleFixedNodeBranch::initReptile(int num_particles)
 {
   RealType allowedFlux = 50.0;
   BranchMode.set(B_RMC, 1);                               //set RMC
@@ -336,7 +340,7 @@ void SimpleFixedNodeBranch::initReptile(MCWalkerConfiguration& W)
   if (fromscratch)
   {
     //determine the branch cutoff to limit wild weights based on the sigma and sigmaBound
-    setBranchCutoff(vParam[B_SIGMA2], allowedFlux, 50, W.R.size());
+    setBranchCutoff(vParam[B_SIGMA2], allowedFlux, 50, num_particles);
     vParam[B_TAUEFF] = tau * R2Accepted.result() / R2Proposed.result();
   }
   //reset controller
@@ -461,6 +465,8 @@ void SimpleFixedNodeBranch::branch(int iter, UPtrVector<Crowd>& crowds,  MCPopul
   //RealType pop_now= WalkerController->branch(iter,walkers,0.1);
   RefVector<MCPWalker> walkers(convertUPtrToRefVector(population.get_walkers()));
 
+  // the ensemble sums are taken per crowd
+  WalkerController->set_num_crowds(crowds.size());
   FullPrecRealType pop_now;
   if (false) // && BranchMode[B_DMCSTAGE] || iter)
     pop_now = WalkerController->branch(iter, population, 0.1);
@@ -552,9 +558,13 @@ void SimpleFixedNodeBranch::branch(int iter, UPtrVector<Crowd>& crowds,  MCPopul
   WalkerController->setTrialEnergy(vParam[B_ETRIAL]);
   //accumulate collectables and energies for scalar.dat
   FullPrecRealType wgt_inv = WalkerController->get_num_contexts() / wc_ensemble_prop.Weight;
-  //walkers.Collectables *= wgt_inv;
+  RefVector<EstimatorManagerCrowd> crowd_ems;
   for(UPtr<Crowd>& crowd_ptr: crowds)
+  {
     crowd_ptr->accumulate(population.get_num_global_walkers());
+    crowd_ems.push_back(crowd_ptr->get_estimator_manager_crowd());
+  }
+  MyEstimator->accumulateCollectables(crowd_ems, wgt_inv);
 }
 
 /**
@@ -565,7 +575,32 @@ void SimpleFixedNodeBranch::collect(int iter, MCWalkerConfiguration& W)
   //Update the current energy and accumulate.
   MCWalkerConfiguration::Walker_t& head = W.reptile->getHead();
   MCWalkerConfiguration::Walker_t& tail = W.reptile->getTail();
-  vParam[B_ENOW]                        = 0.5 * (head.Properties(LOCALENERGY) + tail.Properties(LOCALENERGY));
+  R2Accepted(head.Properties(R2ACCEPTED));
+  R2Proposed(head.Properties(R2PROPOSED));
+  collectReptileEnergy(0.5 * (head.Properties(LOCALENERGY) + tail.Properties(LOCALENERGY)), W.R.size());
+  //accumulate collectables and energies for scalar.dat
+  MyEstimator->accumulate(W);
+}
+
+void SimpleFixedNodeBranch::collect(int iter,
+                                    const RefVector<MCPWalker>& heads,
+                                    const RefVector<MCPWalker>& tails,
+                                    int num_particles)
+{
+  FullPrecRealType enow = 0.0;
+  for (int ir = 0; ir < heads.size(); ++ir)
+  {
+    const MCPWalker& head = heads[ir];
+    R2Accepted(head.Properties(R2ACCEPTED));
+    R2Proposed(head.Properties(R2PROPOSED));
+    enow += 0.5 * (head.Properties(LOCALENERGY) + tails[ir].get().Properties(LOCALENERGY));
+  }
+  collectReptileEnergy(enow / heads.size(), num_particles);
+}
+
+void SimpleFixedNodeBranch::collectReptileEnergy(FullPrecRealType enow, int num_particles)
+{
+  vParam[B_ENOW] = enow;
   // app_log()<<"IN SimpleFixedNodeBranch::collect\n";
   // app_log()<<"\tvParam[B_ENOW]="<<vParam[B_ENOW]<< std::endl;
   EnergyHist(vParam[B_ENOW]);
@@ -573,8 +608,6 @@ void SimpleFixedNodeBranch::collect(int iter, MCWalkerConfiguration& W)
   // app_log()<<"\tvParam[B_EREF]="<<vParam[B_EREF]<< std::endl;
   //Update the energy variance and R2 for effective timestep and filtering.
   VarianceHist(std::pow(vParam[B_ENOW] - vParam[B_EREF], 2));
-  R2Accepted(head.Properties(R2ACCEPTED));
-  R2Proposed(head.Properties(R2PROPOSED));
   // app_log()<<"\thead.Properties(R2ACCEPTED)="<<head.Properties(R2ACCEPTED)<< std::endl;
   // app_log()<<"\thead.Properties(R2PROPOSED)="<<head.Properties(R2PROPOSED)<< std::endl;
   //  app_log()<<"\tR2Accepted="<<R2Accepted.result()<< std::endl;
@@ -626,7 +659,7 @@ void SimpleFixedNodeBranch::collect(int iter, MCWalkerConfiguration& W)
     {
       vParam[B_TAUEFF] = vParam[B_TAU] * R2Accepted.result() / R2Proposed.result();
       vParam[B_SIGMA2] = VarianceHist.mean();
-      setBranchCutoff(vParam[B_SIGMA2], vParam[B_FILTERSCALE], vParam[B_FILTERSCALE], W.R.size());
+      setBranchCutoff(vParam[B_SIGMA2], vParam[B_FILTERSCALE], vParam[B_FILTERSCALE], num_particles);
       app_log() << "\n Warmup is completed after " << iParam[B_WARMUPSTEPS] << " steps." << std::endl;
       if (BranchMode[B_USETAUEFF])
         app_log() << "\n  TauEff     = " << vParam[B_TAUEFF] << "\n TauEff/Tau = " << vParam[B_TAUEFF] / vParam[B_TAU];
@@ -643,8 +676,6 @@ void SimpleFixedNodeBranch::collect(int iter, MCWalkerConfiguration& W)
       EnergyHist(vParam[B_ENOW]);
     }
   }
-  //accumulate collectables and energies for scalar.dat
-  MyEstimator->accumulate(W);
 }
 
 /** Calculates and saves various action components, also does necessary updates for running averages.
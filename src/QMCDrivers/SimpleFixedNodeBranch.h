@@ -247,6 +247,10 @@ struct SimpleFixedNodeBranch : public QMCTraits
    */
   void initReptile(MCWalkerConfiguration& w);
 
+  /** initialize reptile stats for the reptiles of the batched drivers
+   */
+  void initReptile(MCPopulation& population);
+
   /** determine trial and reference energies
    */
   void checkParameters(MCWalkerConfiguration& w);
@@ -388,6 +392,16 @@ struct SimpleFixedNodeBranch : public QMCTraits
    */
   void collect(int iter, MCWalkerConfiguration& w);
 
+  /** update RMC counters and running averages with the reptiles of a batched driver.
+   * @param iter the iteration
+   * @param heads the heads of the reptiles
+   * @param tails the tails of the reptiles in the same order
+   * @param num_particles number of particles of a walker
+   *
+   * The mean over the reptiles of the head and tail energies is the current energy.
+   */
+  void collect(int iter, const RefVector<MCPWalker>& heads, const RefVector<MCPWalker>& tails, int num_particles);
+
   /** restart averaging
    * @param counter Counter to determine the cummulative average will be reset.
    */
@@ -422,6 +436,10 @@ struct SimpleFixedNodeBranch : public QMCTraits
   void setRN(bool rn);
 
 private:
+  ///initialize reptile stats
+  void initReptile(int num_particles);
+  ///update the running averages of RMC with the current energy
+  void collectReptileEnergy(FullPrecRealType enow, int num_particles);
   ///default constructor (disabled)
   SimpleFixedNodeBranch() {}
 
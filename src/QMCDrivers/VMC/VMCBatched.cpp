@@ -11,9 +11,12 @@
 
 #include "QMCDrivers/VMC/VMCBatched.h"
 #include "Concurrency/TasksOneToOne.hpp"
+#include "Concurrency/TasksPipeline.hpp"
 #include "Concurrency/Info.hpp"
 #include "Utilities/RunTimeManager.h"
+#include "Utilities/Timer.h"
 #include "ParticleBase/RandomSeqGenerator.h"
+#include "Estimators/CollectablesEstimator.h"
 
 namespace qmcplusplus
 {
@@ -69,6 +72,23 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
                                 QMCDriverNew::DriverTimers& timers,
                                 ContextForSteps& step_context,
                                 bool recompute)
+{
+  sweepWalkers(sft, crowd, timers, step_context, recompute);
+
+  timers.hamiltonian_timer.start();
+  const std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
+      QMCHamiltonian::flex_evaluate(crowd.get_walker_hamiltonians(), crowd.get_walker_elecs()));
+  std::copy(local_energies.begin(), local_energies.end(), crowd.get_local_energies().begin());
+  timers.hamiltonian_timer.stop();
+
+  finishStep(sft, crowd, timers, step_context);
+}
+
+void VMCBatched::sweepWalkers(const StateForThread& sft,
+                              Crowd& crowd,
+                              QMCDriverNew::DriverTimers& timers,
+                              ContextForSteps& step_context,
+                              bool recompute)
 {
   timers.buffer_timer.start();
   crowd.loadWalkers();
@@ -87,22 +107,17 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
 
   timers.movepbyp_timer.start();
   int num_walkers = crowd.size();
-  // Note std::vector<bool> is not like the rest of stl.
-  std::vector<bool> moved(num_walkers, false);
   constexpr RealType mhalf(-0.5);
   bool use_drift = sft.vmcdrv_input.get_use_drift();
   //This generates an entire steps worth of deltas.
-  step_context.nextDeltaRs();
+  step_context.nextDeltaRs(num_walkers);
   auto it_delta_r = step_context.deltaRsBegin();
-  std::vector<PosType> drifts(num_walkers);
-
-  // local list to handle accept/reject
-  std::vector<std::reference_wrapper<ParticleSet>> elec_accept_list, elec_reject_list;
-  std::vector<std::reference_wrapper<TrialWaveFunction>> twf_accept_list, twf_reject_list;
-  elec_accept_list.reserve(num_walkers);
-  elec_reject_list.reserve(num_walkers);
-  twf_accept_list.reserve(num_walkers);
-  twf_reject_list.reserve(num_walkers);
+  // per move scratch persists in the crowd
+  auto& drifts = crowd.get_drifts();
+  auto& ratios = crowd.get_ratios();
+  auto& log_gf = crowd.get_log_gf();
+  auto& log_gb = crowd.get_log_gb();
+  auto& probs  = crowd.get_prob();
 
   // up and down electrons are "species" within qmpack
   for (int ig = 0; ig < step_context.get_num_groups(); ++ig) //loop over species
@@ -114,77 +129,74 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
     int end_index        = step_context.getPtclGroupEnd(ig);
     for (int iat = start_index; iat < end_index; ++iat)
     {
-      crowd.clearResults();
-      ParticleSet::flex_setActive(crowd.get_walker_elecs(), iat);
+      ParticleSet::flex_setActive(walker_elecs, iat);
       // step_context.deltaRsBegin returns an iterator to a flat series of PosTypes
       // fastest in walkers then particles
       auto delta_r_start = it_delta_r + iat * num_walkers;
 
       if (use_drift)
       {
-        TrialWaveFunction::flex_evalGrad(crowd.get_walker_twfs(), crowd.get_walker_elecs(), iat, crowd.get_grads_now());
+        TrialWaveFunction::flex_evalGrad(walker_twfs, walker_elecs, iat, crowd.get_grads_now());
         sft.drift_modifier.getDrifts(tauovermass, crowd.get_grads_now(), drifts);
-
-        std::transform(drifts.begin(), drifts.end(), delta_r_start, drifts.begin(),
-                       [sqrttau](PosType& drift, PosType& delta_r) { return drift + (sqrttau * delta_r); });
+        for (int iw = 0; iw < num_walkers; ++iw)
+          drifts[iw] += sqrttau * delta_r_start[iw];
       }
       else
       {
-        std::transform(drifts.begin(), drifts.end(), delta_r_start, drifts.begin(),
-                       [sqrttau](auto& drift, auto& delta_r) { return sqrttau * delta_r; });
+        for (int iw = 0; iw < num_walkers; ++iw)
+          drifts[iw] = sqrttau * delta_r_start[iw];
       }
 
-      auto elecs = crowd.get_walker_elecs();
-      ParticleSet::flex_makeMove(crowd.get_walker_elecs(), iat, drifts);
+      ParticleSet::flex_makeMove(walker_elecs, iat, drifts);
 
-      // This is inelegant
       if (use_drift)
       {
-        TrialWaveFunction::flex_ratioGrad(crowd.get_walker_twfs(), crowd.get_walker_elecs(), iat, crowd.get_ratios(),
-                                          crowd.get_grads_new());
-        auto delta_r_end = delta_r_start + num_walkers;
-        std::transform(delta_r_start, delta_r_end, crowd.get_log_gf().begin(),
-                       [mhalf](auto& delta_r) { return mhalf * dot(delta_r, delta_r); });
-
+        TrialWaveFunction::flex_ratioGrad(walker_twfs, walker_elecs, iat, ratios, crowd.get_grads_new());
         sft.drift_modifier.getDrifts(tauovermass, crowd.get_grads_new(), drifts);
-
-        std::transform(crowd.beginElectrons(), crowd.endElectrons(), drifts.begin(), drifts.begin(),
-                       [iat](auto& elecs, auto& drift) { return elecs.get().R[iat] - elecs.get().activePos - drift; });
-
-        std::transform(drifts.begin(), drifts.end(), crowd.get_log_gb().begin(),
-                       [oneover2tau](auto& drift) { return -oneover2tau * dot(drift, drift); });
+        // Green's functions and acceptance probabilities in one pass
+        for (int iw = 0; iw < num_walkers; ++iw)
+        {
+          const ParticleSet& elecs = walker_elecs[iw];
+          const PosType dr_back    = elecs.R[iat] - elecs.activePos - drifts[iw];
+          log_gf[iw]               = mhalf * dot(delta_r_start[iw], delta_r_start[iw]);
+          log_gb[iw]               = -oneover2tau * dot(dr_back, dr_back);
+          probs[iw]                = std::real(ratios[iw]) * std::real(ratios[iw]);
+        }
       }
       else
       {
-        TrialWaveFunction::flex_calcRatio(crowd.get_walker_twfs(), crowd.get_walker_elecs(), iat, crowd.get_ratios());
+        TrialWaveFunction::flex_calcRatio(walker_twfs, walker_elecs, iat, ratios);
+        // These were cleared to 1.0 each loop by VMCUpdatePbyP advance walker
+        for (int iw = 0; iw < num_walkers; ++iw)
+        {
+          log_gf[iw] = 1.0;
+          log_gb[iw] = 1.0;
+          probs[iw]  = std::real(ratios[iw]) * std::real(ratios[iw]);
+        }
       }
 
-      std::transform(crowd.get_ratios().begin(), crowd.get_ratios().end(), crowd.get_prob().begin(),
-                     [](auto ratio) { return std::real(ratio) * std::real(ratio); });
-
-      twf_accept_list.clear();
-      twf_reject_list.clear();
-      elec_accept_list.clear();
-      elec_reject_list.clear();
+      crowd.clearAcceptRejectLists();
+      auto& twf_accept_list  = crowd.get_twf_accept_list();
+      auto& twf_reject_list  = crowd.get_twf_reject_list();
+      auto& elec_accept_list = crowd.get_elec_accept_list();
+      auto& elec_reject_list = crowd.get_elec_reject_list();
 
       for (int i_accept = 0; i_accept < num_walkers; ++i_accept)
       {
-        auto prob   = crowd.get_prob()[i_accept];
-        auto log_gf = crowd.get_log_gf()[i_accept];
-        auto log_gb = crowd.get_log_gb()[i_accept];
+        auto prob = probs[i_accept];
 
         if (prob >= std::numeric_limits<RealType>::epsilon() &&
-            step_context.get_random_gen()() < prob * std::exp(log_gb - log_gf))
+            step_context.get_random_gen()() < prob * std::exp(log_gb[i_accept] - log_gf[i_accept]))
         {
           crowd.incAccept();
-          twf_accept_list.push_back(crowd.get_walker_twfs()[i_accept]);
-          elec_accept_list.push_back(crowd.get_walker_elecs()[i_accept]);
+          twf_accept_list.push_back(walker_twfs[i_accept]);
+          elec_accept_list.push_back(walker_elecs[i_accept]);
         }
         else
         {
           crowd.incReject();
-          twf_reject_list.push_back(crowd.get_walker_twfs()[i_accept]);
-          elec_reject_list.push_back(crowd.get_walker_elecs()[i_accept]);
+          twf_reject_list.push_back(walker_twfs[i_accept]);
+          elec_reject_list.push_back(walker_elecs[i_accept]);
         }
       }
 
@@ -208,12 +220,24 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
   for (int iw = 0; iw < crowd.size(); ++iw)
     saveElecPosAndGLToWalkers(walker_elecs[iw], walkers[iw]);
   timers.buffer_timer.stop();
+}
 
-  timers.hamiltonian_timer.start();
+void VMCBatched::evaluateLocalEnergy(Crowd& crowd, int iw)
+{
+  QMCHamiltonian& walker_hamiltonian = crowd.get_walker_hamiltonians()[iw];
+  crowd.get_local_energies()[iw]     = walker_hamiltonian.evaluate(crowd.get_walker_elecs()[iw]);
+}
+
+void VMCBatched::finishStep(const StateForThread& sft,
+                            Crowd& crowd,
+                            QMCDriverNew::DriverTimers& timers,
+                            ContextForSteps& step_context)
+{
+  auto& walkers             = crowd.get_walkers();
+  auto& walker_twfs         = crowd.get_walker_twfs();
+  auto& walker_elecs        = crowd.get_walker_elecs();
   auto& walker_hamiltonians = crowd.get_walker_hamiltonians();
-  std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
-      QMCHamiltonian::flex_evaluate(walker_hamiltonians, walker_elecs));
-  timers.hamiltonian_timer.stop();
+  auto& local_energies      = crowd.get_local_energies();
 
   auto resetSigNLocalEnergy = [](MCPWalker& walker, TrialWaveFunction& twf, auto& local_energy) {
     walker.resetProperty(twf.getLogPsi(), twf.getPhase(), local_energy);
@@ -223,11 +247,16 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
 
   // moved to be consistent with DMC
   timers.collectables_timer.start();
-  auto evaluateNonPhysicalHamiltonianElements = [](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker) {
-    ham.auxHevaluate(pset, walker);
+  // the sampling estimators, e.g. the one body density matrices, draw from the generator of the crowd
+  auto evaluateNonPhysicalHamiltonianElements = [&step_context](QMCHamiltonian& ham, ParticleSet& pset,
+                                                                 MCPWalker& walker) {
+    ham.setRandomGenerator(&step_context.get_random_gen());
+    ham.auxHevaluate(pset, walker, true, false);
   };
   for (int iw = 0; iw < crowd.size(); ++iw)
     evaluateNonPhysicalHamiltonianElements(walker_hamiltonians[iw], walker_elecs[iw], walkers[iw]);
+  QMCHamiltonian::mw_auxHevaluateCollectables(walker_hamiltonians, walker_elecs, walkers,
+                                              crowd.get_estimator_manager_crowd().get_step_collectables());
 
   auto savePropertiesIntoWalker = [](QMCHamiltonian& ham, MCPWalker& walker) {
     ham.saveProperty(walker.getPropertyBase());
@@ -250,16 +279,49 @@ void VMCBatched::runVMCStep(int crowd_id,
                             std::vector<std::unique_ptr<Crowd>>& crowds)
 {
   Crowd& crowd = *(crowds[crowd_id]);
+  advanceWalkers(sft, crowd, timers, *context_for_steps[crowd_id], isRecomputeStep(sft));
+  crowd.accumulate(sft.population.get_num_global_walkers());
+}
 
+bool VMCBatched::isRecomputeStep(const StateForThread& sft)
+{
   int max_steps = sft.qmcdrv_input.get_max_steps();
   bool is_recompute_block =
       sft.recomputing_blocks ? (1 + sft.block) % sft.qmcdrv_input.get_blocks_between_recompute() == 0 : false;
-  RealType cnorm = 1.0 / static_cast<RealType>(crowd.size());
   IndexType step = sft.step;
   // Are we entering the the last step of a block to recompute at?
-  bool recompute_this_step = (is_recompute_block && (step + 1) == max_steps);
-  advanceWalkers(sft, crowd, timers, *context_for_steps[crowd_id], recompute_this_step);
-  crowd.accumulate(sft.population.get_num_global_walkers());
+  return (is_recompute_block && (step + 1) == max_steps);
+}
+
+/** Runs a VMC step of all the crowds as tasks
+ *
+ *  The move sweep and the accumulation are crowd tasks, the local energies walker tasks.
+ *  A thread done with its own crowd evaluates the local energies of the slower crowds.
+ *  The walker tasks draw from walker private generators reseeded by the crowd every step.
+ */
+void VMCBatched::runVMCStepTasks(const StateForThread& sft,
+                                 DriverTimers& timers,
+                                 std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
+                                 std::vector<std::unique_ptr<Crowd>>& crowds)
+{
+  const bool recompute_this_step = isRecomputeStep(sft);
+  auto sweep = [&](int crowd_id) {
+    sweepWalkers(sft, *crowds[crowd_id], timers, *context_for_steps[crowd_id], recompute_this_step);
+    context_for_steps[crowd_id]->seedWalkerRandomGens(crowds[crowd_id]->size());
+  };
+  auto crowdSize        = [&crowds](int crowd_id) { return crowds[crowd_id]->size(); };
+  auto localEnergy      = [&](int crowd_id, int iw) {
+    QMCHamiltonian& walker_hamiltonian = crowds[crowd_id]->get_walker_hamiltonians()[iw];
+    walker_hamiltonian.setRandomGenerator(&context_for_steps[crowd_id]->get_walker_random_gen(iw));
+    evaluateLocalEnergy(*crowds[crowd_id], iw);
+  };
+  auto finishAndCollect = [&](int crowd_id) {
+    Crowd& crowd = *crowds[crowd_id];
+    finishStep(sft, crowd, timers, *context_for_steps[crowd_id]);
+    crowd.accumulate(sft.population.get_num_global_walkers());
+  };
+  TasksPipeline<> step_tasks(Concurrency::maxThreads());
+  step_tasks(crowds.size(), sweep, crowdSize, localEnergy, finishAndCollect);
 }
 
 /** Runs the actual VMC section
@@ -288,26 +350,29 @@ bool VMCBatched::run()
   { // walker initialization
     ScopedTimer local_timer(&(timers_.init_walkers_timer));
     TasksOneToOne<> section_start_task(num_crowds_);
-    section_start_task(initialLogEvaluation, std::ref(crowds_));
+    section_start_task(initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_));
   }
 
-  TasksOneToOne<> crowd_task(num_crowds_);
-
   auto runWarmupStep = [](int crowd_id, StateForThread& sft, DriverTimers& timers,
                           UPtrVector<ContextForSteps>& context_for_steps, UPtrVector<Crowd>& crowds) {
     Crowd& crowd = *(crowds[crowd_id]);
     advanceWalkers(sft, crowd, timers, *context_for_steps[crowd_id], false);
   };
 
-  for (int step = 0; step < qmcdriver_input_.get_warmup_steps(); ++step)
   {
-    ScopedTimer local_timer(&(timers_.run_steps_timer));
-    crowd_task(runWarmupStep, vmc_state, std::ref(timers_), std::ref(step_contexts_), std::ref(crowds_));
+    TasksOneToOne<> warmup_task(num_crowds_);
+    for (int step = 0; step < qmcdriver_input_.get_warmup_steps(); ++step)
+    {
+      ScopedTimer local_timer(&(timers_.run_steps_timer));
+      warmup_task(runWarmupStep, vmc_state, std::ref(timers_), std::ref(step_contexts_), std::ref(crowds_));
+    }
   }
 
   for (int block = 0; block < num_blocks; ++block)
   {
     vmc_loop.start();
+    // the crowd tuning can change the number of crowds between blocks
+    TasksOneToOne<> crowd_task(num_crowds_);
     vmc_state.recalculate_properties_period =
         (qmc_driver_mode_[QMC_UPDATE_MODE]) ? qmcdriver_input_.get_recalculate_properties_period() : 0;
     vmc_state.recomputing_blocks = qmcdriver_input_.get_blocks_between_recompute();
@@ -316,12 +381,18 @@ bool VMCBatched::run()
 
     for (auto& crowd : crowds_)
       crowd->startBlock(qmcdriver_input_.get_max_steps());
+    Timer block_timer;
     for (int step = 0; step < qmcdriver_input_.get_max_steps(); ++step)
     {
       ScopedTimer local_timer(&(timers_.run_steps_timer));
       vmc_state.step = step;
-      crowd_task(runVMCStep, vmc_state, timers_, std::ref(step_contexts_), std::ref(crowds_));
+      if (qmcdriver_input_.get_crowd_tasks())
+        runVMCStepTasks(vmc_state, timers_, step_contexts_, crowds_);
+      else
+        crowd_task(runVMCStep, vmc_state, timers_, std::ref(step_contexts_), std::ref(crowds_));
+      accumulateCollectables();
     }
+    const double block_seconds = block_timer.elapsed();
 
     RefVector<ScalarEstimatorBase> all_scalar_estimators;
     FullPrecRealType total_block_weight = 0.0;
@@ -339,8 +410,11 @@ bool VMCBatched::run()
     total_accept_ratio /= crowds_.size();
     estimator_manager_->collectScalarEstimators(all_scalar_estimators, population_.get_num_local_walkers(),
                                                 total_block_weight);
+    estimator_manager_->collectCollectables();
     // TODO: should be accept rate for block
     estimator_manager_->stopBlockNew(total_accept_ratio);
+
+    tuneCrowds(static_cast<double>(population_.get_active_walkers()) * qmcdriver_input_.get_max_steps(), block_seconds);
   }
 
   return false;
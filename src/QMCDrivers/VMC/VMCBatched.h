@@ -76,6 +76,16 @@ public:
    */
   static void advanceWalkers(const StateForThread& sft, Crowd& crowd, DriverTimers& timers, ContextForSteps& move_context, bool recompute);
 
+  /** @name Stages of advanceWalkers
+   *  the move sweep, the local energy of one walker and the property update with the collectables.
+   *  The local energies go through Crowd::get_local_energies.
+   *  @{
+   */
+  static void sweepWalkers(const StateForThread& sft, Crowd& crowd, DriverTimers& timers, ContextForSteps& move_context, bool recompute);
+  static void evaluateLocalEnergy(Crowd& crowd, int iw);
+  static void finishStep(const StateForThread& sft, Crowd& crowd, DriverTimers& timers, ContextForSteps& move_context);
+  /** @} */
+
   // This is the task body executed at crowd scope
   // it does not have access to object member variables by design
   static void runVMCStep(int crowd_id,
@@ -84,6 +94,15 @@ public:
                          std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
                          std::vector<std::unique_ptr<Crowd>>& crowds);
 
+  /// runs the step of all crowds with TasksPipeline, enabled by crowd_tasks
+  static void runVMCStepTasks(const StateForThread& sft,
+                              DriverTimers& timers,
+                              std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
+                              std::vector<std::unique_ptr<Crowd>>& crowds);
+
+  /// is this the last step of a block recomputing the wavefunction
+  static bool isRecomputeStep(const StateForThread& sft);
+
   IndexType calc_default_local_walkers(IndexType walkers_per_rank);
 
 private:
@@ -18,6 +18,7 @@
 #include "Particle/HDFWalkerIO.h"
 #include "OhmmsData/ParameterSet.h"
 #include "type_traits/template_types.hpp"
+#include "Concurrency/TasksOneToOne.hpp"
 
 #include <numeric>
 
@@ -32,7 +33,8 @@ WalkerControlBase::WalkerControlBase(Communicate* c, bool rn)
       NumWalkersCreated(0),
       target_sigma_(10),
       dmcStream(0),
-      write_release_nodes_(rn)
+      write_release_nodes_(rn),
+      num_crowds_(1)
 {
   method_    = -1; //assign invalid method
   num_contexts_ = myComm->size();
@@ -238,73 +240,95 @@ int WalkerControlBase::doNotBranch(int iter, MCWalkerConfiguration& W)
   return int(curData[WEIGHT_INDEX]);
 }
 
-int WalkerControlBase::doNotBranch(int iter, MCPopulation& pop)
+std::vector<WalkerControlBase::FullPrecRealType> WalkerControlBase::sumEnsembleProperties(
+    const RefVector<MCPWalker>& walkers,
+    bool weight_by_copies) const
 {
-  RefVector<MCPWalker> walkers(convertUPtrToRefVector(pop.get_walkers()));
-  FullPrecRealType esum = 0.0, e2sum = 0.0, wsum = 0.0, ecum = 0.0, w2sum = 0.0, besum = 0.0, bwgtsum = 0.0;
-  FullPrecRealType r2_accepted = 0.0, r2_proposed = 0.0;
-  int nrn(0), ncr(0), nfn(0), ngoodfn(0), nc(0);
-  for(MCPWalker& walker : walkers)
-  {
-    bool inFN = ((walker.ReleasedNodeAge) == 0);
-    nc        = std::min(static_cast<int>(walker.Multiplicity), MaxCopy);
-    if (write_release_nodes_)
+  auto sumRange = [this, &walkers, weight_by_copies](int first, int last, std::vector<FullPrecRealType>& sums) {
+    FullPrecRealType esum = 0.0, e2sum = 0.0, wsum = 0.0, ecum = 0.0, besum = 0.0, bwgtsum = 0.0;
+    FullPrecRealType r2_accepted = 0.0, r2_proposed = 0.0;
+    int nfn(0), ncr(0);
+    for (int iw = first; iw < last; ++iw)
     {
-      if (walker.ReleasedNodeAge == 1)
-        ncr += 1;
-      else if (walker.ReleasedNodeAge == 0)
-      {
-        nfn += 1;
-        ngoodfn += nc;
-      }
+      const MCPWalker& walker = walkers[iw];
+      int nc                  = std::min(static_cast<int>(walker.Multiplicity), MaxCopy);
       r2_accepted += walker.Properties(R2ACCEPTED);
       r2_proposed += walker.Properties(R2PROPOSED);
-      FullPrecRealType e(walker.Properties(LOCALENERGY));
-      FullPrecRealType bfe(walker.Properties(ALTERNATEENERGY));
-      FullPrecRealType wgt   = (walker.Weight);
-      FullPrecRealType rnwgt = (walker.ReleasedNodeWeight);
-      esum += wgt * rnwgt * e;
-      e2sum += wgt * rnwgt * e * e;
-      wsum += rnwgt * wgt;
-      w2sum += rnwgt * rnwgt * wgt * wgt;
-      ecum += e;
-      besum += bfe * wgt;
-      bwgtsum += wgt;
-    }
-    else
-    {
-      if (nc > 0)
-        nfn++;
+      FullPrecRealType local_energy(walker.Properties(LOCALENERGY));
+      if (write_release_nodes_)
+      {
+        if (walker.ReleasedNodeAge == 1)
+          ncr += 1;
+        else if (walker.ReleasedNodeAge == 0)
+          nfn += 1;
+        FullPrecRealType alternate_energy(walker.Properties(ALTERNATEENERGY));
+        FullPrecRealType wgt   = walker.Weight;
+        FullPrecRealType rnwgt = walker.ReleasedNodeWeight;
+        esum += wgt * rnwgt * local_energy;
+        e2sum += wgt * rnwgt * local_energy * local_energy;
+        wsum += rnwgt * wgt;
+        ecum += local_energy;
+        besum += alternate_energy * wgt;
+        bwgtsum += wgt;
+      }
       else
-        ncr++;
-      r2_accepted += walker.Properties(R2ACCEPTED);
-      r2_proposed += walker.Properties(R2PROPOSED);
-      FullPrecRealType e(walker.Properties(LOCALENERGY));
-      // This is a trick to estimate the number of walkers
-      // after the first iterration branching.
-      //RealType wgt=(walker.Weight);
-      FullPrecRealType wgt = FullPrecRealType(nc);
-      esum += wgt * e;
-      e2sum += wgt * e * e;
-      wsum += wgt;
-      w2sum += wgt * wgt;
-      ecum += e;
+      {
+        if (nc > 0)
+          nfn++;
+        else
+          ncr++;
+        // Weighting by the number of copies estimates the number of walkers
+        // after the first iteration branching.
+        FullPrecRealType wgt = weight_by_copies ? FullPrecRealType(nc) : FullPrecRealType(walker.Weight);
+        esum += wgt * local_energy;
+        e2sum += wgt * local_energy * local_energy;
+        wsum += wgt;
+        ecum += local_energy;
+      }
     }
+    sums[ENERGY_INDEX]     = esum;
+    sums[ENERGY_SQ_INDEX]  = e2sum;
+    sums[WEIGHT_INDEX]     = wsum;
+    sums[EREF_INDEX]       = ecum;
+    sums[R2ACCEPTED_INDEX] = r2_accepted;
+    sums[R2PROPOSED_INDEX] = r2_proposed;
+    sums[FNSIZE_INDEX]     = static_cast<FullPrecRealType>(nfn);
+    sums[RNONESIZE_INDEX]  = static_cast<FullPrecRealType>(ncr);
+    sums[B_ENERGY_INDEX]   = besum;
+    sums[B_WGT_INDEX]      = bwgtsum;
+  };
+
+  const int num_walkers = walkers.size();
+  const int num_ranges  = std::max(1, std::min(num_crowds_, num_walkers));
+  std::vector<std::vector<FullPrecRealType>> partial_sums(num_ranges, std::vector<FullPrecRealType>(LE_MAX, 0.0));
+  if (num_ranges == 1)
+    sumRange(0, num_walkers, partial_sums[0]);
+  else
+  {
+    auto sumCrowdRange = [num_walkers, num_ranges, &sumRange](int range_id,
+                                                               std::vector<std::vector<FullPrecRealType>>& sums) {
+      sumRange(range_id * num_walkers / num_ranges, (range_id + 1) * num_walkers / num_ranges, sums[range_id]);
+    };
+    TasksOneToOne<> do_per_crowd(num_ranges);
+    do_per_crowd(sumCrowdRange, partial_sums);
   }
+
+  // combined in range order so the sums only depend on the number of crowds
+  std::vector<FullPrecRealType> sums(LE_MAX, 0.0);
+  for (const auto& range_sums : partial_sums)
+    for (int i = 0; i < LE_MAX; ++i)
+      sums[i] += range_sums[i];
+  return sums;
+}
+
+int WalkerControlBase::doNotBranch(int iter, MCPopulation& pop)
+{
+  RefVector<MCPWalker> walkers(convertUPtrToRefVector(pop.get_walkers()));
+  std::vector<FullPrecRealType> sums(sumEnsembleProperties(walkers, true));
   //temp is an array to perform reduction operations
   std::fill(curData.begin(), curData.end(), 0);
-  curData[ENERGY_INDEX]      = esum;
-  curData[ENERGY_SQ_INDEX]   = e2sum;
-  curData[WALKERSIZE_INDEX]  = pop.get_num_global_walkers();
-  curData[WEIGHT_INDEX]      = wsum;
-  curData[EREF_INDEX]        = ecum;
-  curData[R2ACCEPTED_INDEX]  = r2_accepted;
-  curData[R2PROPOSED_INDEX]  = r2_proposed;
-  curData[FNSIZE_INDEX]      = static_cast<FullPrecRealType>(nfn);
-  curData[RNONESIZE_INDEX]   = static_cast<FullPrecRealType>(ncr);
-  curData[RNSIZE_INDEX]      = nrn;
-  curData[B_ENERGY_INDEX]    = besum;
-  curData[B_WGT_INDEX]       = bwgtsum;
+  std::copy(sums.begin(), sums.end(), curData.begin());
+  curData[WALKERSIZE_INDEX] = pop.get_num_global_walkers();
 
   myComm->allreduce(curData);
   measureProperties(iter);
@@ -552,10 +576,7 @@ WalkerControlBase::PopulationAdjustment WalkerControlBase::calcPopulationAdjustm
 
   PopulationAdjustment adjustment;
   adjustment.num_walkers = 0;
-  // So many sums and counters
-  FullPrecRealType esum = 0.0, e2sum = 0.0, wsum = 0.0, ecum = 0.0, w2sum = 0.0, besum = 0.0, bwgtsum = 0.0;
-  FullPrecRealType r2_accepted = 0.0, r2_proposed = 0.0;
-  int nfn(0), nrn(0), ngoodfn(0), ncr(0);
+  int nrn(0);
   for(MCPWalker& walker : walkers)
   {
     bool inFN = (walker.ReleasedNodeAge == 0);
@@ -566,45 +587,6 @@ WalkerControlBase::PopulationAdjustment WalkerControlBase::calcPopulationAdjustm
                                   };
     int nc = calcNumberWalkerCopies(walker.Multiplicity);
 
-    if (write_release_nodes_)
-    {
-      if (walker.ReleasedNodeAge == 1)
-        ncr += 1;
-      else if (walker.ReleasedNodeAge == 0)
-      {
-        nfn += 1;
-        ngoodfn += nc;
-      }
-      r2_accepted += walker.Properties(R2ACCEPTED);
-      r2_proposed += walker.Properties(R2PROPOSED);
-      FullPrecRealType local_energy(walker.Properties(LOCALENERGY));
-      FullPrecRealType alternate_energy(walker.Properties(ALTERNATEENERGY));
-      FullPrecRealType wgt   = walker.Weight;
-      FullPrecRealType rnwgt = walker.ReleasedNodeWeight;
-      esum += wgt * rnwgt * local_energy;
-      e2sum += wgt * rnwgt * local_energy * local_energy;
-      wsum += rnwgt * wgt;
-      w2sum += rnwgt * rnwgt * wgt * wgt;
-      ecum += local_energy;
-      besum += alternate_energy * wgt;
-      bwgtsum += wgt;
-    }
-    else
-    {
-      if (nc > 0)
-        nfn++;
-      else
-        ncr++;
-      r2_accepted += walker.Properties(R2ACCEPTED);
-      r2_proposed += walker.Properties(R2PROPOSED);
-      FullPrecRealType local_energy(walker.Properties(LOCALENERGY));
-      FullPrecRealType wgt = walker.Weight;
-      esum += wgt * local_energy;
-      e2sum += wgt * local_energy * local_energy;
-      wsum += wgt;
-      w2sum += wgt * wgt;
-      ecum += local_energy;
-    }
     if ((nc) && (inFN))
     {
       adjustment.num_walkers += nc;
@@ -628,21 +610,15 @@ WalkerControlBase::PopulationAdjustment WalkerControlBase::calcPopulationAdjustm
       adjustment.bad_walkers.push_back(walker);
     }
   }
+  // the ensemble sums are independent of the sorting and are reduced per crowd
+  std::vector<FullPrecRealType> sums(sumEnsembleProperties(walkers, false));
   //temp is an array to perform reduction operations
   std::fill(curData.begin(), curData.end(), 0);
   //update curData
-  curData[ENERGY_INDEX]     = esum;
-  curData[ENERGY_SQ_INDEX]  = e2sum;
+  std::copy(sums.begin(), sums.end(), curData.begin());
   curData[WALKERSIZE_INDEX] = pop.get_active_walkers();
-  curData[WEIGHT_INDEX]     = wsum;
-  curData[EREF_INDEX]       = ecum;
-  curData[R2ACCEPTED_INDEX] = r2_accepted;
-  curData[R2PROPOSED_INDEX] = r2_proposed;
   curData[FNSIZE_INDEX]     = good_walkers.size();
-  curData[RNONESIZE_INDEX]  = ncr;
   curData[RNSIZE_INDEX]     = nrn;
-  curData[B_ENERGY_INDEX]   = besum;
-  curData[B_WGT_INDEX]      = bwgtsum;
   if (write_release_nodes_)
   {
     auto addWalkersWithReleaseNodeAge = [&adjustment](MCPWalker& walker, int copies) {
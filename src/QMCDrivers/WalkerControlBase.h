@@ -122,6 +122,17 @@ public:
   /** update properties without branching */
   int doNotBranch(int iter, MCPopulation& pop);
 
+  /** sum the per walker contributions to the ensemble properties
+   *
+   *  The walkers are split into num_crowds_ contiguous ranges whose partial sums are
+   *  taken concurrently and then combined in range order.
+   *  @param walkers walkers of this rank
+   *  @param weight_by_copies weight the fixed node walkers by their number of copies instead of Weight
+   *  @return sums indexed like curData, LE_MAX long
+   */
+  std::vector<FullPrecRealType> sumEnsembleProperties(const RefVector<MCPWalker>& walkers,
+                                                      bool weight_by_copies) const;
+
   /** sort Walkers between good and bad and prepare branching
    *  
    *  not a sort changes internal state of walkers to copy and how many of each copy
@@ -183,6 +194,8 @@ public:
   void set_write_release_nodes(bool write_release_nodes) { write_release_nodes_ = write_release_nodes; }
   IndexType get_method() const { return method_; }
   void set_method(IndexType method) { method_ = method; }
+  int get_num_crowds() const { return num_crowds_; }
+  void set_num_crowds(int num_crowds) { num_crowds_ = num_crowds; }
 
 protected:
   ///id for the method
@@ -233,6 +246,8 @@ protected:
   
   ///ensemble properties
   MCDataType<FullPrecRealType> ensemble_property_;
+  ///number of concurrent ranges the ensemble sums of a population are split into
+  int num_crowds_;
 
 
 
@@ -0,0 +1,193 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "QMCDrivers/CorrelatedSampling/CSVMCBatched.h"
+#include "QMCWaveFunctions/Jastrow/RadialJastrowBuilder.h"
+#include "Estimators/tests/FakeEstimator.h"
+#include "QMCDrivers/tests/SetupPools.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("CSVMCBatched::SumRatio", "[drivers]")
+{
+  using RealType = CSVMCBatched::RealType;
+  std::vector<RealType> logpsi{-1.0, -1.5, -0.75};
+  std::vector<RealType> avg_norm{0.5, 0.25, 0.25};
+  Matrix<RealType> ratio_ij(3, 3);
+  std::vector<RealType> sumratio(3);
+  CSVMCBatched::computeSumRatio(logpsi, avg_norm, ratio_ij, sumratio);
+
+  auto scaledRatio = [&](const std::vector<RealType>& lpsi, int i, int j) {
+    return avg_norm[i] / avg_norm[j] * std::exp(2.0 * (lpsi[j] - lpsi[i]));
+  };
+  for (int i = 0; i < 3; ++i)
+  {
+    RealType sum = 0.0;
+    for (int j = 0; j < 3; ++j)
+    {
+      CHECK(ratio_ij(i, j) == Approx(scaledRatio(logpsi, i, j)));
+      sum += scaledRatio(logpsi, i, j);
+    }
+    CHECK(sumratio[i] == Approx(sum));
+  }
+
+  // an accepted move changes |psi_i|^2 by ratio_i
+  std::vector<RealType> ratio_i{0.5, 2.0, 1.25};
+  CSVMCBatched::updateRatioMatrix(ratio_i, ratio_ij);
+  CSVMCBatched::computeSumRatio(ratio_ij, sumratio);
+  std::vector<RealType> logpsi_new(3);
+  for (int i = 0; i < 3; ++i)
+    logpsi_new[i] = logpsi[i] + 0.5 * std::log(ratio_i[i]);
+  for (int i = 0; i < 3; ++i)
+  {
+    RealType sum = 0.0;
+    for (int j = 0; j < 3; ++j)
+    {
+      CHECK(ratio_ij(i, j) == Approx(scaledRatio(logpsi_new, i, j)));
+      sum += scaledRatio(logpsi_new, i, j);
+    }
+    CHECK(sumratio[i] == Approx(sum));
+  }
+}
+
+namespace testing
+{
+/// only exposes the driver timers to the test
+class CSVMCBatchedTest : public CSVMCBatched
+{
+public:
+  using CSVMCBatched::DriverTimers;
+};
+} // namespace testing
+
+/** the log psi, G and L of every wavefunction of the walkers against a single wavefunction evaluated from scratch
+ *
+ *  The wavefunctions share the ParticleSet of a walker and one after the other overwrite its G and L,
+ *  those kept in the TrialWaveFunction are the ones of the wavefunction.
+ */
+static void checkCorrelatedSystems(Crowd& crowd,
+                                   CSVMCBatched::CorrelatedSystems& systems,
+                                   const std::vector<TrialWaveFunction*>& psi_refs,
+                                   bool check_properties)
+{
+  using RealType = CSVMCBatched::RealType;
+  auto& walkers  = crowd.get_walkers();
+  for (int iw = 0; iw < crowd.size(); ++iw)
+  {
+    ParticleSet pset_ref(crowd.get_walker_elecs()[iw].get());
+    pset_ref.R = walkers[iw].get().R;
+    for (int ipsi = 0; ipsi < systems.get_num_psi(); ++ipsi)
+    {
+      pset_ref.update();
+      std::unique_ptr<TrialWaveFunction> psi_ref(psi_refs[ipsi]->makeClone(pset_ref));
+      const RealType logpsi_ref    = psi_ref->evaluateLog(pset_ref);
+      const TrialWaveFunction& twf = systems.psis[ipsi][iw];
+      CHECK(twf.getLogPsi() == Approx(logpsi_ref));
+      if (check_properties)
+        CHECK(walkers[iw].get().Properties(ipsi, LOGPSI) == Approx(logpsi_ref));
+      for (int iat = 0; iat < pset_ref.getTotalNum(); ++iat)
+      {
+        for (int idim = 0; idim < OHMMS_DIM; ++idim)
+          CHECK(std::real(twf.G[iat][idim]) == Approx(std::real(pset_ref.G[iat][idim])));
+        CHECK(std::real(twf.L[iat]) == Approx(std::real(pset_ref.L[iat])));
+      }
+    }
+  }
+}
+
+TEST_CASE("CSVMCBatched::advanceWalkers two wavefunctions", "[drivers]")
+{
+  using namespace testing;
+  using RealType = CSVMCBatched::RealType;
+  SetupPools pools;
+
+  ParticleSet& elec        = *pools.particle_pool->getParticleSet("e");
+  TrialWaveFunction& psi_0 = *pools.wavefunction_pool->getPrimary();
+  // the second wavefunction is the first one with a Jastrow factor
+  std::unique_ptr<TrialWaveFunction> psi_1(psi_0.makeClone(elec));
+  const char* jas_input = "<jastrow name=\"J2\" type=\"Two-Body\" function=\"Bspline\" print=\"no\"> \
+   <correlation size=\"4\" speciesA=\"u\" speciesB=\"u\"> \
+      <coefficients id=\"uu\" type=\"Array\"> 0.25 0.15 0.08 0.02 </coefficients> \
+   </correlation> \
+   <correlation size=\"4\" speciesA=\"u\" speciesB=\"d\"> \
+      <coefficients id=\"ud\" type=\"Array\"> 0.5 0.3 0.15 0.05 </coefficients> \
+   </correlation> \
+</jastrow>";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(jas_input));
+  RadialJastrowBuilder jb(elec, *psi_1);
+  REQUIRE(jb.put(doc.getRoot()));
+  std::vector<TrialWaveFunction*> psi_refs{&psi_0, psi_1.get()};
+  const int num_psi = psi_refs.size();
+
+  // the particle groups and masses of the moves are those of the walker configuration
+  MCPopulation population(1, *pools.particle_pool->getWalkerSet("e"), &elec, &psi_0,
+                          pools.hamiltonian_pool->getPrimary());
+  population.createWalkers(2);
+  EstimatorManagerBase em(pools.comm);
+  em.add(new FakeEstimator, "fake");
+  std::vector<std::unique_ptr<Crowd>> crowds;
+  crowds.emplace_back(std::make_unique<Crowd>(em));
+  population.distributeWalkers(crowds.begin(), crowds.end(), 2);
+  Crowd& crowd = *crowds[0];
+
+  // the wavefunction and hamiltonian clones of each walker as CSVMCBatched::createCorrelatedSystems makes them
+  UPtrVector<TrialWaveFunction> psi_clones;
+  UPtrVector<QMCHamiltonian> h_clones;
+  std::vector<CSVMCBatched::CorrelatedSystems> crowd_systems(1);
+  crowd_systems[0].resize(num_psi, crowd.size());
+  std::vector<TrialWaveFunction*> walker_psis(num_psi);
+  std::vector<QMCHamiltonian*> walker_hamiltonians(num_psi);
+  for (ParticleSet& pset : crowd.get_walker_elecs())
+  {
+    for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+    {
+      psi_clones.emplace_back(psi_refs[ipsi]->makeClone(pset));
+      h_clones.emplace_back(pools.hamiltonian_pool->getPrimary()->makeClone(pset, *psi_clones.back()));
+      walker_psis[ipsi]         = psi_clones.back().get();
+      walker_hamiltonians[ipsi] = h_clones.back().get();
+      walker_psis[ipsi]->G.resize(pset.getTotalNum());
+      walker_psis[ipsi]->L.resize(pset.getTotalNum());
+    }
+    crowd_systems[0].addWalker(walker_psis, walker_hamiltonians);
+  }
+  CSVMCBatched::CorrelatedSystems& systems = crowd_systems[0];
+
+  QMCDriverInput qmcdrv_input(3);
+  VMCDriverInput vmcdrv_input;
+  std::vector<RealType> avg_norm(num_psi, 1.0);
+  CSVMCBatched::StateForThread sft(qmcdrv_input, vmcdrv_input, population, avg_norm);
+  RandomGenerator_t random_gen;
+  std::vector<std::unique_ptr<ContextForSteps>> context_for_steps;
+  context_for_steps.emplace_back(std::make_unique<ContextForSteps>(crowd.size(), population.get_num_particles(),
+                                                                   population.get_particle_group_indexes(),
+                                                                   random_gen));
+  CSVMCBatchedTest::DriverTimers timers("CSVMCBatchedTest::");
+
+  CSVMCBatched::initCorrelatedWalkers(0, sft, timers, context_for_steps, crowds, crowd_systems);
+  checkCorrelatedSystems(crowd, systems, psi_refs, true);
+  // the two wavefunctions differ
+  CHECK(systems.psis[0][0].get().getLogPsi() != Approx(systems.psis[1][0].get().getLogPsi()));
+
+  // every sweep restores both wavefunctions from the buffer of the walker and stores them back
+  for (int step = 0; step < 3; ++step)
+  {
+    CSVMCBatched::advanceWalkers(sft, crowd, timers, *context_for_steps[0], systems, step == 2);
+    checkCorrelatedSystems(crowd, systems, psi_refs, true);
+  }
+  CHECK(crowd.get_accept_ratio() > 0.0);
+  for (int ipsi = 0; ipsi < num_psi; ++ipsi)
+    CHECK(systems.cum_norm[ipsi] > 0.0);
+}
+
+} // namespace qmcplusplus
@@ -148,6 +148,29 @@ TEST_CASE("Crowd redistribute walkers")
                     *crowd_with_walkers.hams[iw]);
   REQUIRE(crowd.size() == 3);
   REQUIRE(crowd.get_grads_new().size() == 3);
+  REQUIRE(crowd.get_drifts().size() == 3);
+  REQUIRE(crowd.get_node_rejects().size() == 3);
+  REQUIRE(crowd.get_elec_accept_list().capacity() >= 3);
+}
+
+TEST_CASE("Crowd::clearAcceptRejectLists", "[Drivers]")
+{
+  using namespace testing;
+  SetupPools pools;
+
+  CrowdWithWalkers crowd_with_walkers(pools);
+  Crowd& crowd = crowd_with_walkers.get_crowd();
+
+  crowd.get_elec_accept_list().push_back(crowd.get_walker_elecs()[0]);
+  crowd.get_twf_accept_list().push_back(crowd.get_walker_twfs()[0]);
+  crowd.get_elec_reject_list().push_back(crowd.get_walker_elecs()[1]);
+  crowd.get_twf_reject_list().push_back(crowd.get_walker_twfs()[1]);
+  crowd.clearAcceptRejectLists();
+  REQUIRE(crowd.get_elec_accept_list().empty());
+  REQUIRE(crowd.get_twf_accept_list().empty());
+  REQUIRE(crowd.get_elec_reject_list().empty());
+  REQUIRE(crowd.get_twf_reject_list().empty());
+  REQUIRE(crowd.get_elec_accept_list().capacity() >= 2);
 }
 
 } // namespace qmcplusplus
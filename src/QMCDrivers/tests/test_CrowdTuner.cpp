@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <sstream>
+#include "QMCDrivers/CrowdTuner.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("CrowdTuner candidates", "[drivers]")
+{
+  CrowdTuner tuner(8, 8, 8, 1);
+  std::vector<int> expected{8, 4, 2, 1};
+  CHECK(tuner.get_candidates() == expected);
+  CHECK(tuner.isTuning());
+
+  CrowdTuner odd(3, 6, 6, 2);
+  std::vector<int> expected_odd{3, 6, 1};
+  CHECK(odd.get_candidates() == expected_odd);
+
+  CrowdTuner off(4, 4, 4, 0);
+  CHECK(!off.isTuning());
+  CHECK(off.get_num_crowds() == 4);
+
+  CrowdTuner single(1, 1, 1, 2);
+  CHECK(!single.isTuning());
+
+  // 9 walkers asked for 4 crowds fill 3 crowds of 3, the duplicate is measured once
+  CHECK(CrowdTuner::realizable(4, 9) == 3);
+  CHECK(CrowdTuner::realizable(2, 9) == 2);
+  CHECK(CrowdTuner::realizable(9, 9) == 9);
+  CrowdTuner filled(4, 9, 9, 1);
+  std::vector<int> expected_filled{3, 9, 2, 1};
+  CHECK(filled.get_candidates() == expected_filled);
+  CHECK(filled.get_num_crowds() == 3);
+}
+
+TEST_CASE("CrowdTuner selection", "[drivers]")
+{
+  CrowdTuner tuner(4, 4, 8, 2);
+  // 4 crowds, two blocks each
+  CHECK(tuner.get_num_crowds() == 4);
+  CHECK(!tuner.recordBlock(100.0, 1.0, 4, nullptr));
+  CHECK(tuner.recordBlock(100.0, 1.0, 4, nullptr));
+  // 2 crowds are the fastest
+  CHECK(tuner.get_num_crowds() == 2);
+  CHECK(!tuner.recordBlock(300.0, 1.0, 2, nullptr));
+  CHECK(tuner.recordBlock(300.0, 1.0, 2, nullptr));
+  CHECK(tuner.get_num_crowds() == 1);
+  CHECK(!tuner.recordBlock(200.0, 1.0, 1, nullptr));
+  // selection differs from the last candidate
+  CHECK(tuner.recordBlock(200.0, 1.0, 1, nullptr));
+  CHECK(!tuner.isTuning());
+  CHECK(tuner.get_num_crowds() == 2);
+  // no more changes
+  CHECK(!tuner.recordBlock(1000.0, 1.0, 2, nullptr));
+  CHECK(tuner.get_num_crowds() == 2);
+
+  std::ostringstream os;
+  tuner.report(os);
+  CHECK(os.str().find("Selected 2 crowds") != std::string::npos);
+}
+
+TEST_CASE("CrowdTuner realized crowds", "[drivers]")
+{
+  // a rank with more walkers than the others can fill another number of crowds
+  CrowdTuner tuner(2, 2, 4, 1);
+  CHECK(tuner.recordBlock(100.0, 1.0, 3, nullptr));
+  CHECK(tuner.recordBlock(50.0, 1.0, 1, nullptr));
+  CHECK(tuner.get_num_crowds() == 2);
+  std::ostringstream os;
+  tuner.report(os);
+  CHECK(os.str().find("     2               3") != std::string::npos);
+}
+
+} // namespace qmcplusplus
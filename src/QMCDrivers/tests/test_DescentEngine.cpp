@@ -71,6 +71,55 @@ REQUIRE(std::real(results[1]) == Approx(-2.001));
 
 }
 
+///The derivatives reduced from the sample vectors and from the streamed walker batch must agree
+TEST_CASE("DescentEngine streamed samples","[drivers][descent]")
+{
+OHMMS::Controller->initialize(0, NULL);
+Communicate* c = OHMMS::Controller;
+
+xmlNodePtr fakeXML = NULL;
+
+DescentEngine vector_engine(c, fakeXML);
+DescentEngine stream_engine(c, fakeXML);
+
+const int num_params = 2;
+vector_engine.prepareStorage(1, num_params);
+stream_engine.prepareStorage(1, num_params);
+
+//Fake derivatives and local energies of three walkers
+std::vector<std::vector<ValueType>> dlogpsi_list{{0.5, -1.0}, {0.25, 2.0}, {-0.75, 0.5}};
+std::vector<std::vector<ValueType>> dhpsioverpsi_list{{1.0, 0.5}, {-2.0, 0.25}, {0.5, -1.5}};
+std::vector<QMCTraits::FullPrecRealType> local_energies{-1.5, -2.0, -1.0};
+
+for (int iw = 0; iw < local_energies.size(); iw++)
+{
+  std::vector<FullPrecValueType> der_rat_samp(num_params + 1, 1.0);
+  std::vector<FullPrecValueType> le_der_samp(num_params + 1, local_energies[iw]);
+  for (int i = 0; i < num_params; i++)
+  {
+    der_rat_samp[i + 1] = dlogpsi_list[iw][i];
+    le_der_samp[i + 1]  = dhpsioverpsi_list[iw][i] + local_energies[iw] * dlogpsi_list[iw][i];
+  }
+  vector_engine.takeSample(0, der_rat_samp, le_der_samp, le_der_samp, 1.0, 1.0);
+}
+stream_engine.takeSamples(0, dlogpsi_list, dhpsioverpsi_list, local_energies);
+
+std::vector<QMCTraits::FullPrecRealType> etemp{-4.5, 3.0, 7.25};
+vector_engine.setEtemp(etemp);
+vector_engine.sample_finish();
+stream_engine.setEtemp(etemp);
+stream_engine.sample_finish();
+
+const std::vector<ValueType>& vector_derivs = vector_engine.getAveragedDerivatives();
+const std::vector<ValueType>& stream_derivs = stream_engine.getAveragedDerivatives();
+//2*(<E_L dlogpsi> - <E_L><dlogpsi>) + 2*<dhpsioverpsi>
+REQUIRE(std::real(vector_derivs[0]) == Approx(-2.0 / 3.0));
+REQUIRE(std::real(vector_derivs[1]) == Approx(-1.0));
+for (int i = 0; i < num_params; i++)
+  REQUIRE(std::real(stream_derivs[i]) == Approx(std::real(vector_derivs[i])));
+
+}
+
 }
 
 
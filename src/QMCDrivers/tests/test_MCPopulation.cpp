@@ -91,4 +91,48 @@ TEST_CASE("MCPopulation::distributeWalkers", "[particle][population]")
   REQUIRE((*walker_consumers_incommensurate[4]).walkers.size() == 4);
 }
 
+TEST_CASE("MCPopulation::killWalker spawnWalker recycle", "[particle][population]")
+{
+  using namespace testing;
+  Communicate* comm;
+  OHMMS::Controller->initialize(0, NULL);
+  comm = OHMMS::Controller;
+
+  MinimalParticlePool mpp;
+  ParticleSetPool particle_pool = mpp(comm);
+  MinimalWaveFunctionPool wfp;
+  WaveFunctionPool wavefunction_pool = wfp(comm, &particle_pool);
+  wavefunction_pool.setPrimary(wavefunction_pool.getWaveFunction("psi0"));
+  MinimalHamiltonianPool mhp;
+  HamiltonianPool hamiltonian_pool = mhp(comm, &particle_pool, &wavefunction_pool);
+
+  MCPopulation population(1, particle_pool.getParticleSet("e"), wavefunction_pool.getPrimary(),
+                          hamiltonian_pool.getPrimary());
+
+  population.createWalkers(4);
+  using MCPWalker = MCPopulation::MCPWalker;
+  MCPWalker* killed = population.get_walkers()[1].get();
+  MCPWalker* last   = population.get_walkers()[3].get();
+  population.killWalker(*killed);
+  REQUIRE(population.get_num_local_walkers() == 3);
+  REQUIRE(population.get_walkers().size() == 3);
+  REQUIRE(population.get_num_dead_walkers() == 1);
+  // the live walkers stay dense and in order
+  CHECK(population.get_walkers()[2].get() == last);
+
+  MCPWalker& spawned = population.spawnWalker();
+  CHECK(&spawned == killed);
+  CHECK(spawned.Weight == 1.0);
+  REQUIRE(population.get_num_local_walkers() == 4);
+  REQUIRE(population.get_num_dead_walkers() == 0);
+
+  // with the dead pool empty a new walker is cloned
+  MCPWalker& cloned = population.spawnWalker();
+  CHECK(&cloned == population.get_walkers().back().get());
+  REQUIRE(population.get_walkers().size() == 5);
+
+  MCPWalker not_in_population;
+  CHECK_THROWS(population.killWalker(not_in_population));
+}
+
 } // namespace qmcplusplus
@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include <catch.hpp>
+
+#include "QMCDrivers/RMC/RMCBatched.h"
+#include "QMCDrivers/GreenFunctionModifiers/DriftModifierUNR.h"
+#include "Estimators/tests/FakeEstimator.h"
+#include "QMCDrivers/tests/SetupPools.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("RMCBatched::ReptileBeads", "[drivers]")
+{
+  using MCPWalker = RMCBatched::MCPWalker;
+  MCPWalker walker(2);
+  RMCBatched::ReptileBeads reptile(4, walker);
+  REQUIRE(reptile.size() == 4);
+  // tag the beads from the head to the tail
+  for (int i = 0; i < reptile.size(); ++i)
+    reptile.getBead(i).Age = i;
+  CHECK(reptile.getHead().Age == 0);
+  CHECK(reptile.getCenter().Age == 1);
+  CHECK(reptile.getNext().Age == 2);
+  CHECK(reptile.getTail().Age == 3);
+
+  // an accepted head overwrites the tail
+  reptile.getNewHead().Age = 4;
+  CHECK(reptile.getHead().Age == 4);
+  CHECK(reptile.getBead(1).Age == 0);
+  CHECK(reptile.getTail().Age == 2);
+
+  // a bounce turns the reptile around
+  reptile.flip();
+  CHECK(reptile.getHead().Age == 2);
+  CHECK(reptile.getBead(1).Age == 1);
+  CHECK(reptile.getNext().Age == 0);
+  CHECK(reptile.getTail().Age == 4);
+}
+
+namespace testing
+{
+/// only exposes the driver timers to the test
+class RMCBatchedTest : public RMCBatched
+{
+public:
+  using RMCBatched::DriverTimers;
+};
+} // namespace testing
+
+TEST_CASE("RMCBatched::moveReptiles Age", "[drivers]")
+{
+  using namespace testing;
+  using MCPWalker = RMCBatched::MCPWalker;
+  SetupPools pools;
+
+  MCPopulation population(1, pools.particle_pool->getParticleSet("e"), pools.wavefunction_pool->getPrimary(),
+                          pools.hamiltonian_pool->getPrimary());
+  population.createWalkers(1);
+  EstimatorManagerBase em(pools.comm);
+  em.add(new FakeEstimator, "fake");
+  UPtrVector<Crowd> crowds;
+  crowds.emplace_back(std::make_unique<Crowd>(em));
+  population.distributeWalkers(crowds.begin(), crowds.end(), 1);
+  Crowd& crowd = *crowds[0];
+
+  QMCDriverInput qmcdrv_input(3);
+  RMCDriverInput rmcdrv_input;
+  DriftModifierUNR drift_modifier;
+  SimpleFixedNodeBranch branch_engine(0.1, 1);
+  RMCBatched::StateForThread sft(qmcdrv_input, rmcdrv_input, drift_modifier, branch_engine, population);
+  RandomGenerator_t random_gen;
+  ContextForSteps step_context(crowd.size(), population.get_num_particles(), population.get_particle_group_indexes(),
+                               random_gen);
+  RMCBatchedTest::DriverTimers timers("RMCBatchedTest::");
+
+  MCPWalker& prophead = crowd.get_walkers()[0];
+  std::vector<RMCBatched::ReptileBeads> reptiles;
+  reptiles.emplace_back(4, prophead);
+  RMCBatched::ReptileBeads& reptile = reptiles[0];
+  for (int i = 0; i < reptile.size(); ++i)
+    reptile.getBead(i).Age = 0;
+
+  // all the moves of the head are rejected: the head ages and the reptile bounces
+  reptile.resetMoveStats();
+  MCPWalker& oldhead = reptile.getHead();
+  RMCBatched::moveReptiles(sft, crowd, timers, step_context, reptiles);
+  CHECK(oldhead.Age == 1);
+  CHECK(reptile.getTail().Age == 1);
+  CHECK(&reptile.getHead() != &oldhead);
+  CHECK(prophead.Age == reptile.getHead().Age);
+
+  // an old head forces the acceptance, the new head starts with Age 0
+  reptile.getHead().Age = rmcdrv_input.get_max_age();
+  prophead.Age          = rmcdrv_input.get_max_age();
+  reptile.num_accepted  = 1;
+  RMCBatched::moveReptiles(sft, crowd, timers, step_context, reptiles);
+  CHECK(prophead.Age == 0);
+  CHECK(reptile.getHead().Age == 0);
+  CHECK(reptile.getBead(1).Age == rmcdrv_input.get_max_age());
+}
+
+} // namespace qmcplusplus
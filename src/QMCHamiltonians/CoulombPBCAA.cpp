@@ -15,6 +15,7 @@
 
 
 #include "QMCHamiltonians/CoulombPBCAA.h"
+#include "LongRange/PPPMHandler.h"
 #include "Particle/DistanceTableData.h"
 #include "Utilities/ProgressReportEngine.h"
 #include <numeric>
@@ -22,7 +23,7 @@
 namespace qmcplusplus
 {
 CoulombPBCAA::CoulombPBCAA(ParticleSet& ref, bool active, bool computeForces)
-    : AA(0), d_aa_ID(ref.addTable(ref, DT_SOA_PREFERRED)),
+    : AA(0), meshAA(0), d_aa_ID(ref.addTable(ref, DT_SOA_PREFERRED)),
       myGrid(0),
       rVs(0),
       is_active(active),
@@ -52,7 +53,7 @@ CoulombPBCAA::CoulombPBCAA(ParticleSet& ref, bool active, bool computeForces)
   app_log() << "\n    e-e Madelung Const. =" << MC0 << "\n    Vtot     =" << Value << std::endl;
 }
 
-CoulombPBCAA::~CoulombPBCAA() {}
+CoulombPBCAA::~CoulombPBCAA() { delete meshAA; }
 
 void CoulombPBCAA::addObservables(PropertySetType& plist, BufferType& collectables)
 {
@@ -296,6 +297,11 @@ void CoulombPBCAA::initBreakup(ParticleSet& P)
     Zat[iat]       = Zspec[P.GroupID[iat]];
   }
   AA = LRCoulombSingleton::getHandler(P);
+  // the mesh charges and potential are scratch, the shared handler is only read
+  delete meshAA;
+  meshAA = nullptr;
+  if (PPPMHandler* mesh = dynamic_cast<PPPMHandler*>(AA))
+    meshAA = mesh->makeClone(P);
   //AA->initBreakup(*PtclRef);
   myConst = evalConsts();
   myRcut  = AA->get_rc(); //Basis.get_rc();
@@ -537,6 +543,10 @@ CoulombPBCAA::Return_t CoulombPBCAA::evalLR(ParticleSet& P)
       }
     }
   }
+  else if (meshAA)
+  {
+    res = meshAA->evaluateMesh(P, Zat);
+  }
   else
   {
     for (int spec1 = 0; spec1 < NumSpecies; spec1++)
@@ -699,6 +709,11 @@ OperatorBase* CoulombPBCAA::makeClone(ParticleSet& qp, TrialWaveFunction& psi)
   if (is_active)
     return new CoulombPBCAA(qp, is_active, ComputeForces);
   else
-    return new CoulombPBCAA(*this); //nothing needs to be re-evaluated
+  {
+    CoulombPBCAA* myclone = new CoulombPBCAA(*this); //nothing needs to be re-evaluated
+    if (meshAA)
+      myclone->meshAA = meshAA->makeClone(qp);
+    return myclone;
+  }
 }
 } // namespace qmcplusplus
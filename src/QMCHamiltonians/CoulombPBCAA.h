@@ -23,6 +23,8 @@
 
 namespace qmcplusplus
 {
+class PPPMHandler;
+
 /** @ingroup hamiltonian
  *\brief Calculates the AA Coulomb potential using PBCs
  *
@@ -39,6 +41,8 @@ struct CoulombPBCAA : public OperatorBase, public ForceBase
   typedef DistanceTableData::RowContainer RowContainerType;
 
   LRHandlerType* AA;
+  ///clone of AA owned by this operator when the long-range part is evaluated on a mesh
+  PPPMHandler* meshAA;
   GridType* myGrid;
   RadFunctorType* rVs;
 
@@ -15,6 +15,7 @@
 
 
 #include "QMCHamiltonians/CoulombPBCAB.h"
+#include "LongRange/PPPMHandler.h"
 #include "Particle/DistanceTableData.h"
 #include "Message/Communicate.h"
 #include "Utilities/ProgressReportEngine.h"
@@ -23,6 +24,7 @@ namespace qmcplusplus
 {
 CoulombPBCAB::CoulombPBCAB(ParticleSet& ions, ParticleSet& elns, bool computeForces)
     : PtclA(ions),
+      meshAB(nullptr),
       myConst(0.0),
       myGrid(nullptr),
       V0(nullptr),
@@ -91,6 +93,7 @@ OperatorBase* CoulombPBCAB::makeClone(ParticleSet& qp, TrialWaveFunction& psi)
 
 CoulombPBCAB::~CoulombPBCAB()
 {
+  delete meshAB;
   delete V0;
   delete fV0;
   delete dfV0;
@@ -461,6 +464,10 @@ CoulombPBCAB::Return_t CoulombPBCAB::evalLR(ParticleSet& P)
       res += Zat[iat] * u;
     }
   }
+  else if (meshAB)
+  {
+    res = meshAB->evaluateMesh(PtclA, Zat, P, Qat);
+  }
   else
   {
     for (int i = 0; i < NumSpeciesA; i++)
@@ -616,7 +623,12 @@ void CoulombPBCAB::initBreakup(ParticleSet& P)
   //AB->initBreakup(*PtclB);
   //initBreakup is called only once
   //AB = LRCoulombSingleton::getHandler(*PtclB);
-  AB      = LRCoulombSingleton::getHandler(P);
+  AB = LRCoulombSingleton::getHandler(P);
+  // the mesh charges and potential are scratch, the shared handler is only read
+  delete meshAB;
+  meshAB = nullptr;
+  if (PPPMHandler* mesh = dynamic_cast<PPPMHandler*>(AB))
+    meshAB = mesh->makeClone(P);
   myConst = evalConsts();
   myRcut  = AB->get_rc(); //Basis.get_rc();
   // create the spline function for the short-range part assuming pure potential
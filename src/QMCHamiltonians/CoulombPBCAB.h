@@ -26,6 +26,8 @@
 #include "Particle/DistanceTableData.h"
 namespace qmcplusplus
 {
+class PPPMHandler;
+
 /** @ingroup hamiltonian
  *\brief Calculates the AA Coulomb potential using PBCs
  *
@@ -45,6 +47,8 @@ struct CoulombPBCAB : public OperatorBase, public ForceBase
   ParticleSet& PtclA;
   ///long-range Handler
   LRHandlerType* AB;
+  ///clone of AB owned by this operator when the long-range part is evaluated on a mesh
+  PPPMHandler* meshAB;
   ///long-range derivative handler
   LRHandlerType* dAB;
   ///locator of the distance table
@@ -41,45 +41,69 @@ DensityEstimator::DensityEstimator(ParticleSet& elns)
 
 void DensityEstimator::resetTargetParticleSet(ParticleSet& P) {}
 
-DensityEstimator::Return_t DensityEstimator::evaluate(ParticleSet& P)
+inline int DensityEstimator::findGridIndex(const ParticleSet::ParticleLayout_t& lattice, const PosType& r) const
 {
-  RealType wgt = tWalker->Weight;
+  PosType ru;
   if (Periodic)
+    ru = lattice.toUnit(r);
+  else
   {
-    for (int iat = 0; iat < P.getTotalNum(); ++iat)
+    for (int dim = 0; dim < OHMMS_DIM; dim++)
     {
-      PosType ru;
-      ru    = P.Lattice.toUnit(P.R[iat]);
-      int i = static_cast<int>(DeltaInv[0] * (ru[0] - std::floor(ru[0])));
-      int j = static_cast<int>(DeltaInv[1] * (ru[1] - std::floor(ru[1])));
-      int k = static_cast<int>(DeltaInv[2] * (ru[2] - std::floor(ru[2])));
-      P.Collectables[getGridIndex(i, j, k)] += wgt; //1.0;
-      //	P.Collectables[getGridIndexPotential(i,j,k)]-=1.0;
+      //ru[dim]=(r[dim]-density_min[dim])/(density_max[dim]-density_min[dim]);
+      ru[dim] = (r[dim] - density_min[dim]) * ScaleFactor[dim];
     }
+    if (!(ru[0] > 0.0 && ru[1] > 0.0 && ru[2] > 0.0 && ru[0] < 1.0 && ru[1] < 1.0 && ru[2] < 1.0))
+      return -1;
   }
-  else
+  int i = static_cast<int>(DeltaInv[0] * (ru[0] - std::floor(ru[0])));
+  int j = static_cast<int>(DeltaInv[1] * (ru[1] - std::floor(ru[1])));
+  int k = static_cast<int>(DeltaInv[2] * (ru[2] - std::floor(ru[2])));
+  return getGridIndex(i, j, k);
+}
+
+DensityEstimator::Return_t DensityEstimator::evaluate(ParticleSet& P)
+{
+  RealType wgt = tWalker->Weight;
+  for (int iat = 0; iat < P.getTotalNum(); ++iat)
   {
-    for (int iat = 0; iat < P.getTotalNum(); ++iat)
-    {
-      PosType ru;
-      for (int dim = 0; dim < OHMMS_DIM; dim++)
-      {
-        //ru[dim]=(P.R[iat][dim]-density_min[dim])/(density_max[dim]-density_min[dim]);
-        ru[dim] = (P.R[iat][dim] - density_min[dim]) * ScaleFactor[dim];
-      }
-      if (ru[0] > 0.0 && ru[1] > 0.0 && ru[2] > 0.0 && ru[0] < 1.0 && ru[1] < 1.0 && ru[2] < 1.0)
-      {
-        int i = static_cast<int>(DeltaInv[0] * (ru[0] - std::floor(ru[0])));
-        int j = static_cast<int>(DeltaInv[1] * (ru[1] - std::floor(ru[1])));
-        int k = static_cast<int>(DeltaInv[2] * (ru[2] - std::floor(ru[2])));
-        P.Collectables[getGridIndex(i, j, k)] += wgt; //1.0;
-        //	  P.Collectables[getGridIndexPotential(i,j,k)]-=1.0;
-      }
-    }
+    const int ig = findGridIndex(P.Lattice, P.R[iat]);
+    if (ig >= 0)
+      P.Collectables[ig] += wgt; //1.0;
   }
   return 0.0;
 }
 
+/** bin the particles of all the walkers
+ *
+ * The grid indices of all the particles are found in a single pass before any
+ * bin is touched, the binning is then a plain weighted scatter into the buffer.
+ */
+void DensityEstimator::mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                                               const RefVector<ParticleSet>& P_list,
+                                               const RefVector<Walker_t>& W_list,
+                                               BufferType& collectables)
+{
+  const int nw = P_list.size();
+  const int N  = P_list[0].get().getTotalNum();
+  grid_ids.resize(nw * N);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    const ParticleSet& P = P_list[iw];
+    int* restrict ids    = grid_ids.data() + iw * N;
+    for (int iat = 0; iat < N; ++iat)
+      ids[iat] = findGridIndex(P.Lattice, P.R[iat]);
+  }
+  for (int iw = 0; iw < nw; iw++)
+  {
+    const RealType wgt      = W_list[iw].get().Weight;
+    const int* restrict ids = grid_ids.data() + iw * N;
+    for (int iat = 0; iat < N; ++iat)
+      if (ids[iat] >= 0)
+        collectables[ids[iat]] += wgt;
+  }
+}
+
 void DensityEstimator::addEnergy(MCWalkerConfiguration& W, std::vector<RealType>& LocalEnergy)
 {
   int nw = W.WalkerList.size();
@@ -33,6 +33,10 @@ public:
   void resetTargetParticleSet(ParticleSet& P);
 
   Return_t evaluate(ParticleSet& P);
+  void mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                               const RefVector<ParticleSet>& P_list,
+                               const RefVector<Walker_t>& W_list,
+                               BufferType& collectables);
   void addEnergy(MCWalkerConfiguration& W, std::vector<RealType>& LocalEnergy);
 
   void addObservables(PropertySetType& plist) {}
@@ -71,6 +75,8 @@ private:
   TinyVector<RealType, OHMMS_DIM> density_max;
   ///name of the density data
   std::string prefix;
+  ///grid indices of the particles of a crowd of walkers
+  std::vector<int> grid_ids;
   ///density
   //Array<RealType,OHMMS_DIM> density, Vavg;
   /** resize the internal data
@@ -78,6 +84,8 @@ private:
    * The argument list is not completed
    */
   void resize();
+  ///return the index of the grid point of r, -1 if r is outside of the grid
+  inline int findGridIndex(const ParticleSet::ParticleLayout_t& lattice, const PosType& r) const;
 };
 
 } // namespace qmcplusplus
@@ -317,6 +317,9 @@ void DensityMatrices1B::initialize()
   if (evaluator == matrix)
   {
     Phi_MB.resize(samples, basis_size);
+    Phi_PB.resize(nparticles, basis_size);
+    samples_vp   = std::unique_ptr<VirtualParticleSet>(new VirtualParticleSet(Pq, samples));
+    particles_vp = std::unique_ptr<VirtualParticleSet>(new VirtualParticleSet(Pq, nparticles));
     for (int s = 0; s < nspecies; ++s)
     {
       int specs_size = species_size[s];
@@ -603,6 +606,42 @@ DensityMatrices1B::Return_t DensityMatrices1B::evaluate(ParticleSet& P)
 }
 
 
+/** evaluate the density matrices of the walkers of a crowd
+ *
+ * The integration samples and their basis values are generated once by the
+ * first component and shared by all the walkers, only the wavefunction ratios
+ * and the basis values at the particles are evaluated per walker. The loop
+ * evaluator and the energy matrices fall back to one walker at a time.
+ */
+void DensityMatrices1B::mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                                                const RefVector<ParticleSet>& P_list,
+                                                const RefVector<Walker_t>& W_list,
+                                                BufferType& collectables)
+{
+  if (evaluator != matrix || energy_mat || check_derivatives)
+  {
+    OperatorBase::mw_evaluateCollectables(O_list, P_list, W_list, collectables);
+    return;
+  }
+  ScopedTimer t(timers[DM_eval]);
+  if (!warmed_up)
+    warmup_sampling();
+  generate_samples(1.0);
+  generate_sample_basis(Phi_MB);
+  // this is also the first component, keep the unweighted samples aside
+  const Vector<RealType> weights(sample_weights);
+  for (int iw = 0; iw < O_list.size(); iw++)
+  {
+    DensityMatrices1B& dm = static_cast<DensityMatrices1B&>(O_list[iw].get());
+    dm.setHistories(W_list[iw]);
+    dm.rsamples       = rsamples;
+    dm.sample_weights = weights;
+    dm.sample_weights *= W_list[iw].get().Weight * metric;
+    dm.integrate_matrix(P_list[iw], Phi_MB, collectables);
+  }
+}
+
+
 DensityMatrices1B::Return_t DensityMatrices1B::evaluate_matrix(ParticleSet& P)
 {
   //perform warmup sampling the first time
@@ -619,67 +658,8 @@ DensityMatrices1B::Return_t DensityMatrices1B::evaluate_matrix(ParticleSet& P)
     get_energies(E_N); // energies        : particles x 1
   // compute sample positions (monte carlo or deterministic)
   generate_samples(weight);
-  // compute basis and wavefunction ratio values in matrix form
-  generate_sample_basis(Phi_MB);      // basis           : samples   x basis_size
-  generate_sample_ratios(Psi_NM);     // conj(Psi ratio) : particles x samples
-  generate_particle_basis(P, Phi_NB); // conj(basis)     : particles x basis_size
-  // perform integration via matrix products
-  timers[DM_matrix_products]->start();
-  for (int s = 0; s < nspecies; ++s)
-  {
-    Matrix_t& Psi_nm     = *Psi_NM[s];
-    Matrix_t& Phi_Psi_nb = *Phi_Psi_NB[s];
-    Matrix_t& Phi_nb     = *Phi_NB[s];
-    diag_product(Psi_nm, sample_weights, Psi_nm);
-    product(Psi_nm, Phi_MB, Phi_Psi_nb);       // ratio*basis : particles x basis_size
-    product_AtB(Phi_nb, Phi_Psi_nb, *N_BB[s]); // conj(basis)^T*ratio*basis : basis_size^2
-    if (energy_mat)
-    {
-      Vector_t& E = *E_N[s];
-      diag_product(E, Phi_nb, Phi_nb);           // diag(energies)*qmcplusplus::conj(basis)
-      product_AtB(Phi_nb, Phi_Psi_nb, *E_BB[s]); // (energies*conj(basis))^T*ratio*basis
-    }
-  }
-  timers[DM_matrix_products]->stop();
-  // accumulate data into collectables
-  timers[DM_accumulate]->start();
-  const int basis_size2 = basis_size * basis_size;
-  int ij                = nindex;
-  for (int s = 0; s < nspecies; ++s)
-  {
-    //int ij=nindex; // for testing
-    const Matrix_t& NDM = *N_BB[s];
-    for (int n = 0; n < basis_size2; ++n)
-    {
-      Value_t val = NDM(n);
-      P.Collectables[ij] += real(val);
-      ij++;
-#if defined(QMC_COMPLEX)
-      P.Collectables[ij] += imag(val);
-      ij++;
-#endif
-    }
-  }
-  if (energy_mat)
-  {
-    int ij = eindex;
-    for (int s = 0; s < nspecies; ++s)
-    {
-      //int ij=eindex; // for testing
-      const Matrix_t& EDM = *E_BB[s];
-      for (int n = 0; n < basis_size2; ++n)
-      {
-        Value_t val = EDM(n);
-        P.Collectables[ij] += real(val);
-        ij++;
-#if defined(QMC_COMPLEX)
-        P.Collectables[ij] += imag(val);
-        ij++;
-#endif
-      }
-    }
-  }
-  timers[DM_accumulate]->stop();
+  generate_sample_basis(Phi_MB); // basis           : samples   x basis_size
+  integrate_matrix(P, Phi_MB, P.Collectables);
 
 
   // jtk come back to this
@@ -754,6 +734,78 @@ DensityMatrices1B::Return_t DensityMatrices1B::evaluate_matrix(ParticleSet& P)
 }
 
 
+/** integrate the density matrices of a walker over the samples
+ * @param P particle set of the walker
+ * @param Phi_mb basis values at the samples : samples x basis_size
+ * @param collectables buffer the density matrices are added to
+ *
+ * rsamples and sample_weights, the walker weight included, must be set.
+ */
+void DensityMatrices1B::integrate_matrix(ParticleSet& P, const Matrix_t& Phi_mb, BufferType& collectables)
+{
+  // compute wavefunction ratio and particle basis values in matrix form
+  generate_sample_ratios(Psi_NM);     // conj(Psi ratio) : particles x samples
+  generate_particle_basis(P, Phi_NB); // conj(basis)     : particles x basis_size
+  // perform integration via matrix products
+  timers[DM_matrix_products]->start();
+  for (int s = 0; s < nspecies; ++s)
+  {
+    Matrix_t& Psi_nm     = *Psi_NM[s];
+    Matrix_t& Phi_Psi_nb = *Phi_Psi_NB[s];
+    Matrix_t& Phi_nb     = *Phi_NB[s];
+    diag_product(Psi_nm, sample_weights, Psi_nm);
+    product(Psi_nm, Phi_mb, Phi_Psi_nb);       // ratio*basis : particles x basis_size
+    product_AtB(Phi_nb, Phi_Psi_nb, *N_BB[s]); // conj(basis)^T*ratio*basis : basis_size^2
+    if (energy_mat)
+    {
+      Vector_t& E = *E_N[s];
+      diag_product(E, Phi_nb, Phi_nb);           // diag(energies)*qmcplusplus::conj(basis)
+      product_AtB(Phi_nb, Phi_Psi_nb, *E_BB[s]); // (energies*conj(basis))^T*ratio*basis
+    }
+  }
+  timers[DM_matrix_products]->stop();
+  // accumulate data into collectables
+  timers[DM_accumulate]->start();
+  const int basis_size2 = basis_size * basis_size;
+  int ij                = nindex;
+  for (int s = 0; s < nspecies; ++s)
+  {
+    //int ij=nindex; // for testing
+    const Matrix_t& NDM = *N_BB[s];
+    for (int n = 0; n < basis_size2; ++n)
+    {
+      Value_t val = NDM(n);
+      collectables[ij] += real(val);
+      ij++;
+#if defined(QMC_COMPLEX)
+      collectables[ij] += imag(val);
+      ij++;
+#endif
+    }
+  }
+  if (energy_mat)
+  {
+    int ij = eindex;
+    for (int s = 0; s < nspecies; ++s)
+    {
+      //int ij=eindex; // for testing
+      const Matrix_t& EDM = *E_BB[s];
+      for (int n = 0; n < basis_size2; ++n)
+      {
+        Value_t val = EDM(n);
+        collectables[ij] += real(val);
+        ij++;
+#if defined(QMC_COMPLEX)
+        collectables[ij] += imag(val);
+        ij++;
+#endif
+      }
+    }
+  }
+  timers[DM_accumulate]->stop();
+}
+
+
 DensityMatrices1B::Return_t DensityMatrices1B::evaluate_check(ParticleSet& P)
 {
 #ifdef DMCHECK
@@ -1146,13 +1198,8 @@ void DensityMatrices1B::get_energies(std::vector<Vector_t*>& E_n)
 void DensityMatrices1B::generate_sample_basis(Matrix_t& Phi_mb)
 {
   ScopedTimer t(timers[DM_gen_sample_basis]);
-  int mb = 0;
-  for (int m = 0; m < samples; ++m)
-  {
-    update_basis(rsamples[m]);
-    for (int b = 0; b < basis_size; ++b, ++mb)
-      Phi_mb(mb) = basis_values[b];
-  }
+  std::copy(rsamples.begin(), rsamples.end(), samples_vp->R.begin());
+  update_basis(*samples_vp, Phi_mb);
 }
 
 
@@ -1182,17 +1229,14 @@ void DensityMatrices1B::generate_sample_ratios(std::vector<Matrix_t*> Psi_nm)
 void DensityMatrices1B::generate_particle_basis(ParticleSet& P, std::vector<Matrix_t*>& Phi_nb)
 {
   ScopedTimer t(timers[DM_gen_particle_basis]);
-  int p = 0;
+  particles_vp->R = P.R;
+  update_basis(*particles_vp, Phi_PB);
+  int pb = 0;
   for (int s = 0; s < nspecies; ++s)
   {
-    int nb         = 0;
     Matrix_t& P_nb = *Phi_nb[s];
-    for (int n = 0; n < species_size[s]; ++n, ++p)
-    {
-      update_basis(P.R[p]);
-      for (int b = 0; b < basis_size; ++b, ++nb)
-        P_nb(nb) = qmcplusplus::conj(basis_values[b]);
-    }
+    for (int nb = 0; nb < species_size[s] * basis_size; ++nb, ++pb)
+      P_nb(nb) = qmcplusplus::conj(Phi_PB(pb));
   }
 }
 
@@ -1223,6 +1267,20 @@ inline void DensityMatrices1B::update_basis(const PosType& r)
 }
 
 
+/** basis values at all the virtual particles in a single pass
+ * @param vp virtual particles, the positions are set in vp.R
+ * @param Phi_rb basis values : virtual particles x basis_size
+ */
+void DensityMatrices1B::update_basis(VirtualParticleSet& vp, Matrix_t& Phi_rb)
+{
+  vp.update();
+  basis_functions.evaluateValues(vp, Phi_rb);
+  for (int r = 0; r < Phi_rb.rows(); ++r)
+    for (int i = 0; i < basis_size; ++i)
+      Phi_rb(r, i) *= basis_norms[i];
+}
+
+
 inline void DensityMatrices1B::update_basis_d012(const PosType& r)
 {
   Pq.makeMove(0, r - Pq.R[0]);
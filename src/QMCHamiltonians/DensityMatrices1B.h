@@ -14,8 +14,10 @@
 #ifndef QMCPLUSPLUS_ONE_BODY_DENSITY_MATRICES_H
 #define QMCPLUSPLUS_ONE_BODY_DENSITY_MATRICES_H
 
+#include <memory>
 #include <QMCHamiltonians/OperatorBase.h>
 #include <QMCWaveFunctions/CompositeSPOSet.h>
+#include <Particle/VirtualParticleSet.h>
 #include <ParticleBase/RandomSeqGenerator.h>
 
 namespace qmcplusplus
@@ -117,6 +119,10 @@ public:
   std::vector<Vector_t*> E_N;
   std::vector<Matrix_t*> Phi_NB, Psi_NM, Phi_Psi_NB, N_BB, E_BB;
   Matrix_t Phi_MB;
+  ///basis values at all the particle positions : particles x basis_size
+  Matrix_t Phi_PB;
+  ///virtual particles at the integration samples and at the particle positions
+  std::unique_ptr<VirtualParticleSet> samples_vp, particles_vp;
   bool check_overlap;
   bool check_derivatives;
 
@@ -163,6 +169,10 @@ public:
   OperatorBase* makeClone(ParticleSet& P, TrialWaveFunction& psi);
   bool put(xmlNodePtr cur);
   Return_t evaluate(ParticleSet& P);
+  void mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                               const RefVector<ParticleSet>& P_list,
+                               const RefVector<Walker_t>& W_list,
+                               BufferType& collectables);
 
   //optional standard interface
   void get_required_traces(TraceManager& tm);
@@ -211,6 +221,7 @@ public:
   //  basis set updates
   void update_basis(const PosType& r);
   void update_basis_d012(const PosType& r);
+  void update_basis(VirtualParticleSet& vp, Matrix_t& Phi_rb);
   //  testing
   void test_overlap();
   void test_derivatives();
@@ -220,6 +231,7 @@ public:
   //  matrix implementation
   Return_t evaluate_check(ParticleSet& P);
   Return_t evaluate_matrix(ParticleSet& P);
+  void integrate_matrix(ParticleSet& P, const Matrix_t& Phi_mb, BufferType& collectables);
 
 
   bool match(Value_t e1, Value_t e2, RealType tol = 1e-12);
@@ -17,7 +17,9 @@
 #include "LongRange/LRCoulombSingleton.h"
 #include "Particle/DistanceTableData.h"
 #include "Particle/MCWalkerConfiguration.h"
+#include "Message/CommOperators.h"
 #include <Utilities/string_utils.h>
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -26,7 +28,15 @@
 namespace qmcplusplus
 {
 EnergyDensityEstimator::EnergyDensityEstimator(PSPool& PSP, const std::string& defaultKE)
-    : psetpool(PSP), w_trace(0), Td_trace(0), Vd_trace(0), Vs_trace(0), Pdynamic(0), Pstatic(0)
+    : psetpool(PSP),
+      w_trace(0),
+      Td_trace(0),
+      Vd_trace(0),
+      Vs_trace(0),
+      Pdynamic(0),
+      Pstatic(0),
+      sparse(false),
+      sparse_weight(0.0)
 {
   bool write = omp_get_thread_num() == 0;
   if (write)
@@ -42,7 +52,15 @@ EnergyDensityEstimator::EnergyDensityEstimator(PSPool& PSP, const std::string& d
 }
 
 
-EnergyDensityEstimator::~EnergyDensityEstimator() { delete_iter(spacegrids.begin(), spacegrids.end()); }
+EnergyDensityEstimator::~EnergyDensityEstimator()
+{
+  if (sparse_clones)
+  {
+#pragma omp critical(ede_sparse_clones)
+    sparse_clones->erase(std::find(sparse_clones->begin(), sparse_clones->end(), this));
+  }
+  delete_iter(spacegrids.begin(), spacegrids.end());
+}
 
 
 bool EnergyDensityEstimator::put(xmlNodePtr cur, ParticleSet& Pdyn)
@@ -60,11 +78,22 @@ bool EnergyDensityEstimator::put(xmlNodePtr cur)
   //initialize simple xml attributes
   myName = "EnergyDensity";
   std::string dyn, stat = "";
+  std::string sparse_grids = "no";
   OhmmsAttributeSet attrib;
   attrib.add(myName, "name");
   attrib.add(dyn, "dynamic");
   attrib.add(stat, "static");
+  attrib.add(sparse_grids, "sparse");
   attrib.put(cur);
+  sparse = sparse_grids == "yes";
+  if (sparse)
+  {
+    //clones join the estimator they are made from
+    if (!sparse_clones)
+      sparse_clones = std::make_shared<std::vector<EnergyDensityEstimator*>>();
+#pragma omp critical(ede_sparse_clones)
+    sparse_clones->push_back(this);
+  }
   //collect particle sets
   if (!Pdynamic)
     Pdynamic = get_particleset(dyn);
@@ -297,13 +326,19 @@ EnergyDensityEstimator::Return_t EnergyDensityEstimator::evaluate(ParticleSet& P
       }
     }
     //Accumulate energy density in spacegrids
-    const DistanceTableData& dtab(P.getDistTable(dtable_index));
+    //there is no table without static particles
+    const DistanceTableData* dtab = dtable_index < 0 ? nullptr : &P.getDistTable(dtable_index);
     fill(particles_outside.begin(), particles_outside.end(), true);
     for (int i = 0; i < spacegrids.size(); i++)
     {
       SpaceGrid& sg = *spacegrids[i];
-      sg.evaluate(R, EDValues, P.Collectables, particles_outside, dtab);
+      if (sparse)
+        sg.evaluate(R, EDValues, sparse_values, particles_outside, dtab);
+      else
+        sg.evaluate(R, EDValues, P.Collectables, particles_outside, dtab);
     }
+    if (sparse)
+      sparse_weight += w;
     //Accumulate energy density of particles outside any spacegrid
     int bi, v;
     const int bimax = outside_buffer_offset + (int)nEDValues;
@@ -413,9 +448,13 @@ void EnergyDensityEstimator::addObservables(PropertySetType& plist, BufferType&
   std::vector<RealType> tmp(nvalues);
   collectables.add(tmp.begin(), tmp.end());
   //allocate space for spacegrids
+  int sparse_size = 0;
   for (int i = 0; i < spacegrids.size(); i++)
   {
-    spacegrids[i]->allocate_buffer_space(collectables);
+    if (sparse)
+      sparse_size += spacegrids[i]->reserve_buffer_space(sparse_size);
+    else
+      spacegrids[i]->allocate_buffer_space(collectables);
   }
 }
 
@@ -438,13 +477,101 @@ void EnergyDensityEstimator::registerCollectables(std::vector<observable_helper*
   oh->set_dimensions(ng, outside_buffer_offset);
   oh->open(g);
   h5desc.push_back(oh);
+  sparse_h5.clear();
   for (int i = 0; i < spacegrids.size(); i++)
   {
     SpaceGrid& sg = *spacegrids[i];
-    sg.registerCollectables(h5desc, g, i);
+    oh            = sg.registerCollectables(h5desc, g, i, !sparse);
+    if (sparse)
+      sparse_h5.push_back(oh);
   }
 }
 
+
+void EnergyDensityEstimator::collectBlock(Communicate* comm, bool write)
+{
+  if (!sparse)
+    return;
+  //merge the clones into this estimator
+  SpaceGrid::SparseBufferType& merged = sparse_values;
+  for (EnergyDensityEstimator* ed : *sparse_clones)
+  {
+    if (ed == this)
+      continue;
+    for (auto it = ed->sparse_values.begin(); it != ed->sparse_values.end(); ++it)
+      merged[it->first] += it->second;
+    sparse_weight += ed->sparse_weight;
+    ed->startBlock();
+  }
+  if (comm->size() > 1)
+  {
+    //gather the coordinate lists on the master
+    std::vector<int> index;
+    std::vector<double> values;
+    pack_sparse(merged, sparse_weight, index, values);
+    std::vector<int> counts(comm->size()), displ(comm->size() + 1, 0);
+    std::vector<int> nlocal(1, index.size());
+    comm->gather(nlocal, counts, 0);
+    for (int i = 0; i < counts.size(); ++i)
+      displ[i + 1] = displ[i] + counts[i];
+    //the receive buffers are only used on the master
+    std::vector<int> all_index(comm->rank() == 0 ? displ.back() : 1);
+    std::vector<double> all_values(all_index.size());
+    comm->gatherv(index, all_index, counts, displ, 0);
+    comm->gatherv(values, all_values, counts, displ, 0);
+    merged.clear();
+    sparse_weight = 0.0;
+    if (comm->rank() == 0)
+      sparse_weight = unpack_sparse(all_index, all_values, merged);
+  }
+  //values are averaged over the total walker weight of the block
+  if (write)
+  {
+    FullPrecRealType norm = sparse_weight > 0.0 ? 1.0 / sparse_weight : 0.0;
+    for (int i = 0; i < spacegrids.size(); i++)
+      spacegrids[i]->write_sparse(sparse_h5[i], merged, norm);
+  }
+  startBlock();
+}
+
+
+void EnergyDensityEstimator::startBlock()
+{
+  sparse_values.clear();
+  sparse_weight = 0.0;
+}
+
+
+void EnergyDensityEstimator::pack_sparse(const SpaceGrid::SparseBufferType& buf,
+                                         FullPrecRealType weight,
+                                         std::vector<int>& index,
+                                         std::vector<double>& values)
+{
+  index.reserve(index.size() + buf.size() + 1);
+  values.reserve(values.size() + buf.size() + 1);
+  index.push_back(-1);
+  values.push_back(weight);
+  for (auto it = buf.begin(); it != buf.end(); ++it)
+  {
+    index.push_back(it->first);
+    values.push_back(it->second);
+  }
+}
+
+
+EnergyDensityEstimator::FullPrecRealType EnergyDensityEstimator::unpack_sparse(const std::vector<int>& index,
+                                                                               const std::vector<double>& values,
+                                                                               SpaceGrid::SparseBufferType& buf)
+{
+  FullPrecRealType weight = 0.0;
+  for (int i = 0; i < index.size(); ++i)
+    if (index[i] < 0)
+      weight += values[i];
+    else
+      buf[index[i]] += values[i];
+  return weight;
+}
+
 void EnergyDensityEstimator::setObservables(PropertySetType& plist)
 {
   //remains empty
@@ -468,6 +595,7 @@ OperatorBase* EnergyDensityEstimator::makeClone(ParticleSet& qp, TrialWaveFuncti
   if (write)
     app_log() << "EnergyDensityEstimator::makeClone" << std::endl;
   EnergyDensityEstimator* edclone = new EnergyDensityEstimator(psetpool, defKE);
+  edclone->sparse_clones          = sparse_clones;
   edclone->put(input_xml, qp);
   //int thread = omp_get_thread_num();
   //app_log()<<thread<<"make edclone"<< std::endl;
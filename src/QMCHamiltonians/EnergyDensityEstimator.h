@@ -18,6 +18,7 @@
 #include <QMCHamiltonians/ReferencePoints.h>
 #include <QMCHamiltonians/SpaceGrid.h>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace qmcplusplus
@@ -42,6 +43,27 @@ public:
   bool put(xmlNodePtr cur, ParticleSet& P);
   bool get(std::ostream& os) const;
   OperatorBase* makeClone(ParticleSet& qp, TrialWaveFunction& psi);
+  /** merge the sparse spacegrids of all the clones and ranks and write the nonzero domains
+   *
+   * Does nothing unless the spacegrids are sparse.
+   */
+  void collectBlock(Communicate* comm, bool write);
+  ///discard the sparse values accumulated by this estimator, e.g. during warmup
+  void startBlock();
+  /** append a sparse buffer and its walker weight to a coordinate list
+   *
+   * The weight has the index -1, so that the lists of several ranks can be concatenated.
+   */
+  static void pack_sparse(const SpaceGrid::SparseBufferType& buf,
+                          FullPrecRealType weight,
+                          std::vector<int>& index,
+                          std::vector<double>& values);
+  /** accumulate a coordinate list of pack_sparse into buf
+   * @return sum of the walker weights in the list
+   */
+  static FullPrecRealType unpack_sparse(const std::vector<int>& index,
+                                        const std::vector<double>& values,
+                                        SpaceGrid::SparseBufferType& buf);
 
   void write_description(std::ostream& os);
 
@@ -77,6 +99,16 @@ private:
   //spacegrids are used to find which cell domain
   //  contains the Energy information of particles
   std::vector<SpaceGrid*> spacegrids;
+  //with sparse="yes" the spacegrids are accumulated in a sparse buffer
+  //  instead of the collectables and only their nonzero domains are written
+  bool sparse;
+  SpaceGrid::SparseBufferType sparse_values;
+  //sum of the walker weights accumulated in sparse_values
+  FullPrecRealType sparse_weight;
+  //the estimator and all its clones, shared among them
+  std::shared_ptr<std::vector<EnergyDensityEstimator*>> sparse_clones;
+  //h5 groups of the spacegrids, set by registerCollectables
+  mutable std::vector<observable_helper*> sparse_h5;
   //particle positions
   ParticlePos_t R;
   //number of samples accumulated
@@ -35,6 +35,13 @@ MomentumEstimator::MomentumEstimator(ParticleSet& elns, TrialWaveFunction& psi)
 
 void MomentumEstimator::resetTargetParticleSet(ParticleSet& P) {}
 
+/** evaluate n(k) for M random displacements
+ *
+ * The ratios of all the samples are collected first. The phases of all the
+ * samples and of all the particles are then evaluated by one sincos call each,
+ * and the sum over the particles is a gemm of the ratios with the phases of
+ * the particles, leaving a sum over the samples of nk long rows.
+ */
 MomentumEstimator::Return_t MomentumEstimator::evaluate(ParticleSet& P)
 {
   const int np = P.getTotalNum();
@@ -49,34 +56,43 @@ MomentumEstimator::Return_t MomentumEstimator::evaluate(ParticleSet& P)
     P.makeVirtualMoves(vPos[s]);
     refPsi.evaluateRatiosAlltoOne(P, psi_ratios);
     for (int i = 0; i < np; ++i)
-      psi_ratios_all[s][i] = psi_ratios[i];
-
-    for (int ik = 0; ik < nk; ++ik)
-      kdotp[ik] = -dot(kPoints[ik], vPos[s]);
-    eval_e2iphi(nk, kdotp.data(), phases_vPos[s].data(0), phases_vPos[s].data(1));
+      psi_ratios_c(s, i) = std::real(psi_ratios[i]);
+#if defined(QMC_COMPLEX)
+    for (int i = 0; i < np; ++i)
+      psi_ratios_s(s, i) = std::imag(psi_ratios[i]);
+#endif
   }
+  evaluate_phases(vPos.data(), M, -1, phases_vPos_c, phases_vPos_s);
+  evaluate_phases(P.R.data(), np, 1, phases_c, phases_s);
+
+  // sum over the particles of ratio*exp(ik.r) : M x nk
+  const char transa = 'N';
+  const char transb = 'N';
+  const RealType one(1);
+  const RealType zero(0);
+  BLAS::gemm(transa, transb, nk, M, np, one, phases_c.data(), nk, psi_ratios_c.data(), np, zero,
+             ratio_phases_c.data(), nk);
+  BLAS::gemm(transa, transb, nk, M, np, one, phases_s.data(), nk, psi_ratios_c.data(), np, zero,
+             ratio_phases_s.data(), nk);
+#if defined(QMC_COMPLEX)
+  BLAS::gemm(transa, transb, nk, M, np, -one, phases_s.data(), nk, psi_ratios_s.data(), np, one,
+             ratio_phases_c.data(), nk);
+  BLAS::gemm(transa, transb, nk, M, np, one, phases_c.data(), nk, psi_ratios_s.data(), np, one,
+             ratio_phases_s.data(), nk);
+#endif
 
+  // real part of the sum over the samples of exp(-ik.v)*ratio*exp(ik.r)
   std::fill_n(nofK.begin(), nk, RealType(0));
-  for (int i = 0; i < np; ++i)
+  RealType* restrict nofK_here = nofK.data();
+  for (int s = 0; s < M; ++s)
   {
+    const RealType* restrict phases_vPos_c_s  = phases_vPos_c[s];
+    const RealType* restrict phases_vPos_s_s  = phases_vPos_s[s];
+    const RealType* restrict ratio_phases_c_s = ratio_phases_c[s];
+    const RealType* restrict ratio_phases_s_s = ratio_phases_s[s];
+#pragma omp simd
     for (int ik = 0; ik < nk; ++ik)
-      kdotp[ik] = dot(kPoints[ik], P.R[i]);
-    eval_e2iphi(nk, kdotp.data(), phases.data(0), phases.data(1));
-    for (int s = 0; s < M; ++s)
-    {
-      const ComplexType one_ratio(psi_ratios_all[s][i]);
-      const RealType ratio_c                 = one_ratio.real();
-      const RealType ratio_s                 = one_ratio.imag();
-      const RealType* restrict phases_c      = phases.data(0);
-      const RealType* restrict phases_s      = phases.data(1);
-      const RealType* restrict phases_vPos_c = phases_vPos[s].data(0);
-      const RealType* restrict phases_vPos_s = phases_vPos[s].data(1);
-      RealType* restrict nofK_here           = nofK.data();
-#pragma omp simd aligned(nofK_here, phases_c, phases_s, phases_vPos_c, phases_vPos_s)
-      for (int ik = 0; ik < nk; ++ik)
-        nofK_here[ik] += (phases_c[ik] * phases_vPos_c[ik] - phases_s[ik] * phases_vPos_s[ik]) * ratio_c -
-            (phases_s[ik] * phases_vPos_c[ik] + phases_c[ik] * phases_vPos_s[ik]) * ratio_s;
-    }
+      nofK_here[ik] += phases_vPos_c_s[ik] * ratio_phases_c_s[ik] - phases_vPos_s_s[ik] * ratio_phases_s_s[ik];
   }
   if (hdf5_out)
   {
@@ -407,14 +423,7 @@ bool MomentumEstimator::putSpecial(xmlNodePtr cur, ParticleSet& elns, bool rootN
     }
     fout.close();
   }
-  nofK.resize(kPoints.size());
-  kdotp.resize(kPoints.size());
-  vPos.resize(M);
-  phases.resize(kPoints.size());
-  phases_vPos.resize(M);
-  for (int im = 0; im < M; im++)
-    phases_vPos[im].resize(kPoints.size());
-  psi_ratios_all.resize(M, psi_ratios.size());
+  resize_work();
   norm_nofK = 1.0 / RealType(M);
   return true;
 }
@@ -435,16 +444,41 @@ void MomentumEstimator::resize(const std::vector<PosType>& kin, const int Min)
 {
   //copy kpoints
   kPoints = kin;
-  nofK.resize(kin.size());
-  kdotp.resize(kPoints.size());
-  phases.resize(kPoints.size());
   //M
   M = Min;
+  resize_work();
+}
+
+void MomentumEstimator::resize_work()
+{
+  const int np = psi_ratios.size();
+  const int nk = kPoints.size();
+  nofK.resize(nk);
   vPos.resize(M);
-  psi_ratios_all.resize(M, psi_ratios.size());
-  phases_vPos.resize(M);
-  for (int im = 0; im < M; im++)
-    phases_vPos[im].resize(kPoints.size());
+  psi_ratios_c.resize(M, np);
+#if defined(QMC_COMPLEX)
+  psi_ratios_s.resize(M, np);
+#endif
+  kdotp.resize(std::max(M, np), nk);
+  phases_c.resize(np, nk);
+  phases_s.resize(np, nk);
+  phases_vPos_c.resize(M, nk);
+  phases_vPos_s.resize(M, nk);
+  ratio_phases_c.resize(M, nk);
+  ratio_phases_s.resize(M, nk);
+}
+
+void MomentumEstimator::evaluate_phases(const PosType* r,
+                                        int n,
+                                        RealType sign,
+                                        Matrix<RealType>& phase_c,
+                                        Matrix<RealType>& phase_s)
+{
+  const int nk = kPoints.size();
+  for (int i = 0; i < n; ++i)
+    for (int ik = 0; ik < nk; ++ik)
+      kdotp(i, ik) = sign * dot(kPoints[ik], r[i]);
+  eval_e2iphi(n * nk, kdotp.data(), phase_c.data(), phase_s.data());
 }
 
 void MomentumEstimator::setRandomGenerator(RandomGenerator_t* rng)
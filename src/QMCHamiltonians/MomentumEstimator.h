@@ -51,14 +51,16 @@ public:
   std::vector<PosType> vPos;
   ///wavefunction ratios
   std::vector<ValueType> psi_ratios;
-  ///wavefunction ratios all samples
-  Matrix<ValueType> psi_ratios_all;
-  ///nofK internal
-  Vector<RealType> kdotp;
-  ///phases
-  VectorSoaContainer<RealType, 2> phases;
-  ///phases of vPos
-  std::vector<VectorSoaContainer<RealType, 2>> phases_vPos;
+  ///real and imaginary parts of the wavefunction ratios of all samples : M x particles
+  Matrix<RealType> psi_ratios_c, psi_ratios_s;
+  ///k.r of the samples or of the particles : max(M, particles) x k-points
+  Matrix<RealType> kdotp;
+  ///phases exp(ik.r) of the particles : particles x k-points
+  Matrix<RealType> phases_c, phases_s;
+  ///phases exp(-ik.v) of the samples : M x k-points
+  Matrix<RealType> phases_vPos_c, phases_vPos_s;
+  ///phases of the particles contracted with the ratios : M x k-points
+  Matrix<RealType> ratio_phases_c, ratio_phases_s;
   ///list of k-points in Cartesian Coordinates
   std::vector<PosType> kPoints;
   ///weight of k-points (make use of symmetry)
@@ -68,6 +70,12 @@ public:
   /// print to hdf5 or scalar.dat
   bool hdf5_out;
   PosType twist;
+
+private:
+  ///allocate the work space for M samples and the k-points
+  void resize_work();
+  ///phases exp(i sign k.r) of n positions, one row per position
+  void evaluate_phases(const PosType* r, int n, RealType sign, Matrix<RealType>& phase_c, Matrix<RealType>& phase_s);
 };
 
 } // namespace qmcplusplus
@@ -19,8 +19,72 @@
 
 namespace qmcplusplus
 {
+/** Legendre sums \f$S_j=\sum_{l=0}^{l_{max}} w_l P_l(z_j)\f$ of all the knots
+ * @tparam LMAX compile-time lmax, -1 for the runtime lmax
+ * @tparam NKNOT compile-time number of knots, 0 for the runtime nknot
+ *
+ * The product of the Legendre matrix \f$P_l(z_j)\f$ and w is computed one l at a time,
+ * the recursion generates \f$P_{l+1}\f$ of all the knots from \f$P_l\f$ and \f$P_{l-1}\f$ in pc and pm.
+ */
+template<typename T, int LMAX, int NKNOT>
+void legendreSums(int nknot,
+                  int lmax,
+                  const T* restrict z,
+                  const T* restrict w,
+                  T* restrict lsum,
+                  T* restrict pm,
+                  T* restrict pc)
+{
+  const int nk = (NKNOT > 0) ? NKNOT : nknot;
+  const int lm = (LMAX >= 0) ? LMAX : lmax;
+  const T w0   = w[0];
+  for (int j = 0; j < nk; j++)
+    lsum[j] = w0;
+  if (lm == 0)
+    return;
+  const T w1 = w[1];
+  for (int j = 0; j < nk; j++)
+  {
+    pm[j] = T(1);
+    pc[j] = z[j];
+    lsum[j] += w1 * z[j];
+  }
+  for (int l = 1; l < lm; l++)
+  {
+    const T a  = static_cast<T>(2 * l + 1) / static_cast<T>(l + 1);
+    const T b  = static_cast<T>(l) / static_cast<T>(l + 1);
+    const T wl = w[l + 1];
+    for (int j = 0; j < nk; j++)
+    {
+      const T pn = a * z[j] * pc[j] - b * pm[j];
+      pm[j]      = pc[j];
+      pc[j]      = pn;
+      lsum[j] += wl * pn;
+    }
+  }
+}
+
+/// select legendreSums specialized for the common lmax and quadrature rules
+template<typename T, int LMAX>
+auto selectLegendreSums(int nknot) -> void (*)(int, int, const T*, const T*, T*, T*, T*)
+{
+  switch (nknot)
+  {
+  case 6:
+    return legendreSums<T, LMAX, 6>;
+  case 12:
+    return legendreSums<T, LMAX, 12>;
+  case 18:
+    return legendreSums<T, LMAX, 18>;
+  case 26:
+    return legendreSums<T, LMAX, 26>;
+  default:
+    return legendreSums<T, LMAX, 0>;
+  }
+}
+
 NonLocalECPComponent::NonLocalECPComponent()
-    : lmax(0), nchannel(0), nknot(0), Rmax(-1), VP(nullptr), use_DLA(false)
+    : lmax(0), nchannel(0), nknot(0), Rmax(-1), legendre_sums(nullptr), VP(nullptr), use_DLA(false)
 {
 #if !defined(REMOVE_TRACEMANAGER)
   streaming_particles = false;
@@ -94,6 +158,41 @@ void NonLocalECPComponent::resize_warrays(int n, int m, int l)
       Lfactor2[nl] = 1.0e0 / static_cast<RealType>(nl + 1);
     }
   }
+
+  vrad_l.resize(lmax + 1);
+  knot_cos.resize(nknot);
+  knot_lsum.resize(nknot);
+  knot_pm.resize(nknot);
+  knot_pc.resize(nknot);
+  switch (lmax)
+  {
+  case 0:
+    legendre_sums = selectLegendreSums<RealType, 0>(nknot);
+    break;
+  case 1:
+    legendre_sums = selectLegendreSums<RealType, 1>(nknot);
+    break;
+  case 2:
+    legendre_sums = selectLegendreSums<RealType, 2>(nknot);
+    break;
+  case 3:
+    legendre_sums = selectLegendreSums<RealType, 3>(nknot);
+    break;
+  default:
+    legendre_sums = legendreSums<RealType, -1, 0>;
+  }
+
+  // interleave the channels when they share a linear grid, otherwise evaluate nlpp_m one by one
+  vrad_table.reset();
+  if (nchannel)
+  {
+    auto table = std::make_shared<MultiChannelCubicSpline<RealType>>();
+    bool okay  = table->resize(lmax + 1, nlpp_m[0]->grid());
+    for (int ip = 0; okay && ip < nchannel; ip++)
+      okay = angpp_m[ip] <= lmax && table->add(angpp_m[ip], *nlpp_m[ip], wgt_angpp_m[ip]);
+    if (okay)
+      vrad_table = table;
+  }
 }
 
 void NonLocalECPComponent::print(std::ostream& os)
@@ -150,33 +249,26 @@ NonLocalECPComponent::RealType NonLocalECPComponent::evaluateOne(ParticleSet& W,
     }
   }
 
-  // Compute radial potential, multiplied by (2l+1) factor.
-  for (int ip = 0; ip < nchannel; ip++)
-    vrad[ip] = nlpp_m[ip]->splint(r) * wgt_angpp_m[ip];
+  // Compute radial potential of all the angular momenta, multiplied by (2l+1) factor.
+  if (vrad_table)
+    vrad_table->evaluate(r, vrad_l.data());
+  else
+  {
+    std::fill(vrad_l.begin(), vrad_l.end(), czero);
+    for (int ip = 0; ip < nchannel; ip++)
+      vrad_l[angpp_m[ip]] += nlpp_m[ip]->splint(r) * wgt_angpp_m[ip];
+  }
 
   const RealType rinv = cone / r;
-  RealType pairpot    = 0;
-  // Compute spherical harmonics on grid
   for (int j = 0; j < nknot; j++)
-  {
-    RealType zz = dot(dr, rrotsgrid_m[j]) * rinv;
-    // Forming the Legendre polynomials
-    lpol[0]           = cone;
-    RealType lpolprev = czero;
-    for (int l = 0; l < lmax; l++)
-    {
-      //Not a big difference
-      //lpol[l+1]=(2*l+1)*zz*lpol[l]-l*lpolprev;
-      //lpol[l+1]/=(l+1);
-      lpol[l + 1] = Lfactor1[l] * zz * lpol[l] - l * lpolprev;
-      lpol[l + 1] *= Lfactor2[l];
-      lpolprev = lpol[l];
-    }
+    knot_cos[j] = dot(dr, rrotsgrid_m[j]) * rinv;
+  // Legendre polynomials of all the knots contracted with the radial potentials
+  legendre_sums(nknot, lmax, knot_cos.data(), vrad_l.data(), knot_lsum.data(), knot_pm.data(), knot_pc.data());
 
-    ValueType lsum = 0.0;
-    for (int l = 0; l < nchannel; l++)
-      lsum += vrad[l] * lpol[angpp_m[l]];
-    lsum *= psiratio[j];
+  RealType pairpot = 0;
+  for (int j = 0; j < nknot; j++)
+  {
+    ValueType lsum = knot_lsum[j] * psiratio[j];
     if (Tmove)
       Txy.push_back(NonLocalData(iel, std::real(lsum), deltaV[j]));
     pairpot += std::real(lsum);
@@ -16,12 +16,14 @@
 
 #ifndef QMCPLUSPLUS_NONLOCAL_ECPOTENTIAL_COMPONENT_H
 #define QMCPLUSPLUS_NONLOCAL_ECPOTENTIAL_COMPONENT_H
+#include <memory>
 #include "QMCHamiltonians/OperatorBase.h"
 #include "QMCWaveFunctions/TrialWaveFunction.h"
 #include "Numerics/OneDimGridBase.h"
 #include "Numerics/OneDimGridFunctor.h"
 #include "Numerics/OneDimLinearSpline.h"
 #include "Numerics/OneDimCubicSpline.h"
+#include "Numerics/MultiChannelCubicSpline.h"
 #include "Numerics/OhmmsBlas.h"
 
 namespace qmcplusplus
@@ -34,6 +36,11 @@ private:
   typedef std::vector<PosType> SpherGridType;
   typedef OneDimGridBase<RealType> GridType;
   typedef OneDimCubicSpline<RealType> RadialPotentialType;
+  /** Legendre sums of all the knots
+   *
+   * (nknot, lmax, cos(theta), (2l+1)v_l, sums, work, work)
+   */
+  typedef void (*LegendreSumsType)(int, int, const RealType*, const RealType*, RealType*, RealType*, RealType*);
 
   ///Non Local part: angular momentum, potential and grid
   int lmax;
@@ -53,6 +60,10 @@ private:
   RealType Lfactor2[8];
   ///Non-Local part of the pseudo-potential
   std::vector<RadialPotentialType*> nlpp_m;
+  ///(2l+1)v_l(r) of all the channels interleaved and indexed by l, shared by the clones
+  std::shared_ptr<const MultiChannelCubicSpline<RealType>> vrad_table;
+  ///Legendre sums specialized for lmax and nknot
+  LegendreSumsType legendre_sums;
   ///fixed Spherical Grid for species
   SpherGridType sgridxyz_m;
   ///randomized spherical grid
@@ -72,6 +83,10 @@ private:
   std::vector<ValueType> vrad;
   //Array for (2l+1)*v'_l(r)/r.
   std::vector<RealType> dvrad;
+  //Array for (2l+1)*v_l(r) indexed by l.
+  aligned_vector<RealType> vrad_l;
+  //Arrays for cos(theta), the Legendre sums and the recursion over the knots.
+  aligned_vector<RealType> knot_cos, knot_lsum, knot_pm, knot_pc;
   //$\Psi(...q...)/\Psi(...r...)$ for all quadrature points q.
   std::vector<ValueType> psiratio;
   //$\nabla \Psi(...q...)/\Psi(...r...)$ for all quadrature points q.
@@ -222,7 +237,7 @@ public:
 
   void initVirtualParticle(const ParticleSet& qp);
 
-  inline void setRmax(int rmax) { Rmax = rmax; }
+  inline void setRmax(RealType rmax) { Rmax = rmax; }
   inline RealType getRmax() const { return Rmax; }
   inline int getNknot() const { return nknot; }
   inline void setLmax(int Lmax) { lmax = Lmax; }
@@ -418,6 +418,123 @@ int NonLocalECPotential::makeNonLocalMovesPbyP(ParticleSet& P)
   return NonLocalMoveAccepted;
 }
 
+std::vector<int> NonLocalECPotential::mw_makeNonLocalMovesPbyP(const RefVector<NonLocalECPotential>& nlpp_list,
+                                                              const RefVector<ParticleSet>& p_list)
+{
+  const int nw = nlpp_list.size();
+  std::vector<int> num_accepts(nw, 0);
+  const int tmove = nlpp_list[0].get().UseTMove;
+  if (tmove == TMOVE_OFF)
+    return num_accepts;
+
+  // walkers moving the same electron
+  std::vector<int> moving_iw;
+  RefVector<ParticleSet> moving_p_list;
+  RefVector<TrialWaveFunction> moving_wf_list;
+  std::vector<PosType> displs;
+  std::vector<TrialWaveFunction::PsiValueType> ratios;
+  std::vector<TrialWaveFunction::GradType> grads;
+  moving_iw.reserve(nw);
+  moving_p_list.reserve(nw);
+  moving_wf_list.reserve(nw);
+  displs.reserve(nw);
+
+  auto addMove = [&](int iw, int iat, const NonLocalData* oneTMove) {
+    if (!oneTMove)
+      return;
+    ParticleSet& P = p_list[iw];
+    // same check as ParticleSet::makeMoveAndCheck
+    if (P.Lattice.explicitly_defined &&
+        (P.Lattice.outOfBound(P.Lattice.toUnit(oneTMove->Delta)) ||
+         !P.Lattice.isValid(P.Lattice.toUnit(P.R[iat] + oneTMove->Delta))))
+      return;
+    moving_iw.push_back(iw);
+    moving_p_list.push_back(P);
+    moving_wf_list.push_back(nlpp_list[iw].get().Psi);
+    displs.push_back(oneTMove->Delta);
+  };
+
+  auto moveTogether = [&](int iat) {
+    if (moving_iw.empty())
+      return;
+    const int nmove = moving_iw.size();
+    ratios.resize(nmove);
+    grads.resize(nmove);
+    ParticleSet::flex_setActive(moving_p_list, iat);
+    ParticleSet::flex_makeMove(moving_p_list, iat, displs);
+    TrialWaveFunction::flex_ratioGrad(moving_wf_list, moving_p_list, iat, ratios, grads);
+    TrialWaveFunction::flex_acceptMove(moving_wf_list, moving_p_list, iat);
+    if (tmove == TMOVE_V3)
+      for (int iw : moving_iw)
+      {
+        NonLocalECPotential& nlpp = nlpp_list[iw];
+        nlpp.markAffectedElecs(p_list[iw].get().getDistTable(nlpp.myTableIndex), iat);
+      }
+    ParticleSet::flex_acceptMove(moving_p_list, iat);
+    for (int iw : moving_iw)
+      num_accepts[iw]++;
+    moving_iw.clear();
+    moving_p_list.clear();
+    moving_wf_list.clear();
+    displs.clear();
+  };
+
+  const ParticleSet& P0 = p_list[0];
+  if (tmove == TMOVE_V0)
+  {
+    // one move per walker, the Txy are those of evaluateWithToperator
+    std::vector<const NonLocalData*> selected(nw);
+    for (int iw = 0; iw < nw; ++iw)
+    {
+      NonLocalECPotential& nlpp = nlpp_list[iw];
+      selected[iw]              = nlpp.nonLocalOps.selectMove((*nlpp.myRNG)());
+    }
+    for (int iat = 0; iat < P0.getTotalNum(); ++iat)
+    {
+      for (int iw = 0; iw < nw; ++iw)
+        if (selected[iw] && selected[iw]->PID == iat)
+          addMove(iw, iat, selected[iw]);
+      moveTogether(iat);
+    }
+  }
+  else
+  {
+    if (tmove == TMOVE_V3)
+      for (int iw = 0; iw < nw; ++iw)
+      {
+        NonLocalECPotential& nlpp = nlpp_list[iw];
+        nlpp.elecTMAffected.assign(P0.getTotalNum(), false);
+        nlpp.nonLocalOps.group_by_elec();
+      }
+    for (int ig = 0; ig < P0.groups(); ++ig)
+      for (int iat = P0.first(ig); iat < P0.last(ig); ++iat)
+      {
+        for (int iw = 0; iw < nw; ++iw)
+        {
+          NonLocalECPotential& nlpp = nlpp_list[iw];
+          RandomGenerator_t& RandomGen(*nlpp.myRNG);
+          const NonLocalData* oneTMove;
+          if (tmove == TMOVE_V1 || nlpp.elecTMAffected[iat])
+          {
+            // Txy of the electron changed by the previous moves
+            nlpp.computeOneElectronTxy(p_list[iw], iat);
+            oneTMove = nlpp.nonLocalOps.selectMove(RandomGen());
+          }
+          else
+            oneTMove = nlpp.nonLocalOps.selectMove(RandomGen(), iat);
+          addMove(iw, iat, oneTMove);
+        }
+        moveTogether(iat);
+      }
+  }
+
+  for (int iw = 0; iw < nw; ++iw)
+    if (num_accepts[iw] > 0)
+      nlpp_list[iw].get().Psi.completeUpdates();
+
+  return num_accepts;
+}
+
 void NonLocalECPotential::markAffectedElecs(const DistanceTableData& myTable, int iel)
 {
   std::vector<int>& NeighborIons = ElecNeighborIons.getNeighborList(iel);
@@ -494,6 +611,9 @@ OperatorBase* NonLocalECPotential::makeClone(ParticleSet& qp, TrialWaveFunction&
       myclone->addComponent(ig, ppot);
     }
   }
+  // the batched drivers clone the walker Hamiltonians after the T-moves options are set
+  myclone->UseTMove    = UseTMove;
+  myclone->nonLocalOps = nonLocalOps;
   return myclone;
 }
 
@@ -20,6 +20,7 @@
 #include "QMCHamiltonians/NonLocalECPComponent.h"
 #include "QMCHamiltonians/ForceBase.h"
 #include "Particle/NeighborLists.h"
+#include "type_traits/template_types.hpp"
 
 namespace qmcplusplus
 {
@@ -66,6 +67,21 @@ public:
    */
   int makeNonLocalMovesPbyP(ParticleSet& P);
 
+  /** batched version of makeNonLocalMovesPbyP
+   * @param nlpp_list the potentials of the walkers
+   * @param p_list particle sets of the walkers
+   * @return the number of accepted moves of each walker
+   *
+   * Each walker draws from the generator of its NonLocalECPotential in the same order as makeNonLocalMovesPbyP.
+   * The moves match the serial ones only when the walkers have distinct generators or there is a single walker;
+   * walkers sharing the generator of a crowd interleave their draws electron by electron.
+   * The walkers moving the same electron propose and accept the move together.
+   * The Txy of v1 and v3 are still computed walker by walker by computeOneElectronTxy,
+   * there is no batched evaluateRatios over the VirtualParticleSets of the walkers.
+   */
+  static std::vector<int> mw_makeNonLocalMovesPbyP(const RefVector<NonLocalECPotential>& nlpp_list,
+                                                   const RefVector<ParticleSet>& p_list);
+
   Return_t evaluateValueAndDerivatives(ParticleSet& P,
                                        const opt_variables_type& optvars,
                                        const std::vector<ValueType>& dlogpsi,
@@ -47,6 +47,21 @@ void OperatorBase::mw_evaluate(const RefVector<OperatorBase>& O_list, const RefV
     O_list[iw].get().evaluate(P_list[iw]);
 }
 
+void OperatorBase::mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                                           const RefVector<ParticleSet>& P_list,
+                                           const RefVector<Walker_t>& W_list,
+                                           BufferType& collectables)
+{
+  for (int iw = 0; iw < O_list.size(); iw++)
+  {
+    OperatorBase& O = O_list[iw];
+    ParticleSet& P  = P_list[iw];
+    O.setHistories(W_list[iw]);
+    P.Collectables.swap(collectables);
+    O.evaluate(P);
+    P.Collectables.swap(collectables);
+  }
+}
 
 void OperatorBase::set_energy_domain(energy_domains edomain)
 {
@@ -32,6 +32,8 @@
 #include <QMCWaveFunctions/OrbitalSetTraits.h>
 #include <bitset>
 
+class Communicate;
+
 namespace qmcplusplus
 {
 class MCWalkerConfiguration;
@@ -222,6 +224,23 @@ struct OperatorBase : public QMCTraits
    */
   virtual void registerCollectables(std::vector<observable_helper*>& h5desc, hid_t gid) const {}
 
+  /** collect the data accumulated outside of the collectables at the end of a block
+   * @param comm communicator of the ranks sharing the estimators
+   * @param write true on the rank writing to the h5 groups of registerCollectables
+   *
+   * Called on every rank by the object which registered the collectables.
+   * The default implementation does nothing.
+   */
+  virtual void collectBlock(Communicate* comm, bool write) {}
+
+  /** discard the data accumulated outside of the collectables before a block
+   *
+   * Called by the drivers on the Hamiltonian of every thread or walker at the start of a block,
+   * so that the evaluations of the warmup steps are not collected.
+   * The default implementation does nothing.
+   */
+  virtual void startBlock() {}
+
   /** set the values evaluated by this object to plist
    * @param plist RecordNameProperty
    *
@@ -248,6 +267,20 @@ struct OperatorBase : public QMCTraits
   /** Evaluate the contribution of this component of multiple walkers */
   virtual void mw_evaluate(const RefVector<OperatorBase>& O_list, const RefVector<ParticleSet>& P_list);
 
+  /** Evaluate the collectables of multiple walkers
+   * @param O_list the components of the walkers
+   * @param P_list the particle sets of the walkers
+   * @param W_list the walkers, the samples are weighted as in evaluate
+   * @param collectables buffer the samples of all the walkers are added to
+   *
+   * The buffer is private to the caller, e.g. a crowd, so the walkers do not bin into their own buffers.
+   * The default evaluates one walker at a time, lending the buffer to its particle set.
+   */
+  virtual void mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                                       const RefVector<ParticleSet>& P_list,
+                                       const RefVector<Walker_t>& W_list,
+                                       BufferType& collectables);
+
   virtual Return_t rejectedMove(ParticleSet& P) { return 0; }
   /** Evaluate the local energy contribution of this component with Toperators updated if requested
    *@param P input configuration containing N particles
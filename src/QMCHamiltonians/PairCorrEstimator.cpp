@@ -114,7 +114,25 @@ void PairCorrEstimator::resetTargetParticleSet(ParticleSet& P) {}
 
 PairCorrEstimator::Return_t PairCorrEstimator::evaluate(ParticleSet& P)
 {
-  BufferType& collectables(P.Collectables);
+  binPairs(P, P.Collectables);
+  return 0.0;
+}
+
+/** bin the pairs of all the walkers
+ *
+ * The histograms are not weighted by the walker weights, the same as evaluate.
+ */
+void PairCorrEstimator::mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                                                const RefVector<ParticleSet>& P_list,
+                                                const RefVector<Walker_t>& W_list,
+                                                BufferType& collectables)
+{
+  for (int iw = 0; iw < P_list.size(); iw++)
+    binPairs(P_list[iw], collectables);
+}
+
+void PairCorrEstimator::binPairs(ParticleSet& P, BufferType& collectables)
+{
   const DistanceTableData& dii(P.getDistTable(d_aa_ID_));
   if (dii.DTType == DT_SOA)
   {
@@ -189,7 +207,6 @@ PairCorrEstimator::Return_t PairCorrEstimator::evaluate(ParticleSet& P)
     }
 #endif
   }
-  return 0.0;
 }
 
 void PairCorrEstimator::registerCollectables(std::vector<observable_helper*>& h5list, hid_t gid) const
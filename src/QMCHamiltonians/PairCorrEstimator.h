@@ -39,6 +39,10 @@ public:
 
   /* evaluate the pair correlation functions */
   Return_t evaluate(ParticleSet& P);
+  void mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                               const RefVector<ParticleSet>& P_list,
+                               const RefVector<Walker_t>& W_list,
+                               BufferType& collectables);
 
   void addObservables(PropertySetType& plist) {}
   void addObservables(PropertySetType& plist, BufferType& collectables);
@@ -84,6 +88,8 @@ private:
    * @param nbins number of bins for the historgram
    */
   void resize(int nbins);
+  ///add the pairs of P to the histograms in collectables
+  void binPairs(ParticleSet& P, BufferType& collectables);
 };
 
 } // namespace qmcplusplus
@@ -234,6 +234,18 @@ void QMCHamiltonian::registerCollectables(std::vector<observable_helper*>& h5des
     auxH[i]->registerCollectables(h5desc, gid);
 }
 
+void QMCHamiltonian::collectBlock(Communicate* comm, bool write)
+{
+  for (int i = 0; i < auxH.size(); ++i)
+    auxH[i]->collectBlock(comm, write);
+}
+
+void QMCHamiltonian::startBlock()
+{
+  for (int i = 0; i < auxH.size(); ++i)
+    auxH[i]->startBlock();
+}
+
 
 #if !defined(REMOVE_TRACEMANAGER)
 void QMCHamiltonian::initialize_traces(TraceManager& tm, ParticleSet& P)
@@ -642,6 +654,22 @@ void QMCHamiltonian::auxHevaluate(ParticleSet& P, Walker_t& ThisWalker, bool do_
   }
 }
 
+void QMCHamiltonian::mw_auxHevaluateCollectables(const RefVector<QMCHamiltonian>& H_list,
+                                                 const RefVector<ParticleSet>& P_list,
+                                                 const RefVector<Walker_t>& W_list,
+                                                 BufferType& collectables)
+{
+  if (H_list.size() == 0 || collectables.size() == 0)
+    return;
+  QMCHamiltonian& leader = H_list[0];
+  for (int i = 0; i < leader.auxH.size(); ++i)
+    if (leader.auxH[i]->getMode(OperatorBase::COLLECTABLE))
+    {
+      const auto O_list(extract_auxH_list(H_list, i));
+      O_list[0].get().mw_evaluateCollectables(O_list, P_list, W_list, collectables);
+    }
+}
+
 /** Looks like a hack see DMCBatched.cpp and DMC.cpp weight is used like temporary flag
  *  from DMC.
  */
@@ -783,14 +811,17 @@ std::vector<int> QMCHamiltonian::flex_makeNonLocalMoves(RefVector<QMCHamiltonian
                                                         RefVector<ParticleSet>& p_list)
 {
   std::vector<int> num_accepts(h_list.size(), 0);
-  if(!(h_list[0].get().nlpp_ptr))
+  if (h_list.size() > 0 && h_list[0].get().nlpp_ptr)
   {
-    if(h_list.size() > 1)
+    if (h_list.size() > 1)
     {
-      for( int iw = 0; iw < h_list.size(); ++iw)
-        num_accepts[iw] = h_list[iw].get().nlpp_ptr->makeNonLocalMovesPbyP(p_list[iw]);
+      RefVector<NonLocalECPotential> nlpp_list;
+      nlpp_list.reserve(h_list.size());
+      for (int iw = 0; iw < h_list.size(); ++iw)
+        nlpp_list.push_back(*h_list[iw].get().nlpp_ptr);
+      num_accepts = NonLocalECPotential::mw_makeNonLocalMovesPbyP(nlpp_list, p_list);
     }
-    else if(h_list.size() == 1)
+    else
       num_accepts[0] = h_list[0].get().nlpp_ptr->makeNonLocalMovesPbyP(p_list[0]);
   }
   return num_accepts;
@@ -907,4 +938,13 @@ RefVector<OperatorBase> QMCHamiltonian::extract_HC_list(const RefVector<QMCHamil
   return HC_list;
 }
 
+RefVector<OperatorBase> QMCHamiltonian::extract_auxH_list(const RefVector<QMCHamiltonian>& H_list, int id)
+{
+  RefVector<OperatorBase> auxH_list;
+  auxH_list.reserve(H_list.size());
+  for (QMCHamiltonian& H : H_list)
+    auxH_list.push_back(*(H.auxH[id]));
+  return auxH_list;
+}
+
 } // namespace qmcplusplus
@@ -128,6 +128,13 @@ public:
    * Add observable_helper information for the data stored in ParticleSet::mcObservables.
    */
   void registerCollectables(std::vector<observable_helper*>& h5desc, hid_t gid) const;
+  /** collect the data of the auxiliary operators accumulated outside of the collectables
+   * @param comm communicator of the ranks
+   * @param write true on the rank writing the collectables
+   */
+  void collectBlock(Communicate* comm, bool write);
+  ///discard the data of the auxiliary operators accumulated outside of the collectables
+  void startBlock();
   ///retrun the starting index
   inline int startIndex() const { return myIndex; }
   ///return the size of observables
@@ -176,6 +183,16 @@ public:
   void auxHevaluate(ParticleSet& P, Walker_t& ThisWalker);
   void auxHevaluate(ParticleSet& P, Walker_t& ThisWalker, bool do_properties, bool do_collectables);
   void rejectedMove(ParticleSet& P, Walker_t& ThisWalker);
+
+  /** batched evaluation of the collectables of auxH
+   * @param collectables buffer private to the caller the samples of all the walkers are added to
+   *
+   * Use with auxHevaluate(P, ThisWalker, true, false) for the properties.
+   */
+  static void mw_auxHevaluateCollectables(const RefVector<QMCHamiltonian>& H_list,
+                                          const RefVector<ParticleSet>& P_list,
+                                          const RefVector<Walker_t>& W_list,
+                                          BufferType& collectables);
   ///** set Tau for each Hamiltonian
   // */
   //inline void setTau(RealType tau)
@@ -375,6 +392,8 @@ private:
 
   // helper function for extracting a list of Hamiltonian components from a list of QMCHamiltonian::H.
   static RefVector<OperatorBase> extract_HC_list(const RefVector<QMCHamiltonian>& H_list, int id);
+  // helper function for extracting a list of Hamiltonian components from a list of QMCHamiltonian::auxH.
+  static RefVector<OperatorBase> extract_auxH_list(const RefVector<QMCHamiltonian>& H_list, int id);
 
 #if !defined(REMOVE_TRACEMANAGER)
   ///traces variables
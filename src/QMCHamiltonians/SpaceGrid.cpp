@@ -16,6 +16,8 @@
 #include <Utilities/string_utils.h>
 #include <cmath>
 #include <OhmmsPETE/OhmmsArray.h>
+#include <io/hdf_datatype.h>
+#include <set>
 
 #include <Message/OpenMP.h>
 
@@ -680,26 +682,28 @@ void SpaceGrid::write_description(std::ostream& os, std::string& indent)
 
 int SpaceGrid::allocate_buffer_space(BufferType& buf)
 {
-  buffer_offset = buf.size();
-  if (!chempot)
-  {
-    std::vector<RealType> tmp(nvalues_per_domain * ndomains);
-    buf.add(tmp.begin(), tmp.end());
-    buffer_start = buffer_offset;
-    buffer_end   = buffer_start + nvalues_per_domain * ndomains - 1;
-  }
-  else
-  {
-    std::vector<RealType> tmp(nvalues_per_domain * npvalues * ndomains);
-    buf.add(tmp.begin(), tmp.end());
-    buffer_start = buffer_offset;
-    buffer_end   = buffer_start + nvalues_per_domain * npvalues * ndomains - 1;
-  }
+  std::vector<RealType> tmp(reserve_buffer_space(buf.size()));
+  buf.add(tmp.begin(), tmp.end());
   return buffer_offset;
 }
 
 
-void SpaceGrid::registerCollectables(std::vector<observable_helper*>& h5desc, hid_t gid, int grid_index) const
+int SpaceGrid::reserve_buffer_space(int offset)
+{
+  int nvalues = nvalues_per_domain * ndomains;
+  if (chempot)
+    nvalues *= npvalues;
+  buffer_offset = offset;
+  buffer_start  = buffer_offset;
+  buffer_end    = buffer_start + nvalues - 1;
+  return nvalues;
+}
+
+
+observable_helper* SpaceGrid::registerCollectables(std::vector<observable_helper*>& h5desc,
+                                                   hid_t gid,
+                                                   int grid_index,
+                                                   bool dense) const
 {
   typedef Matrix<int> iMatrix;
   iMatrix imat;
@@ -713,7 +717,8 @@ void SpaceGrid::registerCollectables(std::vector<observable_helper*>& h5desc, hi
     ng[0] = nvalues_per_domain * ndomains;
   else
     ng[0] = nvalues_per_domain * npvalues * ndomains;
-  oh->set_dimensions(ng, buffer_offset);
+  if (dense)
+    oh->set_dimensions(ng, buffer_offset);
   oh->open(gid);
   int coord = (int)coordinate;
   oh->addProperty(const_cast<int&>(coord), "coordinate");
@@ -809,18 +814,19 @@ void SpaceGrid::registerCollectables(std::vector<observable_helper*>& h5desc, hi
     }
   }
   h5desc.push_back(oh);
-  return;
+  return oh;
 }
 
 
 #define SPACEGRID_CHECK
 
 
+template<typename BT>
 void SpaceGrid::evaluate(const ParticlePos_t& R,
                          const Matrix<RealType>& values,
-                         BufferType& buf,
+                         BT& buf,
                          std::vector<bool>& particles_outside,
-                         const DistanceTableData& dtab)
+                         const DistanceTableData* dtab)
 {
   int p, v;
   int nparticles = values.size1();
@@ -892,9 +898,9 @@ void SpaceGrid::evaluate(const ParticlePos_t& R,
       RealType dist;
       for (nd = 0; nd < ndomains; nd++)
 #ifndef ENABLE_SOA
-        for (nn = dtab.M[nd], p = 0; nn < dtab.M[nd + 1]; ++nn, ++p)
+        for (nn = dtab->M[nd], p = 0; nn < dtab->M[nd + 1]; ++nn, ++p)
         {
-          dist = dtab.r(nn);
+          dist = dtab->r(nn);
           if (dist < nearcell[p].r)
           {
             nearcell[p].r = dist;
@@ -997,9 +1003,9 @@ void SpaceGrid::evaluate(const ParticlePos_t& R,
       RealType dist;
       for (nd = 0; nd < ndomains; nd++)
 #ifndef ENABLE_SOA
-        for (nn = dtab.M[nd], p = 0; nn < dtab.M[nd + 1]; ++nn, ++p)
+        for (nn = dtab->M[nd], p = 0; nn < dtab->M[nd + 1]; ++nn, ++p)
         {
-          dist = dtab.r(nn);
+          dist = dtab->r(nn);
           if (dist < nearcell[p].r)
           {
             nearcell[p].r = dist;
@@ -1051,6 +1057,92 @@ void SpaceGrid::evaluate(const ParticlePos_t& R,
 }
 
 
+template void SpaceGrid::evaluate(const ParticlePos_t& R,
+                                  const Matrix<RealType>& values,
+                                  BufferType& buf,
+                                  std::vector<bool>& particles_outside,
+                                  const DistanceTableData* dtab);
+template void SpaceGrid::evaluate(const ParticlePos_t& R,
+                                  const Matrix<RealType>& values,
+                                  SparseBufferType& buf,
+                                  std::vector<bool>& particles_outside,
+                                  const DistanceTableData* dtab);
+
+
+/** append an array to an extendible 1D dataset of a group, the dataset is created on the first call
+ *
+ * The chunks of the dataset are compressed by deflate if the HDF5 library provides it.
+ */
+template<typename T>
+static void append_to_dataset(hid_t gid, const char* name, const std::vector<T>& data)
+{
+  const hid_t type_id = get_h5_datatype(T());
+  hsize_t count       = data.size();
+  hsize_t cur         = 0;
+  hid_t dset;
+  if (H5Lexists(gid, name, H5P_DEFAULT) > 0)
+  {
+    dset         = H5Dopen(gid, name);
+    hid_t fspace = H5Dget_space(dset);
+    H5Sget_simple_extent_dims(fspace, &cur, NULL);
+    H5Sclose(fspace);
+  }
+  else
+  {
+    hsize_t maxdims = H5S_UNLIMITED;
+    hsize_t chunk   = 1024;
+    hid_t fspace    = H5Screate_simple(1, &cur, &maxdims);
+    hid_t p         = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(p, 1, &chunk);
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+      H5Pset_deflate(p, 6);
+    dset = H5Dcreate(gid, name, type_id, fspace, p);
+    H5Pclose(p);
+    H5Sclose(fspace);
+  }
+  if (count)
+  {
+    hsize_t newdims = cur + count;
+    H5Dextend(dset, &newdims);
+    hid_t fspace = H5Dget_space(dset);
+    H5Sselect_hyperslab(fspace, H5S_SELECT_SET, &cur, NULL, &count, NULL);
+    hid_t memspace = H5Screate_simple(1, &count, NULL);
+    H5Dwrite(dset, type_id, memspace, fspace, H5P_DEFAULT, data.data());
+    H5Sclose(memspace);
+    H5Sclose(fspace);
+  }
+  H5Dclose(dset);
+}
+
+
+void SpaceGrid::write_sparse(observable_helper* oh, const SparseBufferType& buf, FullPrecRealType norm) const
+{
+  //values of a domain (of a particle count with chempot) are contiguous in the buffer
+  std::set<int> records;
+  for (auto it = buf.begin(); it != buf.end(); ++it)
+    if (it->first >= buffer_start && it->first <= buffer_end)
+      records.insert((it->first - buffer_offset) / nvalues_per_domain);
+  std::vector<int> index;
+  std::vector<FullPrecRealType> values;
+  index.reserve(records.size());
+  values.reserve(records.size() * nvalues_per_domain);
+  for (auto it = records.begin(); it != records.end(); ++it)
+  {
+    index.push_back(*it);
+    int buf_index = buffer_offset + *it * nvalues_per_domain;
+    for (int v = 0; v < nvalues_per_domain; v++, buf_index++)
+    {
+      auto value = buf.find(buf_index);
+      values.push_back(value == buf.end() ? 0.0 : norm * value->second);
+    }
+  }
+  std::vector<int> nnz(1, index.size());
+  append_to_dataset(oh->data_id, "sparse_index", index);
+  append_to_dataset(oh->data_id, "sparse_value", values);
+  append_to_dataset(oh->data_id, "sparse_count", nnz);
+}
+
+
 void SpaceGrid::sum(const BufferType& buf, RealType* vals)
 {
   for (int v = 0; v < nvalues_per_domain; v++)
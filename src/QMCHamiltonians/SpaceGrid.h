@@ -20,6 +20,7 @@
 #include <Utilities/PooledData.h>
 #include <QMCHamiltonians/observable_helper.h>
 #include "Particle/DistanceTableData.h"
+#include <unordered_map>
 
 namespace qmcplusplus
 {
@@ -28,6 +29,8 @@ class SpaceGrid : public QMCTraits, public PtclOnLatticeTraits
 public:
   typedef TinyVector<RealType, DIM> Point;
   typedef PooledData<RealType> BufferType;
+  ///sparse buffer of the nonzero values, keyed by the index of the value in a dense buffer
+  typedef std::unordered_map<int, RealType> SparseBufferType;
   typedef Matrix<RealType> Matrix_t;
 
   SpaceGrid(int& nvalues);
@@ -48,12 +51,33 @@ public:
   bool initialize_voronoi(std::map<std::string, Point>& points);
   void write_description(std::ostream& os, std::string& indent);
   int allocate_buffer_space(BufferType& buf);
-  void registerCollectables(std::vector<observable_helper*>& h5desc, hid_t gid, int grid_index) const;
+  /** assign the range of the values of the grid starting at offset without allocating them
+   * @return number of values of the grid
+   */
+  int reserve_buffer_space(int offset);
+  /** register the h5 group of the grid
+   * @param dense if false, the values are not written as a dense "value" dataset of the group
+   */
+  observable_helper* registerCollectables(std::vector<observable_helper*>& h5desc,
+                                          hid_t gid,
+                                          int grid_index,
+                                          bool dense = true) const;
+  /** accumulate the values of the particles inside the grid
+   * @param buf BufferType or SparseBufferType
+   * @param dtab table to the static particles, only used by voronoi grids
+   */
+  template<typename BT>
   void evaluate(const ParticlePos_t& R,
                 const Matrix<RealType>& values,
-                BufferType& buf,
+                BT& buf,
                 std::vector<bool>& particles_outside,
-                const DistanceTableData& dtab);
+                const DistanceTableData* dtab);
+  /** append the nonzero domains of the grid in buf scaled by norm to the group of oh
+   *
+   * Every call adds a block of sparse_count domains with indices sparse_index
+   * and nvalues_per_domain values per domain in sparse_value.
+   */
+  void write_sparse(observable_helper* oh, const SparseBufferType& buf, FullPrecRealType norm) const;
 
   bool check_grid(void);
   inline int nDomains(void) { return ndomains; }
@@ -215,23 +215,44 @@ SpinDensity::Return_t SpinDensity::evaluate(ParticleSet& P)
   int offset = myIndex;
   for (int s = 0; s < nspecies; ++s, offset += npoints)
     for (int ps = 0; ps < species_size[s]; ++ps, ++p)
-    {
-      PosType u = cell.toUnit(P.R[p] - corner);
-      //bool inside = true;
-      //for(int d=0;d<DIM;++d)
-      //  inside &= u[d]>0.0 && u[d]<1.0;
-      //if(inside)
-      //{
-      int point = offset;
-      for (int d = 0; d < DIM; ++d)
-        point += gdims[d] * ((int)(grid[d] * (u[d] - std::floor(u[d])))); //periodic only
-      P.Collectables[point] += w;
-      //}
-    }
+      P.Collectables[getGridPoint(P.R[p], offset)] += w;
   return 0.0;
 }
 
 
+/** bin the particles of all the walkers
+ *
+ * The grid points of all the particles are found in a single pass before any
+ * bin is touched, the binning is then a plain weighted scatter into the buffer.
+ */
+void SpinDensity::mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                                          const RefVector<ParticleSet>& P_list,
+                                          const RefVector<Walker_t>& W_list,
+                                          BufferType& collectables)
+{
+  const int nw = P_list.size();
+  const int N  = P_list[0].get().getTotalNum();
+  grid_points.resize(nw * N);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    const ParticleSet& P = P_list[iw];
+    int* restrict points = grid_points.data() + iw * N;
+    int p                = 0;
+    int offset           = myIndex;
+    for (int s = 0; s < nspecies; ++s, offset += npoints)
+      for (int ps = 0; ps < species_size[s]; ++ps, ++p)
+        points[p] = getGridPoint(P.R[p], offset);
+  }
+  for (int iw = 0; iw < nw; iw++)
+  {
+    const RealType w           = W_list[iw].get().Weight;
+    const int* restrict points = grid_points.data() + iw * N;
+    for (int p = 0; p < N; ++p)
+      collectables[points[p]] += w;
+  }
+}
+
+
 void SpinDensity::test(int moves, ParticleSet& P)
 {
   app_log() << "  SpinDensity test" << std::endl;
@@ -291,19 +312,7 @@ void SpinDensity::addEnergy(MCWalkerConfiguration& W, std::vector<RealType>& Loc
     int offset      = myIndex;
     for (int s = 0; s < nspecies; ++s, offset += npoints)
       for (int ps = 0; ps < species_size[s]; ++ps, ++p)
-      {
-        PosType u = cell.toUnit(w.R[p] - corner);
-        //bool inside = true;
-        //for(int d=0;d<DIM;++d)
-        //  inside &= u[d]>0.0 && u[d]<1.0;
-        //if(inside)
-        //{
-        int point = offset;
-        for (int d = 0; d < DIM; ++d)
-          point += gdims[d] * ((int)(grid[d] * (u[d] - std::floor(u[d])))); //periodic only
-        W.Collectables[point] += weight;
-        //}
-      }
+        W.Collectables[getGridPoint(w.R[p], offset)] += weight;
   }
 }
 } // namespace qmcplusplus
@@ -46,6 +46,10 @@ public:
   OperatorBase* makeClone(ParticleSet& P, TrialWaveFunction& psi);
   bool put(xmlNodePtr cur);
   Return_t evaluate(ParticleSet& P);
+  void mw_evaluateCollectables(const RefVector<OperatorBase>& O_list,
+                               const RefVector<ParticleSet>& P_list,
+                               const RefVector<Walker_t>& W_list,
+                               BufferType& collectables);
 
   //required for Collectables interface
   void addObservables(PropertySetType& plist, BufferType& olist);
@@ -70,6 +74,19 @@ public:
   void test(int moves, ParticleSet& P);
   Return_t test_evaluate(ParticleSet& P, int& pmin, int& pmax);
   void addEnergy(MCWalkerConfiguration& W, std::vector<RealType>& LocalEnergy);
+
+private:
+  ///grid points of the particles of a crowd of walkers
+  std::vector<int> grid_points;
+  ///return the grid point of r relative to offset, periodic only
+  inline int getGridPoint(const PosType& r, int offset) const
+  {
+    PosType u = cell.toUnit(r - corner);
+    int point = offset;
+    for (int d = 0; d < DIM; ++d)
+      point += gdims[d] * ((int)(grid[d] * (u[d] - std::floor(u[d]))));
+    return point;
+  }
 };
 
 } // namespace qmcplusplus
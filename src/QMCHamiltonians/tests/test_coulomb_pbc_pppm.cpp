@@ -0,0 +1,329 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "OhmmsData/Libxml2Doc.h"
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "Lattice/ParticleBConds.h"
+#include "Particle/ParticleSet.h"
+#include "Particle/DistanceTableData.h"
+#include "QMCHamiltonians/CoulombPBCAA.h"
+#include "QMCHamiltonians/CoulombPBCAB.h"
+#include "LongRange/PPPMHandler.h"
+
+#include <stdio.h>
+#include <string>
+
+using std::string;
+
+namespace qmcplusplus
+{
+TEST_CASE("Coulomb PBC A-A BCC H PPPM", "[hamiltonian]")
+{
+  Communicate* c;
+  OHMMS::Controller->initialize(0, NULL);
+  c = OHMMS::Controller;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds = true; // periodic
+  Lattice.R.diagonal(3.77945227);
+  Lattice.reset();
+
+  ParticleSet ions;
+
+  ions.setName("ion");
+  ions.create(2);
+  ions.R[0][0] = 0.0;
+  ions.R[0][1] = 0.0;
+  ions.R[0][2] = 0.0;
+  ions.R[1][0] = 1.88972614;
+  ions.R[1][1] = 1.88972614;
+  ions.R[1][2] = 1.88972614;
+  ions.Lattice = Lattice;
+
+  SpeciesSet& ion_species           = ions.getSpeciesSet();
+  int pIdx                          = ion_species.addSpecies("H");
+  int pChargeIdx                    = ion_species.addAttribute("charge");
+  int pMembersizeIdx                = ion_species.addAttribute("membersize");
+  ion_species(pChargeIdx, pIdx)     = 1;
+  ion_species(pMembersizeIdx, pIdx) = 2;
+  ions.Lattice = Lattice;
+  ions.createSK();
+
+  LRCoulombSingleton::CoulombHandler = new PPPMHandler(ions);
+  LRCoulombSingleton::CoulombHandler->initBreakup(ions);
+
+  CoulombPBCAA caa(ions, false);
+  REQUIRE(caa.meshAA != nullptr);
+
+  // same as the Ewald3D breakup
+  double consts = caa.evalConsts();
+  REQUIRE(consts == Approx(-1.690675));
+
+  double val = caa.evaluate(ions);
+  REQUIRE(val == Approx(-0.963074).epsilon(1e-4));
+
+  delete LRCoulombSingleton::CoulombHandler;
+  LRCoulombSingleton::CoulombHandler = 0;
+}
+
+TEST_CASE("Coulomb PBC A-B PPPM", "[hamiltonian]")
+{
+  Communicate* c;
+  OHMMS::Controller->initialize(0, NULL);
+  c = OHMMS::Controller;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds = true; // periodic
+  Lattice.R.diagonal(1.0);
+  Lattice.reset();
+
+  ParticleSet ions;
+  ParticleSet elec;
+
+  ions.setName("ion");
+  ions.create(1);
+  ions.R[0][0] = 0.0;
+  ions.R[0][1] = 0.0;
+  ions.R[0][2] = 0.0;
+
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("H");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, pIdx) = 1;
+  ions.Lattice = Lattice;
+  ions.createSK();
+
+  elec.Lattice = Lattice;
+  elec.setName("elec");
+  elec.create(1);
+  elec.R[0][0] = 0.5;
+  elec.R[0][1] = 0.0;
+  elec.R[0][2] = 0.0;
+
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  int massIdx                  = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  tspecies(massIdx, upIdx)     = 1.0;
+  tspecies(massIdx, downIdx)   = 1.0;
+
+  elec.createSK();
+
+#ifdef ENABLE_SOA
+  elec.addTable(ions, DT_SOA);
+#else
+  elec.addTable(ions, DT_AOS);
+#endif
+  elec.update();
+
+  LRCoulombSingleton::CoulombHandler = new PPPMHandler(ions);
+  LRCoulombSingleton::CoulombHandler->initBreakup(ions);
+
+  CoulombPBCAB cab(ions, elec);
+  REQUIRE(cab.meshAB != nullptr);
+
+  double consts = cab.evalConsts();
+  REQUIRE(consts == Approx(0.0));
+
+  // same as the Ewald3D breakup
+  double val_ei = cab.evaluate(elec);
+  REQUIRE(val_ei == Approx(-0.008302).epsilon(1e-3));
+
+  CoulombPBCAA caa_elec(elec, false);
+  CoulombPBCAA caa_ion(ions, false);
+  double val_ee         = caa_elec.evaluate(elec);
+  double val_ii         = caa_ion.evaluate(ions);
+  double sum            = val_ee + val_ii + val_ei;
+
+  REQUIRE(val_ee == Approx(-1.366567).epsilon(1e-4));
+  REQUIRE(val_ii == Approx(-1.366567).epsilon(1e-4));
+  REQUIRE(sum == Approx(-2.741436).epsilon(1e-4));
+
+  delete LRCoulombSingleton::CoulombHandler;
+  LRCoulombSingleton::CoulombHandler = 0;
+}
+
+TEST_CASE("PPPM single particle moves", "[hamiltonian]")
+{
+  Communicate* c;
+  OHMMS::Controller->initialize(0, NULL);
+  c = OHMMS::Controller;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds = true; // periodic
+  Lattice.R       = 0.0;
+  Lattice.R(0, 0) = 4.0;
+  Lattice.R(1, 0) = 1.0;
+  Lattice.R(1, 1) = 3.5;
+  Lattice.R(2, 2) = 5.0;
+  Lattice.reset();
+
+  ParticleSet elec;
+  elec.Lattice = Lattice;
+  elec.setName("elec");
+  elec.create(4);
+  elec.R[0] = ParticleSet::SingleParticlePos_t(0.1, 0.2, 0.3);
+  elec.R[1] = ParticleSet::SingleParticlePos_t(2.1, 1.7, 0.9);
+  elec.R[2] = ParticleSet::SingleParticlePos_t(3.3, 0.4, 4.1);
+  elec.R[3] = ParticleSet::SingleParticlePos_t(1.2, 2.9, 2.6);
+
+  SpeciesSet& tspecies       = elec.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int chargeIdx              = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx) = -1;
+  elec.createSK();
+  elec.update();
+
+  PPPMHandler pppm(elec, 6);
+  pppm.initBreakup(elec);
+  // the mesh resolves twice the k-space cutoff, sextic B-splines for the skewed cell
+  for (int d = 0; d < OHMMS_DIM; d++)
+    REQUIRE(pppm.MeshDims[d] >= 2 * pppm.Order);
+
+  std::vector<OHMMS_PRECISION> Z(elec.getTotalNum(), -1.0);
+  PPPMHandler::mRealType e_old = pppm.evaluateMesh(elec, Z);
+
+  // the same energy by the k-space sum of the Ewald3D breakup
+  const StructFact& rhok(*elec.SK);
+  LRHandlerBase& ewald(pppm);
+#if defined(USE_REAL_STRUCT_FACTOR)
+  double e_k = 0.5 * ewald.evaluate(rhok.KLists.kshell, rhok.rhok_r[0], rhok.rhok_i[0], rhok.rhok_r[0], rhok.rhok_i[0]);
+#else
+  double e_k = 0.5 * ewald.evaluate(rhok.KLists.kshell, rhok.rhok[0], rhok.rhok[0]);
+#endif
+  REQUIRE(e_old == Approx(e_k).epsilon(1e-4));
+
+  // moves across the boundary and by a few mesh spacings
+  std::vector<ParticleSet::SingleParticlePos_t> moves = {ParticleSet::SingleParticlePos_t(-0.3, 0.15, 0.05),
+                                                         ParticleSet::SingleParticlePos_t(0.7, -0.4, 1.2),
+                                                         ParticleSet::SingleParticlePos_t(0.01, 0.02, -0.03)};
+  PPPMHandler fresh(pppm, elec);
+  for (int iat = 0; iat < moves.size(); iat++)
+  {
+    ParticleSet::SingleParticlePos_t rold = elec.R[iat];
+    ParticleSet::SingleParticlePos_t rnew = rold + moves[iat];
+    double de                             = pppm.evaluateMove(Z[iat], rold, rnew);
+    pppm.acceptMove(Z[iat], rold, rnew);
+    elec.R[iat]                  = rnew;
+    PPPMHandler::mRealType e_new = fresh.evaluateMesh(elec, Z);
+    REQUIRE(de == Approx(e_new - e_old));
+    e_old = e_new;
+    // the mesh potential solved from the charges updated by acceptMove is the one solved from scratch
+    REQUIRE(pppm.evaluatePotential(Z[0], elec.R[0]) == Approx(fresh.evaluatePotential(Z[0], elec.R[0])));
+    REQUIRE(pppm.evaluatePotential(Z[iat], rnew) == Approx(fresh.evaluatePotential(Z[iat], rnew)));
+  }
+}
+
+TEST_CASE("PPPM handler per operator", "[hamiltonian]")
+{
+  Communicate* c;
+  OHMMS::Controller->initialize(0, NULL);
+  c = OHMMS::Controller;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds = true; // periodic
+  Lattice.R       = 0.0;
+  Lattice.R(0, 0) = 4.0;
+  Lattice.R(1, 0) = 1.0;
+  Lattice.R(1, 1) = 3.5;
+  Lattice.R(2, 2) = 5.0;
+  Lattice.reset();
+
+  ParticleSet ions;
+  ions.setName("ion");
+  ions.create(2);
+  ions.R[0] = ParticleSet::SingleParticlePos_t(0.0, 0.0, 0.0);
+  ions.R[1] = ParticleSet::SingleParticlePos_t(2.5, 1.75, 2.5);
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("He");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, pIdx) = 2;
+  ions.Lattice                  = Lattice;
+  ions.createSK();
+
+  ParticleSet elec;
+  elec.Lattice = Lattice;
+  elec.setName("elec");
+  elec.create(4);
+  elec.R[0] = ParticleSet::SingleParticlePos_t(0.1, 0.2, 0.3);
+  elec.R[1] = ParticleSet::SingleParticlePos_t(2.1, 1.7, 0.9);
+  elec.R[2] = ParticleSet::SingleParticlePos_t(3.3, 0.4, 4.1);
+  elec.R[3] = ParticleSet::SingleParticlePos_t(1.2, 2.9, 2.6);
+  SpeciesSet& tspecies       = elec.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int chargeIdx              = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx) = -1;
+  elec.createSK();
+
+  ParticleSet elec2(elec);
+  elec2.R[0] = ParticleSet::SingleParticlePos_t(3.6, 0.5, 1.1);
+  elec2.R[1] = ParticleSet::SingleParticlePos_t(0.4, 3.2, 4.4);
+
+#ifdef ENABLE_SOA
+  elec.addTable(ions, DT_SOA);
+  elec2.addTable(ions, DT_SOA);
+#else
+  elec.addTable(ions, DT_AOS);
+  elec2.addTable(ions, DT_AOS);
+#endif
+
+  LRCoulombSingleton::CoulombHandler = new PPPMHandler(ions);
+  LRCoulombSingleton::CoulombHandler->initBreakup(ions);
+
+  CoulombPBCAA caa(elec, true);
+  CoulombPBCAA caa2(elec2, true);
+  CoulombPBCAB cab(ions, elec);
+  elec.update();
+  elec2.update();
+
+  // every operator evaluates on its own mesh, the singleton is only read
+  REQUIRE(caa.meshAA != nullptr);
+  REQUIRE(caa.meshAA != LRCoulombSingleton::CoulombHandler);
+  REQUIRE(caa.meshAA != caa2.meshAA);
+  REQUIRE(caa.meshAA != cab.meshAB);
+
+  // AA and AB back to back do not disturb the mesh potential of each other
+  std::vector<OHMMS_PRECISION> Z(elec.getTotalNum(), -1.0);
+  PPPMHandler fresh(*caa.meshAA, elec);
+  fresh.evaluateMesh(elec, Z);
+  double v_ee = caa.evaluate(elec);
+  double v_ei = cab.evaluate(elec);
+  REQUIRE(caa.meshAA->evaluatePotential(Z[0], elec.R[0]) == Approx(fresh.evaluatePotential(Z[0], elec.R[0])));
+  REQUIRE(caa.evaluate(elec) == Approx(v_ee));
+  REQUIRE(cab.evaluate(elec) == Approx(v_ei));
+
+  // two operators on two particle sets evaluated concurrently
+  const double v_ee2 = caa2.evaluate(elec2);
+  REQUIRE(v_ee2 != Approx(v_ee));
+  std::vector<CoulombPBCAA*> ops  = {&caa, &caa2};
+  std::vector<ParticleSet*> psets = {&elec, &elec2};
+  std::vector<double> ref         = {v_ee, v_ee2};
+  const int nsteps                = 16;
+  std::vector<int> nfail(ops.size(), 0);
+#pragma omp parallel for
+  for (int iw = 0; iw < ops.size(); iw++)
+    for (int step = 0; step < nsteps; step++)
+      if (ops[iw]->evaluate(*psets[iw]) != Approx(ref[iw]))
+        nfail[iw]++;
+  REQUIRE(nfail[0] == 0);
+  REQUIRE(nfail[1] == 0);
+
+  delete LRCoulombSingleton::CoulombHandler;
+  LRCoulombSingleton::CoulombHandler = 0;
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,145 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "QMCHamiltonians/DensityMatrices1B.h"
+#include "QMCWaveFunctions/SPOSetBuilderFactory.h"
+#include "QMCApp/tests/MinimalParticlePool.h"
+#include "QMCApp/tests/MinimalWaveFunctionPool.h"
+#include "Utilities/RandomGenerator.h"
+
+namespace qmcplusplus
+{
+static const char* dm1b_xml = "<estimator type=\"dm1b\" name=\"DensityMatrices\"> \
+  <parameter name=\"basis\"> updet downdet </parameter> \
+  <parameter name=\"evaluator\"> matrix </parameter> \
+  <parameter name=\"integrator\"> uniform_grid </parameter> \
+  <parameter name=\"points\"> 4 </parameter> \
+</estimator>";
+
+TEST_CASE("DensityMatrices1B batched basis and crowd evaluation", "[hamiltonian]")
+{
+  using RealType = QMCTraits::RealType;
+  using PosType  = QMCTraits::PosType;
+  using Walker_t = OperatorBase::Walker_t;
+
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate* comm = OHMMS::Controller;
+
+  MinimalParticlePool mpp;
+  ParticleSetPool particle_pool = mpp(comm);
+  MinimalWaveFunctionPool wfp;
+  WaveFunctionPool wavefunction_pool = wfp(comm, &particle_pool);
+  TrialWaveFunction& psi             = *wavefunction_pool.getWaveFunction("psi0");
+  ParticleSet& elec                  = *particle_pool.getParticleSet("e");
+  REQUIRE(get_sposet("updet") != nullptr);
+
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(dm1b_xml));
+  DensityMatrices1B dm(elec, psi, nullptr);
+  dm.put(doc.getRoot());
+  const int basis_size = dm.basis_size;
+  REQUIRE(basis_size == get_sposet("updet")->size() + get_sposet("downdet")->size());
+
+  // the orbitals at all the virtual particles at once against one particle move at a time
+  RandomGenerator_t rng(11);
+  const int nvp = 7;
+  VirtualParticleSet vp(elec, nvp);
+  for (int i = 0; i < nvp; ++i)
+    vp.R[i] = elec.Lattice.toCart(PosType(rng(), rng(), rng()));
+  vp.update();
+  elec.update();
+  auto checkValues = [&](SPOSet& spo) {
+    SPOSet::ValueMatrix_t psi_vp(nvp, spo.size());
+    spo.evaluateValues(vp, psi_vp);
+    SPOSet::ValueVector_t psi_ref(spo.size());
+    for (int i = 0; i < nvp; ++i)
+    {
+      elec.makeMove(0, vp.R[i] - elec.R[0]);
+      spo.evaluate(elec, 0, psi_ref);
+      elec.rejectMove(0);
+      for (int j = 0; j < spo.size(); ++j)
+      {
+        CHECK(std::real(psi_vp(i, j)) == Approx(std::real(psi_ref[j])));
+        CHECK(std::imag(psi_vp(i, j)) == Approx(std::imag(psi_ref[j])));
+      }
+    }
+  };
+  checkValues(*get_sposet("updet"));
+  checkValues(dm.basis_functions);
+
+  // a crowd of walkers at different positions
+  const int num_walkers = 3;
+  std::vector<std::unique_ptr<ParticleSet>> elecs;
+  std::vector<std::unique_ptr<TrialWaveFunction>> psis;
+  std::vector<std::unique_ptr<OperatorBase>> dms;
+  std::vector<std::unique_ptr<Walker_t>> walkers;
+  OperatorBase::PropertySetType plist;
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    elecs.emplace_back(std::make_unique<ParticleSet>(elec));
+    ParticleSet& pset = *elecs.back();
+    for (int iat = 0; iat < pset.getTotalNum(); ++iat)
+      pset.R[iat] = pset.Lattice.toCart(PosType(rng(), rng(), rng()));
+    pset.update();
+    psis.emplace_back(psi.makeClone(pset));
+    psis.back()->evaluateLog(pset);
+    dms.emplace_back(dm.makeClone(pset, *psis.back()));
+    pset.Collectables.clear();
+    dms.back()->addObservables(plist, pset.Collectables);
+    walkers.emplace_back(std::make_unique<Walker_t>(pset.getTotalNum()));
+    walkers.back()->R      = pset.R;
+    walkers.back()->Weight = 0.5 + iw;
+  }
+  const int ncollectables = elecs[0]->Collectables.size();
+  REQUIRE(ncollectables > 0);
+
+  // the walkers one at a time, each draws the grid from the same state of the generator
+  RandomGenerator_t rng_crowd(7);
+  std::vector<RealType> collectables_ref(ncollectables, 0.0);
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    RandomGenerator_t rng_walker(rng_crowd);
+    OperatorBase& op = *dms[iw];
+    op.setRandomGenerator(&rng_walker);
+    op.setHistories(*walkers[iw]);
+    op.evaluate(*elecs[iw]);
+    for (int i = 0; i < ncollectables; ++i)
+      collectables_ref[i] += elecs[iw]->Collectables[i];
+  }
+
+  // the crowd shares the grid and its basis drawn by the first walker
+  RefVector<OperatorBase> O_list;
+  RefVector<ParticleSet> P_list;
+  RefVector<Walker_t> W_list;
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    O_list.push_back(*dms[iw]);
+    P_list.push_back(*elecs[iw]);
+    W_list.push_back(*walkers[iw]);
+  }
+  OperatorBase::BufferType collectables(ncollectables);
+  RandomGenerator_t rng_mw(rng_crowd);
+  dms[0]->setRandomGenerator(&rng_mw);
+  dms[0]->mw_evaluateCollectables(O_list, P_list, W_list, collectables);
+
+  RealType norm = 0.0;
+  for (int i = 0; i < ncollectables; ++i)
+  {
+    CHECK(collectables[i] == Approx(collectables_ref[i]));
+    norm += std::abs(collectables_ref[i]);
+  }
+  CHECK(norm > 0.0);
+}
+
+} // namespace qmcplusplus
@@ -25,6 +25,8 @@
 #include "QMCWaveFunctions/Jastrow/RadialJastrowBuilder.h"
 //for nonlocal moves
 #include "QMCHamiltonians/NonLocalTOperator.h"
+#include "QMCHamiltonians/NonLocalECPotential.h"
+#include "Utilities/RandomGenerator.h"
 
 //for Hamiltonian manipulations.
 #include "Lattice/ParticleBConds.h"
@@ -413,4 +415,140 @@ TEST_CASE("Evaluate_ecp", "[hamiltonian]")
 
 #endif
 }
+
+TEST_CASE("mw_makeNonLocalMovesPbyP", "[hamiltonian]")
+{
+  typedef QMCTraits::PosType PosType;
+
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate* c = OHMMS::Controller;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds = true; // periodic
+  Lattice.R.diagonal(20);
+  Lattice.LR_dim_cutoff = 15;
+  Lattice.reset();
+
+  ParticleSet ions;
+  ParticleSet elec;
+
+  ions.setName("ion0");
+  ions.create(2);
+  ions.R[0] = PosType(0.0, 0.0, 0.0);
+  ions.R[1] = PosType(6.0, 0.0, 0.0);
+
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("Na");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  int iatnumber                 = ion_species.addAttribute("atomic_number");
+  ion_species(pChargeIdx, pIdx) = 1;
+  ion_species(iatnumber, pIdx)  = 11;
+  ions.Lattice = Lattice;
+  ions.createSK();
+
+  elec.Lattice = Lattice;
+  elec.setName("e");
+  elec.create(2);
+  elec.R[0] = PosType(2.0, 0.0, 0.0);
+  elec.R[1] = PosType(3.0, 0.0, 0.0);
+
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  int massIdx                  = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  tspecies(massIdx, upIdx)     = 1.0;
+  tspecies(massIdx, downIdx)   = 1.0;
+
+  elec.createSK();
+  ions.resetGroups();
+  elec.resetGroups();
+
+  TrialWaveFunction psi(c);
+  const char* particles = "<tmp> \
+  <jastrow name=\"J2\" type=\"Two-Body\" function=\"Bspline\" print=\"yes\">  \
+      <correlation speciesA=\"u\" speciesB=\"d\" rcut=\"10\" size=\"8\"> \
+          <coefficients id=\"ud\" type=\"Array\"> 2.015599059 1.548994099 1.17959447 0.8769687661 0.6245736507 0.4133517767 0.2333851935 0.1035636904</coefficients> \
+        </correlation> \
+  </jastrow> \
+  </tmp> \
+  ";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(particles));
+  RadialJastrowBuilder jastrow(elec, psi);
+  REQUIRE(jastrow.put(xmlFirstElementChild(doc.getRoot())));
+
+  ECPComponentBuilder ecp("test_read_ecp", c);
+  REQUIRE(ecp.read_pp_file("Na.BFD.xml"));
+  copyGridUnrotatedForTest(*ecp.pp_nonloc);
+
+  NonLocalECPotential nlpp(ions, elec, psi);
+  nlpp.addComponent(pIdx, ecp.pp_nonloc);
+
+  // every walker has its own generator, the same for the serial and the batched moves
+  const int nw = 3;
+  const std::vector<PosType> shifts{PosType(0.0, 0.0, 0.0), PosType(0.3, -0.2, 0.1), PosType(-0.5, 0.4, 0.3)};
+  RandomGenerator_t rng;
+
+  int total_accepts = 0;
+  for (const std::string tmove : {"v0", "v1", "v3"})
+  {
+    std::string tmove_input = "<tmp> <parameter name=\"nonlocalmoves\">" + tmove +
+        "</parameter> <parameter name=\"tau\">2.0</parameter> </tmp>";
+    Libxml2Document tmove_doc;
+    REQUIRE(tmove_doc.parseFromString(tmove_input));
+    nlpp.setNonLocalMoves(tmove_doc.getRoot());
+
+    // [0] for makeNonLocalMovesPbyP, [1] for mw_makeNonLocalMovesPbyP
+    std::vector<std::unique_ptr<ParticleSet>> elecs[2];
+    std::vector<std::unique_ptr<TrialWaveFunction>> psis[2];
+    std::vector<std::unique_ptr<NonLocalECPotential>> nlpps[2];
+    std::vector<std::unique_ptr<RandomGenerator_t>> rngs[2];
+    for (int iw = 0; iw < nw; iw++)
+    {
+      for (int k = 0; k < 2; k++)
+      {
+        elecs[k].emplace_back(new ParticleSet(elec));
+        ParticleSet& P = *elecs[k].back();
+        for (int iel = 0; iel < P.getTotalNum(); iel++)
+          P.R[iel] += (iel + 1) * shifts[iw];
+        psis[k].emplace_back(psi.makeClone(P));
+        nlpps[k].emplace_back(static_cast<NonLocalECPotential*>(nlpp.makeClone(P, *psis[k].back())));
+        rngs[k].emplace_back(new RandomGenerator_t(rng));
+        nlpps[k].back()->setRandomGenerator(rngs[k].back().get());
+        P.update();
+        psis[k].back()->evaluateLog(P);
+        nlpps[k].back()->evaluateWithToperator(P);
+      }
+      rng();
+    }
+
+    std::vector<int> serial_accepts(nw);
+    for (int iw = 0; iw < nw; iw++)
+      serial_accepts[iw] = nlpps[0][iw]->makeNonLocalMovesPbyP(*elecs[0][iw]);
+
+    RefVector<NonLocalECPotential> nlpp_list;
+    RefVector<ParticleSet> p_list;
+    for (int iw = 0; iw < nw; iw++)
+    {
+      nlpp_list.push_back(*nlpps[1][iw]);
+      p_list.push_back(*elecs[1][iw]);
+    }
+    std::vector<int> mw_accepts = NonLocalECPotential::mw_makeNonLocalMovesPbyP(nlpp_list, p_list);
+
+    CHECK(mw_accepts == serial_accepts);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      total_accepts += serial_accepts[iw];
+      for (int iel = 0; iel < elec.getTotalNum(); iel++)
+        for (int idim = 0; idim < OHMMS_DIM; idim++)
+          CHECK(elecs[1][iw]->R[iel][idim] == Approx(elecs[0][iw]->R[iel][idim]));
+      CHECK(psis[1][iw]->getLogPsi() == Approx(psis[0][iw]->getLogPsi()));
+    }
+  }
+  // the walkers are close enough to the ions to move
+  CHECK(total_accepts > 0);
+}
 } // namespace qmcplusplus
@@ -0,0 +1,249 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "Estimators/TraceManager.h"
+#include "QMCHamiltonians/EnergyDensityEstimator.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "io/hdf_datatype.h"
+#include "Utilities/IteratorUtility.h"
+
+#include <random>
+#include <string>
+
+namespace qmcplusplus
+{
+/// read a whole dataset of a h5 file
+template<typename T>
+static std::vector<T> read_dataset(hid_t fid, const std::string& name)
+{
+  hid_t dset   = H5Dopen(fid, name.c_str());
+  hid_t fspace = H5Dget_space(dset);
+  std::vector<T> data(H5Sget_simple_extent_npoints(fspace));
+  if (data.size())
+    H5Dread(dset, get_h5_datatype(T()), H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+  H5Sclose(fspace);
+  H5Dclose(dset);
+  return data;
+}
+
+static const char* edens_xml(bool sparse)
+{
+  return sparse ? "<estimator type=\"EnergyDensity\" name=\"EDsparse\" dynamic=\"e\" sparse=\"yes\"> \
+  <spacegrid coord=\"cartesian\"> \
+    <origin p1=\"zero\"/> \
+    <axis p1=\"a1\" scale=\".5\" label=\"x\" grid=\"-1 (.25) 1\"/> \
+    <axis p1=\"a2\" scale=\".5\" label=\"y\" grid=\"-1 (.25) 1\"/> \
+    <axis p1=\"a3\" scale=\".5\" label=\"z\" grid=\"-1 (.25) 1\"/> \
+  </spacegrid> \
+</estimator>"
+                : "<estimator type=\"EnergyDensity\" name=\"EDdense\" dynamic=\"e\"> \
+  <spacegrid coord=\"cartesian\"> \
+    <origin p1=\"zero\"/> \
+    <axis p1=\"a1\" scale=\".5\" label=\"x\" grid=\"-1 (.25) 1\"/> \
+    <axis p1=\"a2\" scale=\".5\" label=\"y\" grid=\"-1 (.25) 1\"/> \
+    <axis p1=\"a3\" scale=\".5\" label=\"z\" grid=\"-1 (.25) 1\"/> \
+  </spacegrid> \
+</estimator>";
+}
+
+TEST_CASE("EnergyDensity sparse spacegrids", "[hamiltonian]")
+{
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate* c = OHMMS::Controller;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds = true; // periodic
+  Lattice.R.diagonal(4.0);
+  Lattice.reset();
+
+  ParticleSet ions;
+  ions.setName("ion0");
+  ions.create(1);
+  ions.R[0]                     = 0.0;
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("He");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, pIdx) = 2;
+  ions.Lattice                  = Lattice;
+
+  ParticleSet elec;
+  elec.setName("e");
+  elec.create(4);
+  SpeciesSet& tspecies       = elec.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int chargeIdx              = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx) = -1;
+  elec.Lattice               = Lattice;
+
+  EnergyDensityEstimator::PSPool pset_pool;
+  pset_pool["e"]    = &elec;
+  pset_pool["ion0"] = &ions;
+
+  Libxml2Document doc_dense, doc_sparse;
+  REQUIRE(doc_dense.parseFromString(edens_xml(false)));
+  REQUIRE(doc_sparse.parseFromString(edens_xml(true)));
+  EnergyDensityEstimator ed_dense(pset_pool, "Kinetic");
+  EnergyDensityEstimator ed_sparse(pset_pool, "Kinetic");
+  ed_dense.put(doc_dense.getRoot());
+  ed_sparse.put(doc_sparse.getRoot());
+  TrialWaveFunction psi(c);
+  OperatorBase* ed_clone = ed_sparse.makeClone(elec, psi);
+
+  // the collectables of the estimators as QMCHamiltonian::addObservables and resetObservables lay them out
+  OperatorBase::PropertySetType plist;
+  elec.Collectables.clear();
+  ed_dense.addObservables(plist, elec.Collectables);
+  const int sparse_start = elec.Collectables.size();
+  ed_sparse.addObservables(plist, elec.Collectables);
+  REQUIRE(elec.Collectables.size() == sparse_start + 3);
+  {
+    OperatorBase::BufferType clone_collectables;
+    std::vector<OperatorBase::RealType> dense_part(sparse_start);
+    clone_collectables.add(dense_part.begin(), dense_part.end());
+    ed_clone->addObservables(plist, clone_collectables);
+  }
+
+  // the traces of the weight, the kinetic energy and the local potential
+  TraceManager tm;
+  tm.streaming_traces                = true;
+  Array<TraceReal, 1>* weight_sample = tm.checkout_real<1>("weight");
+  Array<TraceReal, 1>* kinetic       = tm.checkout_real<1>("Kinetic", elec);
+  Array<TraceReal, 1>* v_elec        = tm.checkout_real<1>("Coulomb", elec);
+  Array<TraceReal, 1>* v_ion         = tm.checkout_real<1>("Coulomb", ions);
+  std::vector<std::string> vloc(1, "Coulomb");
+  tm.make_combined_trace("LocalPotential", vloc);
+  for (OperatorBase* ed : {static_cast<OperatorBase*>(&ed_dense), static_cast<OperatorBase*>(&ed_sparse), ed_clone})
+    ed->get_required_traces(tm);
+  elec.update();
+
+  std::mt19937 rng(13);
+  std::uniform_real_distribution<OHMMS_PRECISION> u(0.0, 1.0);
+  auto sample = [&]() {
+    for (int i = 0; i < elec.getTotalNum(); i++)
+    {
+      elec.R[i]     = Lattice.toCart(ParticleSet::SingleParticlePos_t(u(rng), u(rng), u(rng)));
+      (*kinetic)(i) = u(rng);
+      (*v_elec)(i)  = u(rng) - 1.0;
+    }
+    (*v_ion)(0)         = u(rng) - 2.0;
+    (*weight_sample)(0) = 0.5 + u(rng);
+    elec.update();
+  };
+
+  // warmup evaluations are discarded by startBlock
+  for (int step = 0; step < 4; step++)
+  {
+    sample();
+    ed_sparse.evaluate(elec);
+    ed_clone->evaluate(elec);
+  }
+  ed_sparse.startBlock();
+  ed_clone->startBlock();
+  std::fill(elec.Collectables.begin(), elec.Collectables.end(), 0.0);
+
+  // one block, the sparse steps are split between the estimator and its clone as between threads
+  const int nsteps    = 12;
+  double block_weight = 0.0;
+  for (int step = 0; step < nsteps; step++)
+  {
+    sample();
+    block_weight += (*weight_sample)(0);
+    ed_dense.evaluate(elec);
+    if (step % 2)
+      ed_clone->evaluate(elec);
+    else
+      ed_sparse.evaluate(elec);
+  }
+
+  // write the block of both estimators
+  const std::string h5name("energy_density_sparse.h5");
+  hid_t fid = H5Fcreate(h5name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  std::vector<observable_helper*> h5desc;
+  ed_dense.registerCollectables(h5desc, fid);
+  ed_sparse.registerCollectables(h5desc, fid);
+  std::vector<observable_helper::value_type> dense_average(elec.Collectables.begin(), elec.Collectables.end());
+  for (int i = 0; i < dense_average.size(); i++)
+    dense_average[i] /= block_weight;
+  for (int i = 0; i < h5desc.size(); i++)
+    h5desc[i]->write(dense_average.data(), 0);
+  ed_sparse.collectBlock(c, true);
+  delete_iter(h5desc.begin(), h5desc.end());
+  H5Fclose(fid);
+
+  fid                              = H5Fopen(h5name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  std::vector<double> dense        = read_dataset<double>(fid, "EDdense/spacegrid1/value");
+  std::vector<int> sparse_count    = read_dataset<int>(fid, "EDsparse/spacegrid1/sparse_count");
+  std::vector<int> sparse_index    = read_dataset<int>(fid, "EDsparse/spacegrid1/sparse_index");
+  std::vector<double> sparse_value = read_dataset<double>(fid, "EDsparse/spacegrid1/sparse_value");
+  H5Fclose(fid);
+
+  // 8^3 domains of 3 values, only the ones visited by a particle are written
+  const int nvalues = 3;
+  REQUIRE(dense.size() == 8 * 8 * 8 * nvalues);
+  REQUIRE(sparse_count.size() == 1);
+  REQUIRE(sparse_count[0] == sparse_index.size());
+  REQUIRE(sparse_count[0] > 0);
+  REQUIRE(sparse_count[0] <= nsteps * elec.getTotalNum() + 1);
+  REQUIRE(sparse_value.size() == sparse_count[0] * nvalues);
+  std::vector<double> from_sparse(dense.size(), 0.0);
+  for (int d = 0; d < sparse_index.size(); d++)
+    for (int v = 0; v < nvalues; v++)
+      from_sparse[sparse_index[d] * nvalues + v] = sparse_value[d * nvalues + v];
+  for (int i = 0; i < dense.size(); i++)
+    REQUIRE(from_sparse[i] == Approx(dense[i]));
+
+  delete ed_clone;
+  delete weight_sample;
+  delete kinetic;
+  delete v_elec;
+  delete v_ion;
+}
+
+TEST_CASE("EnergyDensity sparse gather", "[hamiltonian]")
+{
+  // the coordinate lists of two ranks concatenated as by the gather on the master
+  SpaceGrid::SparseBufferType rank0, rank1;
+  rank0[3]  = 1.0;
+  rank0[17] = 2.0;
+  rank1[17] = 0.5;
+  rank1[40] = -1.5;
+  std::vector<int> index;
+  std::vector<double> values;
+  EnergyDensityEstimator::pack_sparse(rank0, 2.0, index, values);
+  EnergyDensityEstimator::pack_sparse(rank1, 3.0, index, values);
+  REQUIRE(index.size() == 6);
+  REQUIRE(values.size() == 6);
+
+  SpaceGrid::SparseBufferType merged;
+  double weight = EnergyDensityEstimator::unpack_sparse(index, values, merged);
+  REQUIRE(weight == Approx(5.0));
+  REQUIRE(merged.size() == 3);
+  REQUIRE(merged[3] == Approx(1.0));
+  REQUIRE(merged[17] == Approx(2.5));
+  REQUIRE(merged[40] == Approx(-1.5));
+
+  // an empty rank only sends its weight
+  index.clear();
+  values.clear();
+  EnergyDensityEstimator::pack_sparse(SpaceGrid::SparseBufferType(), 1.0, index, values);
+  REQUIRE(index.size() == 1);
+  REQUIRE(index[0] == -1);
+  merged.clear();
+  REQUIRE(EnergyDensityEstimator::unpack_sparse(index, values, merged) == Approx(1.0));
+  REQUIRE(merged.empty());
+}
+
+} // namespace qmcplusplus
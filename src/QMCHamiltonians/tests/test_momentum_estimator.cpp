@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "QMCHamiltonians/MomentumEstimator.h"
+#include "QMCApp/tests/MinimalParticlePool.h"
+#include "QMCApp/tests/MinimalWaveFunctionPool.h"
+#include "Utilities/RandomGenerator.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("MomentumEstimator nofK", "[hamiltonian]")
+{
+  using RealType    = QMCTraits::RealType;
+  using PosType     = QMCTraits::PosType;
+  using ComplexType = QMCTraits::ComplexType;
+
+  OHMMS::Controller->initialize(0, NULL);
+  Communicate* comm = OHMMS::Controller;
+
+  MinimalParticlePool mpp;
+  ParticleSetPool particle_pool = mpp(comm);
+  MinimalWaveFunctionPool wfp;
+  WaveFunctionPool wavefunction_pool = wfp(comm, &particle_pool);
+  TrialWaveFunction& psi             = *wavefunction_pool.getWaveFunction("psi0");
+  ParticleSet& elec                  = *particle_pool.getParticleSet("e");
+  elec.update();
+  psi.evaluateLog(elec);
+
+  // a few reciprocal lattice vectors and the sample count
+  std::vector<PosType> kpoints;
+  for (int i = -1; i <= 1; ++i)
+    for (int j = 0; j <= 1; ++j)
+      kpoints.push_back(elec.Lattice.k_cart(PosType(i, j, 1)));
+  const int nk      = kpoints.size();
+  const int samples = 5;
+
+  MomentumEstimator me(elec, psi);
+  me.resize(kpoints, samples);
+  RandomGenerator_t rng(17);
+  me.setRandomGenerator(&rng);
+  me.evaluate(elec);
+
+  // the ratios of every particle moved to every sample, one k-point at a time
+  const int np = elec.getTotalNum();
+  Matrix<ComplexType> ratios(samples, np);
+  for (int s = 0; s < samples; ++s)
+    for (int i = 0; i < np; ++i)
+    {
+      elec.makeMove(i, me.vPos[s] - elec.R[i]);
+      ratios(s, i) = psi.calcRatio(elec, i);
+      psi.rejectMove(i);
+      elec.rejectMove(i);
+    }
+
+  RealType norm = 0.0;
+  for (int ik = 0; ik < nk; ++ik)
+  {
+    RealType nofk = 0.0;
+    for (int s = 0; s < samples; ++s)
+      for (int i = 0; i < np; ++i)
+      {
+        const RealType kdotr = dot(kpoints[ik], elec.R[i] - me.vPos[s]);
+        nofk += std::real(ratios(s, i) * ComplexType(std::cos(kdotr), std::sin(kdotr)));
+      }
+    CHECK(me.nofK[ik] == Approx(nofk));
+    norm += std::abs(nofk);
+  }
+  CHECK(norm > 0.0);
+}
+
+} // namespace qmcplusplus
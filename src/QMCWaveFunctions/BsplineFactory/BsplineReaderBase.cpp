@@ -25,7 +25,7 @@
 namespace qmcplusplus
 {
 BsplineReaderBase::BsplineReaderBase(EinsplineSetBuilder* e)
-    : mybuilder(e), MeshSize(0), checkNorm(true), saveSplineCoefs(false)
+    : mybuilder(e), MeshSize(0), checkNorm(true), saveSplineCoefs(false), coefsStorage("native"), bandGroupSize(1)
 {
   myComm = mybuilder->getCommunicator();
 }
@@ -88,6 +88,8 @@ void BsplineReaderBase::setCommon(xmlNodePtr cur)
   OhmmsAttributeSet a;
   a.add(checkOrbNorm, "check_orb_norm");
   a.add(saveCoefs, "save_coefs");
+  a.add(coefsStorage, "coefs_storage");
+  a.add(bandGroupSize, "band_group_size");
   a.put(cur);
 
   // allow user to turn off norm check with a warning
@@ -97,6 +99,14 @@ void BsplineReaderBase::setCommon(xmlNodePtr cur)
     checkNorm = false;
   }
   saveSplineCoefs = saveCoefs == "yes";
+
+  if (coefsStorage != "native" && coefsStorage != "bf16" && coefsStorage != "fp16")
+    APP_ABORT("BsplineReaderBase::setCommon coefs_storage must be native, bf16 or fp16!");
+
+  if (bandGroupSize < 1 || myComm->size() % bandGroupSize != 0)
+    APP_ABORT("BsplineReaderBase::setCommon band_group_size must divide the number of MPI ranks!");
+  if (bandGroupSize > 1 && coefsStorage != "native")
+    APP_ABORT("BsplineReaderBase::setCommon band_group_size > 1 requires coefs_storage=\"native\"!");
 }
 
 SPOSet* BsplineReaderBase::create_spline_set(int spin, xmlNodePtr cur)
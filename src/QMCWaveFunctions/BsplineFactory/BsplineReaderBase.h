@@ -44,6 +44,10 @@ struct BsplineReaderBase
   bool checkNorm;
   ///save spline coefficients to storage
   bool saveSplineCoefs;
+  ///storage of spline coefficients, native, bf16 or fp16
+  std::string coefsStorage;
+  ///number of consecutive ranks sharing a table distributed over them
+  int bandGroupSize;
   ///map from spo index to band index
   std::vector<std::vector<int>> spo2band;
 
@@ -0,0 +1,331 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file DistributedMultiBspline.h
+ *
+ * define class DistributedMultiBspline, a 3D multi spline table whose splines
+ * are divided among the ranks of a band group.
+ *
+ * Every rank of the group keeps the coefficients of a contiguous and aligned
+ * slice of the splines and exposes them in an MPI window. A position only
+ * touches the 4x4x4 coefficient stencil around it, so instead of sending the
+ * positions to the owners and waiting for them to evaluate, the stencils of a
+ * batch of positions are fetched from the owners with one-sided MPI_Get and a
+ * single flush, and evaluated locally by the spline2 kernels. The owners take
+ * no part in the exchange, which keeps the drivers free of any lockstep among
+ * the ranks of a group. A stencil is 64 lines of the padded slice size, the
+ * traffic per position is the same as the memory traffic of a local evaluation.
+ */
+#ifndef QMCPLUSPLUS_DISTRIBUTED_MULTIBSPLINE_H
+#define QMCPLUSPLUS_DISTRIBUTED_MULTIBSPLINE_H
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <Message/Communicate.h>
+#include <Message/OpenMP.h>
+#include <mpi/mpi_datatype.h>
+#include <spline2/MultiBspline.hpp>
+#include <spline2/MultiBsplineEval.hpp>
+#include "simd/allocator.hpp"
+#include "Utilities/FairDivide.h"
+#include "QMCWaveFunctions/BsplineFactory/DistributedSplineWindows.h"
+
+namespace qmcplusplus
+{
+/** 3D multi spline table distributed over a band group
+ * @tparam ST precision of the spline
+ *
+ * The table is shared by all the clones of an adoptor. The remote stencils
+ * are kept by each clone in a RemoteStencils object.
+ */
+template<typename ST>
+class DistributedMultiBspline
+{
+public:
+  using SplineType = typename bspline_traits<ST, 3>::SplineType;
+  using PointType  = TinyVector<ST, 3>;
+
+  /// stencils of a batch of positions fetched from the other ranks of the group
+  struct RemoteStencils
+  {
+    /// coefficients, 64 lines of the remote slice size per rank and position
+    aligned_vector<ST> coefs;
+    /// spline headers pointing at the stencils, indexed by [ip * group size + rank]
+    std::vector<SplineType> headers;
+  };
+
+  DistributedMultiBspline() : my_rank(0), num_ranks(1), local_spline(nullptr)
+  {
+#if defined(HAVE_MPI)
+    win = MPI_WIN_NULL;
+#endif
+  }
+
+  DistributedMultiBspline(const DistributedMultiBspline&) = delete;
+  DistributedMultiBspline& operator=(const DistributedMultiBspline&) = delete;
+
+  /// the window is freed by DistributedSplineWindows::release_all, not here
+  ~DistributedMultiBspline() = default;
+
+  /** create the local slice
+   * @param comm band group communicator, the ownership is taken
+   * @param grid grid parameters
+   * @param bc boundary parameters
+   * @param num_splines padded number of splines of the whole table
+   */
+  template<typename GT, typename BCT>
+  void create(Communicate* comm, GT& grid, BCT& bc, int num_splines)
+  {
+    band_comm.reset(comm);
+    my_rank   = band_comm->rank();
+    num_ranks = band_comm->size();
+    offsets.resize(num_ranks + 1);
+    for (int r = 0; r < num_ranks; r++)
+      FairDivideAligned(num_splines, getAlignment<ST>(), num_ranks, r, offsets[r], offsets[r + 1]);
+    for (int r = 0; r < num_ranks; r++)
+      if (offsets[r] == offsets[r + 1])
+        APP_ABORT("DistributedMultiBspline::create the band group is too large for the number of splines!");
+    local_table.create(grid, bc, offsets[my_rank + 1] - offsets[my_rank]);
+    local_spline = local_table.getSplinePtr();
+  }
+
+  /** expose the local slice to the group, collective over the band group
+   *
+   * Called once the local slice is complete.
+   */
+  void publish()
+  {
+#if defined(HAVE_MPI)
+    if (num_ranks == 1)
+      return;
+    int provided;
+    MPI_Query_thread(&provided);
+    if (provided < MPI_THREAD_SERIALIZED && omp_get_max_threads() > 1)
+      app_warning() << "MPI is not initialized with MPI_THREAD_SERIALIZED. The one-sided fetches of the "
+                    << "distributed spline table are serialized among the threads in a critical section."
+                    << std::endl;
+    MPI_Win_create(local_spline->coefs, local_spline->coefs_size * sizeof(ST), sizeof(ST), MPI_INFO_NULL,
+                   band_comm->getMPI(), &win);
+    // passive target, nothing is written into the windows after this point
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+    DistributedSplineWindows::add(win);
+    band_comm->barrier();
+#endif
+  }
+
+  SplineType* getLocalSplinePtr() { return local_spline; }
+
+  inline void flush_zero() { local_table.flush_zero(); }
+
+  /// return true if spline i of the whole table is kept by this rank
+  inline bool owns(int i) const { return i >= offsets[my_rank] && i < offsets[my_rank + 1]; }
+
+  /// copy a single spline with index i of the whole table to the local slice
+  template<typename SingleSpline>
+  inline void copy_spline(SingleSpline* aSpline, int i)
+  {
+    local_table.copy_spline(aSpline, i - offsets[my_rank]);
+  }
+
+  /// memory of the local slice
+  size_t sizeInByte() const { return local_table.sizeInByte(); }
+
+  inline int getGroupSize() const { return num_ranks; }
+
+  /** fetch the remote stencils of npos positions in PrimLattice unit
+   *
+   * Must be called outside of a parallel region of the caller. All the gets
+   * of the batch are completed by a single flush.
+   */
+  void fetch(const PointType* r, int npos, RemoteStencils& stencils) const
+  {
+    if (num_ranks == 1)
+      return;
+#if defined(HAVE_MPI)
+    const SplineType* restrict spline_m = local_spline;
+    size_t batch_size                   = 0;
+    for (int rank = 0; rank < num_ranks; rank++)
+      if (rank != my_rank)
+        batch_size += 64 * static_cast<size_t>(offsets[rank + 1] - offsets[rank]);
+    stencils.coefs.resize(batch_size * npos);
+    stencils.headers.resize(npos * num_ranks);
+
+    ST* restrict buffer = stencils.coefs.data();
+#pragma omp critical(DistributedMultiBspline_fetch)
+    {
+      for (int ip = 0; ip < npos; ip++)
+      {
+        int ix, iy, iz;
+        ST a[4], b[4], c[4];
+        spline2::computeLocationAndFractional(spline_m, r[ip][0], r[ip][1], r[ip][2], ix, iy, iz, a, b, c);
+        for (int rank = 0; rank < num_ranks; rank++)
+        {
+          if (rank == my_rank)
+            continue;
+          const intptr_t zs = offsets[rank + 1] - offsets[rank];
+          get_stencil(win, rank, spline_m, ix, iy, iz, zs, buffer, stencils.headers[ip * num_ranks + rank]);
+          buffer += 64 * zs;
+        }
+      }
+      MPI_Win_flush_all(win);
+    }
+#endif
+  }
+
+#if defined(HAVE_MPI)
+  /** get the stencil at grid point (ix,iy,iz) of a slice exposed by win
+   * @param rank owner of the slice
+   * @param spline_m any slice of the table, only the grid is used
+   * @param zs number of splines of the slice
+   * @param buffer receives the 64 lines of zs coefficients
+   * @param stencil header of a table of a single grid cell starting at (ix,iy,iz)
+   *
+   * The gets are completed by the next flush of win.
+   */
+  static void get_stencil(MPI_Win win,
+                          int rank,
+                          const SplineType* spline_m,
+                          int ix,
+                          int iy,
+                          int iz,
+                          intptr_t zs,
+                          ST* buffer,
+                          SplineType& stencil)
+  {
+    // the padded grid sizes are the same on every rank
+    const intptr_t nz          = spline_m->y_stride / spline_m->z_stride;
+    const intptr_t ny          = spline_m->x_stride / spline_m->y_stride;
+    const intptr_t ys          = zs * nz;
+    const intptr_t xs          = ys * ny;
+    const MPI_Datatype type_id = mpi::get_mpi_datatype(ST());
+    for (int i = 0; i < 4; i++)
+      for (int j = 0; j < 4; j++)
+        MPI_Get(buffer + (i * 4 + j) * 4 * zs, 4 * zs, type_id, rank, (ix + i) * xs + (iy + j) * ys + iz * zs, 4 * zs,
+                type_id, win);
+
+    stencil             = *spline_m;
+    stencil.coefs       = buffer;
+    stencil.x_stride    = 16 * zs;
+    stencil.y_stride    = 4 * zs;
+    stencil.z_stride    = zs;
+    stencil.num_splines = zs;
+    stencil.coefs_size  = 64 * zs;
+    stencil.x_grid.start += ix * spline_m->x_grid.delta;
+    stencil.y_grid.start += iy * spline_m->y_grid.delta;
+    stencil.z_grid.start += iz * spline_m->z_grid.delta;
+    stencil.x_grid.num = stencil.y_grid.num = stencil.z_grid.num = 1;
+  }
+#endif
+
+  /** evaluate values of the fetched position ip in the range [first,last) of the whole table
+   * @param psi results of the whole table
+   */
+  template<typename VT>
+  void evaluate_v(const RemoteStencils& stencils, int ip, const PointType& r, VT& psi, int first, int last) const
+  {
+    for (int rank = 0; rank < num_ranks; rank++)
+    {
+      const int f = std::max(first, offsets[rank]);
+      const int l = std::min(last, offsets[rank + 1]);
+      if (f < l)
+        spline2::evaluate_v_impl(getSlice(stencils, ip, rank), r[0], r[1], r[2], psi.data() + f, f - offsets[rank],
+                                 l - offsets[rank]);
+    }
+  }
+
+  /// values of fetched positions [0,npos), one row of psi per position
+  template<typename VM>
+  void evaluate_v_multi(const RemoteStencils& stencils, const PointType* r, int npos, VM& psi, int first, int last) const
+  {
+    for (int rank = 0; rank < num_ranks; rank++)
+    {
+      const int f = std::max(first, offsets[rank]);
+      const int l = std::min(last, offsets[rank + 1]);
+      if (f >= l)
+        continue;
+      if (rank == my_rank)
+        spline2::evaluate_v_multi_impl(local_spline, r, npos, psi.data() + f, psi.cols(),
+                                       f - offsets[rank], l - offsets[rank]);
+      else
+        for (int ip = 0; ip < npos; ip++)
+          spline2::evaluate_v_impl(getSlice(stencils, ip, rank), r[ip][0], r[ip][1], r[ip][2], psi[ip] + f,
+                                   f - offsets[rank], l - offsets[rank]);
+    }
+  }
+
+  /// values, gradients and hessians of the fetched position ip
+  template<typename VT, typename GT, typename HT>
+  void evaluate_vgh(const RemoteStencils& stencils,
+                    int ip,
+                    const PointType& r,
+                    VT& psi,
+                    GT& grad,
+                    HT& hess,
+                    int first,
+                    int last) const
+  {
+    for (int rank = 0; rank < num_ranks; rank++)
+    {
+      const int f = std::max(first, offsets[rank]);
+      const int l = std::min(last, offsets[rank + 1]);
+      if (f < l)
+        spline2::evaluate_vgh_impl(getSlice(stencils, ip, rank), r[0], r[1], r[2], psi.data() + f, grad.data() + f,
+                                   hess.data() + f, psi.size(), f - offsets[rank], l - offsets[rank]);
+    }
+  }
+
+  /// values, gradients, hessians and gradients of hessians of the fetched position ip
+  template<typename VT, typename GT, typename HT, typename GHT>
+  void evaluate_vghgh(const RemoteStencils& stencils,
+                      int ip,
+                      const PointType& r,
+                      VT& psi,
+                      GT& grad,
+                      HT& hess,
+                      GHT& ghess,
+                      int first,
+                      int last) const
+  {
+    for (int rank = 0; rank < num_ranks; rank++)
+    {
+      const int f = std::max(first, offsets[rank]);
+      const int l = std::min(last, offsets[rank + 1]);
+      if (f < l)
+        spline2::evaluate_vghgh_impl(getSlice(stencils, ip, rank), r[0], r[1], r[2], psi.data() + f, grad.data() + f,
+                                     hess.data() + f, ghess.data() + f, psi.size(), f - offsets[rank],
+                                     l - offsets[rank]);
+    }
+  }
+
+private:
+  ///band group communicator
+  std::unique_ptr<Communicate> band_comm;
+  ///rank in the band group and the group size
+  int my_rank, num_ranks;
+  ///splines [offsets[r], offsets[r+1]) of the whole table are kept by rank r
+  std::vector<int> offsets;
+  ///the local slice
+  MultiBspline<ST> local_table;
+  SplineType* local_spline;
+#if defined(HAVE_MPI)
+  ///window exposing the local slice
+  MPI_Win win;
+#endif
+
+  inline const SplineType* getSlice(const RemoteStencils& stencils, int ip, int rank) const
+  {
+    return rank == my_rank ? local_spline : &stencils.headers[ip * num_ranks + rank];
+  }
+};
+
+} // namespace qmcplusplus
+#endif
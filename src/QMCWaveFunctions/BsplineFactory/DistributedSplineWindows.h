@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file DistributedSplineWindows.h
+ *
+ * define class DistributedSplineWindows, the MPI windows of the distributed spline tables.
+ */
+#ifndef QMCPLUSPLUS_DISTRIBUTED_SPLINE_WINDOWS_H
+#define QMCPLUSPLUS_DISTRIBUTED_SPLINE_WINDOWS_H
+
+#include <vector>
+#include <Message/Communicate.h>
+
+namespace qmcplusplus
+{
+/** MPI windows exposing the slices of the distributed spline tables
+ *
+ * MPI_Win_unlock_all and MPI_Win_free are collective over a band group. They
+ * cannot be left to the destructor of a table, which runs whenever the last
+ * clone of an adoptor goes away, possibly after MPI is finalized. The windows
+ * are registered in the order they are published, which is the same on every
+ * rank, and are freed together by release_all.
+ */
+class DistributedSplineWindows
+{
+public:
+#if defined(HAVE_MPI)
+  /// register a window locked by MPI_Win_lock_all
+  static void add(MPI_Win win) { windows().push_back(win); }
+#endif
+
+  /** unlock and free all the windows
+   *
+   * Called by every rank once the drivers are done and before the tables are destroyed.
+   * No stencil can be fetched afterwards.
+   */
+  static void release_all()
+  {
+#if defined(HAVE_MPI)
+    for (MPI_Win& win : windows())
+    {
+      MPI_Win_unlock_all(win);
+      MPI_Win_free(&win);
+    }
+    windows().clear();
+#endif
+  }
+
+private:
+#if defined(HAVE_MPI)
+  static std::vector<MPI_Win>& windows()
+  {
+    static std::vector<MPI_Win> published;
+    return published;
+  }
+#endif
+};
+
+} // namespace qmcplusplus
+#endif
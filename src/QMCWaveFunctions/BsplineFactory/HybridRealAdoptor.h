@@ -36,9 +36,9 @@ struct HybridRealSoA : public BaseAdoptor, public HybridAdoptorBase<typename Bas
 
   typename OrbitalSetTraits<ValueType>::ValueVector_t psi_AO, d2psi_AO;
   typename OrbitalSetTraits<ValueType>::GradVector_t dpsi_AO;
-  Matrix<ST, aligned_allocator<ST>> multi_myV;
 
   using BaseAdoptor::HalfG;
+  using BaseAdoptor::multi_myV;
   using BaseAdoptor::myG;
   using BaseAdoptor::myH;
   using BaseAdoptor::myL;
@@ -32,6 +32,8 @@
 #ifndef QMCPLUSPLUS_SPLINEADOPTORBASE_H
 #define QMCPLUSPLUS_SPLINEADOPTORBASE_H
 
+#include "spline2/MultiBsplineCompressed.hpp"
+
 namespace qmcplusplus
 {
 /** base class any SplineAdoptor
@@ -127,6 +129,31 @@ struct SplineAdoptorBase
     return nCB; //return the number of complex bands
   }
 
+  /** replace the coefficient table by a 16-bit compressed one
+   *
+   * Adoptors supporting compressed tables hide this function.
+   */
+  void compress_spline(spline2::CoefsFormat format)
+  {
+    APP_ABORT(AdoptorName + " does not support compressed spline coefficients!");
+  }
+
+  /** create the local slice of a table distributed over a band group
+   *
+   * Adoptors supporting distributed tables hide this function and owns_spline.
+   */
+  template<typename GT, typename BCT>
+  void create_distributed_spline(Communicate* band_comm, GT& xyz_g, BCT& xyz_bc)
+  {
+    APP_ABORT(AdoptorName + " does not support spline tables distributed over band groups!");
+  }
+
+  /// return true if the orbital ispline is kept by this rank
+  bool owns_spline(int ispline) const { return true; }
+
+  /// expose the local slice of a distributed table to the band group
+  void publish_tables() {}
+
   virtual void finalizeConstruction() {}
 };
 
@@ -73,6 +73,8 @@ struct SplineAdoptorReader : public BsplineReaderBase
    */
   void export_MultiSpline(multi_UBspline_3d_z** target)
   {
+    if (!bspline->SplineInst)
+      APP_ABORT("export_MultiSpline is not supported with compressed or distributed spline coefficients!");
     *target                        = new multi_UBspline_3d_z;
     const auto* source_MultiSpline = (multi_UBspline_3d_d*)bspline->SplineInst->getSplinePtr();
 
@@ -126,7 +128,12 @@ struct SplineAdoptorReader : public BsplineReaderBase
   /** for exporting data from multi_UBspline_3d_d to multi_UBspline_3d_z
    *  This is only used by the legacy EinsplineSet class. To be deleted together with EinsplineSet.
    */
-  void export_MultiSpline(multi_UBspline_3d_d** target) { *target = (multi_UBspline_3d_d*)bspline->SplineInst->getSplinePtr(); }
+  void export_MultiSpline(multi_UBspline_3d_d** target)
+  {
+    if (!bspline->SplineInst)
+      APP_ABORT("export_MultiSpline is not supported with compressed or distributed spline coefficients!");
+    *target = (multi_UBspline_3d_d*)bspline->SplineInst->getSplinePtr();
+  }
 
   SPOSet* create_spline_set(int spin, const BandInfoGroup& bandgroup)
   {
@@ -156,7 +163,12 @@ struct SplineAdoptorReader : public BsplineReaderBase
     {
       APP_ABORT("EinsplineAdoptorReader needs psi_g. Set precision=\"double\".");
     }
-    bspline->create_spline(xyz_grid, xyz_bc);
+    // each band group of bandGroupSize consecutive ranks shares a single table
+    const bool distributed = bandGroupSize > 1;
+    if (distributed)
+      bspline->create_distributed_spline(new Communicate(*myComm, myComm->size() / bandGroupSize), xyz_grid, xyz_bc);
+    else
+      bspline->create_spline(xyz_grid, xyz_bc);
     //    int TwistNum = mybuilder->TwistNum;
     std::ostringstream oo;
     oo << bandgroup.myName << ".g" << MeshSize[0] << "x" << MeshSize[1] << "x" << MeshSize[2] << ".h5";
@@ -165,7 +177,8 @@ struct SplineAdoptorReader : public BsplineReaderBase
     bool root       = (myComm->rank() == 0);
     int foundspline = 0;
     Timer now;
-    if (root)
+    // the stored coefficients are the full table
+    if (root && !distributed)
     {
       now.restart();
       hdf_archive h5f(myComm);
@@ -222,7 +235,10 @@ struct SplineAdoptorReader : public BsplineReaderBase
           spline_i = einspline::create(spline_i, start, end, MeshSize, bspline->HalfG);
 
         now.restart();
-        initialize_spline_pio_gather(spin, bandgroup);
+        if (distributed)
+          initialize_spline_distributed(spin, bandgroup);
+        else
+          initialize_spline_pio_gather(spin, bandgroup);
         app_log() << "  SplineAdoptorReader initialize_spline_pio " << now.elapsed() << " sec" << std::endl;
 
         fftw_destroy_plan(FFTplan);
@@ -230,7 +246,7 @@ struct SplineAdoptorReader : public BsplineReaderBase
       }
       else //why, don't know
         initialize_spline_psi_r(spin, bandgroup);
-      if (saveSplineCoefs && root)
+      if (saveSplineCoefs && root && !distributed)
       {
         now.restart();
         hdf_archive h5f;
@@ -245,6 +261,21 @@ struct SplineAdoptorReader : public BsplineReaderBase
       }
     }
 
+    if (distributed)
+    {
+      now.restart();
+      bspline->publish_tables();
+      app_log() << "  Time to expose the distributed table = " << now.elapsed() << std::endl;
+    }
+
+    if (coefsStorage != "native")
+    {
+      now.restart();
+      bspline->compress_spline(coefsStorage == "bf16" ? spline2::CoefsFormat::BF16 : spline2::CoefsFormat::FP16);
+      app_log() << "  Compressed the spline coefficients to " << coefsStorage << " in " << now.elapsed() << " sec."
+                << std::endl;
+    }
+
     clear();
     return bspline;
   }
@@ -275,6 +306,32 @@ struct SplineAdoptorReader : public BsplineReaderBase
   }
 
 
+  /** read psi_g of orbital iorb, fft and spline it and copy it to the table
+   */
+  inline void read_fft_spline(hdf_archive& h5f,
+                              int spin,
+                              const std::vector<BandInfo>& cur_bands,
+                              int iorb,
+                              Vector<std::complex<double>>& cG)
+  {
+    int iorb_h5   = bspline->BandIndexMap[iorb];
+    int ti        = cur_bands[iorb_h5].TwistIndex;
+    std::string s = psi_g_path(ti, spin, cur_bands[iorb_h5].BandIndex);
+    if (!h5f.readEntry(cG, s))
+      APP_ABORT("SplineAdoptorReader Failed to read band(s) from h5!\n");
+    double total_norm = compute_norm(cG);
+    if ((checkNorm) && (std::abs(total_norm - 1.0) > PW_COEFF_NORM_TOLERANCE))
+    {
+      std::cerr << "The orbital " << iorb_h5 << " has a wrong norm " << total_norm
+                << ", computed from plane wave coefficients!" << std::endl
+                << "This may indicate a problem with the HDF5 library versions used "
+                << "during wavefunction conversion or read." << std::endl;
+      APP_ABORT("SplineAdoptorReader Wrong orbital norm!");
+    }
+    fft_spline(cG, ti);
+    bspline->set_spline(spline_r, spline_i, cur_bands[iorb_h5].TwistIndex, iorb, 0);
+  }
+
   /** initialize the splines
    */
   void initialize_spline_pio_gather(int spin, const BandInfoGroup& bandgroup)
@@ -298,24 +355,7 @@ struct SplineAdoptorReader : public BsplineReaderBase
     for (int iorb = iorb_first; iorb < iorb_last; iorb++)
     {
       if (band_group_comm.isGroupLeader())
-      {
-        int iorb_h5   = bspline->BandIndexMap[iorb];
-        int ti        = cur_bands[iorb_h5].TwistIndex;
-        std::string s = psi_g_path(ti, spin, cur_bands[iorb_h5].BandIndex);
-        if (!h5f.readEntry(cG, s))
-          APP_ABORT("SplineAdoptorReader Failed to read band(s) from h5!\n");
-        double total_norm = compute_norm(cG);
-        if ((checkNorm) && (std::abs(total_norm - 1.0) > PW_COEFF_NORM_TOLERANCE))
-        {
-          std::cerr << "The orbital " << iorb_h5 << " has a wrong norm " << total_norm
-                    << ", computed from plane wave coefficients!" << std::endl
-                    << "This may indicate a problem with the HDF5 library versions used "
-                    << "during wavefunction conversion or read." << std::endl;
-          APP_ABORT("SplineAdoptorReader Wrong orbital norm!");
-        }
-        fft_spline(cG, ti);
-        bspline->set_spline(spline_r, spline_i, cur_bands[iorb_h5].TwistIndex, iorb, 0);
-      }
+        read_fft_spline(h5f, spin, cur_bands, iorb, cG);
       this->create_atomic_centers_Gspace(cG, band_group_comm, iorb);
     }
 
@@ -332,6 +372,28 @@ struct SplineAdoptorReader : public BsplineReaderBase
     app_log() << "  Time to bcast the table = " << now.elapsed() << std::endl;
   }
 
+  /** initialize the local slice of a table distributed over a band group
+   *
+   * Every rank transforms only the orbitals it keeps. The ranks keeping the
+   * same slice in different band groups repeat the same work and nothing is
+   * gathered or broadcast.
+   */
+  void initialize_spline_distributed(int spin, const BandInfoGroup& bandgroup)
+  {
+    const int Nbands = bandgroup.getNumDistinctOrbitals();
+    app_log() << "Start transforming plane waves to 3D B-Splines distributed over band groups of " << bandGroupSize
+              << " ranks." << std::endl;
+    hdf_archive h5f;
+    h5f.open(mybuilder->H5FileName, H5F_ACC_RDONLY);
+    Vector<std::complex<double>> cG(mybuilder->Gvecs[0].size());
+    const std::vector<BandInfo>& cur_bands = bandgroup.myBands;
+    for (int iorb = 0; iorb < Nbands; iorb++)
+      if (bspline->owns_spline(iorb))
+        read_fft_spline(h5f, spin, cur_bands, iorb, cG);
+    h5f.close();
+    myComm->barrier();
+  }
+
   void initialize_spline_psi_r(int spin, const BandInfoGroup& bandgroup)
   {
     //not used by may be enabled later
@@ -145,7 +145,9 @@ struct SplineHybridAdoptorReader : public SplineAdoptorReader<SA>
 {
   typedef SplineAdoptorReader<SA> BaseReader;
 
+  using BaseReader::bandGroupSize;
   using BaseReader::bspline;
+  using BaseReader::coefsStorage;
   using BaseReader::mybuilder;
   using BaseReader::rotate_phase_i;
   using BaseReader::rotate_phase_r;
@@ -156,6 +158,10 @@ struct SplineHybridAdoptorReader : public SplineAdoptorReader<SA>
   /** initialize basic parameters of atomic orbitals */
   void initialize_hybridrep_atomic_centers() override
   {
+    if (bandGroupSize > 1)
+      APP_ABORT("The hybrid orbital representation does not support band_group_size > 1!");
+    if (coefsStorage != "native")
+      APP_ABORT("The hybrid orbital representation does not support coefs_storage other than native!");
     OhmmsAttributeSet a;
     std::string scheme_name("Consistent");
     std::string s_function_name("LEKS2018");
@@ -20,6 +20,7 @@
 #include <spline2/MultiBspline.hpp>
 #include <spline2/MultiBsplineEval.hpp>
 #include "QMCWaveFunctions/BsplineFactory/SplineAdoptorBase.h"
+#include "QMCWaveFunctions/BsplineFactory/DistributedMultiBspline.h"
 #include "QMCWaveFunctions/BsplineFactory/contraction_helper.hpp"
 #include "Utilities/FairDivide.h"
 
@@ -59,6 +60,12 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
 
   ///multi bspline set
   std::shared_ptr<MultiBspline<ST>> SplineInst;
+  ///multi bspline set with 16-bit coefficients, replaces SplineInst when set
+  std::shared_ptr<MultiBsplineCompressed<>> CompressedInst;
+  ///multi bspline set distributed over a band group, replaces SplineInst when set
+  std::shared_ptr<DistributedMultiBspline<ST>> DistributedInst;
+  ///coefficient stencils of the positions being evaluated, fetched from the band group
+  typename DistributedMultiBspline<ST>::RemoteStencils remote_stencils;
 
   vContainer_type myV;
   vContainer_type myL;
@@ -68,6 +75,11 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
 
   ///thread private ratios for reduction when using nested threading, numVP x numThread
   Matrix<TT> ratios_private;
+  ///values of the virtual particles, numVP x padded number of splines
+  Matrix<ST, aligned_allocator<ST>> multi_myV;
+  ///virtual particle positions in PrimLattice unit and their signs
+  std::vector<PointType> multi_ru;
+  std::vector<int> multi_bc_sign;
 
   SplineR2RSoA() : Base()
   {
@@ -114,11 +126,54 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
               << "for the coefficients in 3D spline orbital representation" << std::endl;
   }
 
-  inline void flush_zero() { SplineInst->flush_zero(); }
+  /** create the local slice of a table distributed over band_comm
+   * @param band_comm band group communicator, the ownership is taken
+   */
+  template<typename GT, typename BCT>
+  void create_distributed_spline(Communicate* band_comm, GT& xyz_g, BCT& xyz_bc)
+  {
+    GGt             = dot(transpose(PrimLattice.G), PrimLattice.G);
+    DistributedInst = std::make_shared<DistributedMultiBspline<ST>>();
+    DistributedInst->create(band_comm, xyz_g, xyz_bc, myV.size());
+
+    app_log() << "MEMORY " << DistributedInst->sizeInByte() / (1 << 20) << " MB allocated "
+              << "for the coefficients in 3D spline orbital representation, distributed over "
+              << DistributedInst->getGroupSize() << " ranks" << std::endl;
+  }
+
+  bool owns_spline(int ispline) const { return !DistributedInst || DistributedInst->owns(ispline); }
+
+  void publish_tables() { DistributedInst->publish(); }
+
+  inline void flush_zero()
+  {
+    if (DistributedInst)
+      DistributedInst->flush_zero();
+    else
+      SplineInst->flush_zero();
+  }
+
+  /** replace the coefficient table by a 16-bit compressed one
+   *
+   * Done after the table is complete on every rank, the full precision table is released.
+   */
+  void compress_spline(spline2::CoefsFormat format)
+  {
+    CompressedInst         = std::make_shared<MultiBsplineCompressed<>>();
+    const double max_error = CompressedInst->compress(SplineInst->getSplinePtr(), kPoints.size(), format);
+    app_log() << "MEMORY " << CompressedInst->sizeInByte() / (1 << 20) << " MB allocated "
+              << "for the compressed coefficients, replacing " << SplineInst->sizeInByte() / (1 << 20) << " MB"
+              << std::endl;
+    app_log() << "  Largest orbital error of the compressed spline table " << max_error << std::endl;
+    SplineInst.reset();
+  }
 
   inline void set_spline(SingleSplineType* spline_r, SingleSplineType* spline_i, int twist, int ispline, int level)
   {
-    SplineInst->copy_spline(spline_r, ispline);
+    if (DistributedInst)
+      DistributedInst->copy_spline(spline_r, ispline);
+    else
+      SplineInst->copy_spline(spline_r, ispline);
   }
 
   bool read_splines(hdf_archive& h5f)
@@ -154,6 +209,46 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
     return bc_sign;
   }
 
+  /// fetch the coefficient stencils of npos positions from the band group, outside of parallel regions
+  inline void fetch_stencils(const PointType* ru, int npos)
+  {
+    if (DistributedInst)
+      DistributedInst->fetch(ru, npos, remote_stencils);
+  }
+
+  /// values of the splines [first,last) at ru from the table in use
+  inline void spline_v(const PointType& ru, int first, int last)
+  {
+    if (DistributedInst)
+      DistributedInst->evaluate_v(remote_stencils, 0, ru, myV, first, last);
+    else if (CompressedInst)
+      spline2::evaluate3d(CompressedInst->getSplinePtr(), ru, myV, first, last);
+    else
+      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+  }
+
+  /// values of the splines [first,last) at multi_ru[0,npos) into multi_myV
+  inline void spline_v_multi(int npos, int first, int last)
+  {
+    if (DistributedInst)
+      DistributedInst->evaluate_v_multi(remote_stencils, multi_ru.data(), npos, multi_myV, first, last);
+    else if (CompressedInst)
+      spline2::evaluate3d_multi(CompressedInst->getSplinePtr(), multi_ru.data(), npos, multi_myV, first, last);
+    else
+      spline2::evaluate3d_multi(SplineInst->getSplinePtr(), multi_ru.data(), npos, multi_myV, first, last);
+  }
+
+  /// values, gradients and hessians of the splines [first,last) at ru from the table in use
+  inline void spline_vgh(const PointType& ru, int first, int last)
+  {
+    if (DistributedInst)
+      DistributedInst->evaluate_vgh(remote_stencils, 0, ru, myV, myG, myH, first, last);
+    else if (CompressedInst)
+      spline2::evaluate3d_vgh(CompressedInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    else
+      spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+  }
+
   template<typename VV>
   inline void assign_v(int bc_sign, const vContainer_type& myV, VV& psi, int first, int last) const
   {
@@ -172,13 +267,14 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
     const PointType& r = P.activeR(iat);
     PointType ru;
     int bc_sign = convertPos(r, ru);
+    fetch_stencils(&ru, 1);
 
 #pragma omp parallel
     {
       int first, last;
       FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+      spline_v(ru, first, last);
       assign_v(bc_sign, myV, psi, first, last);
     }
   }
@@ -186,7 +282,16 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
   template<typename VV, typename RT>
   inline void evaluateDetRatios(const VirtualParticleSet& VP, VV& psi, const VV& psiinv, std::vector<RT>& ratios)
   {
-    const bool need_resize = ratios_private.rows() < VP.getTotalNum();
+    const int nVP          = VP.getTotalNum();
+    const bool need_resize = ratios_private.rows() < nVP;
+
+    if (multi_myV.rows() < nVP)
+      multi_myV.resize(nVP, myV.size());
+    multi_ru.resize(nVP);
+    multi_bc_sign.resize(nVP);
+    for (int iat = 0; iat < nVP; ++iat)
+      multi_bc_sign[iat] = convertPos(VP.activeR(iat), multi_ru[iat]);
+    fetch_stencils(multi_ru.data(), nVP);
 
 #pragma omp parallel
     {
@@ -195,27 +300,25 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
       if (need_resize)
       {
         if (tid == 0) // just like #pragma omp master, but one fewer call to the runtime
-          ratios_private.resize(VP.getTotalNum(), omp_get_num_threads());
+          ratios_private.resize(nVP, omp_get_num_threads());
 #pragma omp barrier
       }
       int first, last;
       FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), tid, first, last);
       const int last_real = kPoints.size() < last ? kPoints.size() : last;
 
-      for (int iat = 0; iat < VP.getTotalNum(); ++iat)
+      // all the virtual particles at once, they share most of the spline stencil
+      spline_v_multi(nVP, first, last);
+      for (int iat = 0; iat < nVP; ++iat)
       {
-        const PointType& r = VP.activeR(iat);
-        PointType ru;
-        int bc_sign = convertPos(r, ru);
-
-        spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
-        assign_v(bc_sign, myV, psi, first, last_real);
+        const vContainer_type myV_iat(multi_myV[iat], myV.size());
+        assign_v(multi_bc_sign[iat], myV_iat, psi, first, last_real);
         ratios_private[iat][tid] = simd::dot(psi.data() + first, psiinv.data() + first, last_real - first);
       }
     }
 
     // do the reduction manually
-    for (int iat = 0; iat < VP.getTotalNum(); ++iat)
+    for (int iat = 0; iat < nVP; ++iat)
     {
       ratios[iat] = TT(0);
       for (int tid = 0; tid < ratios_private.cols(); tid++)
@@ -285,13 +388,14 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
     const PointType& r = P.activeR(iat);
     PointType ru;
     int bc_sign = convertPos(r, ru);
+    fetch_stencils(&ru, 1);
 
 #pragma omp parallel
     {
       int first, last;
       FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-      spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+      spline_vgh(ru, first, last);
       assign_vgl(bc_sign, psi, dpsi, d2psi, first, last);
     }
   }
@@ -528,13 +632,14 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
     const PointType& r = P.activeR(iat);
     PointType ru;
     int bc_sign = convertPos(r, ru);
+    fetch_stencils(&ru, 1);
 
 #pragma omp parallel
     {
       int first, last;
       FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-      spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+      spline_vgh(ru, first, last);
       assign_vgh(bc_sign, psi, dpsi, grad_grad_psi, first, last);
     }
   }
@@ -550,12 +655,19 @@ struct SplineR2RSoA : public SplineAdoptorBase<ST, 3>
     PointType ru;
     int bc_sign = convertPos(r, ru);
 
+    if (CompressedInst)
+      APP_ABORT("evaluate_vghgh is not supported with compressed spline coefficients!");
+    fetch_stencils(&ru, 1);
+
 #pragma omp parallel
     {
       int first, last;
       FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-      spline2::evaluate3d_vghgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, mygH, first, last);
+      if (DistributedInst)
+        DistributedInst->evaluate_vghgh(remote_stencils, 0, ru, myV, myG, myH, mygH, first, last);
+      else
+        spline2::evaluate3d_vghgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, mygH, first, last);
       assign_vghgh(bc_sign, psi, dpsi, grad_grad_psi, grad_grad_grad_psi, first, last);
     }
   }
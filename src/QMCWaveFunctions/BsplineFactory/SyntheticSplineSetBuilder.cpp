@@ -0,0 +1,169 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "QMCWaveFunctions/BsplineFactory/SyntheticSplineSetBuilder.h"
+#include "QMCWaveFunctions/BsplineFactory/BsplineSet.h"
+#if defined(QMC_COMPLEX)
+#include "QMCWaveFunctions/BsplineFactory/SplineC2CAdoptor.h"
+#else
+#include "QMCWaveFunctions/BsplineFactory/SplineC2RAdoptor.h"
+#endif
+#include "OhmmsData/AttributeSet.h"
+
+namespace qmcplusplus
+{
+SyntheticSplineSetBuilder::SyntheticSplineSetBuilder(ParticleSet& p, Communicate* comm, xmlNodePtr cur)
+    : SPOSetBuilder(comm), targetPtcl(p), spacing(0.3), smoothing(4), spo_prec("double")
+{
+  int seed = 11;
+  OhmmsAttributeSet a;
+  a.add(spacing, "spacing");
+  a.add(smoothing, "smoothing");
+  a.add(spo_prec, "precision");
+  a.add(seed, "seed");
+  a.put(cur);
+  if (spacing <= 0 || smoothing < 0)
+    APP_ABORT("SyntheticSplineSetBuilder the grid spacing must be positive and the smoothing not negative!");
+  myRng.init(0, 1, seed);
+  app_log() << "  Synthetic B-spline orbitals with random coefficients, grid spacing " << spacing << " seed " << seed
+            << std::endl;
+}
+
+SPOSet* SyntheticSplineSetBuilder::createSPOSetFromXML(xmlNodePtr cur)
+{
+  int norb = 0;
+  std::string spo_name("synthetic");
+  OhmmsAttributeSet a;
+  a.add(norb, "size");
+  a.add(spo_name, "name");
+  a.add(spo_name, "id");
+  a.put(cur);
+  // enough orbitals for the largest group by default, the size then follows the tiling
+  if (norb <= 0)
+    for (int ig = 0; ig < targetPtcl.groups(); ig++)
+      norb = std::max(norb, targetPtcl.last(ig) - targetPtcl.first(ig));
+
+  const bool use_single = (spo_prec == "single" || spo_prec == "float");
+  SPOSet* bspline       = createRandomSplines(targetPtcl, norb, spacing, smoothing, use_single, myRng);
+  bspline->objectName   = spo_name;
+  app_log() << "  Created " << norb << " synthetic orbitals named " << spo_name << " in "
+            << (use_single ? "single" : "double") << " precision" << std::endl;
+  return bspline;
+}
+
+template<typename SA>
+SPOSet* createRandomSplinesImpl(const ParticleSet& P,
+                                int norb,
+                                QMCTraits::RealType spacing,
+                                int smoothing,
+                                RandomGenerator_t& rng)
+{
+  BsplineSet<SA>* bspline = new BsplineSet<SA>;
+  bspline->PrimLattice    = P.Lattice;
+  bspline->SuperLattice   = P.Lattice;
+  bspline->GGt            = dot(transpose(P.Lattice.G), P.Lattice.G);
+
+#if defined(QMC_COMPLEX)
+  const int nsplines = norb;
+#else
+  // a complex spline makes two real orbitals at the Gamma point
+  const int nsplines = (norb + 1) / 2;
+#endif
+  bspline->setOrbitalSetSize(norb);
+  bspline->resizeStorage(nsplines, nsplines);
+  bspline->first_spo = 0;
+  bspline->last_spo  = norb;
+  for (int iorb = 0, num = 0; iorb < nsplines; iorb++)
+  {
+    bspline->kPoints[iorb] = 0;
+#if defined(QMC_COMPLEX)
+    bspline->MakeTwoCopies[iorb] = false;
+#else
+    bspline->MakeTwoCopies[iorb] = (num < norb - 1);
+#endif
+    num += bspline->MakeTwoCopies[iorb] ? 2 : 1;
+  }
+  bspline->HalfG = 0;
+
+  Ugrid xyz_grid[3];
+  typename SA::BCType xyz_bc[3];
+  for (int j = 0; j < 3; j++)
+  {
+    xyz_grid[j].start = 0.0;
+    xyz_grid[j].end   = 1.0;
+    xyz_grid[j].num   = std::max(4, static_cast<int>(std::ceil(P.Lattice.Length[j] / spacing)));
+    xyz_bc[j].lCode   = PERIODIC;
+    xyz_bc[j].rCode   = PERIODIC;
+  }
+  bspline->create_spline(xyz_grid, xyz_bc);
+
+  // random values on the periodic grid, smoothed by [1,2,1]/4 filters along each direction
+  auto* spline_m     = bspline->SplineInst->getSplinePtr();
+  const int ns       = spline_m->num_splines;
+  const int ngrid[3] = {xyz_grid[0].num, xyz_grid[1].num, xyz_grid[2].num};
+  // strides of the grid points of the values
+  const size_t gs[3] = {static_cast<size_t>(ngrid[1]) * ngrid[2] * ns, static_cast<size_t>(ngrid[2]) * ns,
+                        static_cast<size_t>(ns)};
+  std::vector<QMCTraits::RealType> vals(ngrid[0] * gs[0]), work(vals.size());
+  for (size_t i = 0; i < vals.size(); i++)
+    vals[i] = rng() - 0.5;
+  for (int pass = 0; pass < smoothing; pass++)
+    for (int d = 0; d < 3; d++)
+    {
+      for (size_t i = 0; i < vals.size(); i++)
+      {
+        const int ig        = (i / gs[d]) % ngrid[d];
+        const size_t base   = i - ig * gs[d];
+        const size_t iminus = base + ((ig + ngrid[d] - 1) % ngrid[d]) * gs[d];
+        const size_t iplus  = base + ((ig + 1) % ngrid[d]) * gs[d];
+        work[i]             = 0.25 * vals[iminus] + 0.5 * vals[i] + 0.25 * vals[iplus];
+      }
+      vals.swap(work);
+    }
+
+  // the periodic spline coefficient j is the value at the grid point j-1 wrapped into the cell
+  for (int ix = 0; ix < ngrid[0] + 3; ix++)
+    for (int iy = 0; iy < ngrid[1] + 3; iy++)
+      for (int iz = 0; iz < ngrid[2] + 3; iz++)
+      {
+        const size_t src = ((ix + ngrid[0] - 1) % ngrid[0]) * gs[0] + ((iy + ngrid[1] - 1) % ngrid[1]) * gs[1] +
+            ((iz + ngrid[2] - 1) % ngrid[2]) * gs[2];
+        auto* restrict coefs = spline_m->coefs + ix * spline_m->x_stride + iy * spline_m->y_stride +
+            iz * spline_m->z_stride;
+        for (int n = 0; n < ns; n++)
+          coefs[n] = vals[src + n];
+      }
+  bspline->finalizeConstruction();
+  return bspline;
+}
+
+SPOSet* SyntheticSplineSetBuilder::createRandomSplines(const ParticleSet& P,
+                                                       int norb,
+                                                       RealType spacing,
+                                                       int smoothing,
+                                                       bool use_single,
+                                                       RandomGenerator_t& rng)
+{
+#if defined(QMC_COMPLEX)
+  if (use_single)
+    return createRandomSplinesImpl<SplineC2CSoA<float, OHMMS_PRECISION>>(P, norb, spacing, smoothing, rng);
+  else
+    return createRandomSplinesImpl<SplineC2CSoA<double, OHMMS_PRECISION>>(P, norb, spacing, smoothing, rng);
+#else
+  if (use_single)
+    return createRandomSplinesImpl<SplineC2RSoA<float, OHMMS_PRECISION>>(P, norb, spacing, smoothing, rng);
+  else
+    return createRandomSplinesImpl<SplineC2RSoA<double, OHMMS_PRECISION>>(P, norb, spacing, smoothing, rng);
+#endif
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file SyntheticSplineSetBuilder.h
+ * @brief builder of B-spline orbitals with random coefficients
+ *
+ * The orbitals need no ESHDF file and can be made for any cell and any number
+ * of orbitals, e.g. for scaling and throughput studies.
+ * \code
+ * <sposet_builder type="synthetic" spacing="0.3" smoothing="4" precision="single" seed="11">
+ *   <sposet name="spo_ud"/>
+ * </sposet_builder>
+ * \endcode
+ * The coefficients only depend on the seed, so all the ranks get the same orbitals.
+ */
+#ifndef QMCPLUSPLUS_SYNTHETIC_SPLINE_SET_BUILDER_H
+#define QMCPLUSPLUS_SYNTHETIC_SPLINE_SET_BUILDER_H
+
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/SPOSetBuilder.h"
+#include "Utilities/RandomGenerator.h"
+
+namespace qmcplusplus
+{
+class SyntheticSplineSetBuilder : public SPOSetBuilder
+{
+public:
+  SyntheticSplineSetBuilder(ParticleSet& p, Communicate* comm, xmlNodePtr cur);
+
+  /** create an sposet of //sposet/@size random orbitals
+   *
+   * Without @size, the sposet has as many orbitals as the largest group of the target particle set.
+   */
+  SPOSet* createSPOSetFromXML(xmlNodePtr cur);
+
+  /** create real orbitals of random spline coefficients at the Gamma point
+   * @param P target particle set defining the cell
+   * @param norb number of orbitals
+   * @param spacing grid spacing of the spline mesh in bohr
+   * @param smoothing number of passes of the smoothing filter over the random values
+   * @param use_single true for single precision coefficients
+   * @param rng random number generator of the coefficients
+   *
+   * The table is shared by the clones of the returned SPOSet.
+   */
+  static SPOSet* createRandomSplines(const ParticleSet& P,
+                                     int norb,
+                                     RealType spacing,
+                                     int smoothing,
+                                     bool use_single,
+                                     RandomGenerator_t& rng);
+
+private:
+  ///target particle set
+  ParticleSet& targetPtcl;
+  ///grid spacing of the spline mesh
+  RealType spacing;
+  ///passes of the smoothing filter, which bring the kinetic energy to a sensible range
+  int smoothing;
+  ///precision of the spline coefficients, single or double
+  std::string spo_prec;
+  ///generator of the coefficients
+  RandomGenerator_t myRng;
+};
+
+} // namespace qmcplusplus
+#endif
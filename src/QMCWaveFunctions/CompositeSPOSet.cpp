@@ -139,6 +139,22 @@ void CompositeSPOSet::evaluate(const ParticleSet& P, int iat, ValueVector_t& psi
 }
 
 
+void CompositeSPOSet::evaluateValues(const VirtualParticleSet& VP, ValueMatrix_t& psiM)
+{
+  const int nVP = VP.getTotalNum();
+  int n         = 0;
+  for (int c = 0; c < components.size(); ++c)
+  {
+    SPOSet& component = *components[c];
+    ValueMatrix_t values(nVP, component.size());
+    component.evaluateValues(VP, values);
+    for (int iat = 0; iat < nVP; ++iat)
+      std::copy(values[iat], values[iat] + component.size(), psiM[iat] + n);
+    n += component.size();
+  }
+}
+
+
 void CompositeSPOSet::evaluate(const ParticleSet& P,
                                int iat,
                                ValueVector_t& psi,
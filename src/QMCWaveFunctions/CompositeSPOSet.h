@@ -61,6 +61,9 @@ public:
 
   void evaluate(const ParticleSet& P, int iat, ValueVector_t& psi, GradVector_t& dpsi, ValueVector_t& d2psi);
 
+  ///the components are evaluated at all the virtual particles in turn
+  void evaluateValues(const VirtualParticleSet& VP, ValueMatrix_t& psiM);
+
   ///unimplemented functions call this to abort
   inline void not_implemented(const std::string& method)
   {
@@ -51,7 +51,19 @@ bool BackflowBuilder::put(xmlNodePtr cur)
   xmlNodePtr curRoot = cur;
   std::string cname;
   BFTrans = new BackflowTransformation(targetPtcl);
-  cur     = curRoot->children;
+  std::string update("full");
+  OhmmsAttributeSet bfAttrib;
+  bfAttrib.add(update, "update");
+  bfAttrib.add(BFTrans->qpTolerance, "qp_tolerance");
+  bfAttrib.put(curRoot);
+  if (update == "lowrank")
+  {
+    app_log() << "  Backflow determinants use low-rank updates with qp_tolerance = " << BFTrans->qpTolerance << "\n";
+    BFTrans->lowRankUpdate = true;
+  }
+  else if (update != "full")
+    APP_ABORT("Unknown backflow/@update. Valid options are full and lowrank. \n");
+  cur = curRoot->children;
   while (cur != NULL)
   {
     getNodeName(cname, cur);
@@ -94,6 +94,12 @@ public:
   // cutoff of radial funtions
   RealType cutOff;
 
+  /// quasiparticles displaced by less than qpTolerance in a pbyp move are not updated
+  RealType qpTolerance;
+
+  /// if true, determinants update their inverse over the changed quasiparticles only (Woodbury)
+  bool lowRankUpdate;
+
   // pos of first optimizable variable in global array
   int numVarBefore;
 
@@ -151,7 +157,7 @@ public:
   opt_variables_type myVars;
 
   BackflowTransformation(ParticleSet& els)
-    : targetPtcl(els), QP(els), cutOff(0.0),
+    : targetPtcl(els), QP(els), cutOff(0.0), qpTolerance(1e-10), lowRankUpdate(false),
 #ifdef ENABLE_SOA
       myTableIndex_(els.addTable(els, DT_SOA))
 #else
@@ -172,10 +178,12 @@ public:
 
   void copyFrom(BackflowTransformation& tr)
   {
-    cutOff       = tr.cutOff;
-    numParams    = tr.numParams;
-    numVarBefore = tr.numVarBefore;
-    optIndexMap  = tr.optIndexMap;
+    cutOff        = tr.cutOff;
+    qpTolerance   = tr.qpTolerance;
+    lowRankUpdate = tr.lowRankUpdate;
+    numParams     = tr.numParams;
+    numVarBefore  = tr.numVarBefore;
+    optIndexMap   = tr.optIndexMap;
     bfFuns.resize((tr.bfFuns).size());
     std::vector<BackflowFunctionBase*>::iterator it((tr.bfFuns).begin());
     for (int i = 0; i < (tr.bfFuns).size(); i++, it++)
@@ -361,13 +369,7 @@ public:
     indexQP.clear();
     for (int i = 0; i < bfFuns.size(); i++)
       bfFuns[i]->evaluatePbyP(P, iat, newQP);
-    for (int jat = 0; jat < NumTargets; jat++)
-    {
-      // make direct routine in OhmmsPETE later
-      RealType dr = std::sqrt(dot(newQP[jat] - QP.R[jat], newQP[jat] - QP.R[jat]));
-      if (dr > 1e-10)
-        indexQP.push_back(jat);
-    }
+    findChangedQP();
     //debug
     /*
     dummyQP2.R = P.R;
@@ -413,12 +415,7 @@ public:
     std::copy(FirstOfA, LastOfA, FirstOfA_temp);
     for (int i = 0; i < bfFuns.size(); i++)
       bfFuns[i]->evaluatePbyP(P, iat, newQP, Amat_temp);
-    for (int jat = 0; jat < NumTargets; jat++)
-    {
-      RealType dr = std::sqrt(dot(newQP[jat] - QP.R[jat], newQP[jat] - QP.R[jat]));
-      if (dr > 1e-10)
-        indexQP.push_back(jat);
-    }
+    findChangedQP();
   }
 
   /** calculate new quasi-particle coordinates after pbyp move
@@ -441,16 +438,26 @@ public:
     std::copy(FirstOfB, LastOfB, FirstOfB_temp);
     for (int i = 0; i < bfFuns.size(); i++)
       bfFuns[i]->evaluatePbyP(P, iat, newQP, Bmat_temp, Amat_temp);
+    findChangedQP();
+  }
+
+
+  /** collect in indexQP the quasiparticles displaced by more than qpTolerance
+   *
+   * Quasiparticles which moved less than the tolerance keep their old orbital
+   * rows in the determinants until the next full update.
+   */
+  inline void findChangedQP()
+  {
+    const RealType tol2 = qpTolerance * qpTolerance;
     for (int jat = 0; jat < NumTargets; jat++)
     {
-      // make direct routine in OhmmsPETE later
-      RealType dr = std::sqrt(dot(newQP[jat] - QP.R[jat], newQP[jat] - QP.R[jat]));
-      if (dr > 1e-10)
+      const PosType dr = newQP[jat] - QP.R[jat];
+      if (dot(dr, dr) > tol2)
         indexQP.push_back(jat);
     }
   }
 
-
   /** calculate only Bmat. Assume that QP and Amat are current
    *  This is used in pbyp moves, in updateBuffer()
    */
@@ -37,9 +37,11 @@ DiracDeterminantWithBackflow::DiracDeterminantWithBackflow(ParticleSet& ptcl,
   is_fermionic = true;
   ClassName   = "DiracDeterminantWithBackflow";
   registerTimers();
-  BFTrans      = BF;
-  NumParticles = ptcl.getTotalNum();
-  NP           = 0;
+  BFTrans             = BF;
+  NumParticles        = ptcl.getTotalNum();
+  NP                  = 0;
+  LowRankMove         = false;
+  LowRankInverseReady = false;
 }
 
 ///default destructor
@@ -205,31 +207,14 @@ void DiracDeterminantWithBackflow::copyFromBuffer(ParticleSet& P, WFBufferType&
  */
 DiracDeterminantWithBackflow::ValueType DiracDeterminantWithBackflow::ratio(ParticleSet& P, int iat)
 {
-  // FIX FIX FIX : code Woodbury formula
-  psiM_temp = psiM;
-  // either code Woodbury or do multiple single particle updates
-  UpdateMode                        = ORB_PBYP_RATIO;
-  std::vector<int>::iterator it     = BFTrans->indexQP.begin();
-  std::vector<int>::iterator it_end = BFTrans->indexQP.end();
-  while (it != it_end)
-  {
-    if (*it < FirstIndex || *it >= LastIndex)
-    {
-      ++it;
-      continue;
-    }
-    int jat    = *it - FirstIndex;
-    PosType dr = BFTrans->newQP[*it] - BFTrans->QP.R[*it];
-    BFTrans->QP.makeMove(*it, dr);
-    Phi->evaluate(BFTrans->QP, *it, psiV);
-    for (int orb = 0; orb < psiV.size(); orb++)
-      psiM_temp(orb, jat) = psiV[orb];
-    BFTrans->QP.rejectMove(*it);
-    it++;
-  }
-  // FIX FIX FIX : code Woodbury formula
+  psiM_temp   = psiM;
+  UpdateMode  = ORB_PBYP_RATIO;
+  LowRankMove = selectChangedQP();
+  evaluateChangedRows(false);
+  // the inverse is only needed if the move is accepted
+  if (LowRankMove)
+    return curRatio = lowRankRatio();
   psiMinv_temp = psiM_temp;
-  // FIX FIX FIX : code Woodbury formula
   InverseTimer.start();
   RealType NewPhase;
   RealType NewLog = InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewPhase);
@@ -243,6 +228,99 @@ DiracDeterminantWithBackflow::ValueType DiracDeterminantWithBackflow::ratio(Part
 #endif
 }
 
+bool DiracDeterminantWithBackflow::selectChangedQP()
+{
+  LowRankInverseReady = false;
+  QPIndex.clear();
+  for (int i = 0; i < BFTrans->indexQP.size(); i++)
+  {
+    const int jat = BFTrans->indexQP[i];
+    if (jat >= FirstIndex && jat < LastIndex)
+      QPIndex.push_back(jat - FirstIndex);
+  }
+  // beyond half of the rows a full inversion is as cheap and more stable
+  return BFTrans->lowRankUpdate && 2 * QPIndex.size() <= NumPtcls;
+}
+
+void DiracDeterminantWithBackflow::evaluateChangedRows(bool withGrad)
+{
+  const int k = QPIndex.size();
+  LowRankPsi.resize(k, NumOrbitals);
+  for (int a = 0; a < k; a++)
+  {
+    const int jat = QPIndex[a];
+    const int iat = FirstIndex + jat;
+    PosType dr    = BFTrans->newQP[iat] - BFTrans->QP.R[iat];
+    BFTrans->QP.makeMove(iat, dr);
+    if (withGrad)
+    {
+      Phi->evaluate(BFTrans->QP, iat, psiV, dpsiV, d2psiV);
+      std::copy(dpsiV.begin(), dpsiV.end(), dpsiM_temp.begin(jat));
+      std::copy(grad_gradV.begin(), grad_gradV.end(), grad_grad_psiM_temp.begin(jat));
+    }
+    else
+      Phi->evaluate(BFTrans->QP, iat, psiV);
+    for (int orb = 0; orb < psiV.size(); orb++)
+      psiM_temp(orb, jat) = psiV[orb];
+    std::copy(psiV.begin(), psiV.end(), LowRankPsi[a]);
+    BFTrans->QP.rejectMove(iat);
+  }
+}
+
+/** ratio of a rank-k change of the backflow matrix
+ *
+ * With C = psiMinv rows of the changed quasiparticles, S(a,b) = LowRankPsi[a].C[b]
+ * and the ratio is det(S). LowRankS is overwritten by S^{-1}.
+ */
+DiracDeterminantWithBackflow::ValueType DiracDeterminantWithBackflow::lowRankRatio()
+{
+  const int k = QPIndex.size();
+  if (k == 0)
+    return ValueType(1);
+  LowRankS.resize(k, k);
+  LowRankInvRows.resize(k, NumOrbitals);
+  for (int b = 0; b < k; b++)
+    std::copy_n(psiMinv[QPIndex[b]], NumOrbitals, LowRankInvRows[b]);
+  for (int a = 0; a < k; a++)
+    for (int b = 0; b < k; b++)
+      LowRankS(a, b) = simd::dot(LowRankPsi[a], LowRankInvRows[b], NumOrbitals);
+  InverseTimer.start();
+  RealType phaseS;
+  RealType logS = InvertWithLog(LowRankS.data(), k, k, WorkSpace.data(), Pivot.data(), phaseS);
+  InverseTimer.stop();
+#if defined(QMC_COMPLEX)
+  RealType ratioMag = std::exp(logS);
+  return std::complex<OHMMS_PRECISION>(std::cos(phaseS) * ratioMag, std::sin(phaseS) * ratioMag);
+#else
+  return std::cos(phaseS) * std::exp(logS);
+#endif
+}
+
+/** Woodbury update of the inverse for a rank-k change of the backflow matrix
+ *
+ * psiMinv_temp[p] = psiMinv[p] - sum_b C[b] T(b,p) with T = S^{-1} R and
+ * R(a,p) = LowRankPsi[a].psiMinv[p] - delta(QPIndex[a],p). Costs O(k N^2) instead of O(N^3).
+ */
+void DiracDeterminantWithBackflow::lowRankInverseUpdate()
+{
+  const int k         = QPIndex.size();
+  psiMinv_temp        = psiMinv;
+  LowRankInverseReady = true;
+  if (k == 0)
+    return;
+  const ValueType cone(1), czero(0);
+  LowRankR.resize(k, NumPtcls);
+  LowRankT.resize(k, NumPtcls);
+  BLAS::gemm('T', 'N', NumPtcls, k, NumOrbitals, cone, psiMinv.data(), NumOrbitals, LowRankPsi.data(), NumOrbitals,
+             czero, LowRankR.data(), NumPtcls);
+  for (int a = 0; a < k; a++)
+    LowRankR(a, QPIndex[a]) -= cone;
+  BLAS::gemm('N', 'N', NumPtcls, k, k, cone, LowRankR.data(), NumPtcls, LowRankS.data(), k, czero, LowRankT.data(),
+             NumPtcls);
+  BLAS::gemm('N', 'T', NumOrbitals, NumPtcls, k, -cone, LowRankInvRows.data(), NumOrbitals, LowRankT.data(), NumPtcls,
+             cone, psiMinv_temp.data(), NumOrbitals);
+}
+
 void DiracDeterminantWithBackflow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios)
 {
   APP_ABORT(" Need to implement DiracDeterminantWithBackflow::evaluateRatiosAlltoOne. \n");
@@ -282,51 +360,39 @@ DiracDeterminantWithBackflow::ValueType DiracDeterminantWithBackflow::ratioGrad(
                                                                                 int iat,
                                                                                 GradType& grad_iat)
 {
-  // FIX FIX FIX : code Woodbury formula
-  psiM_temp                         = psiM;
-  dpsiM_temp                        = dpsiM;
-  UpdateMode                        = ORB_PBYP_PARTIAL;
-  std::vector<int>::iterator it     = BFTrans->indexQP.begin();
-  std::vector<int>::iterator it_end = BFTrans->indexQP.end();
-  ParticleSet::ParticlePos_t dr;
-  while (it != it_end)
+  psiM_temp   = psiM;
+  dpsiM_temp  = dpsiM;
+  UpdateMode  = ORB_PBYP_PARTIAL;
+  LowRankMove = selectChangedQP();
+  evaluateChangedRows(true);
+  if (LowRankMove)
   {
-    if (*it < FirstIndex || *it >= LastIndex)
-    {
-      ++it;
-      continue;
-    }
-    int jat    = *it - FirstIndex;
-    PosType dr = BFTrans->newQP[*it] - BFTrans->QP.R[*it];
-    BFTrans->QP.makeMove(*it, dr);
-    Phi->evaluate(BFTrans->QP, *it, psiV, dpsiV, d2psiV);
-    for (int orb = 0; orb < psiV.size(); orb++)
-      psiM_temp(orb, jat) = psiV[orb];
-    std::copy(dpsiV.begin(), dpsiV.end(), dpsiM_temp.begin(jat));
-    std::copy(grad_gradV.begin(), grad_gradV.end(), grad_grad_psiM_temp.begin(jat));
-    BFTrans->QP.rejectMove(*it);
-    it++;
+    curRatio = lowRankRatio();
+    lowRankInverseUpdate();
+  }
+  else
+  {
+    psiMinv_temp = psiM_temp;
+    InverseTimer.start();
+    RealType NewPhase;
+    RealType NewLog =
+        InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewPhase);
+    InverseTimer.stop();
+#if defined(QMC_COMPLEX)
+    RealType ratioMag = std::exp(NewLog - LogValue);
+    curRatio          = std::complex<OHMMS_PRECISION>(std::cos(NewPhase - PhaseValue) * ratioMag,
+                                             std::sin(NewPhase - PhaseValue) * ratioMag);
+#else
+    curRatio = std::cos(NewPhase - PhaseValue) * std::exp(NewLog - LogValue);
+#endif
   }
-  // FIX FIX FIX : code Woodbury formula
-  psiMinv_temp = psiM_temp;
-  // FIX FIX FIX : code Woodbury formula
-  InverseTimer.start();
-  RealType NewPhase;
-  RealType NewLog = InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewPhase);
-  InverseTimer.stop();
   // update Fmatdiag_temp
   for (int j = 0; j < NumPtcls; j++)
   {
     Fmatdiag_temp[j] = simd::dot(psiMinv_temp[j], dpsiM_temp[j], NumOrbitals);
     grad_iat += dot(BFTrans->Amat_temp(iat, FirstIndex + j), Fmatdiag_temp[j]);
   }
-#if defined(QMC_COMPLEX)
-  RealType ratioMag = std::exp(NewLog - LogValue);
-  return curRatio   = std::complex<OHMMS_PRECISION>(std::cos(NewPhase - PhaseValue) * ratioMag,
-                                                  std::sin(NewPhase - PhaseValue) * ratioMag);
-#else
-  return curRatio = std::cos(NewPhase - PhaseValue) * std::exp(NewLog - LogValue);
-#endif
+  return curRatio;
 }
 
 void DiracDeterminantWithBackflow::testL(ParticleSet& P)
@@ -591,6 +657,9 @@ void DiracDeterminantWithBackflow::acceptMove(ParticleSet& P, int iat)
   PhaseValue += evaluatePhase(curRatio);
   LogValue += std::log(std::abs(curRatio));
   UpdateTimer.start();
+  if (LowRankMove && !LowRankInverseReady)
+    lowRankInverseUpdate();
+  LowRankMove = false;
   switch (UpdateMode)
   {
   case ORB_PBYP_RATIO:
@@ -620,7 +689,11 @@ void DiracDeterminantWithBackflow::acceptMove(ParticleSet& P, int iat)
 
 /** move was rejected. Nothing to restore for now.
 */
-void DiracDeterminantWithBackflow::restore(int iat) { curRatio = 1.0; }
+void DiracDeterminantWithBackflow::restore(int iat)
+{
+  LowRankMove = false;
+  curRatio    = 1.0;
+}
 
 void DiracDeterminantWithBackflow::evaluateDerivatives(ParticleSet& P,
                                                        const opt_variables_type& active,
@@ -206,6 +206,32 @@ public:
   ParticleSet::ParticleGradient_t myG, myG_temp;
   ParticleSet::ParticleLaplacian_t myL, myL_temp;
 
+  /// true if the pending move is handled by a low-rank update of psiMinv
+  bool LowRankMove;
+  /// true if psiMinv_temp holds the updated inverse of the pending low-rank move
+  bool LowRankInverseReady;
+  /// local indices of the quasiparticles changed by the pending move
+  std::vector<int> QPIndex;
+  /// new orbital rows of the changed quasiparticles
+  ValueMatrix_t LowRankPsi;
+  /// rows of psiMinv of the changed quasiparticles
+  ValueMatrix_t LowRankInvRows;
+  /// inverse of the k-by-k capacitance matrix of the Woodbury update
+  ValueMatrix_t LowRankS;
+  /// k-by-NumPtcls scratch matrices of the Woodbury update
+  ValueMatrix_t LowRankR, LowRankT;
+
+  /** select the quasiparticles of this determinant changed by the current move
+   * @return true if the move is handled by a low-rank update
+   */
+  bool selectChangedQP();
+  /// evaluate the orbital rows of the changed quasiparticles and store them in psiM_temp (and dpsiM_temp)
+  void evaluateChangedRows(bool withGrad);
+  /// return the determinant ratio of the low-rank move, det(S) with S(a,b) = LowRankPsi[a].psiMinv[b]
+  ValueType lowRankRatio();
+  /// Woodbury update of psiMinv into psiMinv_temp using the inverse capacitance matrix
+  void lowRankInverseUpdate();
+
   void testDerivFjj(ParticleSet& P, int pa);
   void testGGG(ParticleSet& P);
   void testGG(ParticleSet& P);
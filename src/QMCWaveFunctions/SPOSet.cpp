@@ -63,6 +63,15 @@ void SPOSet::evaluateDetRatios(const VirtualParticleSet& VP,
   }
 }
 
+void SPOSet::evaluateValues(const VirtualParticleSet& VP, ValueMatrix_t& psiM)
+{
+  for (int iat = 0; iat < VP.getTotalNum(); ++iat)
+  {
+    ValueVector_t psi(psiM[iat], OrbitalSetSize);
+    evaluate(VP, iat, psi);
+  }
+}
+
 void SPOSet::evaluateThirdDeriv(const ParticleSet& P, int first, int last, GGGMatrix_t& grad_grad_grad_logdet)
 {
   APP_ABORT("Need specialization of SPOSet::evaluateThirdDeriv(). \n");
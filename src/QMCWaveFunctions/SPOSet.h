@@ -231,6 +231,12 @@ public:
                                  const ValueVector_t& psiinv,
                                  std::vector<ValueType>& ratios);
 
+  /** evaluate the values of this single-particle orbital set at all the virtual particles
+   * @param VP virtual particle set
+   * @param psiM values of the SPO, one row per virtual particle
+   */
+  virtual void evaluateValues(const VirtualParticleSet& VP, ValueMatrix_t& psiM);
+
   /** evaluate the values, gradients and laplacians of this single-particle orbital set
    * @param P current ParticleSet
    * @param iat active particle
@@ -33,6 +33,7 @@
 
 #if defined(HAVE_EINSPLINE)
 #include "QMCWaveFunctions/EinsplineSetBuilder.h"
+#include "QMCWaveFunctions/BsplineFactory/SyntheticSplineSetBuilder.h"
 #endif
 #endif
 #include "QMCWaveFunctions/CompositeSPOSet.h"
@@ -181,6 +182,15 @@ SPOSetBuilder* SPOSetBuilderFactory::createSPOSetBuilder(xmlNodePtr rootNode)
     bb = new SHOSetBuilder(targetPtcl, myComm);
   }
 #if OHMMS_DIM == 3
+  else if (type == "synthetic")
+  {
+#if defined(HAVE_EINSPLINE)
+    PRE << "SyntheticSplineSetBuilder:  using random B-spline orbitals.\n";
+    bb = new SyntheticSplineSetBuilder(targetPtcl, myComm, rootNode);
+#else
+    PRE.error("Einspline is missing for B-spline orbitals", true);
+#endif
+  }
   else if (type.find("spline") < type.size())
   {
     name = type_in;
@@ -39,6 +39,8 @@ TrialWaveFunction::TrialWaveFunction(Communicate* c)
     : MPIObjectBase(c),
       BufferCursor(0),
       BufferCursor_scalar(0),
+      BufferEnd(0),
+      BufferEnd_scalar(0),
       PhaseValue(0.0),
       LogValue(0.0),
       OneOverM(1.0),
@@ -705,6 +707,8 @@ void TrialWaveFunction::registerData(ParticleSet& P, WFBufferType& buf)
   }
   buf.add(PhaseValue);
   buf.add(LogValue);
+  BufferEnd        = buf.current();
+  BufferEnd_scalar = buf.current_scalar();
 }
 
 void TrialWaveFunction::flex_registerData(const UPtrVector<TrialWaveFunction>& wf_list,
@@ -734,6 +738,8 @@ void TrialWaveFunction::flex_registerData(const UPtrVector<TrialWaveFunction>& w
   auto addPhaseAndLog = [](WFBufferType& wfb, TrialWaveFunction& twf) {
     wfb.add(twf.PhaseValue);
     wfb.add(twf.LogValue);
+    twf.BufferEnd        = wfb.current();
+    twf.BufferEnd_scalar = wfb.current_scalar();
   };
   for (int iw = 0; iw < wf_list.size(); iw++)
     addPhaseAndLog(buf_list[iw], *(wf_list[iw]));
@@ -759,7 +765,7 @@ TrialWaveFunction::RealType TrialWaveFunction::updateBuffer(ParticleSet& P, WFBu
   buf.put(PhaseValue);
   buf.put(LogValue);
   // Ye: temperal added check, to be removed
-  assert(buf.size() == buf.current() + buf.current_scalar() * sizeof(double));
+  assert(atBufferEnd(buf));
   return LogValue;
 }
 
@@ -802,8 +808,7 @@ void TrialWaveFunction::flex_updateBuffer(const RefVector<TrialWaveFunction>& wf
   {
     buf_list[iw].get().put(wf_list[iw].get().PhaseValue);
     buf_list[iw].get().put(wf_list[iw].get().LogValue);
-    assert(buf_list[iw].get().size() ==
-           buf_list[iw].get().current() + buf_list[iw].get().current_scalar() * sizeof(double));
+    assert(wf_list[iw].get().atBufferEnd(buf_list[iw]));
   }
 }
 
@@ -819,7 +824,7 @@ void TrialWaveFunction::copyFromBuffer(ParticleSet& P, WFBufferType& buf)
   //get the gradients and laplacians from the buffer
   buf.get(PhaseValue);
   buf.get(LogValue);
-  assert(buf.size() == buf.current() + buf.current_scalar() * sizeof(double));
+  assert(atBufferEnd(buf));
 }
 
 void TrialWaveFunction::flex_copyFromBuffer(const std::vector<TrialWaveFunction*>& WF_list,
@@ -840,7 +845,7 @@ void TrialWaveFunction::flex_copyFromBuffer(const std::vector<TrialWaveFunction*
   {
     buf_list[iw]->get(WF_list[iw]->PhaseValue);
     buf_list[iw]->get(WF_list[iw]->LogValue);
-    assert(buf_list[iw]->size() == buf_list[iw]->current() + buf_list[iw]->current_scalar() * sizeof(double));
+    assert(WF_list[iw]->atBufferEnd(*buf_list[iw]));
   }
 }
 
@@ -887,6 +892,8 @@ TrialWaveFunction* TrialWaveFunction::makeClone(ParticleSet& tqp) const
   TrialWaveFunction* myclone   = new TrialWaveFunction(myComm);
   myclone->BufferCursor        = BufferCursor;
   myclone->BufferCursor_scalar = BufferCursor_scalar;
+  myclone->BufferEnd           = BufferEnd;
+  myclone->BufferEnd_scalar    = BufferEnd_scalar;
   for (int i = 0; i < Z.size(); ++i)
     myclone->addComponent(Z[i]->makeClone(tqp), Z[i]->ClassName);
   myclone->OneOverM = OneOverM;
@@ -933,6 +940,52 @@ void TrialWaveFunction::evaluateDerivatives(ParticleSet& P,
   }
 }
 
+void TrialWaveFunction::flex_evaluateDerivatives(const RefVector<TrialWaveFunction>& wf_list,
+                                                 const RefVector<ParticleSet>& p_list,
+                                                 const opt_variables_type& optvars,
+                                                 std::vector<std::vector<ValueType>>& dlogpsi_list,
+                                                 std::vector<std::vector<ValueType>>& dhpsioverpsi_list)
+{
+  if (wf_list.size() > 1)
+  {
+    const int num_walkers = wf_list.size();
+    std::vector<std::vector<ValueType>*> dlogpsi_ptr_list(num_walkers);
+    std::vector<std::vector<ValueType>*> dhpsioverpsi_ptr_list(num_walkers);
+    for (int iw = 0; iw < num_walkers; iw++)
+    {
+      dlogpsi_ptr_list[iw]      = &dlogpsi_list[iw];
+      dhpsioverpsi_ptr_list[iw] = &dhpsioverpsi_list[iw];
+    }
+
+    auto& wavefunction_components = wf_list[0].get().Z;
+    const int num_wfc             = wf_list[0].get().Z.size();
+    for (int i = 0; i < num_wfc; ++i)
+    {
+      const auto wfc_list(extractWFCRefList(wf_list, i));
+      // the differential components are per walker, only the components without one are batched
+      if (wavefunction_components[i]->dPsi)
+      {
+#pragma omp parallel for
+        for (int iw = 0; iw < num_walkers; iw++)
+          wfc_list[iw].get().dPsi->evaluateDerivatives(p_list[iw], optvars, dlogpsi_list[iw], dhpsioverpsi_list[iw]);
+      }
+      else
+        wavefunction_components[i]->mw_evaluateDerivatives(convert_ref_to_ptr_list(wfc_list),
+                                                           convert_ref_to_ptr_list(p_list), optvars, dlogpsi_ptr_list,
+                                                           dhpsioverpsi_ptr_list);
+    }
+    //orbitals do not know about mass of particle.
+    for (int iw = 0; iw < num_walkers; iw++)
+    {
+      const RealType one_over_m = wf_list[iw].get().OneOverM;
+      for (ValueType& dhpsi : dhpsioverpsi_list[iw])
+        dhpsi *= one_over_m;
+    }
+  }
+  else if (wf_list.size() == 1)
+    wf_list[0].get().evaluateDerivatives(p_list[0], optvars, dlogpsi_list[0], dhpsioverpsi_list[0]);
+}
+
 void TrialWaveFunction::evaluateDerivativesWF(ParticleSet& P,
                                               const opt_variables_type& optvars,
                                               std::vector<ValueType>& dlogpsi)
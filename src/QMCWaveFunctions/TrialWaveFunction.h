@@ -288,6 +288,17 @@ public:
                            std::vector<ValueType>& dhpsioverpsi,
                            bool project = false);
 
+  /** batched version of evaluateDerivatives
+   *
+   *  dlogpsi_list and dhpsioverpsi_list hold one derivative vector per walker,
+   *  they are scratch of the crowd to be reduced by the caller before the next call.
+   */
+  static void flex_evaluateDerivatives(const RefVector<TrialWaveFunction>& wf_list,
+                                       const RefVector<ParticleSet>& p_list,
+                                       const opt_variables_type& optvars,
+                                       std::vector<std::vector<ValueType>>& dlogpsi_list,
+                                       std::vector<std::vector<ValueType>>& dhpsioverpsi_list);
+
   void evaluateDerivativesWF(ParticleSet& P, const opt_variables_type& optvars, std::vector<ValueType>& dlogpsi);
 
   void evaluateGradDerivatives(const ParticleSet::ParticleGradient_t& G_in, std::vector<ValueType>& dgradlogpsi);
@@ -329,6 +340,18 @@ private:
   ///starting index of the scalar buffer
   size_t BufferCursor_scalar;
 
+  ///end index of the buffer, other wavefunctions may follow in the same buffer
+  size_t BufferEnd;
+
+  ///end index of the scalar buffer
+  size_t BufferEnd_scalar;
+
+  ///true if the cursors of buf are at the end of the data registered by this wavefunction
+  inline bool atBufferEnd(const WFBufferType& buf) const
+  {
+    return buf.current() == BufferEnd && buf.current_scalar() == BufferEnd_scalar;
+  }
+
   ///sign of the trial wave function
   RealType PhaseValue;
 
@@ -561,6 +561,24 @@ struct WaveFunctionComponent : public QMCTraits
                                    std::vector<ValueType>& dlogpsi,
                                    std::vector<ValueType>& dhpsioverpsi);
 
+  /** compute the derivatives of the wavefunctions of a walker batch with respect to the optimizable parameters
+   *  @param WFC_list the list of WaveFunctionComponent pointers of the same component in a walker batch
+   *  @param P_list the list of ParticleSet pointers in a walker batch
+   *  @param optvars optimizable parameters
+   *  @param dlogpsi_list the list of the derivatives of the log of the wavefunctions
+   *  @param dhpsioverpsi_list the list of the derivatives of the Laplacian of the wavefunctions divided by the wavefunctions
+   */
+  virtual void mw_evaluateDerivatives(const std::vector<WaveFunctionComponent*>& WFC_list,
+                                      const std::vector<ParticleSet*>& P_list,
+                                      const opt_variables_type& optvars,
+                                      const std::vector<std::vector<ValueType>*>& dlogpsi_list,
+                                      const std::vector<std::vector<ValueType>*>& dhpsioverpsi_list)
+  {
+#pragma omp parallel for
+    for (int iw = 0; iw < WFC_list.size(); iw++)
+      WFC_list[iw]->evaluateDerivatives(*P_list[iw], optvars, *dlogpsi_list[iw], *dhpsioverpsi_list[iw]);
+  }
+
   /** Compute derivatives of rhe wavefunction with respect to the optimizable 
    *  parameters
    *  @param P particle set
@@ -339,6 +339,30 @@ TEST_CASE("TrialWaveFunction", "[wavefunction]")
   REQUIRE(grad_old[1][2] == Approx(4.8529516184558));
 #endif
 
+  opt_variables_type active;
+  psi.checkInVariables(active);
+  active.resetIndex();
+  psi.checkOutVariables(active);
+  psi_clone->checkOutVariables(active);
+  const int num_params = active.size();
+  REQUIRE(num_params == 10);
+
+  elec_.update();
+  elec_clone.update();
+  std::vector<std::vector<ValueType>> dlogpsi(2, std::vector<ValueType>(num_params, 0.0));
+  std::vector<std::vector<ValueType>> dhpsioverpsi(2, std::vector<ValueType>(num_params, 0.0));
+  for (int iw = 0; iw < 2; iw++)
+    WF_list[iw]->evaluateDerivatives(*P_list[iw], active, dlogpsi[iw], dhpsioverpsi[iw]);
+
+  std::vector<std::vector<ValueType>> dlogpsi_list(2, std::vector<ValueType>(num_params, 0.0));
+  std::vector<std::vector<ValueType>> dhpsioverpsi_list(2, std::vector<ValueType>(num_params, 0.0));
+  TrialWaveFunction::flex_evaluateDerivatives(wf_ref_list, p_ref_list, active, dlogpsi_list, dhpsioverpsi_list);
+  for (int iw = 0; iw < 2; iw++)
+    for (int i = 0; i < num_params; i++)
+    {
+      REQUIRE(dlogpsi_list[iw][i] == ValueApprox(dlogpsi[iw][i]));
+      REQUIRE(dhpsioverpsi_list[iw][i] == ValueApprox(dhpsioverpsi[iw][i]));
+    }
 
   //FIXME more thinking and fix about ownership and schope are needed for exiting clean
   delete psi_clone;
@@ -0,0 +1,213 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "OhmmsData/Libxml2Doc.h"
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "QMCWaveFunctions/SPOSet.h"
+#include "QMCWaveFunctions/Fermion/BackflowBuilder.h"
+#include "QMCWaveFunctions/Fermion/DiracDeterminantWithBackflow.h"
+
+#include <stdio.h>
+#include <string>
+
+using std::string;
+
+namespace qmcplusplus
+{
+typedef QMCTraits::RealType RealType;
+typedef QMCTraits::ValueType ValueType;
+typedef QMCTraits::PosType PosType;
+
+/** orbitals phi_k(r) = exp(a_k.r) with analytic gradients and hessians
+ */
+class ExpSPO : public SPOSet
+{
+public:
+  std::vector<PosType> a;
+
+  ExpSPO()
+  {
+    className = "ExpSPO";
+    a.resize(4);
+    a[0] = PosType(0.0, 0.0, 0.0);
+    a[1] = PosType(0.5, 0.0, -0.2);
+    a[2] = PosType(0.0, 0.4, 0.1);
+    a[3] = PosType(0.2, -0.3, 0.5);
+    OrbitalSetSize = a.size();
+  }
+
+  virtual void resetParameters(const opt_variables_type& optVariables) {}
+  virtual void resetTargetParticleSet(ParticleSet& P) {}
+  virtual void setOrbitalSetSize(int norbs) {}
+
+  virtual void evaluate(const ParticleSet& P, int iat, ValueVector_t& psi)
+  {
+    const PosType& r = P.activeR(iat);
+    for (int k = 0; k < OrbitalSetSize; k++)
+      psi[k] = std::exp(dot(a[k], r));
+  }
+
+  virtual void evaluate(const ParticleSet& P, int iat, ValueVector_t& psi, GradVector_t& dpsi, ValueVector_t& d2psi)
+  {
+    const PosType& r = P.activeR(iat);
+    for (int k = 0; k < OrbitalSetSize; k++)
+    {
+      RealType phi = std::exp(dot(a[k], r));
+      psi[k]       = phi;
+      dpsi[k]      = phi * a[k];
+      d2psi[k]     = phi * dot(a[k], a[k]);
+    }
+  }
+
+  virtual void evaluate_notranspose(const ParticleSet& P,
+                                    int first,
+                                    int last,
+                                    ValueMatrix_t& logdet,
+                                    GradMatrix_t& dlogdet,
+                                    ValueMatrix_t& d2logdet)
+  {
+    for (int iat = first, i = 0; iat < last; iat++, i++)
+      for (int k = 0; k < OrbitalSetSize; k++)
+      {
+        RealType phi   = std::exp(dot(a[k], P.R[iat]));
+        logdet(i, k)   = phi;
+        dlogdet(i, k)  = phi * a[k];
+        d2logdet(i, k) = phi * dot(a[k], a[k]);
+      }
+  }
+
+  virtual void evaluate_notranspose(const ParticleSet& P,
+                                    int first,
+                                    int last,
+                                    ValueMatrix_t& logdet,
+                                    GradMatrix_t& dlogdet,
+                                    HessMatrix_t& grad_grad_logdet)
+  {
+    for (int iat = first, i = 0; iat < last; iat++, i++)
+      for (int k = 0; k < OrbitalSetSize; k++)
+      {
+        RealType phi  = std::exp(dot(a[k], P.R[iat]));
+        logdet(i, k)  = phi;
+        dlogdet(i, k) = phi * a[k];
+        for (int x = 0; x < OHMMS_DIM; x++)
+          for (int y = 0; y < OHMMS_DIM; y++)
+            grad_grad_logdet(i, k)(x, y) = phi * a[k][x] * a[k][y];
+      }
+  }
+};
+
+TEST_CASE("DiracDeterminantWithBackflow lowrank update", "[wavefunction][fermion]")
+{
+  Communicate* c;
+  OHMMS::Controller->initialize(0, NULL);
+  c = OHMMS::Controller;
+
+  ParticleSet elec;
+  std::vector<int> agroup(1, 4);
+  elec.setName("e");
+  elec.create(agroup);
+  elec.R[0] = PosType(0.1, 0.2, 0.0);
+  elec.R[1] = PosType(0.9, -0.1, 0.3);
+  elec.R[2] = PosType(3.0, 0.4, -0.2);
+  elec.R[3] = PosType(3.2, 1.3, 0.5);
+
+  SpeciesSet& tspecies       = elec.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int chargeIdx              = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx) = -1;
+  elec.resetGroups();
+
+  std::map<string, ParticleSet*> pool;
+  pool["e"] = &elec;
+  TrialWaveFunction psi(c);
+
+  // short ranged e-e backflow, a move of electron 0 displaces quasiparticles 0 and 1 only
+  const char* xmltext = "<tmp> \
+<backflow update=\"lowrank\"> \
+  <transformation name=\"eeB\" type=\"e-e\" function=\"Bspline\"> \
+    <correlation cusp=\"0.0\" size=\"4\" type=\"shortrange\" init=\"no\" speciesA=\"u\" speciesB=\"u\" rcut=\"1.5\"> \
+      <coefficients id=\"uuB\" type=\"Array\" optimize=\"no\"> 0.2 0.1 0.05 0.02 </coefficients> \
+    </correlation> \
+  </transformation> \
+</backflow> \
+</tmp> \
+";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(xmltext);
+  REQUIRE(okay);
+  xmlNodePtr bf_node = xmlFirstElementChild(doc.getRoot());
+
+  BackflowBuilder bfbuilder(elec, pool, psi);
+  bfbuilder.put(bf_node);
+  BackflowTransformation* BFTrans = bfbuilder.getBFTrans();
+  REQUIRE(BFTrans->lowRankUpdate);
+
+  ExpSPO spo;
+  DiracDeterminantWithBackflow det(elec, &spo, BFTrans);
+  det.set(0, 4);
+
+  elec.update();
+  elec.G = 0.0;
+  elec.L = 0.0;
+  WaveFunctionComponent::WFBufferType buf;
+  BFTrans->registerData(elec, buf);
+  det.registerData(elec, buf);
+
+  PosType dr(0.15, -0.1, 0.05);
+  elec.makeMove(0, dr);
+
+  BFTrans->evaluatePbyPWithGrad(elec, 0);
+  REQUIRE(BFTrans->indexQP.size() == 2);
+
+  DiracDeterminantWithBackflow::GradType grad_lowrank(0.0);
+  ValueType ratio_lowrank = det.ratioGrad(elec, 0, grad_lowrank);
+  REQUIRE(det.LowRankMove);
+
+  BFTrans->lowRankUpdate = false;
+  DiracDeterminantWithBackflow::GradType grad_full(0.0);
+  ValueType ratio_full = det.ratioGrad(elec, 0, grad_full);
+  REQUIRE(!det.LowRankMove);
+
+  REQUIRE(ratio_lowrank == ValueApprox(ratio_full));
+  for (int idim = 0; idim < OHMMS_DIM; idim++)
+    REQUIRE(grad_lowrank[idim] == ValueApprox(grad_full[idim]));
+
+  // ratio only, the inverse is updated when the move is accepted
+  BFTrans->lowRankUpdate = true;
+  BFTrans->evaluatePbyP(elec, 0);
+  ValueType ratio_only = det.ratio(elec, 0);
+  REQUIRE(ratio_only == ValueApprox(ratio_full));
+
+  det.acceptMove(elec, 0);
+  BFTrans->acceptMove(elec, 0);
+  elec.acceptMove(0);
+
+  DiracDeterminantWithBackflow::ValueMatrix_t psiMinv_lowrank(det.psiMinv);
+  RealType logpsi_lowrank = det.LogValue;
+
+  ParticleSet::ParticleGradient_t G(elec.getTotalNum());
+  ParticleSet::ParticleLaplacian_t L(elec.getTotalNum());
+  elec.update();
+  BFTrans->evaluate(elec);
+  RealType logpsi_ref = det.evaluateLog(elec, G, L);
+
+  REQUIRE(logpsi_lowrank == Approx(logpsi_ref));
+  for (int i = 0; i < psiMinv_lowrank.rows(); i++)
+    for (int j = 0; j < psiMinv_lowrank.cols(); j++)
+      REQUIRE(psiMinv_lowrank(i, j) == ValueApprox(det.psiMinv(i, j)));
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "QMCWaveFunctions/BsplineFactory/DistributedMultiBspline.h"
+#include <random>
+#include <cmath>
+#include <limits>
+
+namespace qmcplusplus
+{
+/** rebuild the stencils of a table by MPI_Get on a window of a single rank
+ *
+ * The stencils fetched by DistributedMultiBspline from the other ranks of a band
+ * group must evaluate to the same values as the full table.
+ */
+template<typename T>
+void test_remote_stencil()
+{
+  using SplineType = typename bspline_traits<T, 3>::SplineType;
+  const int N      = 6;
+  const int npad   = getAlignedSize<T>(5);
+
+  BCtype_d bc[3];
+  Ugrid grid[3];
+  for (int d = 0; d < 3; d++)
+  {
+    grid[d].start = 0.0;
+    grid[d].end   = 1.0;
+    grid[d].num   = N;
+    bc[d].lCode   = PERIODIC;
+    bc[d].rCode   = PERIODIC;
+    bc[d].lVal    = 0.0;
+    bc[d].rVal    = 0.0;
+  }
+
+  MultiBspline<T> table;
+  table.create(grid, bc, npad);
+  SplineType* spline_m = table.getSplinePtr();
+  std::mt19937 rng(23);
+  std::uniform_real_distribution<T> u(-1.0, 1.0);
+  for (size_t i = 0; i < spline_m->coefs_size; i++)
+    spline_m->coefs[i] = u(rng);
+
+  MPI_Win win;
+  MPI_Win_create(spline_m->coefs, spline_m->coefs_size * sizeof(T), sizeof(T), MPI_INFO_NULL, MPI_COMM_SELF, &win);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+  // the origin of a stencil is rounded to the precision of the spline
+  const double eps = std::sqrt(std::numeric_limits<T>::epsilon());
+  std::uniform_real_distribution<T> upos(0.0, 1.0);
+  aligned_vector<T> buffer(64 * npad);
+  SplineType stencil;
+  for (int ip = 0; ip < 8; ip++)
+  {
+    const T x = upos(rng), y = upos(rng), z = upos(rng);
+    int ix, iy, iz;
+    T a[4], b[4], c[4];
+    spline2::computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c);
+    DistributedMultiBspline<T>::get_stencil(win, 0, spline_m, ix, iy, iz, npad, buffer.data(), stencil);
+    MPI_Win_flush_all(win);
+
+    aligned_vector<T> v_ref(npad), v(npad);
+    spline2::evaluate_v_impl(spline_m, x, y, z, v_ref.data(), 0, npad);
+    spline2::evaluate_v_impl(&stencil, x, y, z, v.data(), 0, npad);
+    for (int i = 0; i < npad; i++)
+      REQUIRE(v[i] == Approx(v_ref[i]).margin(eps));
+
+    // the laplacians are in the first third of the buffers
+    aligned_vector<T> g_ref(3 * npad), g(3 * npad), l_ref(3 * npad), l(3 * npad);
+    spline2::evaluate_vgl_impl(spline_m, x, y, z, v_ref.data(), g_ref.data(), l_ref.data(), npad, 0, npad);
+    spline2::evaluate_vgl_impl(&stencil, x, y, z, v.data(), g.data(), l.data(), npad, 0, npad);
+    for (int i = 0; i < npad; i++)
+    {
+      REQUIRE(v[i] == Approx(v_ref[i]).margin(eps));
+      REQUIRE(l[i] == Approx(l_ref[i]).margin(eps));
+    }
+    for (int i = 0; i < 3 * npad; i++)
+      REQUIRE(g[i] == Approx(g_ref[i]).margin(eps));
+  }
+
+  MPI_Win_unlock_all(win);
+  MPI_Win_free(&win);
+}
+
+TEST_CASE("DistributedMultiBspline remote stencil double", "[wavefunction]") { test_remote_stencil<double>(); }
+
+TEST_CASE("DistributedMultiBspline remote stencil float", "[wavefunction]") { test_remote_stencil<float>(); }
+
+} // namespace qmcplusplus
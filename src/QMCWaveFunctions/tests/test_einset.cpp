@@ -21,6 +21,7 @@
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "QMCWaveFunctions/TrialWaveFunction.h"
 #include "QMCWaveFunctions/EinsplineSetBuilder.h"
+#include "QMCWaveFunctions/BsplineFactory/SyntheticSplineSetBuilder.h"
 
 
 #include <stdio.h>
@@ -293,4 +294,77 @@ TEST_CASE("EinsplineSetBuilder CheckLattice", "[wavefunction]")
   esb.SuperLattice(0, 0) = 1.1;
   REQUIRE_FALSE(esb.CheckLattice());
 }
+
+TEST_CASE("SyntheticSplineSetBuilder periodic random orbitals", "[wavefunction]")
+{
+  Communicate* c;
+  OHMMS::Controller->initialize(0, NULL);
+  c = OHMMS::Controller;
+
+  ParticleSet elec_;
+  elec_.setName("elec");
+  std::vector<int> ud{2, 1};
+  elec_.create(ud);
+  elec_.Lattice.R(0, 0) = 3.37316115;
+  elec_.Lattice.R(0, 1) = 3.37316115;
+  elec_.Lattice.R(0, 2) = 0.0;
+  elec_.Lattice.R(1, 0) = 0.0;
+  elec_.Lattice.R(1, 1) = 3.37316115;
+  elec_.Lattice.R(1, 2) = 3.37316115;
+  elec_.Lattice.R(2, 0) = 3.37316115;
+  elec_.Lattice.R(2, 1) = 0.0;
+  elec_.Lattice.R(2, 2) = 3.37316115;
+  elec_.Lattice.reset();
+
+  // the same point and two of its periodic images
+  elec_.R[0] = {0.1, 0.2, 0.3};
+  elec_.R[1] = elec_.R[0] + elec_.Lattice.a(0);
+  elec_.R[2] = elec_.R[0] - elec_.Lattice.a(1) + elec_.Lattice.a(2);
+
+  SpeciesSet& tspecies         = elec_.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  elec_.resetGroups();
+
+  const char* particles = "<tmp> \
+<sposet_builder type=\"synthetic\" spacing=\"0.5\" seed=\"5\"> \
+  <sposet name=\"spo\"/> \
+</sposet_builder> \
+</tmp> \
+";
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(particles);
+  REQUIRE(okay);
+  xmlNodePtr ein1    = xmlFirstElementChild(doc.getRoot());
+  xmlNodePtr sposet1 = xmlFirstElementChild(ein1);
+
+  SyntheticSplineSetBuilder builder(elec_, c, ein1);
+  std::unique_ptr<SPOSet> spo(builder.createSPOSetFromXML(sposet1));
+  REQUIRE(spo != nullptr);
+  // the size defaults to the largest group
+  REQUIRE(spo->getOrbitalSetSize() == 2);
+
+  SPOSet::ValueVector_t psi0(2), psi1(2), psi2(2);
+  spo->evaluate(elec_, 0, psi0);
+  spo->evaluate(elec_, 1, psi1);
+  spo->evaluate(elec_, 2, psi2);
+  for (int i = 0; i < 2; i++)
+  {
+    REQUIRE(std::abs(psi0[i]) > 0.0);
+    REQUIRE(std::real(psi1[i]) == Approx(std::real(psi0[i])));
+    REQUIRE(std::real(psi2[i]) == Approx(std::real(psi0[i])));
+  }
+
+  // the orbitals only depend on the seed
+  SyntheticSplineSetBuilder builder2(elec_, c, ein1);
+  std::unique_ptr<SPOSet> spo2(builder2.createSPOSetFromXML(sposet1));
+  SPOSet::ValueVector_t psi_again(2);
+  spo2->evaluate(elec_, 0, psi_again);
+  for (int i = 0; i < 2; i++)
+    REQUIRE(std::real(psi_again[i]) == Approx(std::real(psi0[i])));
+}
 } // namespace qmcplusplus
@@ -25,6 +25,7 @@
 #include <complex>
 #include <limits>
 #include <iterator>
+#include <utility>
 
 template<class T>
 struct PooledData
@@ -79,6 +80,12 @@ struct PooledData
     myData.resize(n, val);
     Current = 0;
   }
+  ///exchange the data and the cursor with another buffer
+  inline void swap(PooledData<T>& other)
+  {
+    myData.swap(other.myData);
+    std::swap(Current, other.Current);
+  }
   ///return i-th value
   inline T operator[](size_type i) const { return myData[i]; }
   ///return i-th value to assign
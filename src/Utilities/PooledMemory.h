@@ -147,6 +147,11 @@ struct PooledMemory
     Current += getAlignedSize<T>(nbytes);
   }
 
+  /** lend the storage of n T1 at the cursor and move the cursor past it
+   *
+   *  The SoA determinants and Jastrows keep their arrays in the buffer this way and step over them
+   *  with forward in updateBuffer and copyFromBuffer, so their arrays are never copied by put or get.
+   */
   template<typename T1>
   inline T1* lendReference(size_type n)
   {
@@ -899,7 +899,7 @@ void cqmc::engine::LMYEngine::shift_update(std::vector<double> & new_shift) {
 
 
 //Transfers the vectors from descent to the engine's LMBlocker object during the hybrid method.
-void cqmc::engine::LMYEngine::setHybridBLM_Input(std::vector< std::vector<double>>& from_descent) 
+void cqmc::engine::LMYEngine::setHybridBLM_Input(const std::vector< std::vector<double>>& from_descent) 
 {
 
     //Change the LMBlocker object's hybrid variable to true so input vectors will be used later on
@@ -908,7 +908,7 @@ void cqmc::engine::LMYEngine::setHybridBLM_Input(std::vector< std::vector<double
     //Clear to avoid retaining old sets of vectors
     _lmb.getInputVector().clear();
     
-    for (std::vector<double> v : from_descent)
+    for (const std::vector<double>& v : from_descent)
     {
 
 	_lmb.getInputVector().push_back(v);
@@ -0,0 +1,214 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineCompressed.hpp
+ *
+ * define class MultiBsplineCompressed, 3D multi splines with 16-bit coefficients
+ *
+ * The coefficients of each spline are divided by the largest magnitude of that
+ * spline and stored as bfloat16 or IEEE half precision numbers. The evaluation
+ * functions in MultiBsplineCompressedEval.hpp decode them on the fly and apply
+ * the per-spline scale to the results. The table takes half the memory of a
+ * single precision one.
+ */
+#ifndef QMCPLUSPLUS_MULTIEINSPLINE_COMPRESSED_HPP
+#define QMCPLUSPLUS_MULTIEINSPLINE_COMPRESSED_HPP
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include "config.h"
+#include "simd/Mallocator.hpp"
+#include "spline2/bspline_traits.hpp"
+
+namespace spline2
+{
+/// storage formats of compressed coefficients
+enum class CoefsFormat
+{
+  BF16,
+  FP16
+};
+
+/// bfloat16, the upper 16 bits of an IEEE single precision number
+struct bf16_codec
+{
+  static inline uint16_t encode(float x)
+  {
+    uint32_t u;
+    std::memcpy(&u, &x, sizeof(u));
+    // round to nearest even
+    u += 0x7fffu + ((u >> 16) & 1u);
+    return static_cast<uint16_t>(u >> 16);
+  }
+
+  static inline float decode(uint16_t h)
+  {
+    const uint32_t u = static_cast<uint32_t>(h) << 16;
+    float x;
+    std::memcpy(&x, &u, sizeof(x));
+    return x;
+  }
+};
+
+/** IEEE half precision
+ *
+ * Subnormals are flushed to zero and overflows saturate, scaled coefficients
+ * are within [-1,1] and never get close to the overflow.
+ */
+struct fp16_codec
+{
+  static inline uint16_t encode(float x)
+  {
+    uint32_t u;
+    std::memcpy(&u, &x, sizeof(u));
+    const uint32_t sign = (u >> 16) & 0x8000u;
+    const int exponent  = static_cast<int>((u >> 23) & 0xffu) - 127 + 15;
+    const uint32_t mant = u & 0x7fffffu;
+    if (exponent <= 0)
+      return static_cast<uint16_t>(sign);
+    if (exponent >= 31)
+      return static_cast<uint16_t>(sign | 0x7bffu);
+    uint32_t h         = (static_cast<uint32_t>(exponent) << 10) | (mant >> 13);
+    const uint32_t rem = mant & 0x1fffu;
+    // round to nearest even, a carry into the exponent is the correct result
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u)))
+      h++;
+    return static_cast<uint16_t>(sign | std::min(h, 0x7bffu));
+  }
+
+  static inline float decode(uint16_t h)
+  {
+    const uint32_t e = h & 0x7c00u;
+    const uint32_t u = (static_cast<uint32_t>(h & 0x8000u) << 16) |
+        (e ? ((static_cast<uint32_t>(h & 0x7fffu) << 13) + ((127u - 15u) << 23)) : 0u);
+    float x;
+    std::memcpy(&x, &u, sizeof(x));
+    return x;
+  }
+};
+
+/** multi_UBspline_3d_s/d counterpart with 16-bit coefficients
+ *
+ * The coefficient layout and the strides are the same as the source table.
+ */
+struct multi_UBspline_3d_compressed
+{
+  CoefsFormat format;
+  uint16_t* restrict coefs;
+  /// largest coefficient magnitude of each spline
+  float* restrict scales;
+  intptr_t x_stride, y_stride, z_stride;
+  Ugrid x_grid, y_grid, z_grid;
+  int num_splines;
+  size_t coefs_size;
+};
+
+} // namespace spline2
+
+namespace qmcplusplus
+{
+/** container class of a compressed 3D multi spline
+ * @tparam ALIGN the alignment of the orbital dimension
+ *
+ * The table is built from a populated MultiBspline table by compress.
+ */
+template<size_t ALIGN = QMC_CLINE>
+class MultiBsplineCompressed
+{
+private:
+  using SplineType = spline2::multi_UBspline_3d_compressed;
+  SplineType spline_c;
+  std::vector<uint16_t, Mallocator<uint16_t, ALIGN>> coefs;
+  std::vector<float, Mallocator<float, ALIGN>> scales;
+
+  template<typename CODEC, typename ST>
+  double encode(const ST* restrict source, size_t npoints, int num_valid)
+  {
+    const intptr_t zs = spline_c.z_stride;
+    double max_error  = 0.0;
+#pragma omp parallel for reduction(max : max_error)
+    for (size_t ig = 0; ig < npoints; ig++)
+    {
+      const ST* restrict src = source + ig * zs;
+      uint16_t* restrict dst = coefs.data() + ig * zs;
+      for (int n = 0; n < spline_c.num_splines; n++)
+        dst[n] = CODEC::encode(static_cast<float>(src[n] / scales[n]));
+      // validation against the source table, the padded splines are skipped
+      for (int n = 0; n < num_valid; n++)
+        max_error = std::max(max_error, std::abs(static_cast<double>(CODEC::decode(dst[n])) * scales[n] - src[n]));
+    }
+    return max_error;
+  }
+
+public:
+  MultiBsplineCompressed() { spline_c.coefs = nullptr; }
+  MultiBsplineCompressed(const MultiBsplineCompressed& in) = delete;
+  MultiBsplineCompressed& operator=(const MultiBsplineCompressed& in) = delete;
+
+  SplineType* getSplinePtr() { return spline_c.coefs == nullptr ? nullptr : &spline_c; }
+
+  /** compress a populated single or double precision table
+   * @param source multi spline table
+   * @param num_valid number of splines holding orbitals, the rest is padding
+   * @param format storage format of the coefficients
+   * @return the largest absolute error of the compressed coefficients
+   *
+   * The B-spline weights are positive and sum to one, the returned value is
+   * an upper bound of the error of orbital values over the whole cell.
+   */
+  template<typename SplineT>
+  double compress(const SplineT* source, int num_valid, spline2::CoefsFormat format)
+  {
+    if (source == nullptr)
+      throw std::runtime_error("MultiBsplineCompressed::compress needs a populated source table!\n");
+    spline_c.format      = format;
+    spline_c.x_stride    = source->x_stride;
+    spline_c.y_stride    = source->y_stride;
+    spline_c.z_stride    = source->z_stride;
+    spline_c.x_grid      = source->x_grid;
+    spline_c.y_grid      = source->y_grid;
+    spline_c.z_grid      = source->z_grid;
+    spline_c.num_splines = source->num_splines;
+    spline_c.coefs_size  = source->coefs_size;
+
+    coefs.resize(spline_c.coefs_size);
+    scales.resize(spline_c.num_splines);
+    spline_c.coefs  = coefs.data();
+    spline_c.scales = scales.data();
+
+    const size_t npoints = spline_c.coefs_size / spline_c.z_stride;
+    std::vector<double> cmax(spline_c.num_splines, 0.0);
+    for (size_t ig = 0; ig < npoints; ig++)
+      for (int n = 0; n < spline_c.num_splines; n++)
+        cmax[n] = std::max(cmax[n], static_cast<double>(std::abs(source->coefs[ig * spline_c.z_stride + n])));
+    for (int n = 0; n < spline_c.num_splines; n++)
+      scales[n] = cmax[n] > 0.0 ? static_cast<float>(cmax[n]) : 1.0f;
+
+    if (format == spline2::CoefsFormat::BF16)
+      return encode<spline2::bf16_codec>(source->coefs, npoints, num_valid);
+    else
+      return encode<spline2::fp16_codec>(source->coefs, npoints, num_valid);
+  }
+
+  int num_splines() const { return (spline_c.coefs == nullptr) ? 0 : spline_c.num_splines; }
+
+  size_t sizeInByte() const
+  {
+    return (spline_c.coefs == nullptr) ? 0 : spline_c.coefs_size * sizeof(uint16_t) + scales.size() * sizeof(float);
+  }
+};
+
+} // namespace qmcplusplus
+
+#endif
@@ -0,0 +1,400 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineCompressedEval.hpp
+ *
+ * evaluate_v/vgl/vgh_impl overloads for multi_UBspline_3d_compressed
+ *
+ * The 16-bit coefficients are decoded into single precision registers and
+ * accumulated in the precision of the result arrays. The per-spline scales are
+ * applied once to the accumulated results since the evaluation is linear in
+ * the coefficients. Halving the bytes per coefficient halves the memory
+ * traffic of these bandwidth bound kernels.
+ */
+#ifndef SPLINE2_MULTIEINSPLINE_COMPRESSED_EVAL_HPP
+#define SPLINE2_MULTIEINSPLINE_COMPRESSED_EVAL_HPP
+
+#include <algorithm>
+#include <spline2/MultiBsplineCompressed.hpp>
+
+namespace spline2
+{
+template<typename T>
+inline void computeLocationAndFractional(const multi_UBspline_3d_compressed* restrict spline_m,
+                                         T x,
+                                         T y,
+                                         T z,
+                                         int& ix,
+                                         int& iy,
+                                         int& iz,
+                                         T a[4],
+                                         T b[4],
+                                         T c[4])
+{
+  T tx, ty, tz;
+  getSplineBound((x - spline_m->x_grid.start) * spline_m->x_grid.delta_inv, tx, ix, spline_m->x_grid.num - 1);
+  getSplineBound((y - spline_m->y_grid.start) * spline_m->y_grid.delta_inv, ty, iy, spline_m->y_grid.num - 1);
+  getSplineBound((z - spline_m->z_grid.start) * spline_m->z_grid.delta_inv, tz, iz, spline_m->z_grid.num - 1);
+
+  MultiBsplineData<T>::compute_prefactors(a, tx);
+  MultiBsplineData<T>::compute_prefactors(b, ty);
+  MultiBsplineData<T>::compute_prefactors(c, tz);
+}
+
+template<typename T>
+inline void computeLocationAndFractional(const multi_UBspline_3d_compressed* restrict spline_m,
+                                         T x,
+                                         T y,
+                                         T z,
+                                         int& ix,
+                                         int& iy,
+                                         int& iz,
+                                         T a[4],
+                                         T b[4],
+                                         T c[4],
+                                         T da[4],
+                                         T db[4],
+                                         T dc[4],
+                                         T d2a[4],
+                                         T d2b[4],
+                                         T d2c[4])
+{
+  T tx, ty, tz;
+  getSplineBound((x - spline_m->x_grid.start) * spline_m->x_grid.delta_inv, tx, ix, spline_m->x_grid.num - 1);
+  getSplineBound((y - spline_m->y_grid.start) * spline_m->y_grid.delta_inv, ty, iy, spline_m->y_grid.num - 1);
+  getSplineBound((z - spline_m->z_grid.start) * spline_m->z_grid.delta_inv, tz, iz, spline_m->z_grid.num - 1);
+
+  MultiBsplineData<T>::compute_prefactors(a, da, d2a, tx);
+  MultiBsplineData<T>::compute_prefactors(b, db, d2b, ty);
+  MultiBsplineData<T>::compute_prefactors(c, dc, d2c, tz);
+}
+
+template<typename CODEC, typename T>
+inline void evaluate_v_compressed_impl(const multi_UBspline_3d_compressed* restrict spline_m,
+                                       T x,
+                                       T y,
+                                       T z,
+                                       T* restrict vals,
+                                       int first,
+                                       int last)
+{
+  int ix, iy, iz;
+  T a[4], b[4], c[4];
+
+  computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  const int num_splines = last - first;
+  std::fill(vals, vals + num_splines, T());
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const T pre00                     = a[i] * b[j];
+      const uint16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const uint16_t* restrict coefszs  = coefs + zs;
+      const uint16_t* restrict coefs2zs = coefs + 2 * zs;
+      const uint16_t* restrict coefs3zs = coefs + 3 * zs;
+#pragma omp simd aligned(vals)
+      for (int n = 0; n < num_splines; n++)
+        vals[n] += pre00 *
+            (c[0] * CODEC::decode(coefs[n]) + c[1] * CODEC::decode(coefszs[n]) + c[2] * CODEC::decode(coefs2zs[n]) +
+             c[3] * CODEC::decode(coefs3zs[n]));
+    }
+
+  const float* restrict scales = spline_m->scales + first;
+#pragma omp simd aligned(vals)
+  for (int n = 0; n < num_splines; n++)
+    vals[n] *= scales[n];
+}
+
+template<typename CODEC, typename T>
+inline void evaluate_vgl_compressed_impl(const multi_UBspline_3d_compressed* restrict spline_m,
+                                         T x,
+                                         T y,
+                                         T z,
+                                         T* restrict vals,
+                                         T* restrict grads,
+                                         T* restrict lapl,
+                                         size_t out_offset,
+                                         int first,
+                                         int last)
+{
+  int ix, iy, iz;
+  T a[4], b[4], c[4], da[4], db[4], dc[4], d2a[4], d2b[4], d2c[4];
+
+  computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c, da, db, dc, d2a, d2b, d2c);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  const int num_splines = last - first;
+
+  T* restrict gx = grads;
+  T* restrict gy = grads + out_offset;
+  T* restrict gz = grads + 2 * out_offset;
+  T* restrict lx = lapl;
+  T* restrict ly = lapl + out_offset;
+  T* restrict lz = lapl + 2 * out_offset;
+
+  std::fill(vals, vals + num_splines, T());
+  std::fill(gx, gx + num_splines, T());
+  std::fill(gy, gy + num_splines, T());
+  std::fill(gz, gz + num_splines, T());
+  std::fill(lx, lx + num_splines, T());
+  std::fill(ly, ly + num_splines, T());
+  std::fill(lz, lz + num_splines, T());
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const T pre20 = d2a[i] * b[j];
+      const T pre10 = da[i] * b[j];
+      const T pre00 = a[i] * b[j];
+      const T pre01 = a[i] * db[j];
+      const T pre02 = a[i] * d2b[j];
+
+      const uint16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const uint16_t* restrict coefszs  = coefs + zs;
+      const uint16_t* restrict coefs2zs = coefs + 2 * zs;
+      const uint16_t* restrict coefs3zs = coefs + 3 * zs;
+
+#pragma omp simd aligned(gx, gy, gz, lx, ly, lz, vals)
+      for (int n = 0; n < num_splines; n++)
+      {
+        const float coefsv    = CODEC::decode(coefs[n]);
+        const float coefsvzs  = CODEC::decode(coefszs[n]);
+        const float coefsv2zs = CODEC::decode(coefs2zs[n]);
+        const float coefsv3zs = CODEC::decode(coefs3zs[n]);
+
+        T sum0 = c[0] * coefsv + c[1] * coefsvzs + c[2] * coefsv2zs + c[3] * coefsv3zs;
+        T sum1 = dc[0] * coefsv + dc[1] * coefsvzs + dc[2] * coefsv2zs + dc[3] * coefsv3zs;
+        T sum2 = d2c[0] * coefsv + d2c[1] * coefsvzs + d2c[2] * coefsv2zs + d2c[3] * coefsv3zs;
+        gx[n] += pre10 * sum0;
+        gy[n] += pre01 * sum0;
+        gz[n] += pre00 * sum1;
+        lx[n] += pre20 * sum0;
+        ly[n] += pre02 * sum0;
+        lz[n] += pre00 * sum2;
+        vals[n] += pre00 * sum0;
+      }
+    }
+
+  const T dxInv = spline_m->x_grid.delta_inv;
+  const T dyInv = spline_m->y_grid.delta_inv;
+  const T dzInv = spline_m->z_grid.delta_inv;
+
+  const T dxInv2 = dxInv * dxInv;
+  const T dyInv2 = dyInv * dyInv;
+  const T dzInv2 = dzInv * dzInv;
+
+  const float* restrict scales = spline_m->scales + first;
+#pragma omp simd aligned(gx, gy, gz, lx, vals)
+  for (int n = 0; n < num_splines; n++)
+  {
+    const T s = scales[n];
+    vals[n] *= s;
+    gx[n] *= dxInv * s;
+    gy[n] *= dyInv * s;
+    gz[n] *= dzInv * s;
+    lx[n] = (lx[n] * dxInv2 + ly[n] * dyInv2 + lz[n] * dzInv2) * s;
+  }
+}
+
+template<typename CODEC, typename T>
+inline void evaluate_vgh_compressed_impl(const multi_UBspline_3d_compressed* restrict spline_m,
+                                         T x,
+                                         T y,
+                                         T z,
+                                         T* restrict vals,
+                                         T* restrict grads,
+                                         T* restrict hess,
+                                         size_t out_offset,
+                                         int first,
+                                         int last)
+{
+  int ix, iy, iz;
+  T a[4], b[4], c[4], da[4], db[4], dc[4], d2a[4], d2b[4], d2c[4];
+
+  computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c, da, db, dc, d2a, d2b, d2c);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  const int num_splines = last - first;
+
+  T* restrict gx = grads;
+  T* restrict gy = grads + out_offset;
+  T* restrict gz = grads + 2 * out_offset;
+
+  T* restrict hxx = hess;
+  T* restrict hxy = hess + out_offset;
+  T* restrict hxz = hess + 2 * out_offset;
+  T* restrict hyy = hess + 3 * out_offset;
+  T* restrict hyz = hess + 4 * out_offset;
+  T* restrict hzz = hess + 5 * out_offset;
+
+  std::fill(vals, vals + num_splines, T());
+  std::fill(gx, gx + num_splines, T());
+  std::fill(gy, gy + num_splines, T());
+  std::fill(gz, gz + num_splines, T());
+  std::fill(hxx, hxx + num_splines, T());
+  std::fill(hxy, hxy + num_splines, T());
+  std::fill(hxz, hxz + num_splines, T());
+  std::fill(hyy, hyy + num_splines, T());
+  std::fill(hyz, hyz + num_splines, T());
+  std::fill(hzz, hzz + num_splines, T());
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const uint16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const uint16_t* restrict coefszs  = coefs + zs;
+      const uint16_t* restrict coefs2zs = coefs + 2 * zs;
+      const uint16_t* restrict coefs3zs = coefs + 3 * zs;
+
+      const T pre20 = d2a[i] * b[j];
+      const T pre10 = da[i] * b[j];
+      const T pre00 = a[i] * b[j];
+      const T pre11 = da[i] * db[j];
+      const T pre01 = a[i] * db[j];
+      const T pre02 = a[i] * d2b[j];
+
+#pragma omp simd aligned(gx, gy, gz, hxx, hxy, hxz, hyy, hyz, hzz, vals)
+      for (int n = 0; n < num_splines; n++)
+      {
+        const float coefsv    = CODEC::decode(coefs[n]);
+        const float coefsvzs  = CODEC::decode(coefszs[n]);
+        const float coefsv2zs = CODEC::decode(coefs2zs[n]);
+        const float coefsv3zs = CODEC::decode(coefs3zs[n]);
+
+        T sum0 = c[0] * coefsv + c[1] * coefsvzs + c[2] * coefsv2zs + c[3] * coefsv3zs;
+        T sum1 = dc[0] * coefsv + dc[1] * coefsvzs + dc[2] * coefsv2zs + dc[3] * coefsv3zs;
+        T sum2 = d2c[0] * coefsv + d2c[1] * coefsvzs + d2c[2] * coefsv2zs + d2c[3] * coefsv3zs;
+
+        hxx[n] += pre20 * sum0;
+        hxy[n] += pre11 * sum0;
+        hxz[n] += pre10 * sum1;
+        hyy[n] += pre02 * sum0;
+        hyz[n] += pre01 * sum1;
+        hzz[n] += pre00 * sum2;
+        gx[n] += pre10 * sum0;
+        gy[n] += pre01 * sum0;
+        gz[n] += pre00 * sum1;
+        vals[n] += pre00 * sum0;
+      }
+    }
+
+  const T dxInv = spline_m->x_grid.delta_inv;
+  const T dyInv = spline_m->y_grid.delta_inv;
+  const T dzInv = spline_m->z_grid.delta_inv;
+  const T dxx   = dxInv * dxInv;
+  const T dyy   = dyInv * dyInv;
+  const T dzz   = dzInv * dzInv;
+  const T dxy   = dxInv * dyInv;
+  const T dxz   = dxInv * dzInv;
+  const T dyz   = dyInv * dzInv;
+
+  const float* restrict scales = spline_m->scales + first;
+#pragma omp simd aligned(gx, gy, gz, hxx, hxy, hxz, hyy, hyz, hzz, vals)
+  for (int n = 0; n < num_splines; n++)
+  {
+    const T s = scales[n];
+    vals[n] *= s;
+    gx[n] *= dxInv * s;
+    gy[n] *= dyInv * s;
+    gz[n] *= dzInv * s;
+    hxx[n] *= dxx * s;
+    hyy[n] *= dyy * s;
+    hzz[n] *= dzz * s;
+    hxy[n] *= dxy * s;
+    hxz[n] *= dxz * s;
+    hyz[n] *= dyz * s;
+  }
+}
+
+/// dispatch on the storage format, same signatures as the uncompressed kernels
+template<typename T>
+inline void evaluate_v_impl(const multi_UBspline_3d_compressed* restrict spline_m,
+                            T x,
+                            T y,
+                            T z,
+                            T* restrict vals,
+                            int first,
+                            int last)
+{
+  if (spline_m->format == CoefsFormat::BF16)
+    evaluate_v_compressed_impl<bf16_codec>(spline_m, x, y, z, vals, first, last);
+  else
+    evaluate_v_compressed_impl<fp16_codec>(spline_m, x, y, z, vals, first, last);
+}
+
+template<typename T>
+inline void evaluate_vgl_impl(const multi_UBspline_3d_compressed* restrict spline_m,
+                              T x,
+                              T y,
+                              T z,
+                              T* restrict vals,
+                              T* restrict grads,
+                              T* restrict lapl,
+                              size_t out_offset,
+                              int first,
+                              int last)
+{
+  if (spline_m->format == CoefsFormat::BF16)
+    evaluate_vgl_compressed_impl<bf16_codec>(spline_m, x, y, z, vals, grads, lapl, out_offset, first, last);
+  else
+    evaluate_vgl_compressed_impl<fp16_codec>(spline_m, x, y, z, vals, grads, lapl, out_offset, first, last);
+}
+
+template<typename T>
+inline void evaluate_vgh_impl(const multi_UBspline_3d_compressed* restrict spline_m,
+                              T x,
+                              T y,
+                              T z,
+                              T* restrict vals,
+                              T* restrict grads,
+                              T* restrict hess,
+                              size_t out_offset,
+                              int first,
+                              int last)
+{
+  if (spline_m->format == CoefsFormat::BF16)
+    evaluate_vgh_compressed_impl<bf16_codec>(spline_m, x, y, z, vals, grads, hess, out_offset, first, last);
+  else
+    evaluate_vgh_compressed_impl<fp16_codec>(spline_m, x, y, z, vals, grads, hess, out_offset, first, last);
+}
+
+/** many positions, one after another
+ *
+ * The 16-bit stencil lines of nearby positions are already half the size, no
+ * cache blocking over the splines is done.
+ */
+template<typename T, typename PT>
+inline void evaluate_v_multi_impl(const multi_UBspline_3d_compressed* restrict spline_m,
+                                  const PT* restrict r,
+                                  int npos,
+                                  T* restrict vals,
+                                  size_t out_stride,
+                                  int first,
+                                  int last)
+{
+  for (int ip = 0; ip < npos; ip++)
+    evaluate_v_impl(spline_m, T(r[ip][0]), T(r[ip][1]), T(r[ip][2]), vals + ip * out_stride, first, last);
+}
+
+} // namespace spline2
+#endif
@@ -47,6 +47,12 @@
 ///include evaluate_vghgh_impl
 #include <spline2/MultiBsplineVGHGH.hpp>
 
+///include evaluate_v/vgl_multi_impl
+#include <spline2/MultiBsplineMultiPos.hpp>
+
+///include overloads for the 16-bit compressed coefficients
+#include <spline2/MultiBsplineCompressedEval.hpp>
+
 namespace spline2
 {
 /// evaluate values optionally in the range [first,last)
@@ -111,5 +117,45 @@ __forceinline void evaluate3d_vghgh(const SPLINET& spline,
                       ghess.data() + first, psi.size(), first, last);
 }
 
+/** evaluate values at npos positions optionally in the range [first,last)
+ * @param r positions
+ * @param psi matrix with a row of padded size per position
+ */
+template<typename SPLINET, typename PT, typename VM>
+__forceinline void evaluate3d_multi(const SPLINET& spline, const PT* r, int npos, VM& psi)
+{
+  evaluate_v_multi_impl(spline, r, npos, psi.data(), psi.cols(), 0, psi.cols());
+}
+
+template<typename SPLINET, typename PT, typename VM>
+__forceinline void evaluate3d_multi(const SPLINET& spline, const PT* r, int npos, VM& psi, int first, int last)
+{
+  evaluate_v_multi_impl(spline, r, npos, psi.data() + first, psi.cols(), first, last);
+}
+
+/** evaluate values, gradients, laplacians at npos positions optionally in the range [first,last)
+ * @param psi matrix with a row of padded size per position
+ * @param grad, lap matrices with a row of three times the padded size per position
+ */
+template<typename SPLINET, typename PT, typename VM, typename GM, typename LM>
+__forceinline void evaluate3d_vgl_multi(const SPLINET& spline, const PT* r, int npos, VM& psi, GM& grad, LM& lap)
+{
+  evaluate_vgl_multi_impl(spline, r, npos, psi.data(), grad.data(), lap.data(), psi.cols(), 0, psi.cols());
+}
+
+template<typename SPLINET, typename PT, typename VM, typename GM, typename LM>
+__forceinline void evaluate3d_vgl_multi(const SPLINET& spline,
+                                        const PT* r,
+                                        int npos,
+                                        VM& psi,
+                                        GM& grad,
+                                        LM& lap,
+                                        int first,
+                                        int last)
+{
+  evaluate_vgl_multi_impl(spline, r, npos, psi.data() + first, grad.data() + first, lap.data() + first, psi.cols(),
+                          first, last);
+}
+
 } // namespace spline2
 #endif
@@ -0,0 +1,218 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2019 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineMultiPos.hpp
+ *
+ * Evaluation of a MultiBspline at many positions in a single call.
+ *
+ * The single position kernels stream the 64 coefficient lines of the 4x4x4
+ * stencil over the full spline range. Positions which are close to each other,
+ * e.g. the quadrature points of a non-local pseudopotential, share most of
+ * their stencil lines. The kernels here walk the spline range in cache blocks
+ * and evaluate all the positions within a block, so that the shared lines are
+ * reused from cache instead of being read again from memory.
+ *
+ * Results of position ip start at vals + ip * out_stride with vals pointing at
+ * the element of spline first, the same as the single position kernels.
+ */
+#ifndef SPLINE2_MULTIEINSPLINE_MULTIPOS_HPP
+#define SPLINE2_MULTIEINSPLINE_MULTIPOS_HPP
+
+#include <algorithm>
+
+namespace spline2
+{
+/** number of splines in a cache block of the multi-position kernels
+ *
+ * 64 stencil lines of 2KB each, 128KB per position, stay in L2 while the
+ * positions of a chunk are evaluated. A multiple of the SIMD alignment.
+ */
+template<typename T>
+constexpr int getMultiPosBlockSize()
+{
+  return 2048 / sizeof(T);
+}
+
+/// number of positions whose stencil weights are kept at once
+constexpr int MultiPosChunkSize = 16;
+
+template<typename T, typename PT>
+inline void evaluate_v_multi_impl(const typename qmcplusplus::bspline_traits<T, 3>::SplineType* restrict spline_m,
+                                  const PT* restrict r,
+                                  int npos,
+                                  T* restrict vals,
+                                  size_t out_stride,
+                                  int first,
+                                  int last)
+{
+  int ix[MultiPosChunkSize], iy[MultiPosChunkSize], iz[MultiPosChunkSize];
+  T a[MultiPosChunkSize][4], b[MultiPosChunkSize][4], c[MultiPosChunkSize][4];
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  constexpr int block_size = getMultiPosBlockSize<T>();
+
+  for (int ip0 = 0; ip0 < npos; ip0 += MultiPosChunkSize)
+  {
+    const int np = std::min(MultiPosChunkSize, npos - ip0);
+    for (int ip = 0; ip < np; ip++)
+      computeLocationAndFractional(spline_m, T(r[ip0 + ip][0]), T(r[ip0 + ip][1]), T(r[ip0 + ip][2]), ix[ip], iy[ip],
+                                   iz[ip], a[ip], b[ip], c[ip]);
+
+    for (int block_first = first; block_first < last; block_first += block_size)
+    {
+      const int num_splines = std::min(block_size, last - block_first);
+      for (int ip = 0; ip < np; ip++)
+      {
+        T* restrict val = vals + (ip0 + ip) * out_stride + (block_first - first);
+        std::fill(val, val + num_splines, T());
+
+        for (int i = 0; i < 4; i++)
+          for (int j = 0; j < 4; j++)
+          {
+            const T pre00 = a[ip][i] * b[ip][j];
+            const T* restrict coefs =
+                spline_m->coefs + ((ix[ip] + i) * xs + (iy[ip] + j) * ys + iz[ip] * zs) + block_first;
+            const T* restrict coefszs  = coefs + zs;
+            const T* restrict coefs2zs = coefs + 2 * zs;
+            const T* restrict coefs3zs = coefs + 3 * zs;
+#pragma omp simd aligned(coefs, coefszs, coefs2zs, coefs3zs, val)
+            for (int n = 0; n < num_splines; n++)
+              val[n] += pre00 *
+                  (c[ip][0] * coefs[n] + c[ip][1] * coefszs[n] + c[ip][2] * coefs2zs[n] + c[ip][3] * coefs3zs[n]);
+          }
+      }
+    }
+  }
+}
+
+/** values, gradients and laplacians at many positions
+ *
+ * grads and lapl of position ip start at grads + ip * 3 * out_stride and
+ * lapl + ip * 3 * out_stride with the components out_stride apart. lapl is
+ * used as scratch, the laplacian ends up in its first component.
+ */
+template<typename T, typename PT>
+inline void evaluate_vgl_multi_impl(const typename qmcplusplus::bspline_traits<T, 3>::SplineType* restrict spline_m,
+                                    const PT* restrict r,
+                                    int npos,
+                                    T* restrict vals,
+                                    T* restrict grads,
+                                    T* restrict lapl,
+                                    size_t out_stride,
+                                    int first,
+                                    int last)
+{
+  int ix[MultiPosChunkSize], iy[MultiPosChunkSize], iz[MultiPosChunkSize];
+  T a[MultiPosChunkSize][4], b[MultiPosChunkSize][4], c[MultiPosChunkSize][4];
+  T da[MultiPosChunkSize][4], db[MultiPosChunkSize][4], dc[MultiPosChunkSize][4];
+  T d2a[MultiPosChunkSize][4], d2b[MultiPosChunkSize][4], d2c[MultiPosChunkSize][4];
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  const T dxInv = spline_m->x_grid.delta_inv;
+  const T dyInv = spline_m->y_grid.delta_inv;
+  const T dzInv = spline_m->z_grid.delta_inv;
+
+  const T dxInv2 = dxInv * dxInv;
+  const T dyInv2 = dyInv * dyInv;
+  const T dzInv2 = dzInv * dzInv;
+
+  constexpr int block_size = getMultiPosBlockSize<T>();
+
+  for (int ip0 = 0; ip0 < npos; ip0 += MultiPosChunkSize)
+  {
+    const int np = std::min(MultiPosChunkSize, npos - ip0);
+    for (int ip = 0; ip < np; ip++)
+      computeLocationAndFractional(spline_m, T(r[ip0 + ip][0]), T(r[ip0 + ip][1]), T(r[ip0 + ip][2]), ix[ip], iy[ip],
+                                   iz[ip], a[ip], b[ip], c[ip], da[ip], db[ip], dc[ip], d2a[ip], d2b[ip], d2c[ip]);
+
+    for (int block_first = first; block_first < last; block_first += block_size)
+    {
+      const int num_splines = std::min(block_size, last - block_first);
+      const int offset      = block_first - first;
+      for (int ip = 0; ip < np; ip++)
+      {
+        T* restrict val = vals + (ip0 + ip) * out_stride + offset;
+        T* restrict gx  = grads + (ip0 + ip) * 3 * out_stride + offset;
+        T* restrict gy  = gx + out_stride;
+        T* restrict gz  = gx + 2 * out_stride;
+        T* restrict lx  = lapl + (ip0 + ip) * 3 * out_stride + offset;
+        T* restrict ly  = lx + out_stride;
+        T* restrict lz  = lx + 2 * out_stride;
+
+        std::fill(val, val + num_splines, T());
+        std::fill(gx, gx + num_splines, T());
+        std::fill(gy, gy + num_splines, T());
+        std::fill(gz, gz + num_splines, T());
+        std::fill(lx, lx + num_splines, T());
+        std::fill(ly, ly + num_splines, T());
+        std::fill(lz, lz + num_splines, T());
+
+        const T* restrict pc   = c[ip];
+        const T* restrict pdc  = dc[ip];
+        const T* restrict pd2c = d2c[ip];
+
+        for (int i = 0; i < 4; i++)
+          for (int j = 0; j < 4; j++)
+          {
+            const T pre20 = d2a[ip][i] * b[ip][j];
+            const T pre10 = da[ip][i] * b[ip][j];
+            const T pre00 = a[ip][i] * b[ip][j];
+            const T pre01 = a[ip][i] * db[ip][j];
+            const T pre02 = a[ip][i] * d2b[ip][j];
+
+            const T* restrict coefs =
+                spline_m->coefs + ((ix[ip] + i) * xs + (iy[ip] + j) * ys + iz[ip] * zs) + block_first;
+            const T* restrict coefszs  = coefs + zs;
+            const T* restrict coefs2zs = coefs + 2 * zs;
+            const T* restrict coefs3zs = coefs + 3 * zs;
+
+#pragma omp simd aligned(coefs, coefszs, coefs2zs, coefs3zs, gx, gy, gz, lx, ly, lz, val)
+            for (int n = 0; n < num_splines; n++)
+            {
+              const T coefsv    = coefs[n];
+              const T coefsvzs  = coefszs[n];
+              const T coefsv2zs = coefs2zs[n];
+              const T coefsv3zs = coefs3zs[n];
+
+              T sum0 = pc[0] * coefsv + pc[1] * coefsvzs + pc[2] * coefsv2zs + pc[3] * coefsv3zs;
+              T sum1 = pdc[0] * coefsv + pdc[1] * coefsvzs + pdc[2] * coefsv2zs + pdc[3] * coefsv3zs;
+              T sum2 = pd2c[0] * coefsv + pd2c[1] * coefsvzs + pd2c[2] * coefsv2zs + pd2c[3] * coefsv3zs;
+              gx[n] += pre10 * sum0;
+              gy[n] += pre01 * sum0;
+              gz[n] += pre00 * sum1;
+              lx[n] += pre20 * sum0;
+              ly[n] += pre02 * sum0;
+              lz[n] += pre00 * sum2;
+              val[n] += pre00 * sum0;
+            }
+          }
+
+#pragma omp simd aligned(gx, gy, gz, lx)
+        for (int n = 0; n < num_splines; n++)
+        {
+          gx[n] *= dxInv;
+          gy[n] *= dyInv;
+          gz[n] *= dzInv;
+          lx[n] = lx[n] * dxInv2 + ly[n] * dyInv2 + lz[n] * dzInv2;
+        }
+      }
+    }
+  }
+}
+
+} // namespace spline2
+#endif
@@ -14,7 +14,9 @@
 #include "catch.hpp"
 
 #include <OhmmsSoA/Container.h>
+#include <OhmmsPETE/OhmmsMatrix.h>
 #include "spline2/MultiBspline.hpp"
+#include "spline2/MultiBsplineCompressed.hpp"
 #include "spline2/MultiBsplineEval.hpp"
 #include "QMCWaveFunctions/BsplineFactory/contraction_helper.hpp"
 #include "config/stdlib/Constants.h"
@@ -375,4 +377,138 @@ TEST_CASE("MultiBspline periodic double large", "[.spline2]")
 
 TEST_CASE("MultiBspline periodic float", "[spline2]") { test_splines<float>().test(); }
 
+/** multi-position kernels against the single position ones
+ *  more splines than a cache block and more positions than a chunk
+ */
+template<typename T>
+void test_multi_position()
+{
+  test_splines_base<T, 8, 600> ts;
+  const int npad = ts.npad;
+
+  MultiBspline<T> bs;
+  bs.create(ts.grid, ts.bc, npad);
+
+  BsplineAllocator<double> mAllocator;
+  UBspline_3d_d* aspline =
+      mAllocator.allocateUBspline(ts.grid[0], ts.grid[1], ts.grid[2], ts.bc[0], ts.bc[1], ts.bc[2], ts.data.data());
+  for (int i = 0; i < ts.num_splines; i++)
+    bs.copy_spline(aspline, i);
+  mAllocator.destroy(aspline);
+
+  const int npos = 20;
+  std::vector<TinyVector<T, 3>> pos(npos);
+  for (int ip = 0; ip < npos; ip++)
+    pos[ip] = {T(0.3 + 0.01 * ip), T(0.7 - 0.02 * ip), T(0.05 * ip)};
+
+  Matrix<T, aligned_allocator<T>> multi_v(npos, npad);
+  Matrix<T, aligned_allocator<T>> multi_g(npos, 3 * npad);
+  Matrix<T, aligned_allocator<T>> multi_l(npos, 3 * npad);
+  spline2::evaluate3d_multi(bs.getSplinePtr(), pos.data(), npos, multi_v);
+
+  aligned_vector<T> v(npad);
+  VectorSoaContainer<T, 3> dv(npad);
+  VectorSoaContainer<T, 3> lap(npad);
+  for (int ip = 0; ip < npos; ip++)
+  {
+    spline2::evaluate3d(bs.getSplinePtr(), pos[ip], v);
+    for (int n = 0; n < ts.num_splines; n++)
+      REQUIRE(multi_v[ip][n] == Approx(v[n]));
+  }
+
+  // a sub range starting past the first block
+  const int first = spline2::getMultiPosBlockSize<T>() + getAlignment<T>();
+  spline2::evaluate3d_vgl_multi(bs.getSplinePtr(), pos.data(), npos, multi_v, multi_g, multi_l, first, npad);
+  for (int ip = 0; ip < npos; ip++)
+  {
+    spline2::evaluate3d_vgl(bs.getSplinePtr(), pos[ip], v, dv, lap);
+    for (int n = first; n < ts.num_splines; n++)
+    {
+      REQUIRE(multi_v[ip][n] == Approx(v[n]));
+      for (int idim = 0; idim < 3; idim++)
+        REQUIRE(multi_g[ip][idim * npad + n] == Approx(dv[n][idim]));
+      REQUIRE(multi_l[ip][n] == Approx(lap[n][0]));
+    }
+  }
+}
+
+TEST_CASE("MultiBspline multi-position double", "[spline2]") { test_multi_position<double>(); }
+
+TEST_CASE("MultiBspline multi-position float", "[spline2]") { test_multi_position<float>(); }
+
+TEST_CASE("compressed coefficient codecs", "[spline2]")
+{
+  REQUIRE(spline2::bf16_codec::decode(spline2::bf16_codec::encode(1.0f)) == 1.0f);
+  REQUIRE(spline2::fp16_codec::decode(spline2::fp16_codec::encode(-0.5f)) == -0.5f);
+  REQUIRE(spline2::fp16_codec::decode(spline2::fp16_codec::encode(0.0f)) == 0.0f);
+  REQUIRE(spline2::bf16_codec::decode(spline2::bf16_codec::encode(0.1f)) == Approx(0.1f).epsilon(1.0 / 256));
+  REQUIRE(spline2::fp16_codec::decode(spline2::fp16_codec::encode(0.1f)) == Approx(0.1f).epsilon(1.0 / 2048));
+  // rounding carries into the exponent
+  REQUIRE(spline2::fp16_codec::decode(spline2::fp16_codec::encode(0.99999f)) == 1.0f);
+  // subnormals are flushed
+  REQUIRE(spline2::fp16_codec::decode(spline2::fp16_codec::encode(1e-6f)) == 0.0f);
+}
+
+/** compressed tables against the single precision one
+ *  the errors are bounded by the largest coefficient error returned by compress
+ */
+void test_compressed(spline2::CoefsFormat format)
+{
+  test_splines_base<float, 8, 20> ts;
+  const int npad = ts.npad;
+
+  MultiBspline<float> bs;
+  bs.create(ts.grid, ts.bc, npad);
+
+  BsplineAllocator<double> mAllocator;
+  UBspline_3d_d* aspline =
+      mAllocator.allocateUBspline(ts.grid[0], ts.grid[1], ts.grid[2], ts.bc[0], ts.bc[1], ts.bc[2], ts.data.data());
+  for (int i = 0; i < ts.num_splines; i++)
+    bs.copy_spline(aspline, i);
+  mAllocator.destroy(aspline);
+
+  MultiBsplineCompressed<> cbs;
+  const double max_error = cbs.compress(bs.getSplinePtr(), ts.num_splines, format);
+  REQUIRE(max_error > 0.0);
+  REQUIRE(max_error < (format == spline2::CoefsFormat::BF16 ? 2e-2 : 2e-3));
+  REQUIRE(cbs.sizeInByte() < bs.sizeInByte());
+
+  const double dinv = bs.getSplinePtr()->x_grid.delta_inv;
+  TinyVector<float, 3> pos = {0.1, 0.2, 0.3};
+
+  aligned_vector<float> v(npad), cv(npad);
+  spline2::evaluate3d(bs.getSplinePtr(), pos, v);
+  spline2::evaluate3d(cbs.getSplinePtr(), pos, cv);
+  for (int n = 0; n < ts.num_splines; n++)
+    REQUIRE(std::abs(cv[n] - v[n]) <= max_error * 1.001 + 1e-6);
+
+  VectorSoaContainer<float, 3> dv(npad), cdv(npad);
+  VectorSoaContainer<float, 3> lap(npad), clap(npad);
+  spline2::evaluate3d_vgl(bs.getSplinePtr(), pos, v, dv, lap);
+  spline2::evaluate3d_vgl(cbs.getSplinePtr(), pos, cv, cdv, clap);
+  for (int n = 0; n < ts.num_splines; n++)
+  {
+    REQUIRE(std::abs(cv[n] - v[n]) <= max_error * 1.001 + 1e-6);
+    for (int idim = 0; idim < 3; idim++)
+      REQUIRE(std::abs(cdv[n][idim] - dv[n][idim]) <= 4 * max_error * dinv + 1e-4);
+    REQUIRE(std::abs(clap[n][0] - lap[n][0]) <= 24 * max_error * dinv * dinv + 1e-2);
+  }
+
+  VectorSoaContainer<float, 6> hess(npad), chess(npad);
+  spline2::evaluate3d_vgh(bs.getSplinePtr(), pos, v, dv, hess);
+  spline2::evaluate3d_vgh(cbs.getSplinePtr(), pos, cv, cdv, chess);
+  for (int n = 0; n < ts.num_splines; n++)
+  {
+    REQUIRE(std::abs(cv[n] - v[n]) <= max_error * 1.001 + 1e-6);
+    for (int idim = 0; idim < 3; idim++)
+      REQUIRE(std::abs(cdv[n][idim] - dv[n][idim]) <= 4 * max_error * dinv + 1e-4);
+    for (int i = 0; i < 6; i++)
+      REQUIRE(std::abs(chess[n][i] - hess[n][i]) <= 8 * max_error * dinv * dinv + 1e-2);
+  }
+}
+
+TEST_CASE("MultiBspline compressed bf16", "[spline2]") { test_compressed(spline2::CoefsFormat::BF16); }
+
+TEST_CASE("MultiBspline compressed fp16", "[spline2]") { test_compressed(spline2::CoefsFormat::FP16); }
+
 } // namespace qmcplusplus